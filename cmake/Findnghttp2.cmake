@@ -0,0 +1,47 @@
+#.rst:
+# Findnghttp2
+# -----------
+#
+# Find the nghttp2 HTTP/2 C library.
+#
+# Result Variables
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the following variables:
+#
+# ::
+#
+#   NGHTTP2_FOUND          - True if nghttp2 is found.
+#   NGHTTP2_INCLUDE_DIRS   - Where to find nghttp2/nghttp2.h
+#   NGHTTP2_LIBRARIES      - Where to find libnghttp2.so
+#
+# ::
+#
+#   NGHTTP2_VERSION        - The version of nghttp2 found (x.y.z)
+
+find_path(NGHTTP2_INCLUDE_DIR NAMES nghttp2/nghttp2.h PATH_SUFFIXES include)
+
+if(NOT NGHTTP2_LIBRARY)
+  find_library(NGHTTP2_LIBRARY NAMES nghttp2 PATH_SUFFIXES lib)
+endif()
+
+mark_as_advanced(NGHTTP2_INCLUDE_DIR NGHTTP2_LIBRARY)
+
+if(NGHTTP2_INCLUDE_DIR AND EXISTS "${NGHTTP2_INCLUDE_DIR}/nghttp2/nghttp2ver.h")
+  file(STRINGS "${NGHTTP2_INCLUDE_DIR}/nghttp2/nghttp2ver.h" NGHTTP2_H
+       REGEX "^#define NGHTTP2_VERSION \"[^\"]*\"$")
+  string(REGEX REPLACE "^.*NGHTTP2_VERSION \"([0-9.]+).*$" "\\1"
+         NGHTTP2_VERSION "${NGHTTP2_H}")
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(nghttp2
+  REQUIRED_VARS NGHTTP2_LIBRARY NGHTTP2_INCLUDE_DIR VERSION_VAR NGHTTP2_VERSION)
+
+if(NGHTTP2_FOUND)
+  set(NGHTTP2_INCLUDE_DIRS "${NGHTTP2_INCLUDE_DIR}")
+
+  if(NOT NGHTTP2_LIBRARIES)
+    set(NGHTTP2_LIBRARIES ${NGHTTP2_LIBRARY})
+  endif()
+endif()
@@ -12,6 +12,7 @@ endif()
 include( CMakeDependentOption )
 
 define_default( PLUGIN_VERSION    5 )
+define_default( XRDCMS_MAXNODES  64 )
 option( ENABLE_FUSE      "Enable the fuse filesystem driver if possible."                 TRUE )
 option( ENABLE_KRB5      "Enable the Kerberos 5 authentication if possible."              TRUE )
 option( ENABLE_READLINE  "Enable the lib readline support in the commandline utilities."  TRUE )
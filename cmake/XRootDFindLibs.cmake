@@ -95,6 +95,12 @@ if( ENABLE_HTTP )
     endif()
     set( BUILD_TPC FALSE )
   endif()
+  find_package( nghttp2 1.12 )
+  if( NGHTTP2_FOUND )
+    set( BUILD_HTTP2 TRUE )
+  else()
+    set( BUILD_HTTP2 FALSE )
+  endif()
 endif()
 
 if( BUILD_TPC )
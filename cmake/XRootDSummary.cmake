@@ -5,6 +5,7 @@ set( TRUE_VAR TRUE )
 component_status( CEPH      XRDCEPH_SUBMODULE TRUE_VAR)
 component_status( FUSE      BUILD_FUSE        FUSE_FOUND )
 component_status( HTTP      BUILD_HTTP        OPENSSL_FOUND )
+component_status( HTTP2     BUILD_HTTP        NGHTTP2_FOUND )
 component_status( KRB5      BUILD_KRB5        KERBEROS5_FOUND )
 component_status( MACAROONS BUILD_MACAROONS   MACAROONS_FOUND AND JSON_FOUND AND BUILD_HTTP )
 component_status( PYTHON    BUILD_PYTHON      Python_Interpreter_FOUND AND Python_Development_FOUND )
@@ -23,6 +24,7 @@ message( STATUS "C Compiler:        " ${CMAKE_C_COMPILER} )
 message( STATUS "C++ Compiler:      " ${CMAKE_CXX_COMPILER} )
 message( STATUS "Build type:        " ${CMAKE_BUILD_TYPE} )
 message( STATUS "Plug-in version:   " ${PLUGIN_VERSION} )
+message( STATUS "Cms cell size:     " ${XRDCMS_MAXNODES} )
 message( STATUS "" )
 message( STATUS "Ceph support:      " ${STATUS_CEPH} )
 message( STATUS "Readline support:  " ${STATUS_READLINE} )
@@ -31,6 +33,7 @@ message( STATUS "Kerberos5 support: " ${STATUS_KRB5} )
 message( STATUS "XrdCl:             " ${STATUS_XRDCL} )
 message( STATUS "XrdClHttp:         " ${STATUS_XRDCLHTTP} )
 message( STATUS "HTTP support:      " ${STATUS_HTTP} )
+message( STATUS "HTTP/2 support:    " ${STATUS_HTTP2} )
 message( STATUS "HTTP TPC support:  " ${STATUS_TPC} )
 message( STATUS "VOMS support:      " ${STATUS_VOMSXRD} )
 message( STATUS "Python support:    " ${STATUS_PYTHON} )
@@ -29,6 +29,23 @@ if( NOT HAVE_SIGWTI )
   compiler_define_if_found( HAVE_SIGWTI_IN_RT HAVE_SIGWTI )
 endif()
 
+#-------------------------------------------------------------------------------
+# io_uring (the headers must be recent enough to describe the probe interface)
+#-------------------------------------------------------------------------------
+if( LINUX )
+  check_cxx_source_compiles("
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+int main()
+{
+  int ops[] = {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC,
+               IORING_REGISTER_PROBE, IORING_SETUP_CLAMP, __NR_io_uring_setup};
+  return sizeof(ops) == 0;
+}
+" HAVE_IO_URING )
+  compiler_define_if_found( HAVE_IO_URING HAVE_IO_URING )
+endif()
+
 check_include_file( shadow.h HAVE_SHADOWPW )
 compiler_define_if_found( HAVE_SHADOWPW HAVE_SHADOWPW )
 
@@ -115,6 +115,7 @@ enum CmsReqCode            // Request Codes
      kYR_update  = 25,
      kYR_usage   = 26,
      kYR_xauth   = 27,
+     kYR_bloom   = 28,
      kYR_MaxReq            // Count of request numbers (highest + 1)
 };
 
@@ -187,6 +188,36 @@ struct CmsAvailRequest
 //     kXR_int32     diskUtil;
 };
 
+/******************************************************************************/
+/*                         b l o o m   R e q u e s t                          */
+/******************************************************************************/
+  
+// Request: bloom <gen> <bits> <offset> <hashes> <summary piece>
+// Respond: n/a
+//
+// A namespace summary is a Bloom filter of the paths a server has. It is far
+// larger than a request may be so it is sent as consecutive pieces of at most
+// maxData bytes, starting at offset zero, that all carry the same generation.
+// Bit n of the summary is bit (n % 8) of byte (n / 8), the low order bit being
+// bit 0, so the summary is sent and merged byte by byte in the same order on
+// every platform and needs no conversion.
+//
+struct CmsBloomData
+{      kXR_unt32     Gen;                // Generation of the summary
+       kXR_unt32     Bits;               // Size of the summary in bits
+       kXR_unt32     Offset;             // Offset, in bytes, of this piece
+       kXR_char      Hashes;             // Number of hash functions
+       kXR_char      Rsvd[3];
+};
+
+struct CmsBloomRequest
+{      CmsRRHdr      Hdr;                // Always has the kYR_raw modifier
+       CmsBloomData  Data;
+//     kXR_char      Piece[Hdr.datalen-sizeof(Data)];
+
+static const int     maxData = 8192;
+};
+
 /******************************************************************************/
 /*                         c h m o d   R e q u e s t                          */
 /******************************************************************************/
@@ -30,6 +30,7 @@
 #include <unistd.h>
 #include <cstdio>
 #include <cstdlib>
+#include <sys/mman.h>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
@@ -47,6 +48,7 @@ static const int iniBuffSz = 1 << (XRD_BUSHIFT+XRD_BUCKETS-1);
 static const int minBuffSz = 1 << (XRD_BUSHIFT+XRD_BUCKETS);
 static const int minBShift =      (XRD_BUSHIFT+XRD_BUCKETS);
 static const int isBigBuff = 0x40000000;
+static const int hugePgSz = 2*1024*1024; // Typical transparent huge page
 }
  
 /******************************************************************************/
@@ -54,7 +56,8 @@ static const int isBigBuff = 0x40000000;
 /******************************************************************************/
 
 XrdBuffXL::XrdBuffXL() : bucket(0), totalo(0), pagsz(getpagesize()), slots(0),
-                         maxsz(1<<(XRD_BUSHIFT+XRD_BUCKETS-1)), totreq(0)
+                         maxsz(1<<(XRD_BUSHIFT+XRD_BUCKETS-1)), totreq(0),
+                         totbuf(0), tothuge(0)
 { }
 
 /******************************************************************************/
@@ -130,9 +133,16 @@ XrdBuffer *XrdBuffXL::Obtain(int sz)
 //
    if (bp) return bp;
 
-// Allocate a chunk of aligned memory
+// Allocate a chunk of memory aligned on a huge page boundary. Since these
+// buffers are always a multiple of the huge page size we ask that they be
+// backed by huge pages to cut down on TLB misses when they are filled.
 //
-   if (posix_memalign((void **)&memp, pagsz, buffSz)) return 0;
+   bool isHuge = false;
+   if (posix_memalign((void **)&memp, hugePgSz, buffSz))
+      {if (posix_memalign((void **)&memp, pagsz, buffSz)) return 0;}
+#ifdef MADV_HUGEPAGE
+      else isHuge = !madvise(memp, buffSz, MADV_HUGEPAGE);
+#endif
 
 // Wrap the memory with a buffer object
 //
@@ -141,7 +151,10 @@ XrdBuffer *XrdBuffXL::Obtain(int sz)
 
 // Update statistics
 //
-   slotXL.Lock(); totalo += buffSz; totbuf++; slotXL.UnLock();
+   slotXL.Lock();
+   totalo += buffSz; totbuf++;
+   if (isHuge) tothuge++;
+   slotXL.UnLock();
 
 // Return the buffer
 //
@@ -199,17 +212,18 @@ void XrdBuffXL::Release(XrdBuffer *bp)
 int XrdBuffXL::Stats(char *buff, int blen, int do_sync)
 {
     static char statfmt[] = "<xlreqs>%d</xlreqs>"
-                "<xlmem>%lld</xlmem><xlbuffs>%d</xlbuffs>";
+                "<xlmem>%lld</xlmem><xlbuffs>%d</xlbuffs>"
+                "<xlhuge>%d</xlhuge>";
     int nlen;
 
 // If only size wanted, return it
 //
-   if (!buff) return sizeof(statfmt) + 16*3;
+   if (!buff) return sizeof(statfmt) + 16*4;
 
 // Return formatted stats
 //
    if (do_sync) slotXL.Lock();
-   nlen = snprintf(buff, blen, statfmt, totreq, totalo, totbuf);
+   nlen = snprintf(buff, blen, statfmt, totreq, totalo, totbuf, tothuge);
    if (do_sync) slotXL.UnLock();
    return nlen;
 }
@@ -76,5 +76,6 @@ const  int        pagsz;
        int        maxsz;
        int        totreq;
        int        totbuf;
+       int        tothuge; // Buffers backed by huge pages
 };
 #endif
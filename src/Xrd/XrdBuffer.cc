@@ -31,6 +31,7 @@
 #include <unistd.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
@@ -61,8 +62,35 @@ const char *XrdBuffManager::TraceID = "BuffManager";
 namespace
 {
 static const int minBuffSz = 1 << XRD_BUSHIFT;
+static const int tcMaxNum  = 16; // Max buffers per bucket in a thread cache
 }
 
+/******************************************************************************/
+/*                          T h r e a d   C a c h e                           */
+/******************************************************************************/
+
+// Each thread keeps a small magazine of free buffers per bucket. It is filled
+// in batches from the shared pool and spilled back in batches so that most
+// Obtain() and Release() calls do not lock the shared pool. The cache belongs
+// to the first buffer manager that uses it and is returned on thread exit.
+//
+struct XrdBuffManager::TCache
+{
+XrdBuffManager *owner;
+XrdBuffer      *bnext[XRD_BUCKETS];
+int             numbuf[XRD_BUCKETS];
+int             numreq[XRD_BUCKETS];
+long long       cached;   // Bytes held by this cache
+int             hits;     // Requests satisfied since last sync
+
+               TCache() : owner(0), cached(0), hits(0)
+                        {memset(bnext,  0, sizeof(bnext));
+                         memset(numbuf, 0, sizeof(numbuf));
+                         memset(numreq, 0, sizeof(numreq));
+                        }
+              ~TCache() {if (owner) owner->tcDrain(*this);}
+};
+
 namespace XrdGlobal
 {
        XrdBuffXL   xlBuff;
@@ -97,6 +125,9 @@ XrdBuffManager::XrdBuffManager(int minrst) :
 #endif
    rsinprog = 0;
    minrsw   = minrst;
+   totnew   = 0;
+   tchits   = 0;
+   tcmax    = 0;
    memset(static_cast<void *>(bucket), 0, sizeof(bucket));
 }
 
@@ -156,13 +187,38 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
    if (mk < sz) {bindex++; mk = mk << 1;}
    if (bindex >= slots) return 0;    // Should never happen!
 
-// Obtain a lock on the bucket array and try to give away an existing buffer
+// Try to satisfy the request from this thread's cache
+//
+   TCache *tc = tcGet();
+   if (tc)
+      {tc->numreq[bindex]++;
+       if ((bp = tc->bnext[bindex]))
+          {tc->bnext[bindex] = bp->next; tc->numbuf[bindex]--;
+           tc->cached -= bp->bsize;
+           tc->hits++;
+           return bp;
+          }
+      }
+
+// Obtain a lock on the bucket array and try to give away an existing buffer.
+// If we have a thread cache, move a batch of buffers into it as well.
 //
     Reshaper.Lock();
-    totreq++;
-    bucket[bindex].numreq++;
+    if (tc) tcSync(*tc);
+       else {totreq++; bucket[bindex].numreq++;}
     if ((bp = bucket[bindex].bnext))
-       {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;}
+       {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;
+        if (tc)
+           {XrdBuffer *xp;
+            int n = tcMaxNum/2;
+            while(n-- && tc->cached + mk <= tcmax
+               && (xp = bucket[bindex].bnext))
+                 {bucket[bindex].bnext = xp->next; bucket[bindex].numbuf--;
+                  xp->next = tc->bnext[bindex]; tc->bnext[bindex] = xp;
+                  tc->numbuf[bindex]++; tc->cached += mk;
+                 }
+           }
+       }
     Reshaper.UnLock();
 
 // Check if we really allocated a buffer
@@ -182,6 +238,7 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
 //
     Reshaper.Lock();
     totbuf++;
+    totnew++;
     if ((totalo += mk) > maxalo && !rsinprog)
        {rsinprog = 1; Reshaper.Signal();}
     Reshaper.UnLock();
@@ -226,12 +283,33 @@ void XrdBuffManager::Release(XrdBuffer *bp)
 //
    if (bindex >= slots) {xlBuff.Release(bp); return;}
 
-// Obtain a lock on the bucket array and reclaim the buffer
+// Keep the buffer in this thread's cache if there is room for it
+//
+   TCache *tc = tcGet();
+   if (tc && tc->numbuf[bindex] < tcMaxNum && tc->cached + bp->bsize <= tcmax)
+      {bp->next = tc->bnext[bindex]; tc->bnext[bindex] = bp;
+       tc->numbuf[bindex]++; tc->cached += bp->bsize;
+       return;
+      }
+
+// Obtain a lock on the bucket array and reclaim the buffer. If the thread
+// cache was full, spill half of it so that subsequent releases stay local.
 //
     Reshaper.Lock();
     bp->next = bucket[bp->bindex].bnext;
     bucket[bp->bindex].bnext = bp;
     bucket[bindex].numbuf++;
+    if (tc)
+       {XrdBuffer *xp;
+        int n = (tc->numbuf[bindex]+1)/2;
+        while(n-- && (xp = tc->bnext[bindex]))
+             {tc->bnext[bindex] = xp->next;
+              tc->numbuf[bindex]--; tc->cached -= xp->bsize;
+              xp->next = bucket[bindex].bnext; bucket[bindex].bnext = xp;
+              bucket[bindex].numbuf++;
+             }
+        tcSync(*tc);
+       }
     Reshaper.UnLock();
 }
  
@@ -316,6 +394,17 @@ void XrdBuffManager::Set(int maxmem, int minw)
    Reshaper.UnLock();
 }
  
+/******************************************************************************/
+/*                             S e t T C a c h e                              */
+/******************************************************************************/
+  
+void XrdBuffManager::SetTCache(int maxbytes)
+{
+   Reshaper.Lock();
+   tcmax = (maxbytes > 0 ? maxbytes : 0);
+   Reshaper.UnLock();
+}
+
 /******************************************************************************/
 /*                                 S t a t s                                  */
 /******************************************************************************/
@@ -323,19 +412,87 @@ void XrdBuffManager::Set(int maxmem, int minw)
 int XrdBuffManager::Stats(char *buff, int blen, int do_sync)
 {
     static char statfmt[] = "<stats id=\"buff\"><reqs>%d</reqs>"
-                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s</stats>";
+                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>"
+                "<new>%d</new><tchits>%lld</tchits>%s</stats>";
     char xlStats[1024];
     int nlen;
 
 // If only size wanted, return it
 //
-   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0);
+   if (!buff) return sizeof(statfmt) + 16*6 + xlBuff.Stats(0,0);
 
-// Return formatted stats
+// Return formatted stats. Requests satisfied by thread caches are counted
+// when a thread next uses the shared pool, so the numbers may lag a bit.
 //
    if (do_sync) Reshaper.Lock();
    xlBuff.Stats(xlStats, sizeof(xlStats), do_sync);
-   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats);
+   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,
+                   totnew,tchits,xlStats);
    if (do_sync) Reshaper.UnLock();
    return nlen;
 }
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                               t c D r a i n                                */
+/******************************************************************************/
+
+void XrdBuffManager::tcDrain(TCache &tc)
+{
+   XrdBuffer *bp;
+
+// Return every cached buffer to the shared pool (called at thread exit)
+//
+   Reshaper.Lock();
+   for (int i = 0; i < XRD_BUCKETS; i++)
+       {while((bp = tc.bnext[i]))
+             {tc.bnext[i] = bp->next;
+              bp->next = bucket[i].bnext; bucket[i].bnext = bp;
+              bucket[i].numbuf++;
+             }
+        tc.numbuf[i] = 0;
+       }
+   tc.cached = 0;
+   tcSync(tc);
+   tc.owner = 0;
+   Reshaper.UnLock();
+}
+
+/******************************************************************************/
+/*                                 t c G e t                                  */
+/******************************************************************************/
+
+XrdBuffManager::TCache *XrdBuffManager::tcGet()
+{
+   static thread_local TCache tCache;
+
+// A thread's cache serves the first manager using it; others go direct
+//
+   if (!tcmax) return 0;
+   if (tCache.owner != this)
+      {if (tCache.owner) return 0;
+       tCache.owner = this;
+      }
+   return &tCache;
+}
+
+/******************************************************************************/
+/*                                t c S y n c                                 */
+/******************************************************************************/
+
+void XrdBuffManager::tcSync(TCache &tc) // Called with Reshaper locked!
+{
+
+// Fold the thread's request counts into the shared profile used by Reshape()
+//
+   for (int i = 0; i < XRD_BUCKETS; i++)
+       if (tc.numreq[i])
+          {bucket[i].numreq += tc.numreq[i];
+           totreq += tc.numreq[i];
+           tc.numreq[i] = 0;
+          }
+   tchits += tc.hits;
+   tc.hits = 0;
+}
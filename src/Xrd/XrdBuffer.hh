@@ -86,6 +86,14 @@ void        Reshape();
 
 void        Set(int maxmem=-1, int minw=-1);
 
+// Set the maximum number of bytes each thread may keep in its private buffer
+// cache. Buffers in a thread's cache are handed out and reclaimed without
+// locking the shared pool. Cached buffers are not seen by Reshape() and so
+// are not bound by the pool's memory limit. A value of zero, the default,
+// disables thread caching.
+//
+void        SetTCache(int maxbytes);
+
 int         Stats(char *buff, int blen, int do_sync=0);
 
             XrdBuffManager(int minrst=20*60);
@@ -111,6 +119,14 @@ long long maxalo;
 int       minrsw;
 int       rsinprog;
 int       totadj;
+int       totnew;   // Number of buffers allocated from the system
+long long tchits;   // Number of requests satisfied by a thread cache
+int       tcmax;    // Max bytes per thread cache (0 -> no thread caching)
+
+struct    TCache;
+TCache   *tcGet();
+void      tcDrain(TCache &tc);
+void      tcSync(TCache &tc);
 
 XrdSysCondVar      Reshaper;
 static const char *TraceID;
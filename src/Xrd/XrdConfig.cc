@@ -1619,11 +1619,16 @@ int XrdConfig::xhpath(XrdSysError *eDest, XrdOucStream &Config)
 
 /* Function: xbuf
 
-   Purpose:  To parse the directive: buffers [maxbsz <bsz>] <memsz> [<rint>]
+   Purpose:  To parse the directive: buffers [maxbsz <bsz>] [tcache <tcsz>]
+                                             <memsz> [<rint>]
 
              <bsz>      maximum size of an individualbuffer. The default is 2m.
                         Specify any value 2m < bsz <= 1g; if specified, it must
                         appear before the <memsz> and <memsz> becomes optional.
+             <tcsz>     maximum amount of memory each thread may hold in its
+                        private buffer cache. The default is 0 (disabled).
+                        If specified, it must appear before
+                        the <memsz> and <memsz> becomes optional.
              <memsz>    maximum amount of memory devoted to buffers
              <rint>     minimum buffer reshape interval in seconds
 
@@ -1649,6 +1654,15 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
         if (!(val = Config.GetWord())) return 0;
        }
 
+    if (!strcmp("tcache", val))
+       {if (!(val = Config.GetWord()))
+           {eDest->Emsg("Config", "thread cache size not specified"); return 1;}
+        if (XrdOuca2x::a2sz(*eDest,"tcache value",val,&blim,0,maxBSZ))
+           return 1;
+        BuffPool.SetTCache((int)blim);
+        if (!(val = Config.GetWord())) return 0;
+       }
+
     if (XrdOuca2x::a2sz(*eDest,"buffer limit value",val,&blim,
                        (long long)1024*1024)) return 1;
 
@@ -2165,6 +2179,7 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
 
    Purpose:  To parse directive: sched [mint <mint>] [maxt <maxt>] [avlt <at>]
                                        [idle <idle>] [stksz <qnt>] [core <cv>]
+                                       [lanes <ln>] [affinity <af>]
 
              <mint>   is the minimum number of threads that we need. Once
                       this number of threads is created, it does not decrease.
@@ -2181,6 +2196,11 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
              <idle>   The time (in time spec) between checks for underused
                       threads. Those found will be terminated. Default is 780.
              <qnt>    The thread stack size in bytes or K, M, or G.
+             <ln>     The number of work-stealing job queues to use instead
+                      of the single job queue. Specify auto for one queue per
+                      available cpu. The default is 0 (single queue).
+             <af>     cpu  - bind the workers of each queue to one cpu.
+                      none - do not bind workers (the default).
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -2190,7 +2210,8 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
     char *val;
     long long lpp;
     int  i, ppp = 0;
-    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1;
+    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1, V_lanes = 0;
+    bool V_bind = false;
     struct schedopts {const char *opname; int minv; int *oploc;
                       const char *opmsg;} scopts[] =
        {
@@ -2199,7 +2220,9 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
         {"maxt",       1, &V_maxt, "sched maxt"},
         {"avlt",       1, &V_avlt, "sched avlt"},
         {"core",       1,       0, "sched core"},
-        {"idle",       0, &V_idle, "sched idle"}
+        {"idle",       0, &V_idle, "sched idle"},
+        {"lanes",      0,       0, "sched lanes"},
+        {"affinity",   0,       0, "sched affinity"}
        };
     int numopts = sizeof(scopts)/sizeof(struct schedopts);
 
@@ -2226,6 +2249,21 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
                                   return 1;
                                  }
                            }
+                   else if (!strcmp(scopts[i].opname, "lanes"))
+                           {if (!strcmp("auto", val)) V_lanes = -1;
+                               else if (XrdOuca2x::a2i(*eDest, scopts[i].opmsg,
+                                                       val, &V_lanes, 0, 1024))
+                                       return 1;
+                            break;
+                           }
+                   else if (!strcmp(scopts[i].opname, "affinity"))
+                           {     if (!strcmp("cpu",  val)) V_bind = true;
+                            else if (!strcmp("none", val)) V_bind = false;
+                            else {eDest->Emsg("Config","invalid sched affinity value -",val);
+                                  return 1;
+                                 }
+                            break;
+                           }
                    else if (*scopts[i].opname == 's')
                            {if (XrdOuca2x::a2sz(*eDest, scopts[i].opmsg, val,
                                                 &lpp, scopts[i].minv)) return 1;
@@ -2258,6 +2296,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
 // Establish scheduler options
 //
    Sched.setParms(V_mint, V_maxt, V_avlt, V_idle);
+   if (V_lanes) Sched.setLanes(V_lanes, V_bind);
    return 0;
 }
 
@@ -2363,6 +2402,8 @@ int XrdConfig::xtcpmon(XrdSysError *eDest, XrdOucStream &Config)
              <opts>   options:
                       [no]detail       do [not] print TLS library msgs
                       hsto <sec>       handshake timeout (default 10).
+                      [no]ktls         do [not] use kernel TLS when the
+                                       kernel supports it (default noktls).
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -2392,6 +2433,8 @@ int XrdConfig::xtls(XrdSysError *eDest, XrdOucStream &Config)
 
 do {     if (!strcmp(val,   "detail")) SSLmsgs = true;
     else if (!strcmp(val, "nodetail")) SSLmsgs = false;
+    else if (!strcmp(val,   "ktls"))   tlsOpts |=  XrdTlsContext::ktlsON;
+    else if (!strcmp(val, "noktls"))   tlsOpts &= ~XrdTlsContext::ktlsON;
     else if (!strcmp(val, "hsto" ))
             {if (!(val = Config.GetWord()))
                 {eDest->Emsg("Config", "tls hsto value not specified");
@@ -233,6 +233,12 @@ XrdTlsPeerCerts *XrdLink::getPeerCerts()
 
 XrdProtocol *XrdLink::getProtocol() {return linkXQ.getProtocol();}
   
+/******************************************************************************/
+/*                               h a s K T L S                                */
+/******************************************************************************/
+
+bool XrdLink::hasKTLS() {return isTLS && linkXQ.hasKTLS();}
+
 /******************************************************************************/
 /*                                  H o l d                                   */
 /******************************************************************************/
@@ -493,6 +499,12 @@ bool XrdLink::setTLS(bool enable, XrdTlsContext *ctx)
    return linkXQ.setTLS(enable, ctx);
 }
   
+/******************************************************************************/
+/*                           s e t Z e r o C o p y                            */
+/******************************************************************************/
+
+bool XrdLink::setZeroCopy(int minsz) {return linkXQ.setZeroCopy(minsz);}
+
 /******************************************************************************/
 /*                              S h u t d o w n                               */
 /******************************************************************************/
@@ -477,6 +477,23 @@ void            setRef(int cnt);
 
 bool            setTLS(bool enable, XrdTlsContext *ctx=0);
 
+//-----------------------------------------------------------------------------
+//! Enable or disable zero-copy sends (Linux MSG_ZEROCOPY) on the link. When
+//! enabled, a plain (non-TLS) Send(iovec) of at least minsz bytes lets the
+//! kernel transmit directly from the caller's buffers. The call still does
+//! not return until the kernel has released the buffers so callers need not
+//! change how they manage them. Zero-copy is automatically turned off for the
+//! link if the kernel reports that it had to copy the data anyway.
+//!
+//! @param  minsz   the minimum send size that uses zero-copy. A value less
+//!                 than or equal to zero disables zero-copy.
+//!
+//! @return true    mode has been set.
+//! @return false   mode is not supported by the platform or the socket.
+//-----------------------------------------------------------------------------
+
+bool            setZeroCopy(int minsz);
+
 //-----------------------------------------------------------------------------
 //! Shutdown the link but otherwise keep it intact.
 //!
@@ -562,6 +579,16 @@ bool            hasBridge() const {return isBridged;}
 
 bool            hasTLS() const {return isTLS;}
 
+//-----------------------------------------------------------------------------
+//! Determine if this link is using TLS with kernel record encryption (kTLS).
+//! When true, Send(sfVec) uses a true sendfile() instead of copying the data.
+//!
+//! @return true    this link is  using kTLS.
+//! @return false   this link not using kTLS.
+//-----------------------------------------------------------------------------
+
+bool            hasKTLS();
+
 //-----------------------------------------------------------------------------
 //! Return TLS protocol version being used.
 //!
@@ -37,7 +37,12 @@
 #include <sys/uio.h>
 
 #if defined(__linux__) || defined(__GNU__)
+#include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <sys/socket.h>
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
 #if !defined(TCP_CORK)
 #undef HAVE_SENDFILE
 #endif
@@ -52,6 +57,7 @@
 #endif
 
 #include "XrdSys/XrdSysAtomics.hh"
+#include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
 #include "XrdSys/XrdSysPlatform.hh"
@@ -136,6 +142,7 @@ void XrdLinkXeq::Reset()
    stallCnt = stallCntTot = 0;
    tardyCnt = tardyCntTot = 0;
    SfIntr   = 0;
+   zcMinSz  = 0;
    isIdle   = 0;
    BytesOut = BytesIn = BytesOutTot = BytesInTot = 0;
    LockReads= false;
@@ -673,10 +680,12 @@ int XrdLinkXeq::Send(const struct iovec *iov, int iocnt, int bytes)
        return retc;
       }
 
-// If the iocnt is within limits then just go ahead and write this out
+// If the iocnt is within limits then just go ahead and write this out. Large
+// sends may be done zero-copy if so enabled.
 //
    if (iocnt <= maxIOV)
-      {retc = SendIOV(iov, iocnt, bytes);
+      {if (zcMinSz && bytes >= zcMinSz) return SendZCP(iov, iocnt, bytes);
+       retc = SendIOV(iov, iocnt, bytes);
        wrMutex.UnLock();
        return retc;
       }
@@ -899,6 +908,78 @@ int XrdLinkXeq::SendIOV(const struct iovec *iov, int iocnt, int bytes)
    return -1;
 }
   
+/******************************************************************************/
+/* Protected:                    S e n d Z C P                                */
+/******************************************************************************/
+
+// Called with wrMutex held, which is released upon return.
+
+int XrdLinkXeq::SendZCP(const struct iovec *iov, int iocnt, int bytes)
+{
+#if defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+   static const int zcMaxIOV = 64;
+   static const int zcWaitMS = 60*1000;
+   struct iovec zcIOV[zcMaxIOV], *vP = zcIOV;
+   struct msghdr mHdr;
+   ssize_t retc = 0;
+   unsigned int zcLast = 0;
+   int zcNum = 0, bytesleft = bytes;
+
+// We need a modifiable copy of the vector to handle partial sends. Vectors
+// this long are not worth the effort and simply go the normal way.
+//
+   if (iocnt > zcMaxIOV)
+      {retc = SendIOV(iov, iocnt, bytes);
+       wrMutex.UnLock();
+       return retc;
+      }
+   memcpy(zcIOV, iov, iocnt*sizeof(struct iovec));
+   memset(&mHdr, 0, sizeof(mHdr));
+
+// Send the data. Each successful sendmsg() generates a completion notice that
+// tells us when the kernel no longer references the data. When the kernel
+// runs out of memory to track the pages (ENOBUFS) we send the rest normally.
+//
+   while(bytesleft > 0)
+        {mHdr.msg_iov = vP; mHdr.msg_iovlen = iocnt;
+         do {retc = sendmsg(LinkInfo.FD, &mHdr, MSG_ZEROCOPY);}
+            while(retc < 0 && errno == EINTR);
+         if (retc < 0)
+            {if (errno == ENOBUFS) retc = SendIOV(vP, iocnt, bytesleft);
+             break;
+            }
+         zcLast = zcInfo.Issued(); zcNum++;
+         if ((bytesleft -= retc) <= 0) break;
+         while(retc >= (ssize_t)vP->iov_len) {retc -= vP->iov_len; vP++; iocnt--;}
+         vP->iov_base = (char *)vP->iov_base + retc; vP->iov_len -= retc;
+        }
+
+// Other threads may write to the link as soon as the data is queued. Only we
+// must hold on to the data, as the caller may reuse it once we return, until
+// the kernel releases it even if an error occurred.
+//
+   wrMutex.UnLock();
+   if (retc < 0) Log.Emsg("Link", errno, "send to", ID);
+   if (zcNum && !zcInfo.Wait(zcLast, zcWaitMS))
+      {if (retc >= 0) Log.Emsg("Link", errno, "complete zero-copy send to", ID);
+       return -1;
+      }
+
+// If the kernel had to copy the data (e.g. loopback or a device that cannot
+// do scatter/gather) zero-copy only adds overhead for this link; turn it off.
+//
+   if (zcMinSz && zcInfo.Copied())
+      {TRACEI(DEBUG, "zero-copy disabled; kernel copied the data");
+       zcMinSz = 0;
+      }
+   return (retc < 0 ? -1 : bytes);
+#else
+   int retc = SendIOV(iov, iocnt, bytes);
+   wrMutex.UnLock();
+   return retc;
+#endif
+}
+
 /******************************************************************************/
 /*                                 s e t I D                                  */
 /******************************************************************************/
@@ -1047,6 +1128,43 @@ int XrdLinkXeq::SFError(int rc)
    return -1;
 }
 
+/******************************************************************************/
+/*                           s e t Z e r o C o p y                            */
+/******************************************************************************/
+
+bool XrdLinkXeq::setZeroCopy(int minsz)
+{
+   XrdSysMutexHelper lck(wrMutex);
+
+// Disabling is always possible. Note that the socket option need not be
+// turned off as it has no effect unless MSG_ZEROCOPY is used.
+//
+   if (minsz <= 0)
+      {zcMinSz = 0;
+       return true;
+      }
+
+// Enable zero-copy sends on the socket. This fails on kernels before 4.14.
+// Completion notices raise POLLERR so tell the poller to expect them.
+//
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+   static const int one = 1;
+   if (!PollInfo.zcInfo)
+      {if (setsockopt(LinkInfo.FD, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)))
+          {TRACEI(DEBUG, "zero-copy not supported; " <<XrdSysE2T(errno));
+           return false;
+          }
+       zcInfo.Reset(LinkInfo.FD);
+       PollInfo.zcInfo = &zcInfo;
+      }
+   zcMinSz = minsz;
+   TRACEI(DEBUG, "enabling zero-copy output for sends >= " <<minsz);
+   return true;
+#else
+   return false;
+#endif
+}
+
 /******************************************************************************/
 /*                              S h u t d o w n                               */
 /******************************************************************************/
@@ -1415,10 +1533,13 @@ int XrdLinkXeq::TLS_Send(const sfVec *sfP, int sfN)
    int bytes, buffsz, fileFD, retc;
    off_t offset;
    ssize_t totamt = 0;
+   bool useKTLS = tlsIO.hasKTLS();
    char myBuff[65536];
 
-// Convert the sendfile to a regular send. The conversion is not particularly
-// fast and caller are advised to avoid using sendfile on TLS connections.
+// When the kernel does the record encryption (kTLS) we can hand the file data
+// directly to sendfile(). Otherwise, convert the sendfile to a regular send.
+// The conversion is not particularly fast and callers are advised to avoid
+// using sendfile on TLS connections unless hasKTLS() is true.
 //
    isIdle = 0;
    for (int i = 0; i < sfN; sfP++, i++)
@@ -1428,6 +1549,10 @@ int XrdLinkXeq::TLS_Send(const sfVec *sfP, int sfN)
            {if (!TLS_Write(sfP->buffer, bytes)) return -1;
             continue;
            }
+        if (useKTLS)
+           {if (!TLS_SendFile(sfP->fdnum, sfP->offset, bytes)) return -1;
+            continue;
+           }
         offset = sfP->offset;
         fileFD = sfP->fdnum;
         buffsz = (bytes < (int)sizeof(myBuff) ? bytes : sizeof(myBuff));
@@ -1446,6 +1571,32 @@ int XrdLinkXeq::TLS_Send(const sfVec *sfP, int sfN)
    return totamt;
 }
 
+/******************************************************************************/
+/* Protected:               T L S _ S e n d F i l e                           */
+/******************************************************************************/
+
+bool XrdLinkXeq::TLS_SendFile(int fd, off_t offset, int Blen)
+{
+   XrdTls::RC retc;
+   int byteswritten;
+
+// Send the file data, the kernel encrypts it on the way out
+//
+   while(Blen)
+        {retc = tlsIO.SendFile(fd, offset, Blen, byteswritten);
+         if (retc != XrdTls::TLS_AOK)
+            {TLS_Error("sendfile to", retc);
+             return false;
+            }
+         if (!byteswritten) {SFError(ESPIPE); return false;}
+         Blen -= byteswritten; offset += byteswritten;
+        }
+
+// All done
+//
+   return true;
+}
+
 /******************************************************************************/
 /* Protected:                  T L S _ W r i t e                              */
 /******************************************************************************/
@@ -35,6 +35,7 @@
 
 #include "Xrd/XrdLink.hh"
 #include "Xrd/XrdLinkInfo.hh"
+#include "Xrd/XrdLinkZC.hh"
 #include "Xrd/XrdPollInfo.hh"
 #include "Xrd/XrdProtocol.hh"
 
@@ -95,6 +96,8 @@ int           Recv(const struct iovec *iov, int iocnt, int timeout);
 
 int           RecvAll(char *buff, int blen, int timeout=-1);
 
+bool          hasKTLS() {return tlsIO.hasKTLS();}
+
 bool          Register(const char *hName);
 
 int           Send(const char *buff, int blen);
@@ -114,6 +117,8 @@ void          setProtName(const char *name);
 
 bool          setTLS(bool enable, XrdTlsContext *ctx=0);
 
+bool          setZeroCopy(int minsz);
+
        void   Shutdown(bool getLock);
 
 static int    Stats(char *buff, int blen, bool do_sync=false);
@@ -150,8 +155,10 @@ int    RecvIOV(const struct iovec *iov, int iocnt);
 void   Reset();
 int    sendData(const char *Buff, int Blen);
 int    SendIOV(const struct iovec *iov, int iocnt, int bytes);
+int    SendZCP(const struct iovec *iov, int iocnt, int bytes);
 int    SFError(int rc);
 int    TLS_Error(const char *act, XrdTls::RC rc);
+bool   TLS_SendFile(int fd, off_t offset, int Blen);
 bool   TLS_Write(const char *Buff, int Blen);
 
 static const char   *TraceID;
@@ -194,6 +201,8 @@ XrdSysMutex         rdMutex;
 XrdSysMutex         wrMutex;
 XrdSendQ           *sendQ;          // Protected by wrMutex && opMutex
 int                 HNlen;
+int                 zcMinSz;        // Min Send(iovec) size for MSG_ZEROCOPY
+XrdLinkZC           zcInfo;         // Zero-copy sends awaiting completion
 bool                LockReads;
 bool                KeepFD;
 char                isIdle;
@@ -0,0 +1,200 @@
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d L i n k Z C . c c                           */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <linux/errqueue.h>
+#endif
+
+#include "Xrd/XrdLinkZC.hh"
+
+/******************************************************************************/
+/*                                 D r a i n                                  */
+/******************************************************************************/
+
+bool XrdLinkZC::Drain()
+{
+   bool aOK;
+
+   zcCond.Lock();
+   aOK = Reap();
+   zcCond.UnLock();
+   return aOK;
+}
+
+/******************************************************************************/
+/*                                 R e s e t                                  */
+/******************************************************************************/
+
+void XrdLinkZC::Reset(int fd)
+{
+   zcCond.Lock();
+   FD       = fd;
+   zcNext   = zcDone = 0;
+   zcCopied = false;
+   zcLate.clear();
+   zcCond.UnLock();
+}
+
+/******************************************************************************/
+/*                                  W a i t                                   */
+/******************************************************************************/
+
+bool XrdLinkZC::Wait(unsigned int last, int tmoMS)
+{
+   static const int sliceMS = 20;
+   struct pollfd pollTab;
+   socklen_t eLen;
+   int rc, sErr;
+
+// Wait until the kernel released the data. One waiter at a time polls the
+// socket while the others wait for whatever it reaps. Notices may also be
+// reaped by the poller without waking the polling waiter, so it polls in
+// short slices to see if that happened.
+//
+   zcCond.Lock();
+   while(!isDone(last))
+        {if (zcReaping) {zcCond.Wait(); continue;}
+         if (!Reap()) {zcCond.UnLock(); return false;}
+         if (isDone(last)) break;
+
+         // Nothing for us yet. A real socket error also raises POLLERR so
+         // check for that before waiting for the peer to acknowledge the data.
+         //
+         eLen = sizeof(sErr); sErr = 0;
+         if (getsockopt(FD, SOL_SOCKET, SO_ERROR, &sErr, &eLen) || sErr)
+            {zcCond.UnLock();
+             if (sErr) errno = sErr;
+             return false;
+            }
+         if (tmoMS <= 0)
+            {zcCond.UnLock();
+             errno = ETIMEDOUT;
+             return false;
+            }
+
+         zcReaping = true;
+         zcCond.UnLock();
+         pollTab.fd = FD; pollTab.events = 0; pollTab.revents = 0;
+         do {rc = poll(&pollTab, 1, (tmoMS < sliceMS ? tmoMS : sliceMS));}
+            while(rc < 0 && errno == EINTR);
+         zcCond.Lock();
+         zcReaping = false;
+         zcCond.Broadcast();
+
+         if (rc < 0) {zcCond.UnLock(); return false;}
+         if (!rc) tmoMS -= sliceMS;
+            else if (pollTab.revents & (POLLHUP | POLLNVAL))
+                    {zcCond.UnLock();
+                     errno = EPIPE;
+                     return false;
+                    }
+        }
+   zcCond.UnLock();
+   return true;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                  D o n e                                   */
+/******************************************************************************/
+
+void XrdLinkZC::Done(unsigned int first, unsigned int last)
+{
+   size_t i;
+
+// Notices normally arrive in order. One that does not is kept until the ones
+// before it arrive.
+//
+   if (first != zcDone)
+      {if ((int)(first - zcDone) > 0) zcLate.push_back({first, last});
+       return;
+      }
+   zcDone = last + 1;
+
+// Fold in any late range that now follows on
+//
+   do {for (i = 0; i < zcLate.size(); i++)
+           if ((int)(zcLate[i].first - zcDone) <= 0) break;
+       if (i >= zcLate.size()) break;
+       if ((int)(zcLate[i].last + 1 - zcDone) > 0) zcDone = zcLate[i].last + 1;
+       zcLate.erase(zcLate.begin() + i);
+      } while(!zcLate.empty());
+}
+
+/******************************************************************************/
+/*                                  R e a p                                   */
+/******************************************************************************/
+
+// Called with zcCond locked.
+
+bool XrdLinkZC::Reap()
+{
+#if defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+   struct sock_extended_err *eP;
+   struct cmsghdr *cmP;
+   struct msghdr   mHdr;
+   char cBuff[CMSG_SPACE(sizeof(struct sock_extended_err)
+                        +sizeof(struct sockaddr_in6))];
+   unsigned int oldDone = zcDone;
+
+// Reap every notice on the error queue. Notices are coalesced into ranges.
+//
+   do {memset(&mHdr, 0, sizeof(mHdr));
+       mHdr.msg_control = cBuff; mHdr.msg_controllen = sizeof(cBuff);
+       if (recvmsg(FD, &mHdr, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+          {if (errno == EINTR) continue;
+           break;
+          }
+       for (cmP = CMSG_FIRSTHDR(&mHdr); cmP; cmP = CMSG_NXTHDR(&mHdr, cmP))
+           {if (!((cmP->cmsg_level == SOL_IP   && cmP->cmsg_type == IP_RECVERR)
+              ||  (cmP->cmsg_level == SOL_IPV6 && cmP->cmsg_type == IPV6_RECVERR)))
+               continue;
+            eP = (struct sock_extended_err *)CMSG_DATA(cmP);
+            if (eP->ee_errno || eP->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+               continue;
+            Done(eP->ee_info, eP->ee_data);
+            if (eP->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) zcCopied = true;
+           }
+      } while(1);
+
+// Wake up anyone whose sends have now completed
+//
+   if (zcDone != oldDone) zcCond.Broadcast();
+   return errno == EAGAIN || errno == EWOULDBLOCK;
+#else
+   return true;
+#endif
+}
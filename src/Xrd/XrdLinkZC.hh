@@ -0,0 +1,112 @@
+#ifndef __XRD_LINKZC_H__
+#define __XRD_LINKZC_H__
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d L i n k Z C . h h                           */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+//-----------------------------------------------------------------------------
+//! The XrdLinkZC object tracks the zero-copy (MSG_ZEROCOPY) sends made on a
+//! link's socket. The kernel numbers each such send and reports, on the
+//! socket's error queue, when it no longer references the data. Notices may
+//! be reaped by any thread: the sender waiting for its data to be released or
+//! the poller when the notices raise POLLERR. The link's write lock need not
+//! be held for any of this.
+//-----------------------------------------------------------------------------
+
+class XrdLinkZC
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Reap all the completion notices queued on the socket without waiting.
+//!
+//! @return true    all notices reaped.
+//! @return false   the socket has an error, errno holds the reason.
+//-----------------------------------------------------------------------------
+
+bool         Drain();
+
+//-----------------------------------------------------------------------------
+//! Record a successful zero-copy send. The link's write lock must be held.
+//!
+//! @return the number the kernel gave the send, for use with Wait().
+//-----------------------------------------------------------------------------
+
+unsigned int Issued() {return zcNext++;}
+
+//-----------------------------------------------------------------------------
+//! Indicate whether the kernel copied the data of any send anyway.
+//-----------------------------------------------------------------------------
+
+bool         Copied() {return zcCopied;}
+
+//-----------------------------------------------------------------------------
+//! Start tracking sends on a new socket.
+//!
+//! @param  fd      the socket's file descriptor.
+//-----------------------------------------------------------------------------
+
+void         Reset(int fd);
+
+//-----------------------------------------------------------------------------
+//! Wait until the kernel no longer references the data of every send up to
+//! and including the indicated one.
+//!
+//! @param  last    the number returned by Issued() for the last send.
+//! @param  tmoMS   how long to wait, in milliseconds.
+//!
+//! @return true    the data may be reused.
+//! @return false   the wait failed, errno holds the reason.
+//-----------------------------------------------------------------------------
+
+bool         Wait(unsigned int last, int tmoMS);
+
+             XrdLinkZC() : zcCond(0), FD(-1), zcNext(0), zcDone(0),
+                           zcCopied(false), zcReaping(false) {}
+            ~XrdLinkZC() {}
+
+private:
+
+void         Done(unsigned int first, unsigned int last);
+bool         isDone(unsigned int last) {return (int)(zcDone - last) > 0;}
+bool         Reap();
+
+struct       Range {unsigned int first; unsigned int last;};
+
+XrdSysCondVar      zcCond;
+std::vector<Range> zcLate;     // Ranges completed ahead of zcDone
+int                FD;
+unsigned int       zcNext;     // Number of the next send
+unsigned int       zcDone;     // All sends before this one are complete
+bool               zcCopied;   // The kernel copied the data
+bool               zcReaping;  // A waiter is polling the socket
+};
+#endif
@@ -64,6 +64,7 @@ private:
 int  AddWaitFd();
 void HandleWaitFd(const unsigned int events);
 void remFD(XrdPollInfo &pInfo, unsigned int events);
+bool zcNotice(XrdPollInfo &pInfo, struct epoll_event &pEvent);
 void Wait4Poller();
 
 #ifdef EPOLLONESHOT
@@ -30,6 +30,7 @@
 /******************************************************************************/
 
 class  XrdLink;
+class  XrdLinkZC;
 class  XrdPoll;
 struct pollfd;
 
@@ -41,6 +42,7 @@ XrdPollInfo   *Next;        // Chain of links waiting for a PollPoll event
 XrdLink       &Link;        // Link associated with this object (always the same)
 struct pollfd *PollEnt;     // Used only by PollPoll
 XrdPoll       *Poller;      // -> Poller object associated with this object
+XrdLinkZC     *zcInfo;      // -> Zero-copy sends whose notices raise POLLERR
 int            FD;          // Associated target file descriptor number
 bool           inQ;         // True -> in a PollPoll event queue
 bool           isEnabled;   // True -> interrupts are enabled
@@ -49,6 +51,7 @@ char           rsv[2];      // Reserved for future flags
 void           Zorch() {Next      = 0;     PollEnt  = 0;
                         Poller    = 0;     FD       = -1;
                         isEnabled = false; inQ      = false;
+                        zcInfo    = 0;
                         rsv[0]    = 0;     rsv[1]   = 0;
                        }
 
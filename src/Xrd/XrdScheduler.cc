@@ -29,6 +29,7 @@
 
 #include <cerrno>
 #include <fcntl.h>
+#include <sched.h>
 #include <signal.h>
 #include <cstdio>
 #include <sys/resource.h>
@@ -67,6 +68,49 @@ class XrdSchedulerPID
                         {next = prev; pid = newpid;}
      ~XrdSchedulerPID() {}
      };
+
+// A lane is one queue of the work-stealing scheduler. Workers are assigned
+// to a home lane and only look at other lanes when their own is empty. The
+// padding keeps lanes used by different cpus off the same cache line.
+//
+class XrdSchedulerLane
+     {public:
+      XrdSysMutex      Mutex;
+      XrdJob          *First;
+      XrdJob          *Last;
+      int              Count;   // Jobs currently queued
+      int              MaxCnt;  // Longest this lane has been
+      int              Steals;  // Jobs taken by workers of other lanes
+      int              CPU;     // Cpu to bind workers to, -1 if none
+      char             Pad[64];
+
+      XrdSchedulerLane() : First(0), Last(0), Count(0), MaxCnt(0),
+                           Steals(0), CPU(-1) {}
+     ~XrdSchedulerLane() {}
+     };
+
+namespace
+{
+// Lane of the calling worker thread; only valid when laneSched matches.
+//
+thread_local XrdScheduler *laneSched = 0;
+thread_local int           laneHome  = 0;
+
+// A worker that was woken but finds no job while one is queued spins this many
+// times, then yields the cpu this many times before it waits again.
+//
+const int laneSpins  = 64;
+const int laneYields = 4;
+
+inline void LanePause()
+{
+#if defined(__x86_64__) || defined(__i386__)
+   __builtin_ia32_pause();
+#elif defined(__aarch64__)
+   __asm__ __volatile__("yield");
+#endif
+}
+}
   
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
@@ -372,6 +416,10 @@ void XrdScheduler::Run()
    int waiting;
    XrdJob *jp;
 
+// Workers of a work-stealing scheduler run a different loop
+//
+   if (num_Lanes) {LaneRun(); return;}
+
 // Wait for work then do it (an endless task for a worker thread)
 //
    do {do {DispatchMutex.Lock();          idl_Workers++;DispatchMutex.UnLock();
@@ -413,6 +461,10 @@ void XrdScheduler::Run()
   
 void XrdScheduler::Schedule(XrdJob *jp)
 {
+// Queue the job on a lane if we are work-stealing
+//
+   if (num_Lanes) {LanePut(1, jp, jp); return;}
+
 // Lock down our data area
 //
    SchedMutex.Lock();
@@ -444,6 +496,9 @@ void XrdScheduler::Schedule(XrdJob *jp)
   
 void XrdScheduler::Schedule(int numjobs, XrdJob *jfirst, XrdJob *jlast)
 {
+// Queue the jobs on a lane if we are work-stealing
+//
+   if (num_Lanes) {LanePut(numjobs, jfirst, jlast); return;}
 
 // Lock down our data area
 //
@@ -554,6 +609,62 @@ void XrdScheduler::setParms(int minw, int maxw, int avlw, int maxi, int once)
    TRACE(SCHED,"Set stk_Workers=" <<stk_Workers <<" max_Workidl=" <<max_Workidl);
 }
 
+/******************************************************************************/
+/*                              s e t L a n e s                               */
+/******************************************************************************/
+
+void XrdScheduler::setLanes(int lanes, bool bind)
+{
+   int cpuVec[1024], cpuNum = 0;
+
+// Lanes can only be established once and before any work is started
+//
+   if (Lanes || !lanes) return;
+   SchedMutex.Lock();
+   bool busy = num_Workers || WorkFirst;
+   SchedMutex.UnLock();
+   if (busy)
+      {XrdLog->Emsg("Scheduler", "Unable to add lanes to an active scheduler.");
+       return;
+      }
+
+// Get the list of cpus we may run on. These are used to size the number of
+// lanes when not specified and to bind workers of each lane to one cpu.
+// Adjacent lanes get adjacent cpus which usually keeps them on one node.
+//
+#if defined(__linux__) && defined(CPU_SETSIZE)
+   cpu_set_t cpuSet;
+   if (!sched_getaffinity(0, sizeof(cpuSet), &cpuSet))
+      {for (int i = 0; i < CPU_SETSIZE && cpuNum < 1024; i++)
+           if (CPU_ISSET(i, &cpuSet)) cpuVec[cpuNum++] = i;
+      }
+#endif
+   if (!cpuNum)
+      {long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+       if (ncpu < 1) ncpu = 1;
+       if (ncpu > 1024) ncpu = 1024;
+       for (int i = 0; i < ncpu; i++) cpuVec[cpuNum++] = i;
+      }
+
+// Establish the number of lanes
+//
+   if (lanes < 0) lanes = cpuNum;
+   if (lanes > 1024) lanes = 1024;
+
+// Allocate the lanes and assign a cpu to each one
+//
+   Lanes = new XrdSchedulerLane[lanes];
+#if defined(__linux__) && defined(CPU_SETSIZE)
+   if (bind) for (int i = 0; i < lanes; i++) Lanes[i].CPU = cpuVec[i % cpuNum];
+#else
+   bind = false;
+#endif
+   lane_Bind = bind;
+   num_Lanes = lanes;
+
+   TRACE(SCHED, "Using " <<lanes <<" work-stealing lanes" <<(bind ? " bound to cpus" : ""));
+}
+
 /******************************************************************************/
 /*                                 S t a r t                                  */
 /******************************************************************************/
@@ -596,15 +707,34 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
 {
     int cnt_Jobs, cnt_JobsinQ, xam_QLength, cnt_Workers, cnt_idl;
     int cnt_TCreate, cnt_TDestroy, cnt_Limited;
+    int cnt_Steals = 0, xam_LaneQ = 0;
     static char statfmt[] = "<stats id=\"sched\"><jobs>%d</jobs>"
                 "<inq>%d</inq><maxinq>%d</maxinq>"
                 "<threads>%d</threads><idle>%d</idle>"
                 "<tcr>%d</tcr><tde>%d</tde>"
-                "<tlimr>%d</tlimr></stats>";
+                "<tlimr>%d</tlimr>%s</stats>";
+    static char lanefmt[] = "<lanes>%d</lanes><steals>%d</steals>"
+                "<maxlaneq>%d</maxlaneq>";
+    char laneBuff[sizeof(lanefmt) + 16*3];
 
 // If only length wanted, do so
 //
-   if (!buff) return sizeof(statfmt) + 16*8;
+   if (!buff) return sizeof(statfmt) + sizeof(laneBuff) + 16*8;
+
+// Collect the lane statistics, if any. Each lane's values are protected by
+// the lane's own lock.
+//
+   *laneBuff = 0;
+   if (num_Lanes)
+      {for (int i = 0; i < num_Lanes; i++)
+           {if (do_sync) Lanes[i].Mutex.Lock();
+            cnt_Steals += Lanes[i].Steals;
+            if (Lanes[i].MaxCnt > xam_LaneQ) xam_LaneQ = Lanes[i].MaxCnt;
+            if (do_sync) Lanes[i].Mutex.UnLock();
+           }
+       snprintf(laneBuff, sizeof(laneBuff), lanefmt,
+                num_Lanes, cnt_Steals, xam_LaneQ);
+      }
 
 // Get values protected by the Dispatch lock (avoid lock if no sync needed)
 //
@@ -628,7 +758,7 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
 //
    return snprintf(buff, blen, statfmt, cnt_Jobs, cnt_JobsinQ, xam_QLength,
                    cnt_Workers, cnt_idl, cnt_TCreate, cnt_TDestroy,
-                   cnt_Limited);
+                   cnt_Limited, laneBuff);
 }
 
 /******************************************************************************/
@@ -723,6 +853,149 @@ void XrdScheduler::Init(int minw, int maxw, int maxi)
    num_Limited =  0;
    firstPID    =  0;
    WorkFirst = WorkLast = TimerQueue = 0;
+   Lanes       =  0;
+   num_Lanes   =  0;
+   lane_Next   =  0;
+   lane_RR     =  0;
+   lane_Bind   =  false;
+}
+
+/******************************************************************************/
+/*                               L a n e P u t                                */
+/******************************************************************************/
+
+void XrdScheduler::LanePut(int numjobs, XrdJob *jfirst, XrdJob *jlast)
+{
+   XrdSchedulerLane *lP;
+   int qLen;
+
+// Workers queue on their home lane so that follow-on work stays on the same
+// cpu. Anyone else spreads work across the lanes.
+//
+   if (laneSched == this) lP = &Lanes[laneHome];
+      else lP = &Lanes[static_cast<unsigned int>(
+                       __atomic_fetch_add(&lane_RR, 1, __ATOMIC_RELAXED))
+                       % num_Lanes];
+
+// Place the jobs on the lane
+//
+   jlast->NextJob = 0;
+   lP->Mutex.Lock();
+   if (lP->First) lP->Last->NextJob = jfirst;
+      else        lP->First          = jfirst;
+   lP->Last = jlast;
+   lP->Count += numjobs;
+   if (lP->Count > lP->MaxCnt) lP->MaxCnt = lP->Count;
+   lP->Mutex.UnLock();
+
+// Calculate statistics. The maximum queue length is advisory only.
+//
+   __atomic_add_fetch(&num_Jobs, numjobs, __ATOMIC_RELAXED);
+   qLen = __atomic_add_fetch(&num_JobsinQ, numjobs, __ATOMIC_RELAXED);
+   if (qLen > max_QLength) max_QLength = qLen;
+
+// Indicate number of jobs to work on
+//
+   while(numjobs--) WorkAvail.Post();
+}
+
+/******************************************************************************/
+/*                               L a n e R u n                                */
+/******************************************************************************/
+  
+void XrdScheduler::LaneRun()
+{
+   XrdJob *jp;
+   int home, waiting;
+
+// Establish our home lane and bind ourselves to its cpu, if so wanted
+//
+   home = static_cast<unsigned int>(
+          __atomic_fetch_add(&lane_Next, 1, __ATOMIC_RELAXED)) % num_Lanes;
+   laneSched = this;
+   laneHome  = home;
+
+#if defined(__linux__) && defined(CPU_SETSIZE)
+   if (lane_Bind && Lanes[home].CPU >= 0)
+      {cpu_set_t cpuSet;
+       CPU_ZERO(&cpuSet);
+       CPU_SET(Lanes[home].CPU, &cpuSet);
+       pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+      }
+#endif
+
+// Wait for work then do it (an endless task for a worker thread). Each post
+// of WorkAvail accounts for one queued job or one layoff. Since the job may
+// sit on any lane, we look at all of them. While we look, another worker may
+// take the job we were woken for and a new one may land on a lane we already
+// passed. So, we look again as long as any job is queued, otherwise that job
+// would be left without a worker. The window is short (a job counts as queued
+// until its taker has left the lane), so we spin briefly, then yield, and if
+// a job still appears queued we hand our wakeup back and wait again rather
+// than spin on a cpu that someone else may need. When none is and no layoff
+// applies we go back to waiting, as Run() does.
+//
+   do {__atomic_add_fetch(&idl_Workers, 1, __ATOMIC_RELAXED);
+       WorkAvail.Wait();
+       waiting = __atomic_sub_fetch(&idl_Workers, 1, __ATOMIC_RELAXED);
+       for (int spins = 0; !(jp = LaneTake(home)); spins++)
+           {if (__atomic_load_n(&num_JobsinQ, __ATOMIC_ACQUIRE) <= 0) break;
+            if (spins < laneSpins) LanePause();
+               else if (spins < laneSpins + laneYields) sched_yield();
+                       else {WorkAvail.Post(); break;}
+           }
+       if (!jp)
+          {SchedMutex.Lock();
+           if (num_Layoffs > 0)
+              {num_Layoffs--;
+               if (waiting)
+                  {num_TDestroy++; num_Workers--;
+                   TRACE(SCHED, "terminating thread; workers=" <<num_Workers);
+                   SchedMutex.UnLock();
+                   laneSched = 0;
+                   return;
+                  }
+              }
+           SchedMutex.UnLock();
+          }
+       if (!jp) continue;
+
+    // Check if we should hire a new worker (we always want 1 idle thread)
+    // before running this job.
+    //
+       if (!waiting) hireWorker();
+       if (TRACING(TRACE_SCHED) && *(jp->Comment) != '.')
+          {TRACE(SCHED, "running " <<jp->Comment <<" inq=" <<num_JobsinQ);}
+       jp->DoIt();
+      } while(1);
+}
+
+/******************************************************************************/
+/*                              L a n e T a k e                               */
+/******************************************************************************/
+
+XrdJob *XrdScheduler::LaneTake(int home)
+{
+   XrdSchedulerLane *lP;
+   XrdJob *jp;
+
+// Look at our own lane first and then steal from the others in order
+//
+   for (int i = 0; i < num_Lanes; i++)
+       {lP = &Lanes[(home + i) % num_Lanes];
+        if (!__atomic_load_n(&lP->Count, __ATOMIC_RELAXED)) continue;
+        lP->Mutex.Lock();
+        if ((jp = lP->First))
+           {if (!(lP->First = jp->NextJob)) lP->Last = 0;
+            lP->Count--;
+            if (i) lP->Steals++;
+            lP->Mutex.UnLock();
+            __atomic_sub_fetch(&num_JobsinQ, 1, __ATOMIC_RELAXED);
+            return jp;
+           }
+        lP->Mutex.UnLock();
+       }
+   return 0;
 }
 
 /******************************************************************************/
@@ -36,6 +36,7 @@
 #include "Xrd/XrdJob.hh"
 
 class XrdOucTrace;
+class XrdSchedulerLane;
 class XrdSchedulerPID;
 class XrdSysError;
 class XrdSysTrace;
@@ -67,6 +68,13 @@ void          Schedule(XrdJob *jp, time_t atime);
 
 void          setParms(int minw, int maxw, int avlt, int maxi, int once=0);
 
+// Use work-stealing lanes instead of the single job queue. Must be called
+// before Start(). A value of zero keeps the single queue; a negative value
+// uses one lane per available cpu. When bind is true, the workers of a lane
+// are bound to the lane's cpu (Linux only).
+//
+void          setLanes(int lanes, bool bind=false);
+
 void          Start();
 
 int           Stats(char *buff, int blen, int do_sync=0);
@@ -127,9 +135,18 @@ XrdSysMutex            TimerMutex; // Protects scheduler area
 XrdSchedulerPID       *firstPID;
 XrdSysMutex            ReaperMutex;
 
+XrdSchedulerLane      *Lanes;      // Work-stealing lanes, if any
+int                    num_Lanes;  // Number of lanes (0 -> single queue)
+int                    lane_Next;  // Lane assigned to the next worker
+int                    lane_RR;    // Lane for the next non-worker submit
+bool                   lane_Bind;  // Bind workers to their lane's cpu
+
 void Boot(XrdSysError *eP, XrdSysTrace *tP, int minw, int maxw, int maxi);
 void hireWorker(int dotrace=1);
 void Init(int minw, int maxw, int maxi);
+void LanePut(int numjobs, XrdJob *jfirst, XrdJob *jlast);
+void LaneRun();
+XrdJob *LaneTake(int home);
 void Monitor();
 void traceExit(pid_t pid, int status);
 static const char *TraceID;
@@ -53,6 +53,17 @@ if( NOT XRDCL_ONLY )
     xrdcrc32c
     XrdUtils )
 
+  #-----------------------------------------------------------------------------
+  # xrdcksbench
+  #-----------------------------------------------------------------------------
+  add_executable(
+    xrdcksbench
+    XrdApps/XrdCksBench.cc )
+
+  target_link_libraries(
+    xrdcksbench
+    XrdUtils )
+
   #-----------------------------------------------------------------------------
   # cconfig
   #-----------------------------------------------------------------------------
@@ -212,7 +223,7 @@ install(
 
 if( NOT XRDCL_ONLY )
   install(
-    TARGETS xrdacctest xrdadler32 cconfig mpxstats wait41 xrdmapc xrdpinls xrdcrc32c xrdcks
+    TARGETS xrdacctest xrdadler32 cconfig mpxstats wait41 xrdmapc xrdpinls xrdcrc32c xrdcks xrdcksbench
     LIBRARY DESTINATION ${CMAKE_INSTALL_LIBDIR}
     RUNTIME DESTINATION ${CMAKE_INSTALL_BINDIR} )
 endif()
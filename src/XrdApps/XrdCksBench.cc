@@ -0,0 +1,251 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C k s B e n c h . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "XrdVersion.hh"
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksData.hh"
+#include "XrdCks/XrdCksManager.hh"
+#include "XrdOuc/XrdOuca2x.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+/******************************************************************************/
+/*                           G l o b a l   D a t a                            */
+/******************************************************************************/
+
+namespace
+{
+const char *pgm = "xrdcksbench";
+
+XrdSysLogger myLogger;
+XrdSysError  eDest(&myLogger, "cksbench_");
+
+XrdVERSIONINFODEF(myVer, xrdcksbench, XrdVNUMBER, XrdVERSION);
+
+const char  *dfltCks[] = {"adler32", "crc32", "crc32c", "md5"};
+const int    dfltNum   = sizeof(dfltCks)/sizeof(dfltCks[0]);
+}
+
+/******************************************************************************/
+/*                                   N o w                                    */
+/******************************************************************************/
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+/******************************************************************************/
+/*                                R e p o r t                                 */
+/******************************************************************************/
+
+void Report(const char *what, long long bytes, double secs)
+{
+   char buff[256];
+
+   if (secs <= 0.0) secs = 0.000001;
+   snprintf(buff, sizeof(buff), "%-24s %10.3f sec %9.3f GB/s %8.3f ns/byte",
+            what, secs, bytes/secs/1.0e9, secs*1.0e9/bytes);
+   std::cout <<buff <<std::endl;
+}
+
+/******************************************************************************/
+/*                                 U s a g e                                  */
+/******************************************************************************/
+
+void Usage(int rc)
+{
+   std::cerr <<"\nUsage: xrdcksbench [opts] [<cksname> [<cksname> [...]]]\n"
+          "\n<cksname> the checksum to measure. The default is to measure"
+          "\n          adler32, crc32, crc32c, and md5.\n"
+          "\nopts: -f <path> -h -m <mb> -r <reps>\n"
+          "\n-f time computing the checksums of <path> one at a time and then"
+          "\n   all at once using a single pass over the file."
+          "\n-h display usage information (arguments ignored)."
+          "\n-m the size, in megabytes, of the memory buffer to checksum."
+          "\n   The default is 64."
+          "\n-r the number of times the memory buffer is checksummed."
+          "\n   The default is 16."
+          <<std::endl;
+   exit(rc);
+}
+
+/******************************************************************************/
+/*                               D o F i l e                                  */
+/******************************************************************************/
+
+int DoFile(const char *path, const char **cksName, int cksNum)
+{
+   XrdCksManager cksMan(&eDest, 0, myVer);
+   XrdCksData    cksData[8];
+   long long     fSize = 0;
+   char          what[64];
+   double        tBeg;
+   int           i, rc;
+
+// Initialize the manager with the native checksums
+//
+   if (!cksMan.Init(0)) return 2;
+   if (cksNum > 8) cksNum = 8;
+
+// Compute each checksum separately
+//
+   tBeg = Now();
+   for (i = 0; i < cksNum; i++)
+       {double cBeg = Now();
+        cksData[i].Set(cksName[i]);
+        if ((rc = cksMan.Calc(path, cksData[i], 0)))
+           {std::cerr <<pgm <<": Unable to compute " <<cksName[i] <<" for "
+                      <<path <<"; " <<strerror(-rc) <<std::endl;
+            return 3;
+           }
+        if (!fSize)
+           {struct stat Stat;
+            if (!stat(path, &Stat)) fSize = Stat.st_size;
+            if (!fSize) fSize = 1;
+           }
+        snprintf(what, sizeof(what), "file %s", cksName[i]);
+        Report(what, fSize, Now() - cBeg);
+       }
+   Report("file separately", fSize*cksNum, Now() - tBeg);
+
+// Now compute them all in a single pass
+//
+   for (i = 0; i < cksNum; i++) cksData[i].Set(cksName[i]);
+   tBeg = Now();
+   if ((rc = cksMan.MultiCalc(path, cksData, cksNum, 0)))
+      {std::cerr <<pgm <<": Unable to compute checksums for " <<path
+                 <<"; " <<strerror(-rc) <<std::endl;
+       return 3;
+      }
+   Report("file single pass", fSize*cksNum, Now() - tBeg);
+
+// Display the results
+//
+   for (i = 0; i < cksNum; i++)
+       {char csBuff[256];
+        cksData[i].Get(csBuff, sizeof(csBuff));
+        std::cout <<cksData[i].Name <<' ' <<csBuff <<std::endl;
+       }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+   extern char *optarg;
+   extern int optind, opterr, optopt;
+   const char **cksName = dfltCks, *fPath = 0;
+   long long bytes, mbSize = 64;
+   int c, cksNum = dfltNum, reps = 16;
+
+// Process the options
+//
+   opterr = 0;
+   while ((c = getopt(argc,argv,"f:hm:r:")) && ((unsigned char)c != 0xff))
+     { switch(c)
+       {
+       case 'f': fPath = optarg;
+                 break;
+       case 'h': Usage(0);
+                 break;
+       case 'm': if (XrdOuca2x::a2ll(eDest, "buffer size", optarg,
+                                     &mbSize, 1, 4096)) Usage(1);
+                 break;
+       case 'r': if (XrdOuca2x::a2i(eDest, "repetitions", optarg,
+                                    &reps, 1)) Usage(1);
+                 break;
+       default:  std::cerr <<pgm <<": -" <<char(optopt) <<" option is invalid"
+                           <<std::endl;
+                 Usage(1);
+                 break;
+       }
+     }
+
+// Get the list of checksums, if any
+//
+   if (optind < argc)
+      {cksName = (const char **)&argv[optind];
+       cksNum  = argc - optind;
+      }
+
+// If a file was specified, time the checksum manager on the file
+//
+   if (fPath) return DoFile(fPath, cksName, cksNum);
+
+// Fill a buffer with something other than zeroes
+//
+   XrdCksManager cksMan(&eDest, 0, myVer);
+   if (!cksMan.Init(0)) return 2;
+
+   bytes = mbSize*1024*1024;
+   char *buff = (char *)malloc(bytes);
+   if (!buff) {std::cerr <<pgm <<": Insufficient memory" <<std::endl; return 2;}
+   srand(1);
+   for (long long i = 0; i < bytes; i++) buff[i] = (char)rand();
+
+// Time each checksum
+//
+   for (int i = 0; i < cksNum; i++)
+       {XrdCksCalc *csP = cksMan.Object(cksName[i]);
+        if (!csP)
+           {std::cerr <<pgm <<": " <<cksName[i] <<" checksum not supported"
+                      <<std::endl;
+            continue;
+           }
+        double tBeg = Now();
+        for (int j = 0; j < reps; j++)
+            {csP->Init();
+             for (long long k = 0; k < bytes; k += 1024*1024)
+                 csP->Update(buff+k, (int)(bytes-k < 1024*1024
+                                           ? bytes-k : 1024*1024));
+             csP->Final();
+            }
+        Report(cksName[i], bytes*reps, Now() - tBeg);
+        csP->Recycle();
+       }
+
+// All done
+//
+   free(buff);
+   return 0;
+}
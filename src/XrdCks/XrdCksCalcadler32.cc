@@ -0,0 +1,169 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d C k s C a l c a d l e r 3 2 . c c                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdCks/XrdCksCalcadler32.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define XRDCKS_ADLER_AVX2 1
+#endif
+
+/* The scalar implementation was derived from zlib; see XrdCksCalcadler32.hh
+   for the zlib license terms. The vector implementation computes the same
+   sums 32 bytes at a time. For a block of n bytes b[0..n-1] following sums
+   s1 and s2 the new sums are:
+
+   s1' = s1 + sum(b[i])
+   s2' = s2 + n*s1 + sum((n-i)*b[i])
+
+   The second sum is split into 32 byte chunks. Each chunk contributes its
+   bytes weighted 32..1 plus 32 times the sum of all of the bytes that came
+   before it in the block. Blocks are limited to NMAX bytes so that nothing
+   overflows before the sums are reduced modulo BASE.
+*/
+
+/******************************************************************************/
+/*                         L o c a l   F u n c t i o n s                      */
+/******************************************************************************/
+
+namespace
+{
+const unsigned int adlerBase = 0xFFF1;
+const          int adlerNMax = 5552;
+
+typedef void (*AdlerFunc)(unsigned int &, unsigned int &,
+                          const unsigned char *, int);
+
+#define DO1(buf)  {s1 += *buf++; s2 += s1;}
+#define DO2(buf)  DO1(buf); DO1(buf);
+#define DO4(buf)  DO2(buf); DO2(buf);
+#define DO8(buf)  DO4(buf); DO4(buf);
+#define DO16(buf) DO8(buf); DO8(buf);
+
+/******************************************************************************/
+/*                           a d l e r S c a l a r                            */
+/******************************************************************************/
+
+void adlerScalar(unsigned int &s1, unsigned int &s2,
+                 const unsigned char *buff, int BLen)
+{
+   int k;
+
+   while(BLen > 0)
+        {k = (BLen < adlerNMax ? BLen : adlerNMax);
+         BLen -= k;
+         while(k >= 16) {DO16(buff); k -= 16;}
+         if (k != 0) do {DO1(buff);} while (--k);
+         s1 %= adlerBase; s2 %= adlerBase;
+        }
+}
+
+/******************************************************************************/
+/*                             a d l e r A V X 2                              */
+/******************************************************************************/
+
+#ifdef XRDCKS_ADLER_AVX2
+
+__attribute__((target("avx2")))
+inline unsigned int hSum(__m256i v)
+{
+   __m128i x = _mm_add_epi32(_mm256_castsi256_si128(v),
+                             _mm256_extracti128_si256(v, 1));
+   x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0x4e));
+   x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0xb1));
+   return static_cast<unsigned int>(_mm_cvtsi128_si32(x));
+}
+
+__attribute__((target("avx2")))
+void adlerAVX2(unsigned int &s1, unsigned int &s2,
+               const unsigned char *buff, int BLen)
+{
+   static const int blkChunks = adlerNMax/32;
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i ones = _mm256_set1_epi16(1);
+   const __m256i taps = _mm256_set_epi8( 1,  2,  3,  4,  5,  6,  7,  8,
+                                         9, 10, 11, 12, 13, 14, 15, 16,
+                                        17, 18, 19, 20, 21, 22, 23, 24,
+                                        25, 26, 27, 28, 29, 30, 31, 32);
+   __m256i vS1, vS2, vPS, bytes;
+   int n;
+
+// Process as many 32 byte chunks as we can, at most NMAX bytes at a time.
+// vPS accumulates the running s1 (times 32 at the end), seeded with the
+// incoming s1 times the number of chunks in the block.
+//
+   while(BLen >= 32)
+        {n = BLen/32;
+         if (n > blkChunks) n = blkChunks;
+         BLen -= n*32;
+         vPS = _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, (int)(s1*n));
+         vS2 = _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, (int)s2);
+         vS1 = zero;
+         do {bytes = _mm256_loadu_si256((const __m256i *)buff);
+             vPS = _mm256_add_epi32(vPS, vS1);
+             vS1 = _mm256_add_epi32(vS1, _mm256_sad_epu8(bytes, zero));
+             vS2 = _mm256_add_epi32(vS2, _mm256_madd_epi16(
+                                         _mm256_maddubs_epi16(bytes, taps), ones));
+             buff += 32;
+            } while(--n);
+         vS2 = _mm256_add_epi32(vS2, _mm256_slli_epi32(vPS, 5));
+         s1 += hSum(vS1);
+         s2  = hSum(vS2);
+         s1 %= adlerBase; s2 %= adlerBase;
+        }
+
+// Finish up whatever is left over
+//
+   if (BLen) adlerScalar(s1, s2, buff, BLen);
+}
+#endif
+
+/******************************************************************************/
+/*                           a d l e r S e l e c t                            */
+/******************************************************************************/
+
+AdlerFunc adlerSelect()
+{
+#ifdef XRDCKS_ADLER_AVX2
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2")) return adlerAVX2;
+#endif
+   return adlerScalar;
+}
+}
+
+/******************************************************************************/
+/*                                U p d a t e                                 */
+/******************************************************************************/
+
+void XrdCksCalcadler32::Update(const char *Buff, int BLen)
+{
+   static const AdlerFunc adlerFunc = adlerSelect();
+
+   if (BLen > 0) adlerFunc(unSum1, unSum2, (const unsigned char *)Buff, BLen);
+}
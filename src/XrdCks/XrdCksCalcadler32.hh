@@ -72,12 +72,6 @@
   (zlib format), rfc1951.txt (deflate format) and rfc1952.txt (gzip format).
 */
 
-#define DO1(buf)  {unSum1 += *buf++; unSum2 += unSum1;}
-#define DO2(buf)  DO1(buf); DO1(buf);
-#define DO4(buf)  DO2(buf); DO2(buf);
-#define DO8(buf)  DO4(buf); DO4(buf);
-#define DO16(buf) DO8(buf); DO8(buf);
-
 class XrdCksCalcadler32 : public XrdCksCalc
 {
 public:
@@ -94,17 +88,7 @@ void        Init() {unSum1 = AdlerStart; unSum2 = 0;}
 
 XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalcadler32;}
 
-void        Update(const char *Buff, int BLen)
-                  {int k;
-                   unsigned char *buff = (unsigned char *)Buff;
-                   while(BLen > 0)
-                        {k = (BLen < AdlerNMax ? BLen : AdlerNMax);
-                         BLen -= k;
-                         while(k >= 16) {DO16(buff); k -= 16;}
-                         if (k != 0) do {DO1(buff);} while (--k);
-                         unSum1 %= AdlerBase; unSum2 %= AdlerBase;
-                        }
-                  }
+void        Update(const char *Buff, int BLen); // Uses SIMD when possible
 
 const char *Type(int &csSize) {csSize = sizeof(AdlerValue); return "adler32";}
 
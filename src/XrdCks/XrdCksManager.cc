@@ -59,6 +59,53 @@
 #define ENOATTR ENODATA
 #endif
 
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// This calculator feeds the same data to several calculators so that a file
+// need only be read once to compute several checksums. Data is handed out in
+// chunks small enough to stay in the cache while every calculator sees them.
+//
+class XrdCksCalcMulti : public XrdCksCalc
+{
+public:
+
+char       *Final() {return 0;}
+
+void        Init() {for (int i = 0; i < csNum; i++) csVec[i]->Init();}
+
+XrdCksCalc *New() {return 0;}
+
+void        Recycle() {}
+
+const char *Type(int &csSize) {csSize = 0; return "multi";}
+
+void        Update(const char *Buff, int BLen)
+                  {int k;
+                   while(BLen > 0)
+                        {k = (BLen < chunkSz ? BLen : chunkSz);
+                         for (int i = 0; i < csNum; i++)
+                             csVec[i]->Update(Buff, k);
+                         Buff += k; BLen -= k;
+                        }
+                  }
+
+            XrdCksCalcMulti(XrdCksCalc **csv, int csn)
+                           : csVec(csv), csNum(csn) {}
+           ~XrdCksCalcMulti() {}
+
+private:
+
+static const int chunkSz = 256*1024;
+
+XrdCksCalc **csVec;
+int          csNum;
+};
+}
+
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
@@ -174,11 +221,18 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
    calcSize = fileSize = Stat.st_size;
    MTime = Stat.st_mtime;
 
-// We now compute checksum 64MB at a time using mmap I/O
+// We now compute checksum 64MB at a time using mmap I/O. Before computing
+// each segment we ask the kernel to start reading the next one so that the
+// I/O overlaps the checksum calculation.
 //
    ioSize = (fileSize < (off_t)segSize ? fileSize : segSize); rc = 0;
    while(calcSize)
-        {if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
+        {
+#ifdef POSIX_FADV_WILLNEED
+         if (calcSize > ioSize)
+            posix_fadvise(In.FD, Offset+ioSize, segSize, POSIX_FADV_WILLNEED);
+#endif
+         if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
 #if defined(__FreeBSD__)
                        MAP_RESERVED0040|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
 #elif defined(__GNU__)
@@ -536,6 +590,71 @@ char *XrdCksManager::List(const char *Pfn, char *Buff, int Blen, char Sep)
    return (bP == Buff ? 0 : Buff);
 }
 
+/******************************************************************************/
+/*                             M u l t i C a l c                              */
+/******************************************************************************/
+
+int XrdCksManager::MultiCalc(const char *Pfn, XrdCksData *Cks, int csNum,
+                             int doSet)
+{
+   XrdCksCalc *csP[csMax];
+   csInfo     *csIP[csMax];
+   time_t MTime;
+   int i, rc;
+
+// Determine which checksums to get
+//
+   if (csLast < 0) return -ENOTSUP;
+   if (csNum < 1 || csNum > csMax) return -EINVAL;
+   for (i = 0; i < csNum; i++)
+       {if (!(*Cks[i].Name)) {Cks[i].Set(csTab[0].Name); csIP[i] = &csTab[0];}
+           else if (!(csIP[i] = Find(Cks[i].Name))) return -ENOTSUP;
+       }
+
+// A single checksum is handled in the usual way
+//
+   if (csNum == 1) return Calc(Pfn, Cks[0], doSet);
+
+// Obtain a new checksum object for each checksum
+//
+   for (i = 0; i < csNum; i++)
+       if (!(csP[i] = csIP[i]->Obj->New()))
+          {while(i--) csP[i]->Recycle();
+           return -ENOMEM;
+          }
+
+// Compute all of the checksums with a single pass over the file
+//
+   {XrdCksCalcMulti csMulti(csP, csNum);
+    rc = Calc(Pfn, MTime, &csMulti);
+   }
+
+// Return the results
+//
+   for (i = 0; i < csNum; i++)
+       {if (!rc)
+           {memcpy(Cks[i].Value, csP[i]->Final(), csIP[i]->Len);
+            Cks[i].fmTime = static_cast<long long>(MTime);
+            Cks[i].csTime = static_cast<int>(time(0) - MTime);
+            Cks[i].Length = csIP[i]->Len;
+           }
+        csP[i]->Recycle();
+       }
+
+// Set the checksums in the extended attributes, if so wanted
+//
+   if (!rc && doSet)
+      for (i = 0; i < csNum; i++)
+          {XrdOucXAttr<XrdCksXAttr> xCS;
+           memcpy(&xCS.Attr.Cks, &Cks[i], sizeof(xCS.Attr.Cks));
+           if ((rc = xCS.Set(Pfn))) return -rc;
+          }
+
+// All done
+//
+   return rc;
+}
+
 /******************************************************************************/
 /*                               M o d T i m e                                */
 /******************************************************************************/
@@ -62,6 +62,19 @@ virtual char       *List(const char *Pfn, char *Buff, int Blen, char Sep=' ');
 
 virtual const char *Name(int seqNum=0);
 
+/* MultiCalc() computes several checksums of the physical file Pfn while reading
+              it only once. Each of the csNum elements of Cks names the
+              checksum to compute (an empty name selects the default one) and
+              receives the result. When doSet is true, each checksum is also
+              recorded in the file's extended attributes. Returns 0 upon
+              success and -errno otherwise. It is not part of the XrdCks
+              plugin interface: a checksum request names a single checksum
+              and a new virtual would break existing XrdCks plugins and
+              wrappers. Use it by holding an XrdCksManager directly.
+*/
+        int         MultiCalc(const char *Pfn, XrdCksData *Cks, int csNum,
+                              int doSet=1);
+
 virtual XrdCksCalc *Object(const char *name);
 
 virtual int         Size( const char  *Name=0);
@@ -96,6 +96,8 @@ namespace XrdCl
   const int DefaultRetryWrtAtLBLimit       = 3;
   const int DefaultCpRetry                 = 0;
   const int DefaultCpUsePgWrtRd            = 1;
+  const int DefaultLocalIOThreads          = 4;
+  const int DefaultLocalIORingDepth        = 256;
 
   const char * const DefaultPollerPreference   = "built-in";
   const char * const DefaultNetworkStack       = "IPAuto";
@@ -112,6 +114,7 @@ namespace XrdCl
   const char * const DefaultClConfFile         = "";
   const char * const DefaultCpTarget           = "";
   const char * const DefaultCpRetryPolicy      = "force";
+  const char * const DefaultLocalIOEngine      = "auto";
 
   inline static std::string to_lower( std::string str )
   {
@@ -161,7 +164,8 @@ namespace XrdCl
       { to_lower( "ZipMtlnCksum" ),            DefaultZipMtlnCksum },
       { to_lower( "IPNoShuffle" ),             DefaultIPNoShuffle },
       { to_lower( "WantTlsOnNoPgrw" ),         DefaultWantTlsOnNoPgrw },
-      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit }
+      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit },
+      { to_lower( "LocalIOThreads" ),          DefaultLocalIOThreads }
     };
 
   static std::unordered_map<std::string, std::string> theDefaultStrs
@@ -179,7 +183,8 @@ namespace XrdCl
       { to_lower( "TlsDbgLvl" ),          DefaultTlsDbgLvl },
       { to_lower( "ClConfDir" ),          DefaultClConfDir },
       { to_lower( "DefaultClConfFile" ),  DefaultClConfFile },
-      { to_lower( "CpTarget" ),           DefaultCpTarget }
+      { to_lower( "CpTarget" ),           DefaultCpTarget },
+      { to_lower( "LocalIOEngine" ),      DefaultLocalIOEngine }
     };
 }
 
@@ -306,6 +306,7 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "XRateThreshold",          DefaultXRateThreshold          );
     REGISTER_VAR_INT( varsInt, "CpRetry",                 DefaultCpRetry                 );
     REGISTER_VAR_INT( varsInt, "CpUsePgWrtRd",            DefaultCpUsePgWrtRd            );
+    REGISTER_VAR_INT( varsInt, "LocalIOThreads",          DefaultLocalIOThreads          );
 
     REGISTER_VAR_STR( varsStr, "ClientMonitor",           DefaultClientMonitor           );
     REGISTER_VAR_STR( varsStr, "ClientMonitorParam",      DefaultClientMonitorParam      );
@@ -319,6 +320,7 @@ namespace XrdCl
     REGISTER_VAR_STR( varsStr, "TlsDbgLvl",               DefaultTlsDbgLvl               );
     REGISTER_VAR_STR( varsStr, "CpTarget",                DefaultCpTarget                );
     REGISTER_VAR_STR( varsStr, "CpRetryPolicy",           DefaultCpRetryPolicy           );
+    REGISTER_VAR_STR( varsStr, "LocalIOEngine",           DefaultLocalIOEngine           );
 
     //--------------------------------------------------------------------------
     // Process the configuration files
@@ -28,6 +28,7 @@
 #include "XrdSys/XrdSysXAttr.hh"
 #include "XrdSys/XrdSysFAttr.hh"
 #include "XrdSys/XrdSysFD.hh"
+#include "XrdSys/XrdSysIOUring.hh"
 
 #include <string>
 #include <memory>
@@ -38,12 +39,163 @@
 #include <cstdlib>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <arpa/inet.h>
 #include <aio.h>
 
 namespace
 {
+  //----------------------------------------------------------------------------
+  // Hand the response over to the user handler
+  //----------------------------------------------------------------------------
+  void QueueTask( XrdCl::XRootDStatus *status, XrdCl::AnyObject *resp,
+                  XrdCl::HostList *hosts, XrdCl::ResponseHandler *handler )
+  {
+    using namespace XrdCl;
+
+    // if it is simply the sync handler we can release the semaphore
+    // and return there is no need to execute this in the thread-pool
+    SyncResponseHandler *syncHandler =
+        dynamic_cast<SyncResponseHandler*>( handler );
+    if( syncHandler || DefaultEnv::GetPostMaster() == nullptr )
+    {
+      syncHandler->HandleResponse( status, resp );
+    }
+    else
+    {
+      JobManager *jmngr = DefaultEnv::GetPostMaster()->GetJobManager();
+      LocalFileTask *task = new LocalFileTask( status, resp, hosts, handler );
+      jmngr->QueueJob( task );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // A local file I/O request. It is executed using io_uring when available,
+  // otherwise it is run synchronously by the local I/O thread pool. Either
+  // way, the user handler is invoked via the post master's job manager.
+  //----------------------------------------------------------------------------
+  class LocalIOJob : public XrdCl::Job
+  {
+    public:
 
+      LocalIOJob( const XrdCl::HostList &hostList, XrdCl::ResponseHandler *handler,
+                  XrdSysIOUring::Opc opcode, int fd, uint64_t offset,
+                  uint32_t size, const void *buffer ) :
+        opcode( opcode ), fd( fd ), offset( offset ), size( size ),
+        buffer( const_cast<void*>( buffer ) ),
+        hosts( new XrdCl::HostList( hostList ) ), handler( handler )
+      {
+      }
+
+      //------------------------------------------------------------------------
+      // Start the request, the job deletes itself once it is done
+      //------------------------------------------------------------------------
+      void Submit( XrdCl::PostMaster *postMaster )
+      {
+        XrdSysIOUring *ring = postMaster->GetLocalIORing();
+        if( ring )
+        {
+          int rc = ring->Submit( opcode, fd, buffer, size, offset,
+                                 RingDone, this );
+          if( !rc ) return;
+          // a full ring is expected under load, anything else is not
+          if( rc != EAGAIN )
+            XrdCl::DefaultEnv::GetLog()->Warning( XrdCl::FileMsg,
+                              "I/O:   io_uring refused the request, using "
+                              "the thread pool: %s", XrdSysE2T( rc ) );
+        }
+        postMaster->GetLocalIOManager()->QueueJob( this );
+      }
+
+      //------------------------------------------------------------------------
+      // Do the I/O synchronously (called by the local I/O thread pool)
+      //------------------------------------------------------------------------
+      void Run( void* )
+      {
+        ssize_t rc = 0;
+        switch( opcode )
+        {
+          case XrdSysIOUring::opRead:
+            do rc = pread( fd, buffer, size, offset );
+            while( rc < 0 && errno == EINTR );
+            break;
+
+          case XrdSysIOUring::opWrite:
+          {
+            const char *buff = reinterpret_cast<const char*>( buffer );
+            ssize_t done = 0;
+            while( done < (ssize_t)size )
+            {
+              rc = pwrite( fd, buff + done, size - done, offset + done );
+              if( rc < 0 && errno == EINTR ) continue;
+              if( rc <= 0 ) break;
+              done += rc;
+            }
+            if( rc >= 0 ) rc = done;
+            break;
+          }
+
+          case XrdSysIOUring::opFsync:
+            rc = fsync( fd );
+            break;
+
+          default:
+            errno = ENOTSUP; rc = -1;
+            break;
+        }
+        Done( rc < 0 ? -errno : rc );
+      }
+
+    private:
+
+      static void RingDone( void *arg, int result )
+      {
+        static_cast<LocalIOJob*>( arg )->Done( result );
+      }
+
+      void Done( int result )
+      {
+        using namespace XrdCl;
+        std::unique_ptr<LocalIOJob> me( this );
+
+        if( result < 0 )
+        {
+          // Indexed by opcode; only opRead, opWrite and opFsync are used
+          static const char *errmsg[] = { "Read:  failed %s",
+                                          "Write: failed %s",
+                                          "Sync:  failed %s" };
+          const char *etxt = ( opcode <= XrdSysIOUring::opFsync ?
+                               errmsg[opcode] : "I/O:   failed %s" );
+          Log *log = DefaultEnv::GetLog();
+          log->Error( FileMsg, etxt, XrdSysE2T( -result ) );
+          XRootDStatus *error = new XRootDStatus( stError, errLocalError,
+                                                  -result );
+          QueueTask( error, 0, hosts, handler );
+          return;
+        }
+
+        AnyObject *resp = 0;
+        if( opcode == XrdSysIOUring::opRead )
+        {
+          ChunkInfo *chunk = new ChunkInfo( offset, result, buffer );
+          resp = new AnyObject();
+          resp->Set( chunk );
+        }
+        QueueTask( new XRootDStatus(), resp, hosts, handler );
+      }
+
+      XrdSysIOUring::Opc      opcode;
+      int                     fd;
+      uint64_t                offset;
+      uint32_t                size;
+      void                   *buffer;
+      XrdCl::HostList        *hosts;
+      XrdCl::ResponseHandler *handler;
+  };
+
+  //----------------------------------------------------------------------------
+  // A local file I/O request executed using POSIX aio
+  //----------------------------------------------------------------------------
   class AioCtx
   {
     public:
@@ -192,27 +344,6 @@ namespace
         }
       }
 
-      static void QueueTask( XrdCl::XRootDStatus *status, XrdCl::AnyObject *resp,
-                             XrdCl::HostList *hosts, XrdCl::ResponseHandler *handler )
-      {
-        using namespace XrdCl;
-
-        // if it is simply the sync handler we can release the semaphore
-        // and return there is no need to execute this in the thread-pool
-        SyncResponseHandler *syncHandler =
-            dynamic_cast<SyncResponseHandler*>( handler );
-        if( syncHandler || DefaultEnv::GetPostMaster() == nullptr )
-        {
-          syncHandler->HandleResponse( status, resp );
-        }
-        else
-        {
-          JobManager *jmngr = DefaultEnv::GetPostMaster()->GetJobManager();
-          LocalFileTask *task = new LocalFileTask( status, resp, hosts, handler );
-          jmngr->QueueJob( task );
-        }
-      }
-      
       std::unique_ptr<aiocb>  cb;
       Opcode                  opcode;
       XrdCl::HostList        *hosts;
@@ -334,6 +465,15 @@ namespace XrdCl
     resp->Set( chunk );
     return QueueTask( new XRootDStatus(), resp, handler );
 #else
+    PostMaster *postMaster = DefaultEnv::GetPostMaster();
+    if( postMaster && postMaster->GetLocalIOManager() )
+    {
+      LocalIOJob *job = new LocalIOJob( pHostList, handler, XrdSysIOUring::opRead,
+                                        fd, offset, size, buffer );
+      job->Submit( postMaster );
+      return XRootDStatus();
+    }
+
     AioCtx *ctx = new AioCtx( pHostList, handler );
     ctx->SetRead( fd, offset, size, buffer );
 
@@ -416,6 +556,15 @@ namespace XrdCl
     }
     return QueueTask( new XRootDStatus(), 0, handler );
 #else
+    PostMaster *postMaster = DefaultEnv::GetPostMaster();
+    if( postMaster && postMaster->GetLocalIOManager() )
+    {
+      LocalIOJob *job = new LocalIOJob( pHostList, handler, XrdSysIOUring::opWrite,
+                                        fd, offset, size, buffer );
+      job->Submit( postMaster );
+      return XRootDStatus();
+    }
+
     AioCtx *ctx = new AioCtx( pHostList, handler );
     ctx->SetWrite( fd, offset, size, buffer );
 
@@ -450,6 +599,15 @@ namespace XrdCl
     }
     return QueueTask( new XRootDStatus(), 0, handler );
 #else
+    PostMaster *postMaster = DefaultEnv::GetPostMaster();
+    if( postMaster && postMaster->GetLocalIOManager() )
+    {
+      LocalIOJob *job = new LocalIOJob( pHostList, handler, XrdSysIOUring::opFsync,
+                                        fd, 0, 0, 0 );
+      job->Submit( postMaster );
+      return XRootDStatus();
+    }
+
     AioCtx *ctx = new AioCtx( pHostList, handler );
     ctx->SetFsync( fd );
     int rc = aio_fsync( O_SYNC, *ctx );
@@ -31,6 +31,8 @@
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClRedirectorRegistry.hh"
 
+#include "XrdSys/XrdSysE2T.hh"
+#include "XrdSys/XrdSysIOUring.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
 namespace XrdCl
@@ -57,7 +59,9 @@ namespace XrdCl
 
   struct PostMasterImpl
   {
-    PostMasterImpl() : pPoller( 0 ), pInitialized( false ), pRunning( false )
+    PostMasterImpl() : pPoller( 0 ), pInitialized( false ), pRunning( false ),
+                       pLocalIOManager( 0 ), pLocalIORing( 0 ),
+                       pLocalIORingOK( false )
     {
       Env *env = DefaultEnv::GetEnv();
       int workerThreads = DefaultWorkerThreads;
@@ -65,6 +69,24 @@ namespace XrdCl
 
       pTaskManager = new TaskManager();
       pJobManager  = new JobManager(workerThreads);
+
+      //------------------------------------------------------------------------
+      // Local files are accessed either with POSIX aio (the legacy mode) or
+      // using io_uring, when available, backed by a bounded pool of threads
+      // doing blocking I/O
+      //------------------------------------------------------------------------
+      std::string localIOEngine = DefaultLocalIOEngine;
+      env->GetString( "LocalIOEngine", localIOEngine );
+      int localIOThreads = DefaultLocalIOThreads;
+      env->GetInt( "LocalIOThreads", localIOThreads );
+      if( localIOThreads < 1 ) localIOThreads = 1;
+
+      if( localIOEngine != "aio" )
+      {
+        pLocalIOManager = new JobManager( localIOThreads );
+        if( localIOEngine != "pool" )
+          pLocalIORing = new XrdSysIOUring( 1, DefaultLocalIORingDepth );
+      }
     }
 
     ~PostMasterImpl()
@@ -72,6 +94,8 @@ namespace XrdCl
       delete pPoller;
       delete pTaskManager;
       delete pJobManager;
+      delete pLocalIORing;
+      delete pLocalIOManager;
     }
 
     typedef std::map<std::string, Channel*> ChannelMap;
@@ -89,6 +113,10 @@ namespace XrdCl
     std::function<void( const URL&, const XRootDStatus& )> pOnConnErrCB;
 
     XrdSysRWLock          pDisconnectLock;
+
+    JobManager           *pLocalIOManager;
+    XrdSysIOUring        *pLocalIORing;
+    bool                  pLocalIORingOK;
   };
 
   //----------------------------------------------------------------------------
@@ -128,6 +156,8 @@ namespace XrdCl
     }
 
     pImpl->pJobManager->Initialize();
+    if( pImpl->pLocalIOManager )
+      pImpl->pLocalIOManager->Initialize();
     pImpl->pInitialized = true;
     return true;
   }
@@ -145,6 +175,8 @@ namespace XrdCl
 
     pImpl->pInitialized = false;
     pImpl->pJobManager->Finalize();
+    if( pImpl->pLocalIOManager )
+      pImpl->pLocalIOManager->Finalize();
     PostMasterImpl::ChannelMap::iterator it;
 
     for( it = pImpl->pChannelMap.begin(); it != pImpl->pChannelMap.end(); ++it )
@@ -178,6 +210,32 @@ namespace XrdCl
       return false;
     }
 
+    if( pImpl->pLocalIOManager && !pImpl->pLocalIOManager->Start() )
+    {
+      pImpl->pPoller->Stop();
+      pImpl->pTaskManager->Stop();
+      pImpl->pJobManager->Stop();
+      return false;
+    }
+
+    //--------------------------------------------------------------------------
+    // Failing to set up io_uring is not fatal, local I/O is then done by the
+    // thread pool
+    //--------------------------------------------------------------------------
+    pImpl->pLocalIORingOK = false;
+    if( pImpl->pLocalIORing )
+    {
+      const char *eTxt = "";
+      int rc = pImpl->pLocalIORing->Init( eTxt );
+      if( rc )
+      {
+        Log *log = DefaultEnv::GetLog();
+        log->Debug( PostMasterMsg, "Unable to %s: %s; local file I/O will be "
+                    "done by a thread pool", eTxt, XrdSysE2T( rc ) );
+      }
+      else pImpl->pLocalIORingOK = true;
+    }
+
     pImpl->pRunning = true;
     return true;
   }
@@ -190,6 +248,10 @@ namespace XrdCl
     if( !pImpl->pInitialized )
       return true;
 
+    if( pImpl->pLocalIORing )
+      pImpl->pLocalIORing->Stop();
+    if( pImpl->pLocalIOManager && !pImpl->pLocalIOManager->Stop() )
+      return false;
     if( !pImpl->pJobManager->Stop() )
       return false;
     if( !pImpl->pTaskManager->Stop() )
@@ -309,6 +371,22 @@ namespace XrdCl
     return pImpl->pJobManager;
   }
 
+  //------------------------------------------------------------------------
+  // Get the job manager running blocking local file I/O
+  //------------------------------------------------------------------------
+  JobManager* PostMaster::GetLocalIOManager()
+  {
+    return pImpl->pLocalIOManager;
+  }
+
+  //------------------------------------------------------------------------
+  // Get the io_uring used for local file I/O
+  //------------------------------------------------------------------------
+  XrdSysIOUring* PostMaster::GetLocalIORing()
+  {
+    return pImpl->pLocalIORingOK ? pImpl->pLocalIORing : 0;
+  }
+
   //------------------------------------------------------------------------
   // Shut down a channel
   //------------------------------------------------------------------------
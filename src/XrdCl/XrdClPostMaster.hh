@@ -31,6 +31,8 @@
 
 #include "XrdSys/XrdSysPthread.hh"
 
+class XrdSysIOUring;
+
 namespace XrdCl
 {
   class Poller;
@@ -147,6 +149,21 @@ namespace XrdCl
       //------------------------------------------------------------------------
       JobManager *GetJobManager();
 
+      //------------------------------------------------------------------------
+      //! Get the job manager running blocking local file I/O
+      //!
+      //! @return the job manager or 0 if local files are to be accessed
+      //!         using POSIX aio
+      //------------------------------------------------------------------------
+      JobManager *GetLocalIOManager();
+
+      //------------------------------------------------------------------------
+      //! Get the io_uring used for local file I/O
+      //!
+      //! @return the ring or 0 if io_uring is not to be used
+      //------------------------------------------------------------------------
+      XrdSysIOUring *GetLocalIORing();
+
       //------------------------------------------------------------------------
       //! Shut down a channel
       //------------------------------------------------------------------------
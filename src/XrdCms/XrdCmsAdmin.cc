@@ -45,6 +45,7 @@
 #include "XrdCms/XrdCmsMeter.hh"
 #include "XrdCms/XrdCmsPrepare.hh"
 #include "XrdCms/XrdCmsState.hh"
+#include "XrdCms/XrdCmsSummary.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 #include "XrdNet/XrdNetSocket.hh"
 #include "XrdOuc/XrdOuca2x.hh"
@@ -827,6 +828,10 @@ void XrdCmsAdmin::do_RmDud(int isPfn)
           } else tp = apath;
       }
 
+// Make sure the file is in any namespace summary we are about to send
+//
+   Summary.Note(tp);
+
 // Check if we are relaying remove events and, if so, vector through that.
 //
    if (areFunc) AddEvent(tp, kYR_have, Mods);
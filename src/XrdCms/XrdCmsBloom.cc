@@ -0,0 +1,157 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s B l o o m . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstring>
+
+#include "XrdCms/XrdCmsBloom.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+const unsigned int XrdCmsBloom::minBits;
+const unsigned int XrdCmsBloom::maxBits;
+const int          XrdCmsBloom::maxHash;
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdCmsBloom::XrdCmsBloom(unsigned int bits, int hashes)
+                        : nBits(bits), bMask(bits-1), nHash(hashes)
+{
+   Bits = new unsigned char[bits >> 3];
+   memset(Bits, 0, bits >> 3);
+}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdCmsBloom::Add(unsigned long long hVal)
+{
+   unsigned int h1 = static_cast<unsigned int>(hVal);
+   unsigned int h2 = static_cast<unsigned int>(hVal >> 32) | 1;
+
+// Set a bit for each hash function (h1 + i*h2)
+//
+   for (int i = 0; i < nHash; i++, h1 += h2)
+       Bits[(h1 & bMask) >> 3] |= 1 << (h1 & 7);
+}
+
+/******************************************************************************/
+/*                                 E m p t y                                  */
+/******************************************************************************/
+
+bool XrdCmsBloom::Empty() const
+{
+   const unsigned int n = Bytes();
+
+   for (unsigned int i = 0; i < n; i++) if (Bits[i]) return false;
+   return true;
+}
+
+/******************************************************************************/
+/*                                  H a s h                                   */
+/******************************************************************************/
+
+unsigned long long XrdCmsBloom::Hash(const char *path, int plen)
+{
+   unsigned long long hVal = 0xcbf29ce484222325ULL;
+
+// Run a 64-bit FNV-1a hash over the path
+//
+   for (int i = 0; i < plen; i++)
+       {hVal ^= static_cast<unsigned char>(path[i]);
+        hVal *= 0x100000001b3ULL;
+       }
+
+// Mix the result so that both halves depend on every byte of the path
+//
+   hVal ^= hVal >> 33; hVal *= 0xff51afd7ed558ccdULL;
+   hVal ^= hVal >> 33; hVal *= 0xc4ceb9fe1a85ec53ULL;
+   hVal ^= hVal >> 33;
+   return hVal;
+}
+
+/******************************************************************************/
+/*                                 M e r g e                                  */
+/******************************************************************************/
+
+bool XrdCmsBloom::Merge(unsigned int offs, const char *data, int dlen)
+{
+   unsigned char *bP;
+
+// Make sure the data fits
+//
+   if (dlen < 0 || offs > Bytes() || (unsigned int)dlen > Bytes() - offs)
+      return false;
+
+// Or in the bits as some may have been set here while the rest was sent
+//
+   bP = Bits + offs;
+   for (int i = 0; i < dlen; i++) bP[i] |= static_cast<unsigned char>(data[i]);
+   return true;
+}
+
+/******************************************************************************/
+/*                                S i z i n g                                 */
+/******************************************************************************/
+
+unsigned int XrdCmsBloom::Sizing(long long nPaths, int bitsPer, int &hashes)
+{
+   unsigned int bits = minBits;
+
+// Find the smallest filter that has at least bitsPer bits for each path
+//
+   if (nPaths < 1) nPaths = 1;
+   while(bits < maxBits && (long long)bits < nPaths*bitsPer) bits <<= 1;
+
+// The best number of hash functions is ln(2) times the bits per path
+//
+   hashes = static_cast<int>((bits * 0.693) / nPaths + 0.5);
+   if (hashes < 1) hashes = 1;
+      else if (hashes > maxHash) hashes = maxHash;
+   return bits;
+}
+
+/******************************************************************************/
+/*                                  T e s t                                   */
+/******************************************************************************/
+
+bool XrdCmsBloom::Test(unsigned long long hVal) const
+{
+   unsigned int h1 = static_cast<unsigned int>(hVal);
+   unsigned int h2 = static_cast<unsigned int>(hVal >> 32) | 1;
+
+// The path may be present only if every one of its bits is set
+//
+   for (int i = 0; i < nHash; i++, h1 += h2)
+       if (!(Bits[(h1 & bMask) >> 3] & (1 << (h1 & 7)))) return false;
+   return true;
+}
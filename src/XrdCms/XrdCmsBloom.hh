@@ -0,0 +1,133 @@
+#ifndef XRDCMSBLOOM__H
+#define XRDCMSBLOOM__H
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s B l o o m . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+//------------------------------------------------------------------------------
+//! XrdCmsBloom is a Bloom filter of path names. It is the namespace summary a
+//! data server sends to its managers: a test of a path that was added always
+//! succeeds while a test of any other path succeeds only now and then (about
+//! 1% of the time with 10 bits and 7 hash functions per path).
+//!
+//! The filter is a power of two bits in size and each path is reduced to a
+//! 64-bit hash from which the bit positions are derived by double hashing.
+//! The bits are kept in an array of bytes, bit n being bit (n % 8) of byte
+//! (n / 8), so the filter has the same layout on every platform and may be
+//! sent and merged as is (see CmsBloomRequest).
+//------------------------------------------------------------------------------
+
+class XrdCmsBloom
+{
+public:
+
+static const unsigned int minBits = 1U << 16;
+static const unsigned int maxBits = 1U << 27;
+static const int          maxHash = 16;
+
+//------------------------------------------------------------------------------
+//! Add a path, given its hash, to the filter.
+//------------------------------------------------------------------------------
+
+void                 Add(unsigned long long hVal);
+
+//------------------------------------------------------------------------------
+//! Return the bits in the filter and their size in bytes.
+//------------------------------------------------------------------------------
+
+const unsigned char *Data() const {return Bits;}
+
+unsigned int         Bytes() const {return nBits >> 3;}
+
+unsigned int         Size()  const {return nBits;}
+
+//------------------------------------------------------------------------------
+//! Return the hash of a path. Every node must compute the same value as it is
+//! part of the protocol.
+//------------------------------------------------------------------------------
+
+static
+unsigned long long   Hash(const char *path, int plen);
+
+//------------------------------------------------------------------------------
+//! Return the number of hash functions used for each path.
+//------------------------------------------------------------------------------
+
+int                  Hashes() const {return nHash;}
+
+//------------------------------------------------------------------------------
+//! Return true if no path has been added to the filter.
+//------------------------------------------------------------------------------
+
+bool                 Empty() const;
+
+//------------------------------------------------------------------------------
+//! Merge bits sent by another node into the filter, starting at the indicated
+//! byte offset. Return false if they do not fit.
+//------------------------------------------------------------------------------
+
+bool                 Merge(unsigned int offs, const char *data, int dlen);
+
+//------------------------------------------------------------------------------
+//! Return the filter size and number of hash functions that best hold the
+//! indicated number of paths using the indicated number of bits per path.
+//------------------------------------------------------------------------------
+
+static
+unsigned int         Sizing(long long nPaths, int bitsPer, int &hashes);
+
+//------------------------------------------------------------------------------
+//! Test whether a path, given its hash, may have been added to the filter.
+//------------------------------------------------------------------------------
+
+bool                 Test(unsigned long long hVal) const;
+
+//------------------------------------------------------------------------------
+//! Return true if a filter of the indicated size may be constructed.
+//------------------------------------------------------------------------------
+
+static bool          Valid(unsigned int bits, int hashes)
+                          {return bits >= minBits && bits <= maxBits
+                               && !(bits & (bits-1))
+                               && hashes > 0 && hashes <= maxHash;
+                          }
+
+//------------------------------------------------------------------------------
+//! Constructor and destructor. The size must be valid (see Valid()).
+//------------------------------------------------------------------------------
+
+                     XrdCmsBloom(unsigned int bits, int hashes);
+                    ~XrdCmsBloom() {delete [] Bits;}
+
+private:
+
+unsigned char *Bits;
+unsigned int   nBits;
+unsigned int   bMask;
+int            nHash;
+};
+#endif
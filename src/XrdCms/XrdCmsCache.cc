@@ -29,6 +29,7 @@
 /******************************************************************************/
   
 #include <cstdio>
+#include <string>
 #include <sys/types.h>
 
 #include "XrdCms/XrdCmsCache.hh"
@@ -61,15 +62,16 @@ class XrdCmsCacheJob : XrdJob
 {
 public:
 
-void   DoIt() {Cache.Recycle(myList); delete this;}
+void   DoIt() {Cache.Recycle(myShard, myList); delete this;}
 
-       XrdCmsCacheJob(XrdCmsKeyItem *List)
-                     : XrdJob("cache scrubber"), myList(List) {}
+       XrdCmsCacheJob(XrdCmsCache::Shard *sP, XrdCmsKeyItem *List)
+                     : XrdJob("cache scrubber"), myShard(sP), myList(List) {}
       ~XrdCmsCacheJob() {}
 
 private:
 
-XrdCmsKeyItem *myList;
+XrdCmsCache::Shard *myShard;
+XrdCmsKeyItem      *myList;
 };
 
 /******************************************************************************/
@@ -108,7 +110,11 @@ void *XrdCmsStartTickTock(void *carg)
 //                 DLTtime seconds in the future. The entry window is set 
 //                 to the current window.
 // Opts  Advisory: The call is ignored since we do not keep information about
-//                 paths that were never asked for.
+//                 paths that were never asked for. However, if the path is in
+//                 the nil list it was asked for and is added as complete.
+
+// Either way the path, and the directories above it when mask != 0, are
+// removed from the nil list as they now exist or are about to be queried.
 
 // Returns True    If this is the first time location information was added
 //                 to the entry.
@@ -116,18 +122,25 @@ void *XrdCmsStartTickTock(void *carg)
   
 int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Shard &sP = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
+   bool wasNil = false;
 
 // Serialize processing
 //
-   myMutex.Lock();
+   sP.Mutex.Lock();
+
+// The path is no longer known to be missing
+//
+   if (nilMax && sP.Nils.Del(Sel.Path.Val, Sel.Path.Len))
+      {sP.NilDrops++; wasNil = true; NilCount(sP);}
 
 // Check for fast path processing
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = sP.CTable.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -138,7 +151,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
            iP->Loc.TOD_B = BClock;
-           iP->Key.TOD = Tock;
+           iP->Key.TOD = sP.Tock;
           } else {
            xmask = iP->Loc.pfvec;
            if (Sel.Opts & XrdCmsSelect::Pending) iP->Loc.pfvec |= mask;
@@ -154,14 +167,14 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
                       if (iP->Loc.roPend) Dispatch(Sel, iP, iP->Loc.roPend, 0);
                      }
           }
-      } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
-                {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+      } else if (!(Sel.Opts & XrdCmsSelect::Advisory) || (wasNil && mask))
+                {Sel.Path.TOD = sP.Tock;
+                 if ((iP = sP.CTable.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
                      iP->Loc.TOD_B    = BClock;
                      iP->Loc.qfvec    = 0;
-                     iP->Loc.deadline = QDelay + time(0);
+                     iP->Loc.deadline = (wasNil && mask ? 0 : QDelay + time(0));
                      iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
                      Sel.Path.Ref     = iP->Key.Ref;
                      Sel.Path.TODRef  = iP; isnew = 1;
@@ -170,7 +183,8 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
+   if (nilMax && mask) NilUp(Sel.Path.Val, Sel.Path.Len);
    return isnew;
 }
   
@@ -190,29 +204,30 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Shard &sP = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    int gone4good;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.Mutex.Lock();
 
 // Look up the entry and remove server
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = sP.CTable.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
            if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
+           &&  sP.Pool.Unload(iP) && !sP.CTable.Recycle(iP))
               Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    return gone4good;
 }
   
@@ -227,23 +242,29 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 //                  has passed, it is nullified and 1 is returned. Otherwise,
 //                  -1 is returned indicating a query is in progress.
 
-// Entry not found: FALSE is returned.
+// Entry not found: If the path is in the nil list, location information is
+//                  nullified and 1 is returned. Otherwise, FALSE is returned.
+
+// When a nil list is kept, an entry whose query completed without finding the
+// file anywhere is moved to the nil list.
   
 int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Shard &sP = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t bVec;
    int retc;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   sP.Mutex.Lock();
 
 // Look up the entry and return location information
 //
-   if ((iP = CTable.Find(Sel.Path)))
-      {if ((bVec = (iP->Loc.TOD_B < BClock 
-                 ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
+   if ((iP = sP.CTable.Find(Sel.Path)))
+      {sP.Hits++;
+       if ((bVec = (iP->Loc.TOD_B < BClock 
+                 ? getBVec(sP, iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
           {iP->Loc.hfvec &= ~bVec; 
            iP->Loc.pfvec &= ~bVec;
            iP->Loc.qfvec &= ~mask;
@@ -262,15 +283,114 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
        Sel.Vec.pf      = okVec & iP->Loc.pfvec;
        Sel.Vec.bf      = okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
        Sel.Path.Ref    = iP->Key.Ref;
-      } else retc = 0;
+
+       if (nilMax && retc == 1 && iP->Loc.hfvec == 0 && !Sel.Vec.bf)
+          iP = NilAdd(sP, Sel, iP);
+      } else if (nilMax
+             &&  sP.Nils.Find(Sel.Path.Val, Sel.Path.Len, time(0), BClock))
+                {sP.NilHits++; retc = 1;
+                 Sel.Vec.hf = Sel.Vec.pf = Sel.Vec.bf = 0;
+                } else {sP.Miss++; retc = 0;}
+   if (nilMax) NilCount(sP);
 
 // All done
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
 
+/******************************************************************************/
+/* Public                        N i l F i l e                                */
+/******************************************************************************/
+
+// This method records that a file is on no node, as when every node that
+// could have it says otherwise in its namespace summary. The entry is added,
+// if need be, with no location information and no update deadline so that it
+// is immediately complete. It is held as any other entry without locations
+// unless a nil list is kept, in which case the path is moved there.
+
+// Returns True    If the entry is in the cache.
+// Returns False   Otherwise.
+  
+int XrdCmsCache::NilFile(XrdCmsSelect &Sel)
+{
+   Shard &sP = getShard(Sel.Path);
+   XrdCmsKeyItem *iP;
+
+// Serialize processing
+//
+   sP.Mutex.Lock();
+
+// Find or add the entry
+//
+   if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = sP.CTable.Find(Sel.Path)))
+         Sel.Path.Ref = iP->Key.Ref;
+
+   if (nilMax)
+      {NilAdd(sP, Sel, iP);
+       sP.Mutex.UnLock();
+       return 1;
+      }
+
+   if (!iP)
+      {Sel.Path.TOD = sP.Tock;
+       if ((iP = sP.CTable.Add(Sel.Path)))
+          {Sel.Path.Ref    = iP->Key.Ref;
+           Sel.Path.TODRef = iP;
+          }
+      } else iP->Key.TOD = sP.Tock;
+
+// Nullify the location information
+//
+   if (iP)
+      {iP->Loc.hfvec    = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
+       iP->Loc.TOD_B    = BClock;
+       iP->Loc.deadline = 0;
+       iP->Loc.lifeline = nilTMO + time(0);
+      }
+
+// All done
+//
+   sP.Mutex.UnLock();
+   return iP != 0;
+}
+
+/******************************************************************************/
+/* Public                        N i l D r o p                                */
+/******************************************************************************/
+
+// This method forgets that a path is on no node because it, or something under
+// it, now exists (e.g., a directory was made or a file renamed). Since the
+// paths under a path may be in any shard, inTree checks every shard.
+  
+void XrdCmsCache::NilDrop(const char *path, int plen, bool inTree)
+{
+   if (!nilMax) return;
+
+// Forget the path and, if so wanted, everything under it
+//
+   if (inTree)
+      {for (int i = 0; i < Shards; i++)
+           {ShardTab[i].Mutex.Lock();
+            ShardTab[i].NilDrops += ShardTab[i].Nils.DelTree(path, plen);
+            NilCount(ShardTab[i]);
+            ShardTab[i].Mutex.UnLock();
+           }
+      } else {
+       XrdCmsKey theKey(const_cast<char *>(path), plen);
+       Shard &sP = getShard(theKey);
+       sP.Mutex.Lock();
+       if (sP.Nils.Del(path, plen)) {sP.NilDrops++; NilCount(sP);}
+       sP.Mutex.UnLock();
+      }
+
+// The directories above the path now exist as well
+//
+   NilUp(path, plen);
+}
+
 /******************************************************************************/
 /* Public                        U n k F i l e                                */
 /******************************************************************************/
@@ -278,11 +398,12 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
+   Shard &sP = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   sP.Mutex.Lock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -294,7 +415,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -313,7 +434,8 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   Shard &sP = getShard(Sel.Path);
+   sP.Mutex.Lock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +450,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   sP.Mutex.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -345,11 +467,11 @@ void XrdCmsCache::Bounce(SMask_t smask, int SNum)
 
 // Simply indicate that this server bounced
 //
-   myMutex.Lock();
+   LockAll();
    Bounced[SNum] = ++BClock;
    okVec |= smask;
    if (SNum > vecHi) vecHi = SNum;
-   myMutex.UnLock();
+   UnLockAll();
 }
 
 /******************************************************************************/
@@ -366,18 +488,19 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
 
 // Remove the node from the list of valid nodes
 //
-   myMutex.Lock();
+   LockAll();
    Bounced[SNum] = 0;
    okVec &= nmask;
    vecHi = xHi;
-   myMutex.UnLock();
+   UnLockAll();
 }
 
 /******************************************************************************/
 /* public                           I n i t                                   */
 /******************************************************************************/
   
-int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold)
+int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold,
+                      int nxMax)
 {
    XrdCmsKeyItem *iP;
    pthread_t tid;
@@ -392,6 +515,11 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
    DLTime = fxDelay; QDelay = fxQuery;
    if (!(Tick = fxHold/XrdCmsKeyItem::TickRate)) Tick = 1;
 
+// Each shard is aged in turn, so the clock thread wakes up once per shard in
+// each tick.
+//
+   Nap = Tick*1000/Shards;
+
 // Set the timeout for nil entries if one needs to be set. Since this may cause
 // an infinite lookup delay, adjust it to be no less than 10 minutes longer
 // than the overall deadline for lookups (QDelay/fxQuery).
@@ -401,6 +529,15 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
        nilTMO = static_cast<unsigned int>(nxHold);
       }
 
+// If the number of paths known to be on no node is limited, they are kept in
+// a nil list per shard for as long as entries without locations are held.
+//
+   if (nxMax > 0)
+      {nilLife = (nilTMO ? nilTMO : fxHold);
+       nilMax  = (nxMax + Shards - 1) / Shards;
+       for (int i = 0; i < Shards; i++) ShardTab[i].Nils.SetMax(nilMax);
+      }
+
 // Start the clock thread
 //
    if (XrdSysThread::Run(&tid, XrdCmsStartTickTock, (void *)this,
@@ -409,17 +546,39 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
        return 0;
       }
 
-// Get the first reserve of cache items
+// Get the first reserve of cache items for each shard
 //
-   iP = XrdCmsKeyItem::Alloc(0);
-   XrdCmsKeyItem::Unload((unsigned int)0);
-   iP->Recycle();
+   for (int i = 0; i < Shards; i++)
+       {iP = ShardTab[i].Pool.Alloc(0);
+        ShardTab[i].Pool.Unload((unsigned int)0);
+        ShardTab[i].Pool.Recycle(iP);
+       }
 
 // All done
 //
    return 1;
 }
 
+/******************************************************************************/
+/* public                     S t a t i s t i c s                             */
+/******************************************************************************/
+
+void XrdCmsCache::Statistics(Info &Data)
+{
+   Data = Info();
+   for (int i = 0; i < Shards; i++)
+       {ShardTab[i].Mutex.Lock();
+        Data.Hits  += ShardTab[i].Hits;
+        Data.Miss  += ShardTab[i].Miss;
+        Data.Evict += ShardTab[i].Evict;
+        Data.NilHits  += ShardTab[i].NilHits;
+        Data.NilAdds  += ShardTab[i].NilAdds;
+        Data.NilDrops += ShardTab[i].NilDrops;
+        Data.NilEvict += ShardTab[i].NilEvict;
+        ShardTab[i].Mutex.UnLock();
+       }
+}
+
 /******************************************************************************/
 /* public                       T i c k T o c k                               */
 /******************************************************************************/
@@ -427,16 +586,22 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 void *XrdCmsCache::TickTock()
 {
    XrdCmsKeyItem *iP;
-
-// Simply adjust the clock and trim old entries
-//
-   do {XrdSysTimer::Snooze(Tick);
-       myMutex.Lock();
-       Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
-       Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
-       myMutex.UnLock();
-       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
+   int sNum = 0;
+
+// Simply adjust the clock and trim old entries (including expired nil list
+// entries). We do this one shard at a time
+// so that only one shard is ever locked and the work is spread over the tick.
+//
+   do {XrdSysTimer::Wait(Nap ? Nap : 1);
+       Shard *sP = &ShardTab[sNum];
+       sNum = (sNum+1) % Shards;
+       sP->Mutex.Lock();
+       sP->Tock = (sP->Tock+1) & XrdCmsKeyItem::TickMask;
+       sP->Bhistory[sP->Tock].Start = sP->Bhistory[sP->Tock].End = 0;
+       iP = sP->Pool.Unload(sP->Tock);
+       if (nilMax) {sP->NilEvict += sP->Nils.Trim(time(0)); NilCount(*sP);}
+       sP->Mutex.UnLock();
+       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(sP, iP));
       } while(1);
 
 // Keep compiler happy
@@ -502,7 +667,7 @@ void XrdCmsCache::Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *iP,
 /*                               g e t B V e c                                */
 /******************************************************************************/
   
-SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
+SMask_t XrdCmsCache::getBVec(Shard &sP, unsigned int TODa, unsigned int &TODb)
 {
    EPNAME("getBVec");
    SMask_t BVec(0);
@@ -510,28 +675,91 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 
 // See if we can use a previously calculated bVec
 //
-   if (Bhistory[TODa].End == BClock && Bhistory[TODa].Start <= TODb)
-      {Bhits++; TODb = BClock; return Bhistory[TODa].Vec;}
+   if (sP.Bhistory[TODa].End == BClock && sP.Bhistory[TODa].Start <= TODb)
+      {sP.Bhits++; TODb = BClock; return sP.Bhistory[TODa].Vec;}
 
 // Calculate the new vector
 //
    for (i = 0; i <= vecHi; i++)
-       if (TODb < Bounced[i]) BVec |= 1ULL << i;
-
-   Bhistory[TODa].Vec   = BVec;
-   Bhistory[TODa].Start = TODb;
-   Bhistory[TODa].End   = BClock;
-   TODb                 = BClock;
-   Bmiss++;
-   if (!(Bmiss & 0xff)) DEBUG("hits=" <<Bhits <<" miss=" <<Bmiss);
+       if (TODb < Bounced[i]) BVec |= SMask_t::Bit(i);
+
+   sP.Bhistory[TODa].Vec   = BVec;
+   sP.Bhistory[TODa].Start = TODb;
+   sP.Bhistory[TODa].End   = BClock;
+   TODb                    = BClock;
+   sP.Bmiss++;
+   if (!(sP.Bmiss & 0xff)) DEBUG("hits=" <<sP.Bhits <<" miss=" <<sP.Bmiss);
    return BVec;
 }
 
+/******************************************************************************/
+/*                               L o c k A l l                                */
+/******************************************************************************/
+
+// Shards are always locked in the same order so this cannot deadlock
+
+void XrdCmsCache::LockAll()
+{
+   for (int i = 0; i < Shards; i++) ShardTab[i].Mutex.Lock();
+}
+
+/******************************************************************************/
+/*                                N i l A d d                                 */
+/******************************************************************************/
+
+// Add the path to the nil list and recycle its entry, if any. Clients still
+// waiting on the entry are told that the file was not found. The shard must
+// be locked. Returns the entry if it could not be recycled.
+
+XrdCmsKeyItem *XrdCmsCache::NilAdd(Shard &sP, XrdCmsSelect &Sel,
+                                   XrdCmsKeyItem *iP)
+{
+   sP.NilEvict += sP.Nils.Add(Sel.Path.Val, Sel.Path.Len,
+                              nilLife + time(0), BClock);
+   sP.NilAdds++;
+   NilCount(sP);
+
+   if (iP && sP.Pool.Unload(iP))
+      {if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
+       if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
+       if (!sP.CTable.Recycle(iP))
+          Say.Emsg("NilAdd", "Delete failed for", iP->Key.Val);
+       iP = 0;
+      }
+   Sel.Path.TODRef = iP;
+   return iP;
+}
+
+/******************************************************************************/
+/*                                 N i l U p                                  */
+/******************************************************************************/
+
+// Remove every directory above the path from the nil list. Each may be in a
+// different shard so the shards are locked one at a time. Nothing needs to be
+// done when every nil list is empty (a directory added to one while we look
+// is no different than one added just after).
+
+void XrdCmsCache::NilUp(const char *path, int plen)
+{
+   if (!nilNum.load(std::memory_order_relaxed)) return;
+
+   std::string dir(path, plen);
+
+   for (int dlen = plen-1; dlen > 0; dlen--)
+       {if (dir[dlen] != '/' || dir[dlen-1] == '/') continue;
+        XrdCmsKey theKey(&dir[0], dlen);
+        Shard &sP = getShard(theKey);
+        sP.Mutex.Lock();
+        if (sP.Nils.Del(&dir[0], dlen)) {sP.NilDrops++; NilCount(sP);}
+        sP.Mutex.UnLock();
+       }
+}
+
 /******************************************************************************/
 /*                               R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
+void XrdCmsCache::Recycle(Shard *sP, XrdCmsKeyItem *theList)
 {
    XrdCmsKeyItem *iP;
    char msgBuff[100];
@@ -543,28 +771,38 @@ void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
         {theList = iP->Key.TODRef;
          if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
          if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
+         sP->Mutex.Lock(); sP->CTable.Recycle(iP); sP->Mutex.UnLock();
          numRecycled++;
         }
 
 // See if we have enough items in reserve
 //
-   myMutex.Lock();
-   XrdCmsKeyItem::Stats(numHave, numFree, numNull);
-   if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
+   sP->Mutex.Lock();
+   sP->Evict += numRecycled;
+   sP->Pool.Stats(numHave, numFree, numNull);
+   if (numFree < XrdCmsKeyPool::minFree)
+      {sP->Mutex.UnLock();
        if (!(numNull /= 4)) numNull = 1;
-       numHave += XrdCmsKeyItem::minAlloc * numNull;
+       numHave += XrdCmsKeyPool::minAlloc * numNull;
        while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
+            {sP->Mutex.Lock();
+             numFree = sP->Pool.Replenish();
+             sP->Mutex.UnLock();
             }
-      } else myMutex.UnLock();
+      } else sP->Mutex.UnLock();
 
 // Log the stats
 //
-   sprintf(msgBuff, "%d cache items; %d allocated %d free",
-           numRecycled, numHave, numFree);
+   sprintf(msgBuff, "%d cache items; %d allocated %d free in shard %d",
+           numRecycled, numHave, numFree, static_cast<int>(sP - ShardTab));
    Say.Emsg("Recycle", msgBuff);
 }
+
+/******************************************************************************/
+/*                             U n L o c k A l l                              */
+/******************************************************************************/
+
+void XrdCmsCache::UnLockAll()
+{
+   for (int i = Shards-1; i >= 0; i--) ShardTab[i].Mutex.UnLock();
+}
@@ -30,12 +30,14 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <cstring>
   
 #include "Xrd/XrdJob.hh"
 #include "Xrd/XrdScheduler.hh"
 #include "XrdCms/XrdCmsKey.hh"
 #include "XrdCms/XrdCmsNash.hh"
+#include "XrdCms/XrdCmsNilList.hh"
 #include "XrdCms/XrdCmsPList.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdCms/XrdCmsSelect.hh"
@@ -61,6 +63,16 @@ int         DelFile(XrdCmsSelect &Sel, SMask_t mask);
 //
 int         GetFile(XrdCmsSelect &Sel, SMask_t mask);
 
+// NilFile() adds or resets an entry for a file known to be on no node without
+//           a query (see method for details). Returns true if it has an entry.
+//
+int         NilFile(XrdCmsSelect &Sel);
+
+// NilDrop() forgets that a path, and the directories above it, are on no node.
+//           When inTree is true, every path under the path is forgotten too.
+//
+void        NilDrop(const char *path, int plen, bool inTree=false);
+
 // UnkFile() updates the unqueried vector and returns 1 upon success, 0 o/w.
 //
 int         UnkFile(XrdCmsSelect &Sel, SMask_t mask);
@@ -70,50 +82,114 @@ int         UnkFile(XrdCmsSelect &Sel, SMask_t mask);
 //
 int         WT4File(XrdCmsSelect &Sel, SMask_t mask);
 
+// Statistics() returns the cache counters summed over all shards
+//
+struct Info
+      {long long Hits;     // Lookups that found the path
+       long long Miss;     // Lookups that did not find the path
+       long long Evict;    // Paths aged out of the cache
+       long long NilHits;  // Lookups answered from the nil list
+       long long NilAdds;  // Paths added to the nil list
+       long long NilDrops; // Paths forgotten because they now exist
+       long long NilEvict; // Paths expired or displaced from the nil list
+       Info() : Hits(0), Miss(0), Evict(0),
+                NilHits(0), NilAdds(0), NilDrops(0), NilEvict(0) {}
+      };
+
+void        Statistics(Info &Data);
+
 void        Bounce(SMask_t smask, int SNum);
 
 void        Drop(SMask_t mask, int SNum, int xHi);
 
-int         Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold);
+int         Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold,
+                 int nxMax=0);
 
 void       *TickTock();
 
 static const int min_nxTime = 60;
 
-            XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
-                            nilTMO(0),
-                            DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
+            XrdCmsCache() : okVec(0), Tick(8*60*60), Nap(1000), BClock(0),
+                            nilTMO(0), nilLife(0), nilMax(0), nilNum(0),
+                            DLTime(5), QDelay(5), vecHi(-1),
                             isDFS(0)
-                          {memset(Bounced,  0, sizeof(Bounced));
-                           memset(Bhistory, 0, sizeof(Bhistory));
-                          }
+                          {memset(Bounced,  0, sizeof(Bounced));}
            ~XrdCmsCache() {}   // Never gets deleted
 
 private:
 
+// The cache is split into shards by path hash. Each shard has its own lock,
+// hash table, item pool, and clock so that lookups and updates of different
+// paths do not contend and aging locks only one shard at a time. When a limit
+// is set, paths found on no node are moved to the shard's nil list so that the
+// number of them that is remembered is bounded; nilNum counts the paths in
+// all of the nil lists so that NilUp() can skip the shards when there are
+// none, the usual case for a file that is found. The shared node information
+// (Bounced, BClock, okVec, vecHi) changes rarely and is only changed with
+// every shard locked.
+//
+static const int ShardBits = 5;
+static const int Shards    = 1 << ShardBits;
+
+struct Shard
+      {XrdSysMutex   Mutex;
+       XrdCmsKeyPool Pool;
+       XrdCmsNash    CTable;
+       struct {SMask_t      Vec;
+               unsigned int Start;
+               unsigned int End;
+              }      Bhistory[XrdCmsKeyItem::TickRate];
+       unsigned int  Tock;
+                int  Bhits;
+                int  Bmiss;
+       long long     Hits;
+       long long     Miss;
+       long long     Evict;
+       XrdCmsNilList Nils;
+                int  NilNum;
+       long long     NilHits;
+       long long     NilAdds;
+       long long     NilDrops;
+       long long     NilEvict;
+
+       Shard() : CTable(Pool, 610, 987), Tock(0), Bhits(0), Bmiss(0),
+                 Hits(0), Miss(0), Evict(0), NilNum(0),
+                 NilHits(0), NilAdds(0), NilDrops(0), NilEvict(0)
+               {memset((void *)Bhistory, 0, sizeof(Bhistory));}
+      };
+
 void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
 void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
                        short roQ, short rwQ);
-SMask_t       getBVec(unsigned int todA, unsigned int &todB);
-void          Recycle(XrdCmsKeyItem *theList);
-
-struct  {SMask_t      Vec;
-         unsigned int Start;
-         unsigned int End;
-        }             Bhistory[XrdCmsKeyItem::TickRate];
-
-XrdSysMutex   myMutex;
-XrdCmsNash    CTable;
+SMask_t       getBVec(Shard &sP, unsigned int todA, unsigned int &todB);
+Shard        &getShard(XrdCmsKey &Key)
+                      {if (!Key.Hash) Key.setHash();
+                       return ShardTab[Key.Hash >> (32 - ShardBits)];
+                      }
+void          LockAll();
+XrdCmsKeyItem *NilAdd(Shard &sP, XrdCmsSelect &Sel, XrdCmsKeyItem *iP);
+void          NilCount(Shard &sP) // Shard must be locked
+                      {int n = sP.Nils.Num();
+                       if (n != sP.NilNum) {nilNum += n - sP.NilNum;
+                                            sP.NilNum = n;
+                                           }
+                      }
+void          NilUp(const char *path, int plen);
+void          Recycle(Shard *sP, XrdCmsKeyItem *theList);
+void          UnLockAll();
+
+Shard         ShardTab[Shards];
 unsigned int  Bounced[STMax];
 SMask_t       okVec;
 unsigned int  Tick;
-unsigned int  Tock;
+unsigned int  Nap;
 unsigned int  BClock;
          int  nilTMO;
+         int  nilLife;
+         int  nilMax;
+std::atomic<int> nilNum;
          int  DLTime;
          int  QDelay;
-         int  Bhits;
-         int  Bmiss;
          int  vecHi;
          int  isDFS;
 };
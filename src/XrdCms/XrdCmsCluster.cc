@@ -53,6 +53,8 @@
 #include "XrdCms/XrdCmsRRQ.hh"
 #include "XrdCms/XrdCmsState.hh"
 #include "XrdCms/XrdCmsSelect.hh"
+#include "XrdCms/XrdCmsSelNode.hh"
+#include "XrdCms/XrdCmsSummary.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 #include "XrdCms/XrdCmsTypes.hh"
 
@@ -116,6 +118,7 @@ XrdCmsCluster::XrdCmsCluster()
      SelWtot = 0;
      SelRtot = 0;
      SelTcnt = 0;
+     SelNext = 0;
      peerHost  = 0;
      peerMask  = ~peerHost;
 }
@@ -243,8 +246,13 @@ XrdCmsNode *XrdCmsCluster::Add(XrdLink *lp, int port, int Status, int sport,
           {Config.SUPCount=tmp; CmsState.Set(tmp);}
       } else nP->isMan |= 0x02;
 
-// Compute new peer mask, as needed
+// Any namespace summary the node sent before no longer applies
 //
+   if (!Hidden) Summary.Drop(Slot);
+
+// Rank the node for selection and compute new peer mask, as needed
+//
+   if (!Hidden) Rank(nP);
    if (nP->isPeer) peerHost |=  nP->NodeMask;
       else         peerHost &= ~nP->NodeMask;
    peerMask = ~peerHost;
@@ -383,12 +391,13 @@ SMask_t XrdCmsCluster::Broadcast(SMask_t smask, const struct iovec *iod,
    STMutex.ReadLock(); // Sufficient to prevent modifications
    bmask = smask & peerMask;
 
-// Run through the table looking for nodes to send messages to. We don't need
-// the node lock for this but we do need to up the reference count to keep the
-// node pointer valid for the duration of the send() (may or may not block).
+// Run through the nodes in the mask looking for nodes to send messages to. We
+// don't need the node lock for this but we do need to up the reference count
+// to keep the node pointer valid for the duration of the send() (may or may
+// not block). Note that a node's slot number is the number of its mask bit.
 //
-   for (i = 0; i <= STHi; i++)
-       {if ((nP = NodeTab[i]) && nP->isNode(bmask))
+   for (i = bmask.First(); i >= 0 && i <= STHi; i = bmask.Next(i))
+       {if ((nP = NodeTab[i]))
            {if (nP->isOffline) unQueried |= nP->Mask();
                else {nP->Ref();
                      STMutex.UnLock();
@@ -545,8 +554,8 @@ XrdCmsSelected *XrdCmsCluster::List(SMask_t mask, CmsLSOpts opts, bool &oksel)
 //
    oksel = false;
    STMutex.ReadLock();
-   for (i = 0; i <= STHi; i++)
-        if ((nP=NodeTab[i]) && (nP->NodeMask & mask))
+   for (i = mask.First(); i >= 0 && i <= STHi; i = mask.Next(i))
+        if ((nP=NodeTab[i]))
            {oksel = true;
             if (retDest)
                {     if (nP->netIF.HasDest(ifType)) ifGet = ifType;
@@ -650,12 +659,16 @@ int XrdCmsCluster::Locate(XrdCmsSelect &Sel)
 // First check if we have seen this file before. If so, get nodes that have it.
 // A Refresh request kills this because it's as if we hadn't seen it before.
 // If the file was found but either a query is in progress or we have a server
-// bounce; the client must wait.
-//
-   if (Sel.Opts & XrdCmsSelect::Refresh 
-   || !(retc = Cache.GetFile(Sel, pinfo.rovec)))
+// bounce; the client must wait. Otherwise, only the nodes whose namespace
+// summary says they may have the file need be asked and if there are none
+// the file is not here.
+//
+   qfVec = pinfo.rovec;
+   if (Sel.Opts & XrdCmsSelect::Refresh
+   || (!(retc = Cache.GetFile(Sel, pinfo.rovec))
+   &&  !(retc = NoneHave(Sel, qfVec))))
       {Cache.AddFile(Sel, 0);
-       qfVec = pinfo.rovec; Sel.Vec.hf = 0;
+       Sel.Vec.hf = 0;
       } else qfVec = Sel.Vec.bf;
 
 // Compute the delay, if any
@@ -860,6 +873,7 @@ void XrdCmsCluster::Remove(const char *reason, XrdCmsNode *theNode, int immed)
    && (altNode = theNode->cidP->RemNode(theNode)))
       {if (altNode->isBound) NodeCnt++;
        NodeTab[NodeID] = altNode;
+       Rank(altNode);
        if (Config.asManager())
           CmsState.Update(XrdCmsState::Counts,
                           altNode->isBad & XrdCmsNode::isSuspend ? 0 :  1,
@@ -933,7 +947,7 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
    XrdCmsPInfo  pinfo;
    const char  *Amode;
    int dowt = 0, retc = 0, isRW, fRD, noSel = (Sel.Opts & XrdCmsSelect::Defer);
-   SMask_t amask, smask, pmask;
+   SMask_t amask, smask, pmask, qmask;
 
 // Establish some local options
 //
@@ -988,10 +1002,13 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
 // have servers that we can query regarding the file. Note that for files being
 // opened in write mode, only one writable copy may exist unless this is a
 // meta-operation (e.g., remove) in which case the file itself remain unmodified
-// or a replica request, in which case we select a new target server.
+// or a replica request, in which case we select a new target server. A file
+// that no node's namespace summary admits to is treated as found nowhere.
 //
+   qmask = pinfo.rovec;
    if (!(Sel.Opts & XrdCmsSelect::Refresh)
-   &&   (retc = Cache.GetFile(Sel, pinfo.rovec)))
+   &&   ((retc = Cache.GetFile(Sel, pinfo.rovec))
+   ||    (retc = NoneHave(Sel, qmask))))
       {if (isRW)
           {     if (retc<0) return Config.LUPDelay;
               else if (Sel.Opts & XrdCmsSelect::Replica)
@@ -1022,7 +1039,7 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
        if (Sel.Vec.hf & Sel.nmask) Cache.UnkFile(Sel, Sel.nmask);
       } else {
        Cache.AddFile(Sel, 0); 
-       Sel.Vec.bf = pinfo.rovec; 
+       Sel.Vec.bf = qmask;
        Sel.Vec.hf = Sel.Vec.pf = pmask = smask = 0;
        retc = 0;
       }
@@ -1085,10 +1102,8 @@ int XrdCmsCluster::Select(XrdCmsSelect &Sel)
 int XrdCmsCluster::Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
                           int isrw, int isMulti, int ifWant)
 {
-   static const SMask_t smLow(255);
    XrdCmsSelector selR;
    XrdCmsNode *nP = 0;
-   SMask_t tmask;
    int Snum = 0;
    XrdNetIF::ifType nType = static_cast<XrdNetIF::ifType>(ifWant);
 
@@ -1125,9 +1140,7 @@ int XrdCmsCluster::Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
 // In shared-nothing systems the incoming mask will only have a single node.
 // Compute the a single node number that is contained in the mask.
 //
-   do {if (!(tmask = pmask & smLow)) Snum += 8;
-         else {while((tmask = tmask>>1)) Snum++; break;}
-      } while((pmask = pmask >> 8));
+   Snum = pmask.First();
 
 // See if the node passes muster
 //
@@ -1222,8 +1235,8 @@ void XrdCmsCluster::Space(SpaceData &sData, SMask_t smask)
 
 // Run through the table getting space information
 //
-   for (i = 0; i <= STHi; i++)
-       if ((nP = NodeTab[i]) && nP->isNode(bmask) && !(nP->isOffline))
+   for (i = bmask.First(); i >= 0 && i <= STHi; i = bmask.Next(i))
+       if ((nP = NodeTab[i]) && !(nP->isOffline))
           {if (doAll || !sData.Total) 
               {sData.Total += nP->DiskTotal;
                sData.TotFr += nP->DiskFree;
@@ -1284,12 +1297,18 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
    static const char statfmt5[] =
           "<frq><add>%lld<d>%lld</d></add><rsp>%lld<m>%lld</m></rsp>"
           "<lf>%lld</lf><ls>%lld</ls><rf>%lld</rf><rs>%lld</rs></frq>";
+   static const char statfmt6[] =
+          "<cch><hit>%lld</hit><miss>%lld</miss><evict>%lld</evict>"
+          "<nil><hit>%lld</hit><add>%lld</add><drop>%lld</drop>"
+          "<evict>%lld</evict></nil></cch>";
 
    static int AddFrq = (Config.RepStats & XrdCmsConfig::RepStat_frq);
+   static int AddCch = (Config.RepStats & XrdCmsConfig::RepStat_cch);
    static int AddShr = (Config.RepStats & XrdCmsConfig::RepStat_shr)
                        && Config.asMetaMan();
 
    XrdCmsRRQ::Info Frq;
+   XrdCmsCache::Info Cch;
    XrdCmsSelected *sp;
    int mlen, tlen, n = 0;
    char shrBuff[80], stat[6], *stp;
@@ -1312,12 +1331,14 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
           (sizeof(statfmt2) + 10*2 + 256 + 16) * STMax + sizeof(statfmt4);
        if (AddShr) n += sizeof(statfmt3) + 12;
        if (AddFrq) n += sizeof(statfmt4) + (10*8);
+       if (AddCch) n += sizeof(statfmt6) + (20*3);
        return n;
       }
 
 // Get the statistics
 //
    if (AddFrq) RRQ.Statistics(Frq);
+   if (AddCch) Cache.Statistics(Cch);
    mngrsp.sp = sp = List(FULLMASK, LS_NULL, oksel);
 
 // Count number of nodes we have
@@ -1362,6 +1383,12 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
        bfr += mlen; bln -= mlen; tlen += mlen;
       }
 
+   if (AddCch && bln > 0)
+      {mlen = snprintf(bfr, bln, statfmt6, Cch.Hits, Cch.Miss, Cch.Evict,
+                       Cch.NilHits, Cch.NilAdds, Cch.NilDrops, Cch.NilEvict);
+       bfr += mlen; bln -= mlen; tlen += mlen;
+      }
+
 // See if we overflowed. otherwise finish up
 //
    if (sp || bln < (int)sizeof(statfmt0)) return 0;
@@ -1445,6 +1472,9 @@ int XrdCmsCluster::Drop(int sent, int sinst, XrdCmsDrop *djp)
 // Cleanup status
 //
    NodeTab[sent] = 0;
+   loadRank.Set(sent, -1);
+   massRank.Set(sent, -1);
+   Summary.Drop(sent);
    nP->isOffline = 1; // STMutex is locked in write mode
    nP->DropTime  = 0;
    nP->DropJob   = 0;
@@ -1494,30 +1524,7 @@ int XrdCmsCluster::Drop(int sent, int sinst, XrdCmsDrop *djp)
 
 int XrdCmsCluster::Multiple(SMask_t mVec)
 {
-   static const unsigned long long Left32  = 0xffffffff00000000LL;
-   static const unsigned long long Right32 = 0x00000000ffffffffLL;
-   static const unsigned long long Left16  = 0x00000000ffff0000LL;
-   static const unsigned long long Right16 = 0x000000000000ffffLL;
-   static const unsigned long long Left08  = 0x000000000000ff00LL;
-   static const unsigned long long Right08 = 0x00000000000000ffLL;
-   static const unsigned long long Left04  = 0x00000000000000f0LL;
-   static const unsigned long long Right04 = 0x000000000000000fLL;
-//                                0 1 2 3 4 5 6 7 8 9 A B C D E F
-   static const int isMult[16] = {0,0,0,1,0,1,1,1,0,1,1,1,1,1,1,1};
-
-   if (mVec & Left32) {if (mVec & Right32) return 1;
-                          else mVec = mVec >> 32LL;
-                      }
-   if (mVec & Left16) {if (mVec & Right16) return 1;
-                          else mVec = mVec >> 16LL;
-                      }
-   if (mVec & Left08) {if (mVec & Right08) return 1;
-                          else mVec = mVec >>  8LL;
-                      }
-   if (mVec & Left04) {if (mVec & Right04) return 1;
-                          else mVec = mVec >>  4LL;
-                      }
-   return isMult[mVec];
+   return mVec.Count() > 1;
 }
   
 /******************************************************************************/
@@ -1526,19 +1533,41 @@ int XrdCmsCluster::Multiple(SMask_t mVec)
   
 bool XrdCmsCluster::maxBits(SMask_t mVec, int mbits)
 {
-   int count = 0;
+   return mVec.Count() >= mbits;
+}
 
-// Count bits. This is the fastest way assuming few bits are set
-//
-   while(mVec)
-        {mVec &= (mVec - 1);
-         count++;
-         if (count >= mbits) return true;
-        }
+/******************************************************************************/
+/*                              N o n e H a v e                               */
+/******************************************************************************/
 
-// Indicate we have not reached the maximum bits set
+// Reduce qmask to the nodes that may have the file according to their
+// namespace summaries. If none may, record that the file is nowhere so that
+// no client waits for an answer to a query that is never made.
 //
-   return false;
+int XrdCmsCluster::NoneHave(XrdCmsSelect &Sel, SMask_t &qmask)
+{
+   if ((qmask = Summary.Prune(qmask, Sel.Path.Val, Sel.Path.Len))) return 0;
+
+   Cache.NilFile(Sel);
+   Sel.Vec.hf = Sel.Vec.pf = Sel.Vec.bf = 0;
+   return 1;
+}
+
+/******************************************************************************/
+/*                                  R a n k                                   */
+/******************************************************************************/
+
+// Nodes whose loads differ by no more than the fuzz factor are treated as
+// equally loaded, so each rank is one more than the fuzz factor wide. This is
+// called without the STMutex, hence the node table check is only a screen.
+
+void XrdCmsCluster::Rank(XrdCmsNode *nP)
+{
+   int width = Config.P_fuzz + 1, slot = nP->NodeID;
+
+   if (slot < 0 || slot >= STMax || NodeTab[slot] != nP) return;
+   loadRank.Set(slot, nP->myLoad/width);
+   massRank.Set(slot, nP->myMass/width);
 }
 
 /******************************************************************************/
@@ -1583,8 +1612,7 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
    if (!(Sel.Opts & XrdCmsSelect::Pack)) selR.selPack = 0;
       else {unsigned int theHash = (Sel.Opts & XrdCmsSelect::UseAH
                                  ?  Sel.AltHash : Sel.Path.Hash);
-            SMask_t sVec = pmask;
-            for (count = 0; sVec; count++) sVec &= (sVec - 1);
+            count = pmask.Count();
             if (count > 1) selR.selPack = affsel = (theHash % count) + 1;
                else        selR.selPack = 0;
            }
@@ -1744,8 +1772,8 @@ XrdCmsNode *XrdCmsCluster::SelbyCost(SMask_t mask, XrdCmsSelector &selR)
 // Scan for a node (sp points to the selected one)
 //
    selR.Reset(); SelTcnt++;
-   for (int i = 0; i <= STHi; i++)
-       if ((np = NodeTab[i]) && (np->NodeMask & mask))
+   for (int i = mask.First(); i >= 0 && i <= STHi; i = mask.Next(i))
+       if ((np = NodeTab[i]))
           {if (!(selR.needNet &  np->hasNet))    {selR.xNoNet= true; continue;}
            selR.nPick++;
            if (np->isOffline)                    {selR.xOff  = true; continue;}
@@ -1779,44 +1807,24 @@ XrdCmsNode *XrdCmsCluster::SelbyCost(SMask_t mask, XrdCmsSelector &selR)
 /*                             S e l b y L o a d                              */
 /******************************************************************************/
 
+// The selection itself is done by XrdCmsSelNode (see there) which compares
+// every node in a small mask and otherwise picks from the least loaded rank.
+
 // Caller must have the STMutex locked. The returned node, if any, is unlocked.
   
 XrdCmsNode *XrdCmsCluster::SelbyLoad(SMask_t mask, XrdCmsSelector &selR)
 {
-    XrdCmsNode *np, *sp = 0;
-    bool Multi = false, reqSS = (selR.needSpace & XrdCmsNode::allowsSS) != 0;
+    XrdCmsRank<STMax> &rTab = (selR.needSpace ? massRank : loadRank);
+    XrdCmsSelNode<XrdCmsNode>::Parms parms = {Config.MaxLoad, Config.P_fuzz,
+                                              Config.DiskLinger, SelWidth};
+    XrdCmsNode *sp;
+    bool Multi = false;
 
 // Scan for a node (preset possible, suspended, overloaded, full, and dead)
 //
    selR.Reset(); SelTcnt++;
-   for (int i = 0; i <= STHi; i++)
-       if ((np = NodeTab[i]) && (np->NodeMask & mask))
-          {if (!(selR.needNet & np->hasNet))      {selR.xNoNet= true; continue;}
-           selR.nPick++;
-           if (np->isOffline)                     {selR.xOff  = true; continue;}
-           if (np->isBad)                         {selR.xSusp = true; continue;}
-           if (np->myLoad > Config.MaxLoad)       {selR.xOvld = true; continue;}
-           if (selR.needSpace && (np->DiskFree < np->DiskMinF
-                                  || (reqSS && np->isNoStage)))
-              {selR.xFull = true; continue;}
-           if (!sp) sp = np;
-              else{if (selR.needSpace)
-                      {if (abs(sp->myMass - np->myMass) <= Config.P_fuzz)
-                          {if (sp->RefW > (np->RefW+Config.DiskLinger)) sp=np;}
-                          else if (sp->myMass > np->myMass)             sp=np;
-                      } else {
-                       if (abs(sp->myLoad - np->myLoad) <= Config.P_fuzz)
-                          {if (selR.selPack)
-                              {if (--selR.selPack)                      sp=np;
-                                  else break;
-                              }
-                              else if (sp->RefR > np->RefR)             sp=np;
-                          }
-                          else if (sp->myLoad > np->myLoad)             sp=np;
-                      }
-                   Multi = true;
-                  }
-          }
+   sp = XrdCmsSelNode<XrdCmsNode>::byLoad(NodeTab, STHi, rTab, mask, selR,
+                                          Multi, SelNext, parms);
 
 // Check for overloaded node and return result
 //
@@ -1833,32 +1841,16 @@ XrdCmsNode *XrdCmsCluster::SelbyLoad(SMask_t mask, XrdCmsSelector &selR)
 
 XrdCmsNode *XrdCmsCluster::SelbyRef(SMask_t mask, XrdCmsSelector &selR)
 {
-    XrdCmsNode *np, *sp = 0;
-    bool Multi = false, reqSS = (selR.needSpace & XrdCmsNode::allowsSS) != 0;
+    XrdCmsSelNode<XrdCmsNode>::Parms parms = {Config.MaxLoad, Config.P_fuzz,
+                                              Config.DiskLinger, SelWidth};
+    XrdCmsNode *sp;
+    bool Multi = false;
 
 // Scan for a node (sp points to the selected one)
 //
    selR.Reset(); SelTcnt++;
-   for (int i = 0; i <= STHi; i++)
-       if ((np = NodeTab[i]) && (np->NodeMask & mask))
-          {if (!(selR.needNet & np->hasNet))    {selR.xNoNet= true; continue;}
-           selR.nPick++;
-           if (np->isOffline)                   {selR.xOff  = true; continue;}
-           if (np->isBad)                       {selR.xSusp = true; continue;}
-           if (selR.needSpace && (np->DiskFree < np->DiskMinF
-                                  || (reqSS && np->isNoStage)))
-              {selR.xFull = true; continue;}
-           if (!sp) sp = np;
-              else {Multi = true;
-                         if (selR.selPack)
-                            {if (--selR.selPack) sp=np;
-                                else break;
-                            }
-                    else if (selR.needSpace)
-                            {if (sp->RefW > (np->RefW+Config.DiskLinger)) sp=np;}
-                    else if (sp->RefR > np->RefR)                         sp=np;
-                   }
-          }
+   sp = XrdCmsSelNode<XrdCmsNode>::byRank(NodeTab, STHi, mask, selR, Multi,
+                                          false, SelNext, parms);
 
 // Check for overloaded node and return result
 //
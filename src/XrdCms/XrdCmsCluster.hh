@@ -35,6 +35,7 @@
 #include <strings.h>
 #include <netinet/in.h>
   
+#include "XrdCms/XrdCmsRank.hh"
 #include "XrdCms/XrdCmsTypes.hh"
 #include "XrdOuc/XrdOucTList.hh"
 #include "XrdOuc/XrdOucEnum.hh"
@@ -169,6 +170,10 @@ void           *MonPerf();
 //
 void           *MonRefs();
 
+// Called when a node reports a new load to re-rank it for selection
+//
+void            Rank(XrdCmsNode *nP);
+
 // Return total number of redirect references
 //
 long long       Refs() {return SelWtot+SelRtot;}
@@ -225,6 +230,7 @@ int         Drop(int sent, int sinst, XrdCmsDrop *djp=0);
 void        Record(char *path, const char *reason, bool force=false);
 bool        maxBits(SMask_t mVec, int mbits);
 int         Multiple(SMask_t mVec);
+int         NoneHave(XrdCmsSelect &Sel, SMask_t &qmask);
 enum        {eExists, eDups, eROfs, eNoRep, eNoSel, eNoEnt}; // Passed to SelFail
 int         SelFail(XrdCmsSelect &Sel, int rc);
 int         SelNode(XrdCmsSelect &Sel, SMask_t  pmask, SMask_t  amask);
@@ -238,6 +244,10 @@ void        setAltMan(int snum, XrdLink *lp, int port);
 int         Unreachable(XrdCmsSelect &Sel, bool none);
 int         Unuseable(XrdCmsSelect &Sel);
 
+// Maximum number of equally ranked eligible nodes looked at per selection
+//
+static const  int SelWidth = 8;
+
 // Number of <host>:Port characters per entry was INET6_ADDRSTRLEN+10
 //
 static const  int AltSize = 254; // We may revert to IP address
@@ -250,6 +260,13 @@ int           Reserved;
 RAtomic_llong SelWtot;          // Total number of r/w selections (successful)
 RAtomic_llong SelRtot;          // Total number of r/o selections (successful)
 RAtomic_llong SelTcnt;          // Total number of all selections
+RAtomic_uint  SelNext;          // Where the next selection starts looking
+
+// Nodes ranked by load and by load including space (mass). These are updated
+// as load reports arrive and are protected by their own mutex.
+//
+XrdCmsRank<STMax> loadRank;
+XrdCmsRank<STMax> massRank;
 
 // The following is a list of IP:Port tokens that identify supervisor nodes.
 // The information is sent via the try request to redirect nodes; as needed.
@@ -66,6 +66,7 @@
 #include "XrdCms/XrdCmsSecurity.hh"
 #include "XrdCms/XrdCmsSelect.hh"
 #include "XrdCms/XrdCmsState.hh"
+#include "XrdCms/XrdCmsSummary.hh"
 #include "XrdCms/XrdCmsSupervisor.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 #include "XrdCms/XrdCmsUtils.hh"
@@ -435,7 +436,8 @@ int XrdCmsConfig::Configure2()
 //
    if (QryDelay < 0) QryDelay = LUPDelay;
    if (isManager) 
-      NoGo = !Cache.Init(cachelife,LUPDelay,QryDelay,baseFS.isDFS(),emptylife);
+      NoGo = !Cache.Init(cachelife, LUPDelay, QryDelay, baseFS.isDFS(),
+                         emptylife, emptymax);
 
 // Issue warning if the adminpath resides in /tmp
 //
@@ -569,6 +571,7 @@ int XrdCmsConfig::ConfigXeq(char *var, XrdOucStream &CFile, XrdSysError *eDest)
    TS_Xeq("role",          xrole);   // Server,  non-dynamic
    TS_Xeq("seclib",        xsecl);   // Server,  non-dynamic
    TS_Xeq("subcluster",    xsubc);   // Manager, non-dynamic
+   TS_Xeq("summary",       xsumm);   // Server,  non-dynamic
    TS_Xeq("superport",     xsupp);   // Super,   non-dynamic
    TS_Xeq("vnid",          xvnid);   // Server,  non-dynamic
    TS_Set("wait",          doWait);  // Server,  non-dynamic (backward compat)
@@ -653,6 +656,17 @@ void XrdCmsConfig::DoIt()
 //
    if (isManager || isServer || isPeer) XrdCmsManager::Start(ManList);
 
+// Start sending namespace summaries if we are a data server that should. As
+// summaries are made by walking the local file system, they are only sent
+// when that is where the oss keeps its files unless we were told otherwise.
+//
+   if (DiskOK && sumint)
+      {if (ossLib && !sumanyoss)
+          Say.Say("Config warning: namespace summaries disabled; osslib '",
+                  ossLib, "' may not use the local file system.");
+          else Summary.Start(sumint, sumbits);
+      }
+
 // Start state monitoring thread
 //
    if (XrdSysThread::Run(&tid, XrdCmsStartMonStat, (void *)0,
@@ -783,6 +797,9 @@ void XrdCmsConfig::ConfigDefaults(void)
    ifList    =0;
    perfint  = 3*60;
    perfpgm  = 0;
+   sumint   = 0;
+   sumbits  = 10;
+   sumanyoss= 0;
    xrdEnv   = 0;
    AdminPath= 0;
    AdminMode= 0700;
@@ -792,6 +809,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    Police   = 0;
    cachelife= 8*60*60;
    emptylife= 0;
+   emptymax = 1024*1024;
    pendplife=   60*60*24*7;
    DiskLinger=0;
    ProgCH   = 0;
@@ -1893,9 +1911,12 @@ int XrdCmsConfig::xfsxq(XrdSysError *eDest, XrdOucStream &CFile)
 
 /* Function: xfxhld
 
-   Purpose:  To parse the directive: fxhold [noloc <nls>] <sec>
+   Purpose:  To parse the directive: fxhold [noloc <nls>] [nxmax <num>] <sec>
 
              <nls>  number of seconds (or M, H, etc) to cache file non-existence
+             <num>  maximum number of non-existent files to cache (default 1m).
+                    When the limit is reached the oldest one is forgotten. A
+                    value of 0 caches them with all other files without limit.
              <sec>  number of seconds (or M, H, etc) to cache file     existence
 
    Type: Manager only, dynamic.
@@ -1906,6 +1927,7 @@ int XrdCmsConfig::xfsxq(XrdSysError *eDest, XrdOucStream &CFile)
 int XrdCmsConfig::xfxhld(XrdSysError *eDest, XrdOucStream &CFile)
 {
     char *val;
+    long long nx;
     int ct;
 
     if (!isManager) return CFile.noEcho();
@@ -1922,6 +1944,15 @@ int XrdCmsConfig::xfxhld(XrdSysError *eDest, XrdOucStream &CFile)
         if (!(val = CFile.GetWord())) return 0;
        }
 
+    if (!strcmp(val, "nxmax"))
+       {if (!(val = CFile.GetWord()))
+           {eDest->Emsg("Config","fxhold nxmax value not specified."); return 1;}
+        if (XrdOuca2x::a2sz(*eDest, "fxhold nxmax value", val, &nx,
+                                    0, 0x7fffffff)) return 1;
+        emptymax = static_cast<int>(nx);
+        if (!(val = CFile.GetWord())) return 0;
+       }
+
     if (XrdOuca2x::a2tm(*eDest, "fxhold value", val, &ct, 60)) return 1;
 
     cachelife = ct;
@@ -2400,6 +2431,7 @@ int XrdCmsConfig::xreps(XrdSysError *eDest, XrdOucStream &CFile)
     static struct repsopts {const char *opname; int opval;} rsopts[] =
        {
         {"all",      RepStat_All},
+        {"cch",      RepStat_cch},
         {"frq",      RepStat_frq},
         {"shr",      RepStat_shr}
        };
@@ -3069,6 +3101,76 @@ int XrdCmsConfig::xsubc(XrdSysError *eDest, XrdOucStream &CFile)
    return (XrdCmsUtils::ParseMan(eDest, &SanList, hSpec, hPort) ? 0 : 1);
 }
   
+/******************************************************************************/
+/*                                 x s u m m                                  */
+/******************************************************************************/
+
+/* Function: xsumm
+
+   Purpose:  To parse the directive: summary {off | int <sec> [bits <num>]
+                                                           [anyoss]}
+
+             int <sec>  time (seconds, M, H) between namespace summaries sent
+                        to our managers. Each summary is made by walking every
+                        exported path and lets a manager skip asking us about
+                        files we do not have. The minimum is 60 seconds.
+             bits <num> the number of bits in the summary for each file. More
+                        bits make it larger but reduce how often it wrongly
+                        says a file may be present. The default is 10 (about
+                        1 in 100) and must be between 4 and 32.
+             anyoss     send summaries even when an osslib is used (this
+                        includes proxy servers). Only specify this when the
+                        osslib keeps its files in the local file system at
+                        the paths the oss would use, as the summary is made
+                        by walking those paths. Otherwise, the summary would
+                        wrongly say the files are not here.
+             off        do not send namespace summaries (the default).
+
+   Type: Server only, non-dynamic.
+
+   Output: 0 upon success or !0 upon failure. Ignored by manager.
+*/
+int XrdCmsConfig::xsumm(XrdSysError *eDest, XrdOucStream &CFile)
+{   char *val;
+    int sint = 0, sbits = 10, sany = 0;
+
+    if (!isServer) return CFile.noEcho();
+
+    if (!(val = CFile.GetWord()))
+       {eDest->Emsg("Config", "summary options not specified"); return 1;}
+
+    if (!strcmp("off", val)) {sumint = 0; return 0;}
+
+    do {     if (!strcmp("int", val))
+                {if (!(val = CFile.GetWord()))
+                    {eDest->Emsg("Config", "summary int value not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2tm(*eDest,"summary int",val,&sint,60))
+                    return 1;
+                }
+        else if (!strcmp("bits", val))
+                {if (!(val = CFile.GetWord()))
+                    {eDest->Emsg("Config", "summary bits value not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2i(*eDest,"summary bits",val,&sbits,4,32))
+                    return 1;
+                }
+        else if (!strcmp("anyoss", val)) sany = 1;
+        else eDest->Say("Config warning: ignoring invalid summary option '",
+                        val, "'.");
+       } while((val = CFile.GetWord()));
+
+    if (!sint)
+       {eDest->Emsg("Config", "summary int value not specified"); return 1;}
+
+    sumint    = sint;
+    sumbits   = sbits;
+    sumanyoss = sany;
+    return 0;
+}
+
 /******************************************************************************/
 /*                                 x s u p p                                  */
 /******************************************************************************/
@@ -204,6 +204,7 @@ XrdNetSecurity    *Police;
 //
 static const int RepStat_frq    = 0x0001; // Fast Response Queue
 static const int RepStat_shr    = 0x0002; // Share
+static const int RepStat_cch    = 0x0004; // Location cache
 static const int RepStat_All    = 0xffff; // All
 
 private:
@@ -249,6 +250,7 @@ bool xschedy(char *val, XrdSysError *eDest, char *&host, int &hlen, int &port);
 int  xsecl(XrdSysError *edest, XrdOucStream &CFile);
 int  xspace(XrdSysError *edest, XrdOucStream &CFile);
 int  xsubc(XrdSysError *edest, XrdOucStream &CFile);
+int  xsumm(XrdSysError *edest, XrdOucStream &CFile);
 int  xsupp(XrdSysError *edest, XrdOucStream &CFile);
 int  xtrace(XrdSysError *edest, XrdOucStream &CFile);
 int  xvnid(XrdSysError *edest, XrdOucStream &CFile);
@@ -270,8 +272,12 @@ int               isServer;
 int               isSolo;
 char             *perfpgm;
 int               perfint;
+int               sumint;
+int               sumbits;
+int               sumanyoss;
 int               cachelife;
 int               emptylife;
+int               emptymax;
 int               pendplife;
 int               FSlim;
 };
@@ -130,34 +130,53 @@ public:
        XrdCmsKey      Key;
        XrdCmsKeyItem *Next;
 
-static XrdCmsKeyItem *Alloc(unsigned int theTock);
+       XrdCmsKeyItem() {}  // Warning see the constructor!
+      ~XrdCmsKeyItem() {}  // These are usually never deleted
+
+static const unsigned int TickRate =   64;
+static const unsigned int TickMask =   63;
+};
+
+/******************************************************************************/
+/*                   C l a s s   X r d C m s K e y P o o l                    */
+/******************************************************************************/
 
-       void           Recycle();
+// The XrdCmsKeyPool object holds the free list of key items and the lists of
+// items by the clock tick in which they were added (used to age them out).
+// The cache is split into shards each with its own pool so that shards may be
+// manipulated concurrently. The caller must serialize all calls.
+//
+class XrdCmsKeyPool
+{
+public:
 
-       void           Reload();
+XrdCmsKeyItem *Alloc(unsigned int theTock);
 
-static int            Replenish();
+void           Recycle(XrdCmsKeyItem *theItem);
 
-static void           Stats(int &isAlloc, int &isFree, int &wasEmpty);
+void           Reload(XrdCmsKeyItem *theItem);
 
-static XrdCmsKeyItem *Unload(unsigned int   theTock);
+int            Replenish();
 
-static XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+void           Stats(int &isAlloc, int &isFree, int &wasEmpty);
 
-       XrdCmsKeyItem() {}  // Warning see the constructor!
-      ~XrdCmsKeyItem() {}  // These are usually never deleted
+XrdCmsKeyItem *Unload(unsigned int   theTock);
 
-static const unsigned int TickRate =   64;
-static const unsigned int TickMask =   63;
-static const          int minAlloc = 4096;
-static const          int minFree  = 1024;
+XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+
+               XrdCmsKeyPool() : Free(0), numFree(0), numHave(0), numNull(0)
+                               {memset(TockTable, 0, sizeof(TockTable));}
+              ~XrdCmsKeyPool() {}  // These are never deleted
+
+static const int minAlloc =  512;
+static const int minFree  =  128;
 
 private:
 
-static XrdCmsKeyItem *TockTable[TickRate];
-static XrdCmsKeyItem *Free;
-static int            numFree;
-static int            numHave;
-static int            numNull;
+XrdCmsKeyItem *TockTable[XrdCmsKeyItem::TickRate];
+XrdCmsKeyItem *Free;
+int            numFree;
+int            numHave;
+int            numNull;
 };
 #endif
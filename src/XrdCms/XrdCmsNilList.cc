@@ -0,0 +1,160 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C m s N i l L i s t . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdCms/XrdCmsNilList.hh"
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+  
+int XrdCmsNilList::Add(const char *path, int plen, time_t endT,
+                       unsigned int clock)
+{
+   std::pair<NilMap::iterator, bool> rc;
+   int numGone = 0;
+
+// Insert the path or find the existing one
+//
+   rc = nilMap.insert(NilMap::value_type(std::string(path, plen), NilItem()));
+
+// A refreshed path becomes the newest one. A new one may displace the oldest.
+//
+   if (!rc.second) nilAge.splice(nilAge.end(), nilAge, rc.first->second.Age);
+      else {rc.first->second.Age = nilAge.insert(nilAge.end(),&rc.first->first);
+            while((int)nilMap.size() > nilMax)
+                 {Erase(nilMap.find(*nilAge.front())); numGone++;}
+           }
+
+// Set the expiration and clock
+//
+   rc.first->second.endT  = endT;
+   rc.first->second.Clock = clock;
+   return numGone;
+}
+  
+/******************************************************************************/
+/*                                   D e l                                    */
+/******************************************************************************/
+  
+bool XrdCmsNilList::Del(const char *path, int plen)
+{
+   NilMap::iterator it;
+
+   if (nilMap.empty()
+   || (it = nilMap.find(std::string(path, plen))) == nilMap.end()) return false;
+
+   Erase(it);
+   return true;
+}
+
+/******************************************************************************/
+/*                               D e l T r e e                                */
+/******************************************************************************/
+  
+int XrdCmsNilList::DelTree(const char *path, int plen)
+{
+   NilMap::iterator it;
+   std::string pfx;
+   int numGone = 0;
+
+// Trailing slashes do not change the directory being named
+//
+   while(plen > 1 && path[plen-1] == '/') plen--;
+   if (nilMap.empty()) return 0;
+
+// Forget the path itself
+//
+   pfx.assign(path, plen);
+   if ((it = nilMap.find(pfx)) != nilMap.end()) {Erase(it); numGone++;}
+
+// Forget every path that starts with the path as a directory. These follow one
+// another in name order.
+//
+   if (pfx != "/") pfx += '/';
+   it = nilMap.lower_bound(pfx);
+   while(it != nilMap.end() && !it->first.compare(0, pfx.size(), pfx))
+        {Erase(it++); numGone++;}
+
+   return numGone;
+}
+
+/******************************************************************************/
+/*                                  F i n d                                   */
+/******************************************************************************/
+  
+bool XrdCmsNilList::Find(const char *path, int plen, time_t now,
+                         unsigned int clock)
+{
+   NilMap::iterator it;
+
+// Look up the path
+//
+   if (nilMap.empty()
+   || (it = nilMap.find(std::string(path, plen))) == nilMap.end()) return false;
+
+// Forget it if it has expired or if a node reconnected since it was added
+//
+   if (it->second.endT <= now || it->second.Clock < clock)
+      {Erase(it);
+       return false;
+      }
+   return true;
+}
+
+/******************************************************************************/
+/*                                  T r i m                                   */
+/******************************************************************************/
+  
+int XrdCmsNilList::Trim(time_t now)
+{
+   NilMap::iterator it;
+   int numGone = 0;
+
+// Paths are usually refreshed with the same lifetime so the oldest ones expire
+// first. We stop at the first one that is still current.
+//
+   while(!nilAge.empty())
+        {it = nilMap.find(*nilAge.front());
+         if (it->second.endT > now) break;
+         Erase(it); numGone++;
+        }
+   return numGone;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                 E r a s e                                  */
+/******************************************************************************/
+  
+void XrdCmsNilList::Erase(NilMap::iterator it)
+{
+   nilAge.erase(it->second.Age);
+   nilMap.erase(it);
+}
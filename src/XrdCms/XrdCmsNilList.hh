@@ -0,0 +1,99 @@
+#ifndef XRDCMSNILLIST__H
+#define XRDCMSNILLIST__H
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C m s N i l L i s t . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <ctime>
+#include <list>
+#include <map>
+#include <string>
+
+// The XrdCmsNilList object holds the paths that the location cache found on
+// no node. Each path is remembered until its expiration time or until any node
+// reconnects (the caller passes a clock that advances when that happens). The
+// list is bounded and, when full, the oldest path is forgotten first. Paths
+// may also be forgotten along with all of the paths under them (e.g., when a
+// directory is renamed). The caller must serialize all calls.
+//
+class XrdCmsNilList
+{
+public:
+
+// Add() adds or refreshes a path. It returns the number of paths forgotten to
+//       make room for it (0 or 1).
+//
+int         Add(const char *path, int plen, time_t endT, unsigned int clock);
+
+// Del() forgets a path. It returns true if the path was present.
+//
+bool        Del(const char *path, int plen);
+
+// DelTree() forgets a path and every path under it. It returns the number of
+//           paths forgotten.
+//
+int         DelTree(const char *path, int plen);
+
+// Find() returns true if the path is present, has not expired, and was added
+//        at or after the indicated clock. A stale path is forgotten.
+//
+bool        Find(const char *path, int plen, time_t now, unsigned int clock);
+
+// Num() returns the number of paths in the list.
+//
+int         Num() const {return static_cast<int>(nilMap.size());}
+
+// SetMax() sets the maximum number of paths in the list.
+//
+void        SetMax(int maxNum) {nilMax = (maxNum > 0 ? maxNum : 1);}
+
+// Trim() forgets the paths that have expired. It returns the number forgotten.
+//
+int         Trim(time_t now);
+
+            XrdCmsNilList(int maxNum=1) : nilMax(maxNum) {}
+           ~XrdCmsNilList() {}
+
+private:
+
+typedef std::list<const std::string *> AgeList;
+
+struct NilItem
+      {time_t            endT;
+       unsigned int      Clock;
+       AgeList::iterator Age;
+      };
+
+typedef std::map<std::string, NilItem> NilMap;
+
+void        Erase(NilMap::iterator it);
+
+NilMap      nilMap;  // Paths in name order for DelTree()
+AgeList     nilAge;  // Paths in the order added, oldest first
+int         nilMax;
+};
+#endif
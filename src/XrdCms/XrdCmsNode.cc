@@ -54,6 +54,7 @@
 #include "XrdCms/XrdCmsNode.hh"
 #include "XrdCms/XrdCmsSelect.hh"
 #include "XrdCms/XrdCmsState.hh"
+#include "XrdCms/XrdCmsSummary.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 
 #include "XrdOss/XrdOss.hh"
@@ -99,11 +100,10 @@ XrdCmsNode::XrdCmsNode(XrdLink *lnkp, const char *theIF, const char *nid,
                        int port, int lvl, int id)
 {
     static XrdSysMutex   iMutex;
-    static const SMask_t smask_1(1);
     static int           iNum = 1;
 
     Link     =  lnkp;
-    NodeMask =  (id < 0 ? 0 : smask_1 << id);
+    NodeMask =  (id < 0 ? SMask_t(0) : SMask_t::Bit(id));
     NodeID   = id;
     isOffline=  (lnkp == 0);
     logload  =  Config.LogPerf;
@@ -296,6 +296,23 @@ const char *XrdCmsNode::do_Avail(XrdCmsRRData &Arg)
    return 0;
 }
 
+/******************************************************************************/
+/*                              d o _ B l o o m                               */
+/******************************************************************************/
+  
+// Bloom requests carry a piece of a node's namespace summary. Only managers
+// keep summaries as they are used to avoid needless queries about files.
+//
+const char *XrdCmsNode::do_Bloom(XrdCmsRRData &Arg)
+{
+
+// Process: bloom <gen> <bits> <offset> <hashes> <summary piece>
+// Respond: n/a
+//
+   if (Config.asManager()) Summary.Load(NodeID, Arg.Buff, Arg.Dlen);
+   return 0;
+}
+
 /******************************************************************************/
 /*                              d o _ C h m o d                               */
 /******************************************************************************/
@@ -432,7 +449,10 @@ const char *XrdCmsNode::do_Have(XrdCmsRRData &Arg)
             if (baseFS.isDFS())
                {Sel.Vec.hf = pinfo.rovec; Sel.Vec.wf = pinfo.rwvec;
                 isnew       = Cache.AddFile(Sel, allNodes);
-               } else isnew = Cache.AddFile(Sel, NodeMask);
+               } else {
+                Summary.Have(NodeID, Arg.Path, Arg.PathLen-1);
+                isnew       = Cache.AddFile(Sel, NodeMask);
+               }
            }
 
 // Return if we have no managers or we already informed the managers
@@ -478,6 +498,7 @@ const char *XrdCmsNode::do_Load(XrdCmsRRData &Arg)
    myMass = Meter.calcLoad(myLoad, pdsk);
    DiskFree = Arg.dskFree;
    DiskUtil = pdsk;
+   Cluster.Rank(this);
 
 // Do some debugging
 //
@@ -535,7 +556,7 @@ const char *XrdCmsNode::do_Locate(XrdCmsRRData &Arg)
    XrdCmsSelect    Sel(0, Arg.Path, Arg.PathLen-1);
    XrdCmsSelected *sP = 0;
    struct {kXR_unt32 Val; 
-           char outbuff[CmsLocateRequest::RHLen*STMax];} Resp;
+           char outbuff[LocFmtMax];} Resp;
    struct iovec ioV[2] = {{(char *)&Arg.Request, sizeof(Arg.Request)},
                           {(char *)&Resp,        0}};
    const char *Why;
@@ -636,7 +657,8 @@ const char *XrdCmsNode::do_Locate(XrdCmsRRData &Arg)
       {Resp.Val           = htonl(rc);
        DEBUGR(Why <<Arg.Path);
       } else {
-       bytes = do_LocFmt(Resp.outbuff, sP, Sel.Vec.pf, Sel.Vec.wf, lsall,lsuniq)
+       bytes = do_LocFmt(Resp.outbuff, sizeof(Resp.outbuff), sP,
+                         Sel.Vec.pf, Sel.Vec.wf, lsall, lsuniq)
              + sizeof(Resp.Val) + 1;
        Resp.Val            = 0;
        Arg.Request.rrCode  = kYR_data;
@@ -654,7 +676,7 @@ const char *XrdCmsNode::do_Locate(XrdCmsRRData &Arg)
 /* Static                      d o _ L o c F m t                              */
 /******************************************************************************/
   
-int XrdCmsNode::do_LocFmt(char *buff, XrdCmsSelected *sP,
+int XrdCmsNode::do_LocFmt(char *buff, int blen, XrdCmsSelected *sP,
                           SMask_t pfVec, SMask_t wfVec, bool lsall, bool lsuniq)
 {
    static const int Skip = (XrdCmsSelected::Disable | XrdCmsSelected::Offline);
@@ -686,18 +708,23 @@ if (!lsall && lsuniq)
 // 01234567810123456789212345678
 // xy[::123.123.123.123]:123456
 //
+// Entries that would not fit in the buffer (only possible in very large
+// cells) are dropped; we leave room for the separating blank and the null.
+//
 if (lsall)
    while(sP)
-        {*oP = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
-         if (sP->Status & Hung) *oP = tolower(*oP);
-         *(oP+1) = (sP->Mask   & wfVec               ? 'w' : 'r');
-         strcpy(oP+2, sP->Ident); oP += sP->IdentLen + 2;
-         if (sP->next) *oP++ = ' ';
+        {if (oP + sP->IdentLen + 4 <= buff + blen)
+            {*oP = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
+             if (sP->Status & Hung) *oP = tolower(*oP);
+             *(oP+1) = (sP->Mask   & wfVec               ? 'w' : 'r');
+             strcpy(oP+2, sP->Ident); oP += sP->IdentLen + 2;
+             if (sP->next) *oP++ = ' ';
+            }
          pP = sP; sP = sP->next; delete pP;
         }
    else
    while(sP)
-        {if (!(sP->Status & Skip))
+        {if (!(sP->Status & Skip) && oP + sP->IdentLen + 4 <= buff + blen)
             {*oP     = (sP->Status & XrdCmsSelected::isMangr ? 'M' : 'S');
              if (sP->Mask & pfVec) *oP = tolower(*oP);
              *(oP+1) = (sP->Mask   & wfVec                   ? 'w' : 'r');
@@ -729,10 +756,11 @@ const char *XrdCmsNode::do_Mkdir(XrdCmsRRData &Arg)
 //
    DEBUGR("mode " <<Arg.Mode <<' ' <<Arg.Path);
 
-// We are don here if we have no data; otherwise convert the mode if we
-// haven't done so already.
+// We are don here if we have no data (though the directory now exists as far
+// as our cache is concerned); otherwise convert the mode if we haven't done so
+// already.
 //
-   if (!Config.DiskOK) return 0;
+   if (!Config.DiskOK) {Cache.NilDrop(Arg.Path, strlen(Arg.Path)); return 0;}
    if (!mode && !getMode(Arg.Mode, mode)) return "invalid mode";
 
 // Attempt to create the directory either via call-out of oss plug-in
@@ -761,10 +789,11 @@ const char *XrdCmsNode::do_Mkpath(XrdCmsRRData &Arg)
 //
    DEBUGR("mode " <<Arg.Mode <<' ' <<Arg.Path);
 
-// We are don here if we have no data; otherwise convert the mode if we
-// haven't done so already.
+// We are don here if we have no data (though the path now exists as far as
+// our cache is concerned); otherwise convert the mode if we haven't done so
+// already.
 //
-   if (!Config.DiskOK) return 0;
+   if (!Config.DiskOK) {Cache.NilDrop(Arg.Path, strlen(Arg.Path)); return 0;}
    if (!mode && !getMode(Arg.Mode, mode)) return "invalid mode";
 
 // Attempt to create the directory path via call-out or oss plugin
@@ -796,7 +825,9 @@ const char *XrdCmsNode::do_Mv(XrdCmsRRData &Arg)
 // If we are not a server, if must remove references to the old and new names
 // from our cache. This is independent of how the raname is handled. We need
 // not back percolate the mv since it was hanled top down in the first place.
-// Note that we will scuttle the mv if the target file exists somewhere.
+// Note that we will scuttle the mv if the target file exists somewhere. Since
+// a directory may have been renamed, nothing at or under the new name can be
+// known to be missing any more.
 //
    if (!Config.DiskOK)
       {XrdCmsSelect Sel1(XrdCmsSelect::Defer, Arg.Path, strlen(Arg.Path ));
@@ -819,6 +850,7 @@ const char *XrdCmsNode::do_Mv(XrdCmsRRData &Arg)
           }
        Cache.DelFile(Sel2, allNodes);
        Cache.DelFile(Sel1, allNodes);
+       Cache.NilDrop(Arg.Path2, strlen(Arg.Path2), true);
        return 0;
       }
   
@@ -57,6 +57,7 @@ class XrdOucProg;
 class XrdCmsNode
 {
 friend class XrdCmsCluster;
+template<class Node> friend class XrdCmsSelNode;
 public:
        char  *Ident     = 0; // -> role hostname
        char   hasNet    = 0; //0 Network selection mask
@@ -92,13 +93,14 @@ unsigned int    DiskTotal = 0;// Total disk space in GB
 unsigned int    ConfigID  = 0;// Configuration identifier
 
 const  char  *do_Avail(XrdCmsRRData &Arg);
+const  char  *do_Bloom(XrdCmsRRData &Arg);
 const  char  *do_Chmod(XrdCmsRRData &Arg);
 const  char  *do_Disc(XrdCmsRRData &Arg);
 const  char  *do_Gone(XrdCmsRRData &Arg);
 const  char  *do_Have(XrdCmsRRData &Arg);
 const  char  *do_Load(XrdCmsRRData &Arg);
 const  char  *do_Locate(XrdCmsRRData &Arg);
-static int    do_LocFmt(char *buff, XrdCmsSelected *sP,
+static int    do_LocFmt(char *buff, int blen, XrdCmsSelected *sP,
                         SMask_t pf, SMask_t wf,
                         bool lsall=false, bool lsuniq=false);
 const  char  *do_Mkdir(XrdCmsRRData &Arg);
@@ -142,7 +144,8 @@ inline int    Inst() {return Instance;}
 
        bool   inDomain() {return netIF.InDomain(&netID);}
 
-inline int    isNode(SMask_t smask) {return (smask & NodeMask) != 0;}
+inline int    isNode(const SMask_t &smask)
+                    {return NodeID >= 0 && smask.Test(NodeID);}
 
 inline int    isNode(const XrdNetAddr *addr) // Only for avoid processing!
                     {return netID.Same(addr);}
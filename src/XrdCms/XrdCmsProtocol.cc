@@ -60,6 +60,7 @@
 #include "XrdCms/XrdCmsRouting.hh"
 #include "XrdCms/XrdCmsRTable.hh"
 #include "XrdCms/XrdCmsState.hh"
+#include "XrdCms/XrdCmsSummary.hh"
 #include "XrdCms/XrdCmsTrace.hh"
 
 #include "XrdOuc/XrdOucCRC.hh"
@@ -403,6 +404,7 @@ void XrdCmsProtocol::Pander(const char *manager, int mport)
                    Say.Emsg("Protocol", "Logged into", sname, Link->Name());
                    if (Data.SID)
                       Manager->Verify(Link, (const char *)Data.SID, sname);
+                   Summary.Resend();
                    Reason = Dispatch(isUp, TimeOut, 2);
                    rc = 0;
                    loginData.fSpace= Meter.FreeSpace(fsUtil);
@@ -304,7 +304,8 @@ void XrdCmsRRQ::sendLocResp(XrdCmsRRQSlot *lP)
 //
    lsopts = static_cast<XrdCmsCluster::CmsLSOpts>(lP->Info.lsLU);
    if (!(sP = Cluster.List(lP->Arg1, lsopts, oksel))
-   || (!(bytes = XrdCmsNode::do_LocFmt(databuff,sP,lP->Arg2,lP->Info.rwVec))))
+   || (!(bytes = XrdCmsNode::do_LocFmt(databuff,sizeof(databuff),sP,
+                                                   lP->Arg2,lP->Info.rwVec))))
       {sendLwtResp(lP);
        return;
       }
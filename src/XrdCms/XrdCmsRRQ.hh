@@ -38,6 +38,16 @@
 #include "XrdCms/XrdCmsTypes.hh"
 #include "XrdOuc/XrdOucDLlist.hh"
 #include "XrdSys/XrdSysPthread.hh"
+
+namespace XrdCms
+{
+// Locate responses list up to STMax hosts but, as the response length is
+// sent as a 16-bit value, never more than will fit in a single response
+// (i.e. less the leading status word and the trailing null byte).
+//
+static const int LocFmtMax = (CmsLocateRequest::RHLen*STMax < 65535-5
+                           ?  CmsLocateRequest::RHLen*STMax : 65535-5);
+}
   
 /******************************************************************************/
 /*                         X r d C m s R R Q I n f o                          */
@@ -170,8 +180,7 @@ static   const int                     iov_cnt = 2;
          XrdCms::CmsResponse           redrResp;
          XrdCms::CmsResponse           waitResp;
 union   {char                          hostbuff[288];
-         char                          databuff[XrdCms::CmsLocateRequest::RHLen
-                                               *STMax];
+         char                          databuff[XrdCms::LocFmtMax];
         };
          Info                          Stats;
          int                           luFast;
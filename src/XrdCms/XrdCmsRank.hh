@@ -0,0 +1,140 @@
+#ifndef XRDCMSRANK__H
+#define XRDCMSRANK__H
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d C m s R a n k . h h                          */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <atomic>
+
+#include "XrdCms/XrdCmsSMask.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+//------------------------------------------------------------------------------
+//! XrdCmsRank keeps the node slots of a cell sorted into ranks by a reported
+//! value (e.g. load). Each rank is a server mask so that the least loaded
+//! nodes matching a selection mask are found with a few mask operations,
+//! independent of the number of nodes in the cell. The index is updated when
+//! a node reports a new value, not when a selection is made.
+//!
+//! Updates are serialized by an internal mutex. Lookups take no lock and read
+//! each mask word atomically, so a lookup that races with an update sees each
+//! word either before or after it. A node being moved may thus be seen in
+//! both of its ranks or in neither; just as with the node load values
+//! themselves, callers must treat the result as a hint and verify each node
+//! they are handed.
+//------------------------------------------------------------------------------
+
+template<int nSlots>
+class XrdCmsRank
+{
+public:
+
+typedef XrdCmsSMask<nSlots> Mask;
+
+static const int maxRank = 256;
+
+//------------------------------------------------------------------------------
+//! Find the lowest rank holding any of the nodes in a mask.
+//!
+//! @param  mask   - the nodes of interest.
+//! @param  nodes  - receives the nodes in mask that are in the returned rank.
+//! @param  rank   - the rank at which to start looking.
+//!
+//! @return The rank number or -1 if no rank at or above rank holds any node
+//!         in mask.
+//------------------------------------------------------------------------------
+
+int               Lowest(const Mask &mask, Mask &nodes, int rank=0) const
+                        {int hi = rHi.load(std::memory_order_acquire);
+                         for (; rank <= hi; rank++)
+                             {unsigned long long any = 0;
+                              for (int i = 0; i < Mask::Words; i++)
+                                  {unsigned long long v = mask.Word(i)
+                                     & rTab[rank][i].load(std::memory_order_relaxed);
+                                   nodes.Word(i, v);
+                                   any |= v;
+                                  }
+                              if (any) return rank;
+                             }
+                         return -1;
+                        }
+
+//------------------------------------------------------------------------------
+//! Return the rank of a slot or -1 if the slot is not ranked.
+//------------------------------------------------------------------------------
+
+int               Rank(int slot) const
+                      {return sRank[slot].load(std::memory_order_relaxed);}
+
+//------------------------------------------------------------------------------
+//! Place a slot in a rank.
+//!
+//! @param  slot   - the slot number.
+//! @param  rank   - the new rank; values above maxRank-1 are lumped into the
+//!                  highest rank. A negative value removes the slot.
+//------------------------------------------------------------------------------
+
+void              Set(int slot, int rank)
+                     {if (rank >= maxRank) rank = maxRank-1;
+                      if (rank < 0) rank = -1;
+                      int wd = slot >> 6;
+                      unsigned long long bit = 1ULL << (slot & 63);
+                      rMutex.Lock();
+                      int old = sRank[slot].load(std::memory_order_relaxed);
+                      if (rank != old)
+                         {if (rank >= 0)
+                             {rTab[rank][wd].fetch_or(bit, std::memory_order_relaxed);
+                              if (rank > rHi.load(std::memory_order_relaxed))
+                                 rHi.store(rank, std::memory_order_release);
+                             }
+                          if (old >= 0)
+                             rTab[old][wd].fetch_and(~bit, std::memory_order_relaxed);
+                          sRank[slot].store(static_cast<short>(rank),
+                                            std::memory_order_relaxed);
+                         }
+                      rMutex.UnLock();
+                     }
+
+                  XrdCmsRank() : rHi(-1)
+                            {for (int i = 0; i < maxRank; i++)
+                                 for (int j = 0; j < Mask::Words; j++)
+                                     rTab[i][j].store(0);
+                             for (int i = 0; i < nSlots;  i++) sRank[i] = -1;
+                            }
+
+                 ~XrdCmsRank() {}
+
+private:
+
+XrdSysMutex       rMutex;
+std::atomic<int>  rHi;              // Highest rank ever used
+std::atomic<unsigned long long>
+                  rTab[maxRank][Mask::Words]; // The nodes in each rank
+std::atomic<short> sRank[nSlots];   // The rank of each slot
+};
+#endif
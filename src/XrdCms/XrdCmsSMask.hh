@@ -0,0 +1,182 @@
+#ifndef XRDCMSSMASK__H
+#define XRDCMSSMASK__H
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C m s S M a s k . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+//! XrdCmsSMask is a fixed size server mask: one bit per node slot in a cell.
+//! It behaves like the unsigned integer it replaces (bitwise operators, tests
+//! for zero, construction from an integer) so that a cell may hold more than
+//! 64 nodes. The bits are kept in an array of 64-bit words and every bitwise
+//! operation is a simple loop over that array which the compiler unrolls and
+//! vectorizes; with a single word it is as cheap as the plain integer.
+//!
+//! Construction from an integer sets the low order word. Negative values are
+//! sign extended so that, as before, ~0 yields a mask with every bit set.
+//! Like an integer, a default constructed mask is not initialized.
+//------------------------------------------------------------------------------
+
+template<int nBits>
+class XrdCmsSMask
+{
+public:
+
+static const int Words = (nBits + 63) / 64;
+
+//------------------------------------------------------------------------------
+//! Return a mask with only the indicated bit set.
+//------------------------------------------------------------------------------
+
+static XrdCmsSMask Bit(int bnum)
+                  {XrdCmsSMask m(0);
+                   m.w[bnum >> 6] = 1ULL << (bnum & 63);
+                   return m;
+                  }
+
+//------------------------------------------------------------------------------
+//! Return the number of bits set in the mask.
+//------------------------------------------------------------------------------
+
+int               Count() const
+                       {int n = 0;
+                        for (int i = 0; i < Words; i++)
+                            n += __builtin_popcountll(w[i]);
+                        return n;
+                       }
+
+//------------------------------------------------------------------------------
+//! Return the number of the lowest bit set or -1 if no bits are set.
+//------------------------------------------------------------------------------
+
+int               First() const {return Scan(0);}
+
+//------------------------------------------------------------------------------
+//! Return the number of the lowest bit set above bnum or -1 if there is none.
+//------------------------------------------------------------------------------
+
+int               Next(int bnum) const {return Scan(bnum+1);}
+
+//------------------------------------------------------------------------------
+//! Test whether the indicated bit is set.
+//------------------------------------------------------------------------------
+
+bool              Test(int bnum) const
+                      {return (w[bnum >> 6] >> (bnum & 63)) & 1ULL;}
+
+//------------------------------------------------------------------------------
+//! Return or replace one of the 64-bit words holding the mask (word 0 holds
+//! bits 0 through 63).
+//------------------------------------------------------------------------------
+
+unsigned long long Word(int i) const {return w[i];}
+
+void              Word(int i, unsigned long long val) {w[i] = val;}
+
+//------------------------------------------------------------------------------
+//! Operators
+//------------------------------------------------------------------------------
+
+explicit          operator bool() const
+                          {unsigned long long any = 0;
+                           for (int i = 0; i < Words; i++) any |= w[i];
+                           return any != 0;
+                          }
+
+bool              operator!() const {return !static_cast<bool>(*this);}
+
+XrdCmsSMask       operator~() const
+                          {XrdCmsSMask m;
+                           for (int i = 0; i < Words; i++) m.w[i] = ~w[i];
+                           return m;
+                          }
+
+XrdCmsSMask      &operator&=(const XrdCmsSMask &rhs)
+                            {for (int i = 0; i < Words; i++) w[i] &= rhs.w[i];
+                             return *this;
+                            }
+
+XrdCmsSMask      &operator|=(const XrdCmsSMask &rhs)
+                            {for (int i = 0; i < Words; i++) w[i] |= rhs.w[i];
+                             return *this;
+                            }
+
+XrdCmsSMask      &operator^=(const XrdCmsSMask &rhs)
+                            {for (int i = 0; i < Words; i++) w[i] ^= rhs.w[i];
+                             return *this;
+                            }
+
+friend XrdCmsSMask operator&(XrdCmsSMask lhs, const XrdCmsSMask &rhs)
+                            {return lhs &= rhs;}
+
+friend XrdCmsSMask operator|(XrdCmsSMask lhs, const XrdCmsSMask &rhs)
+                            {return lhs |= rhs;}
+
+friend XrdCmsSMask operator^(XrdCmsSMask lhs, const XrdCmsSMask &rhs)
+                            {return lhs ^= rhs;}
+
+friend bool        operator==(const XrdCmsSMask &lhs, const XrdCmsSMask &rhs)
+                             {unsigned long long diff = 0;
+                              for (int i = 0; i < Words; i++)
+                                  diff |= lhs.w[i] ^ rhs.w[i];
+                              return diff == 0;
+                             }
+
+friend bool        operator!=(const XrdCmsSMask &lhs, const XrdCmsSMask &rhs)
+                             {return !(lhs == rhs);}
+
+//------------------------------------------------------------------------------
+//! Constructors
+//------------------------------------------------------------------------------
+
+                  XrdCmsSMask() = default;
+
+template<typename T, typename = typename
+         std::enable_if<std::is_integral<T>::value>::type>
+                  XrdCmsSMask(T val)
+                    {unsigned long long ext = (std::is_signed<T>::value
+                                            && val < static_cast<T>(0)
+                                            ?  ~0ULL : 0ULL);
+                     w[0] = static_cast<unsigned long long>(val);
+                     for (int i = 1; i < Words; i++) w[i] = ext;
+                    }
+
+private:
+
+int               Scan(int bnum) const
+                      {int i = bnum >> 6;
+                       if (bnum < 0 || i >= Words) return -1;
+                       unsigned long long v = w[i] & (~0ULL << (bnum & 63));
+                       while(!v) {if (++i >= Words) return -1; v = w[i];}
+                       return (i << 6) + __builtin_ctzll(v);
+                      }
+
+unsigned long long w[Words];
+};
+#endif
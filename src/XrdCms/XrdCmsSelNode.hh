@@ -0,0 +1,208 @@
+#ifndef XRDCMSSELNODE__H
+#define XRDCMSSELNODE__H
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C m s S e l N o d e . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstdlib>
+
+#include "XrdCms/XrdCmsRank.hh"
+#include "XrdCms/XrdCmsSelect.hh"
+
+//------------------------------------------------------------------------------
+//! XrdCmsSelNode holds the load and reference count based node selection of
+//! XrdCmsCluster. It is a template over the node type only so that the very
+//! same code can be timed against a table of stand-in nodes; the cluster
+//! instantiates it with XrdCmsNode. The caller must hold the STMutex.
+//------------------------------------------------------------------------------
+
+template<class Node>
+class XrdCmsSelNode
+{
+public:
+
+//------------------------------------------------------------------------------
+//! The configuration values that steer a selection.
+//------------------------------------------------------------------------------
+
+struct Parms
+      {int MaxLoad;    //!< Nodes with a higher load are overloaded
+       int Fuzz;       //!< Loads that differ by no more than this are equal
+       int DiskLinger; //!< Write reference count slack
+       int Width;      //!< Eligible nodes looked at per rank
+      };
+
+//------------------------------------------------------------------------------
+//! Select the least loaded node in a mask.
+//!
+//! @param  tab    - the node table.
+//! @param  hi     - the highest slot in use in the table.
+//! @param  rTab   - the nodes ranked by load (or by mass when space is needed).
+//! @param  mask   - the nodes to choose from.
+//! @param  selR   - the selector; the reasons for skipping nodes are recorded.
+//! @param  Multi  - set when more than one node was eligible.
+//! @param  next   - where the next bounded selection starts looking.
+//! @param  parms  - the selection parameters.
+//!
+//! @return The selected node or nil if none is eligible.
+//!
+//! When every node of the cell fits in one mask word or the mask holds no
+//! more nodes than a rank would have looked at, every node in the mask is
+//! compared as that is cheaper than searching the ranks. Otherwise, the lowest
+//! rank that holds an eligible node supplies the selection and any node in
+//! the mask that is not ranked (e.g. it was just added) is looked at last.
+//------------------------------------------------------------------------------
+
+template<class Mask, class Counter>
+static Node *byLoad(Node *const *tab, int hi, const XrdCmsRank<Mask::Words*64> &rTab,
+                    Mask mask, XrdCmsSelector &selR, bool &Multi,
+                    Counter &next, const Parms &parms)
+            {Node *sp = 0;
+             Mask  rmask;
+             int   i, n = 0, rank = 0;
+
+             // Walk only as far as needed to know whether the mask is small
+             //
+             if (hi >= 64)
+                for (i = mask.First(); i >= 0 && n <= parms.Width; i = mask.Next(i))
+                    n++;
+             if (hi < 64 || n <= parms.Width)
+                return byScan(tab, hi, mask, selR, Multi, parms);
+
+             while((rank = rTab.Lowest(mask, rmask, rank)) >= 0)
+                  {if ((sp = byRank(tab, hi, rmask, selR, Multi, true,
+                                    next, parms))) return sp;
+                   mask &= ~rmask; rank++;
+                  }
+             return (mask ? byRank(tab, hi, mask, selR, Multi, true, next, parms)
+                          : 0);
+            }
+
+//------------------------------------------------------------------------------
+//! Select among nodes that are considered equally loaded using the reference
+//! counts (or the affinity count when stable selection is wanted). Unless
+//! affinity is needed, the scan starts at a rotating slot and stops after
+//! looking at Width eligible nodes so that its cost does not grow with the
+//! cell size. The selector's reasons are accumulated across calls.
+//!
+//! @param  chkLoad - skip overloaded nodes when true.
+//!
+//! The other arguments and the return value are as for byLoad().
+//------------------------------------------------------------------------------
+
+template<class Mask, class Counter>
+static Node *byRank(Node *const *tab, int hi, const Mask &mask,
+                    XrdCmsSelector &selR, bool &Multi, bool chkLoad,
+                    Counter &next, const Parms &parms)
+            {Node *np, *sp = 0;
+             bool reqSS = (selR.needSpace & Node::allowsSS) != 0;
+             int i, end, n = 0;
+             int start = (selR.selPack || hi < 0 ? 0 : next++ % (hi+1));
+
+             for (int pass = 0; pass < 2; pass++)
+                 {i   = (pass ? mask.First() : mask.Next(start-1));
+                  end = (pass ? start : hi+1);
+                  for (; i >= 0 && i < end; i = mask.Next(i))
+                      {if (!(np = tab[i])) continue;
+                       if (!(selR.needNet & np->hasNet))
+                          {selR.xNoNet= true; continue;}
+                       selR.nPick++;
+                       if (np->isOffline)   {selR.xOff  = true; continue;}
+                       if (np->isBad)       {selR.xSusp = true; continue;}
+                       if (chkLoad && np->myLoad > parms.MaxLoad)
+                                            {selR.xOvld = true; continue;}
+                       if (selR.needSpace && (np->DiskFree < np->DiskMinF
+                                              || (reqSS && np->isNoStage)))
+                          {selR.xFull = true; continue;}
+                       if (!sp) sp = np;
+                          else {Multi = true;
+                                     if (selR.selPack)
+                                        {if (--selR.selPack) sp=np;
+                                            else return sp;
+                                        }
+                                else if (selR.needSpace)
+                                        {if (sp->RefW > (np->RefW+parms.DiskLinger))
+                                            sp=np;
+                                        }
+                                else if (sp->RefR > np->RefR)   sp=np;
+                               }
+                       if (++n >= parms.Width && !selR.selPack) return sp;
+                      }
+                 }
+             return sp;
+            }
+
+//------------------------------------------------------------------------------
+//! Select the least loaded node by comparing every node in the mask; loads
+//! within the fuzz factor are equal and the reference counts (or the
+//! affinity count) decide among them.
+//!
+//! The arguments and the return value are as for byLoad().
+//------------------------------------------------------------------------------
+
+template<class Mask>
+static Node *byScan(Node *const *tab, int hi, const Mask &mask,
+                    XrdCmsSelector &selR, bool &Multi, const Parms &parms)
+            {Node *np, *sp = 0;
+             bool reqSS = (selR.needSpace & Node::allowsSS) != 0;
+
+             for (int i = mask.First(); i >= 0 && i <= hi; i = mask.Next(i))
+                 if ((np = tab[i]))
+                    {if (!(selR.needNet & np->hasNet))
+                        {selR.xNoNet= true; continue;}
+                     selR.nPick++;
+                     if (np->isOffline)   {selR.xOff  = true; continue;}
+                     if (np->isBad)       {selR.xSusp = true; continue;}
+                     if (np->myLoad > parms.MaxLoad)
+                                          {selR.xOvld = true; continue;}
+                     if (selR.needSpace && (np->DiskFree < np->DiskMinF
+                                            || (reqSS && np->isNoStage)))
+                        {selR.xFull = true; continue;}
+                     if (!sp) sp = np;
+                        else{if (selR.needSpace)
+                                {if (abs(sp->myMass - np->myMass) <= parms.Fuzz)
+                                    {if (sp->RefW > (np->RefW+parms.DiskLinger))
+                                        sp=np;
+                                    }
+                                    else if (sp->myMass > np->myMass) sp=np;
+                                } else {
+                                 if (abs(sp->myLoad - np->myLoad) <= parms.Fuzz)
+                                    {if (selR.selPack)
+                                        {if (--selR.selPack)          sp=np;
+                                            else break;
+                                        }
+                                        else if (sp->RefR > np->RefR) sp=np;
+                                    }
+                                    else if (sp->myLoad > np->myLoad) sp=np;
+                                }
+                             Multi = true;
+                            }
+                    }
+             return sp;
+            }
+};
+#endif
@@ -0,0 +1,449 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C m s S u m m a r y . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <netinet/in.h>
+#include <sys/uio.h>
+
+#include "XProtocol/YProtocol.hh"
+
+#include "XrdCms/XrdCmsBloom.hh"
+#include "XrdCms/XrdCmsConfig.hh"
+#include "XrdCms/XrdCmsManager.hh"
+#include "XrdCms/XrdCmsSummary.hh"
+#include "XrdCms/XrdCmsTrace.hh"
+
+#include "XrdOuc/XrdOucName2Name.hh"
+#include "XrdOuc/XrdOucNSWalk.hh"
+#include "XrdSys/XrdSysError.hh"
+
+using namespace XrdCms;
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+XrdCmsSummary XrdCms::Summary;
+
+/******************************************************************************/
+/*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
+/******************************************************************************/
+
+void *XrdCmsStartPublish(void *carg)
+     {XrdCmsSummary *mySummary = (XrdCmsSummary *)carg;
+      return mySummary->Publish();
+     }
+
+/******************************************************************************/
+/*                        L o c a l   F u n c t i o n s                       */
+/******************************************************************************/
+
+namespace
+{
+// Return true if path lies in the directory tree rooted at dir.
+//
+bool isUnder(const char *path, const char *dir)
+{
+   int dlen = strlen(dir);
+
+   if (strncmp(path, dir, dlen)) return false;
+   return dlen && (dir[dlen-1] == '/' || path[dlen] == '/' || !path[dlen]);
+}
+
+// Return the summary hash of a path. Trailing slashes are ignored so that a
+// directory is found however it is named.
+//
+unsigned long long PathHash(const char *path, int plen)
+{
+   while(plen > 1 && path[plen-1] == '/') plen--;
+   return XrdCmsBloom::Hash(path, plen);
+}
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdCmsSummary::XrdCmsSummary() : pubCond(0), mySum(0), myGen(0), Interval(0),
+                                 BitsPer(10), Walking(false), reSend(false),
+                                 sumVec(0)
+{
+   memset(Active,  0, sizeof(Active));
+   memset(Pending, 0, sizeof(Pending));
+}
+
+/******************************************************************************/
+/*                         S e r v e r   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/* Public                           N o t e                                   */
+/******************************************************************************/
+
+void XrdCmsSummary::Note(const char *path)
+{
+   unsigned long long hVal;
+
+// Ignore this call if we are not producing summaries
+//
+   if (!Interval) return;
+   hVal = PathHash(path, strlen(path));
+
+// Record the path. While walking, it goes into the summary being built when
+// the walk ends. Otherwise, it goes into the current summary as that may be
+// in the process of being sent.
+//
+   myMutex.Lock();
+   if (Walking) noteVec.push_back(hVal);
+      else if (mySum) mySum->Add(hVal);
+   myMutex.UnLock();
+}
+
+/******************************************************************************/
+/* Public                        P u b l i s h                                */
+/******************************************************************************/
+
+void *XrdCmsSummary::Publish()
+{
+   time_t nextBuild = 0, Now;
+
+// Build and send a summary every interval and resend it whenever asked
+//
+   do {if ((Now = time(0)) >= nextBuild)
+          {Build();
+           nextBuild = time(0) + Interval;
+          }
+       Send();
+       pubCond.Lock();
+       while(!reSend && (Now = time(0)) < nextBuild)
+            pubCond.Wait(static_cast<int>(nextBuild - Now));
+       reSend = false;
+       pubCond.UnLock();
+      } while(1);
+
+// We never get here
+//
+   return (void *)0;
+}
+
+/******************************************************************************/
+/* Public                         R e s e n d                                 */
+/******************************************************************************/
+
+void XrdCmsSummary::Resend()
+{
+   if (!Interval) return;
+   pubCond.Lock();
+   reSend = true;
+   pubCond.Signal();
+   pubCond.UnLock();
+}
+
+/******************************************************************************/
+/* Public                          S t a r t                                  */
+/******************************************************************************/
+
+int XrdCmsSummary::Start(int sumInt, int bitsPer)
+{
+   pthread_t tid;
+
+// Establish the parameters
+//
+   Interval = sumInt;
+   BitsPer  = bitsPer;
+
+// Start the thread that publishes our summaries
+//
+   if (XrdSysThread::Run(&tid, XrdCmsStartPublish, (void *)this,
+                            0, "Namespace summary"))
+      {Say.Emsg("Summary", errno, "start namespace summary publisher");
+       Interval = 0;
+       return 0;
+      }
+   return 1;
+}
+
+/******************************************************************************/
+/* Private                         B u i l d                                  */
+/******************************************************************************/
+
+void XrdCmsSummary::Build()
+{
+   EPNAME("Build");
+   static const int wOpts = XrdOucNSWalk::retFile | XrdOucNSWalk::retDir
+                          | XrdOucNSWalk::Recurse | XrdOucNSWalk::skpErrs;
+   std::vector<unsigned long long> hVec;
+   XrdOucNSWalk::NSEnt *nP, *nnP;
+   XrdCmsPList *pP, *xP;
+   XrdCmsBloom *bfP;
+   const char  *lfn, *pfn;
+   char pbuff[XrdCmsMAX_PATH_LEN+1], lbuff[XrdCmsMAX_PATH_LEN+1];
+   unsigned int bits;
+   int rc, hashes;
+
+// Start recording the paths that are added while we walk
+//
+   myMutex.Lock();
+   Walking = true;
+   myMutex.UnLock();
+
+// Walk each exported path that does not lie under another exported path
+//
+   for (pP = Config.PathList.First(); pP; pP = pP->Next())
+       {for (xP = Config.PathList.First(); xP; xP = xP->Next())
+            if (xP != pP && isUnder(pP->Path(), xP->Path())) break;
+        if (xP) continue;
+
+        if (!Config.lcl_N2N) pfn = pP->Path();
+           else if ((rc = Config.lcl_N2N->lfn2pfn(pP->Path(), pbuff,
+                                                  sizeof(pbuff))))
+                   {Say.Emsg("Summary",rc,"determine pfn for",pP->Path());
+                    continue;
+                   } else pfn = pbuff;
+
+        // Directories must be in the summary as well as files as a manager
+        // would otherwise say that they do not exist, starting with this one.
+        //
+        hVec.push_back(PathHash(pP->Path(), strlen(pP->Path())));
+        XrdOucNSWalk nsWalk(&Say, pfn, 0, wOpts);
+        while((nP = nsWalk.Index(rc)))
+             {do {if (!Config.lcl_N2N) lfn = nP->Path;
+                     else if (Config.lcl_N2N->pfn2lfn(nP->Path, lbuff,
+                                                      sizeof(lbuff))) lfn = 0;
+                     else lfn = lbuff;
+                  if (lfn) hVec.push_back(PathHash(lfn, strlen(lfn)));
+                  nnP = nP->Next; delete nP;
+                 } while((nP = nnP));
+             }
+       }
+
+// Fill in a new summary with everything we found
+//
+   bits = XrdCmsBloom::Sizing(hVec.size(), BitsPer, hashes);
+   bfP  = new XrdCmsBloom(bits, hashes);
+   for (size_t i = 0; i < hVec.size(); i++) bfP->Add(hVec[i]);
+
+// Add whatever was added while we walked and make it the current summary
+//
+   myMutex.Lock();
+   for (size_t i = 0; i < noteVec.size(); i++) bfP->Add(noteVec[i]);
+   if (mySum) delete mySum;
+   mySum   = bfP;
+   Walking = false;
+   std::vector<unsigned long long>().swap(noteVec);
+   myMutex.UnLock();
+
+   DEBUG(hVec.size() <<" paths in " <<bits <<" bit summary using "
+         <<hashes <<" hashes");
+}
+
+/******************************************************************************/
+/* Private                          S e n d                                   */
+/******************************************************************************/
+
+void XrdCmsSummary::Send()
+{
+   CmsBloomRequest bReq;
+   struct iovec ioV[2];
+   unsigned int bytes, offs, dlen;
+
+// Construct the fixed part of each piece. Only Build() replaces the summary
+// and it runs in this thread so it cannot change while we send it. An empty
+// summary is never sent as it would have managers think we have nothing.
+//
+   myMutex.Lock();
+   if (!mySum || mySum->Empty()) {myMutex.UnLock(); return;}
+   memset(&bReq, 0, sizeof(bReq));
+   bReq.Hdr.rrCode    = kYR_bloom;
+   bReq.Hdr.modifier  = kYR_raw;
+   bReq.Data.Gen      = htonl(++myGen);
+   bReq.Data.Bits     = htonl(mySum->Size());
+   bReq.Data.Hashes   = static_cast<kXR_char>(mySum->Hashes());
+   bytes = mySum->Bytes();
+   myMutex.UnLock();
+
+// Send the summary a piece at a time. We hold the lock while a piece is sent
+// so that a path noted after we have sent its piece is certain to have been
+// announced after the manager started receiving this summary.
+//
+   ioV[0].iov_base = (char *)&bReq;
+   ioV[0].iov_len  = sizeof(bReq);
+   for (offs = 0; offs < bytes; offs += dlen)
+       {dlen = bytes - offs;
+        if (dlen > (unsigned int)CmsBloomRequest::maxData)
+           dlen = CmsBloomRequest::maxData;
+        bReq.Data.Offset = htonl(offs);
+        bReq.Hdr.datalen = htons(static_cast<unsigned short>
+                                 (sizeof(bReq.Data) + dlen));
+        myMutex.Lock();
+        ioV[1].iov_base = (char *)mySum->Data() + offs;
+        ioV[1].iov_len  = dlen;
+        XrdCmsManager::Inform("bloom", ioV, 2, sizeof(bReq) + dlen);
+        myMutex.UnLock();
+       }
+}
+
+/******************************************************************************/
+/*                        M a n a g e r   M e t h o d s                       */
+/******************************************************************************/
+/******************************************************************************/
+/* Public                           D r o p                                   */
+/******************************************************************************/
+
+void XrdCmsSummary::Drop(int sNum)
+{
+   PendSum &pS = Pending[sNum];
+
+// Discard any summary we have for this node
+//
+   pendMutex.Lock();
+   if (pS.bfP) {delete pS.bfP; pS.bfP = 0;}
+   sumLock.WriteLock();
+   if (Active[sNum])
+      {delete Active[sNum];
+       Active[sNum] = 0;
+       sumVec &= ~SMask_t::Bit(sNum);
+      }
+   sumLock.UnLock();
+   pendMutex.UnLock();
+}
+
+/******************************************************************************/
+/* Public                           H a v e                                   */
+/******************************************************************************/
+
+void XrdCmsSummary::Have(int sNum, const char *path, int plen)
+{
+   unsigned long long hVal = PathHash(path, plen);
+
+// Add the path to the node's summary as well as to the one being received
+// as the node may have walked past the file before it was added.
+//
+   pendMutex.Lock();
+   if (Pending[sNum].bfP) Pending[sNum].bfP->Add(hVal);
+   sumLock.WriteLock();
+   if (Active[sNum]) Active[sNum]->Add(hVal);
+   sumLock.UnLock();
+   pendMutex.UnLock();
+}
+
+/******************************************************************************/
+/* Public                           L o a d                                   */
+/******************************************************************************/
+
+void XrdCmsSummary::Load(int sNum, const char *data, int dlen)
+{
+   EPNAME("Load");
+   PendSum &pS = Pending[sNum];
+   CmsBloomData bHead;
+   unsigned int gen, bits, offs;
+   int hashes;
+
+// Extract the description of this piece
+//
+   if (dlen <= (int)sizeof(bHead))
+      {Say.Emsg("Summary", "Ignoring invalid summary piece.");
+       return;
+      }
+   memcpy(&bHead, data, sizeof(bHead));
+   data += sizeof(bHead); dlen -= sizeof(bHead);
+   gen    = ntohl(bHead.Gen);
+   bits   = ntohl(bHead.Bits);
+   offs   = ntohl(bHead.Offset);
+   hashes = bHead.Hashes;
+
+// The first piece starts a new summary, discarding any partial one
+//
+   pendMutex.Lock();
+   if (!offs)
+      {if (pS.bfP) {delete pS.bfP; pS.bfP = 0;}
+       if (!XrdCmsBloom::Valid(bits, hashes))
+          {pendMutex.UnLock();
+           Say.Emsg("Summary", "Ignoring summary with an invalid size.");
+           return;
+          }
+       pS.bfP = new XrdCmsBloom(bits, hashes);
+       pS.Gen = gen; pS.Next = 0;
+      }
+
+// Any other piece must follow the previous one
+//
+   if (!pS.bfP || pS.Gen != gen || pS.Next != offs
+   ||  !pS.bfP->Merge(offs, data, dlen))
+      {if (pS.bfP) {delete pS.bfP; pS.bfP = 0;}
+       pendMutex.UnLock();
+       DEBUG("Discarded summary " <<gen <<" piece at " <<offs);
+       return;
+      }
+
+// Wait for the rest if this is not the last piece
+//
+   pS.Next += dlen;
+   if (pS.Next < pS.bfP->Bytes()) {pendMutex.UnLock(); return;}
+
+// The summary is complete so use it from now on. An empty one is not used,
+// and stops the use of any earlier one, as the node is never pruned on it.
+//
+   sumLock.WriteLock();
+   if (Active[sNum]) delete Active[sNum];
+   if (pS.bfP->Empty())
+      {delete pS.bfP;
+       Active[sNum] = 0;
+       sumVec &= ~SMask_t::Bit(sNum);
+      } else {
+       Active[sNum] = pS.bfP;
+       sumVec |= SMask_t::Bit(sNum);
+      }
+   sumLock.UnLock();
+   pS.bfP = 0;
+   pendMutex.UnLock();
+
+   DEBUG("Using " <<bits <<" bit summary " <<gen <<" for node " <<sNum);
+}
+
+/******************************************************************************/
+/* Public                          P r u n e                                  */
+/******************************************************************************/
+
+SMask_t XrdCmsSummary::Prune(SMask_t mask, const char *path, int plen)
+{
+   unsigned long long hVal;
+   SMask_t chk;
+
+// Remove each node whose summary says it does not have the path
+//
+   sumLock.ReadLock();
+   if ((chk = mask & sumVec))
+      {hVal = PathHash(path, plen);
+       for (int i = chk.First(); i >= 0; i = chk.Next(i))
+           if (!Active[i]->Test(hVal)) mask &= ~SMask_t::Bit(i);
+      }
+   sumLock.UnLock();
+   return mask;
+}
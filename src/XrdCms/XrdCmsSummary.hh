@@ -0,0 +1,122 @@
+#ifndef XRDCMSSUMMARY__H
+#define XRDCMSSUMMARY__H
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C m s S u m m a r y . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <vector>
+
+#include "XrdCms/XrdCmsTypes.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdCmsBloom;
+
+// The XrdCmsSummary object handles namespace summaries. A data server walks
+// its exported paths every so often and sends its managers a Bloom filter of
+// the files and directories it has. A manager keeps the latest summary from each node and
+// uses it to avoid asking a node about a file the node says it does not have.
+// Files that appear after the walk are added to the summary at both ends as
+// they are announced, so a summary never wrongly says a file is absent.
+//
+class XrdCmsSummary
+{
+public:
+
+// Server side
+
+// Note() records a path that was just added so that it appears in the summary
+//        being built or the one being sent.
+//
+void        Note(const char *path);
+
+void       *Publish();
+
+// Resend() asks that the current summary be sent again (e.g., after a login).
+//
+void        Resend();
+
+int         Start(int sumInt, int bitsPer);
+
+// Manager side
+
+// Drop() discards the summary for the indicated node.
+//
+void        Drop(int sNum);
+
+// Have() adds a path that the node says it has to the node's summary.
+//
+void        Have(int sNum, const char *path, int plen);
+
+// Load() adds a piece of a node's summary. The summary is used once complete.
+//
+void        Load(int sNum, const char *data, int dlen);
+
+// Prune() returns the nodes in mask that may have the path. Nodes that have
+//         not sent a complete, non-empty summary are always returned.
+//
+SMask_t     Prune(SMask_t mask, const char *path, int plen);
+
+            XrdCmsSummary();
+           ~XrdCmsSummary() {}  // Never gets deleted
+
+private:
+
+void        Build();
+void        Send();
+
+// Server side
+//
+XrdSysMutex     myMutex;     // Serializes Note() with Build() and Send()
+XrdSysCondVar   pubCond;
+std::vector<unsigned long long> noteVec;
+XrdCmsBloom    *mySum;
+unsigned int    myGen;
+int             Interval;
+int             BitsPer;
+bool            Walking;
+bool            reSend;
+
+// Manager side (lock pendMutex before sumLock)
+//
+struct PendSum
+      {XrdCmsBloom  *bfP;
+       unsigned int  Gen;
+       unsigned int  Next;
+      };
+
+XrdSysMutex     pendMutex;
+XrdSysRWLock    sumLock;
+SMask_t         sumVec;
+XrdCmsBloom    *Active[STMax];
+PendSum         Pending[STMax];
+};
+
+namespace XrdCms
+{
+extern    XrdCmsSummary Summary;
+}
+#endif
@@ -30,13 +30,25 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
   
-typedef unsigned long long SMask_t;
+#include "XrdCms/XrdCmsSMask.hh"
 
-#define FULLMASK 0xFFFFFFFFFFFFFFFFULL
-
-// The following defines our cell size (maximum subscribers)
+// The following defines our cell size (maximum subscribers). It may be raised
+// at build time (XRDCMS_STMAX, a multiple of 64) so that a single manager can
+// handle more servers without resorting to supervisors.
 //
-#define STMax 64
+#ifndef XRDCMS_STMAX
+#define XRDCMS_STMAX 64
+#endif
+
+#define STMax XRDCMS_STMAX
+
+#if STMax < 64 || STMax % 64
+#error "XRDCMS_STMAX must be a multiple of 64"
+#endif
+
+typedef XrdCmsSMask<STMax> SMask_t;
+
+#define FULLMASK SMask_t(~0LL)
 
 // The following defines the maximum number of redirectors. It is one greater
 // than the actual maximum as the zeroth is never used.
@@ -30,6 +30,7 @@ add_executable(
   Xrd/XrdMain.cc
   XrdCms/XrdCmsAdmin.cc           XrdCms/XrdCmsAdmin.hh
   XrdCms/XrdCmsBaseFS.cc          XrdCms/XrdCmsBaseFS.hh
+  XrdCms/XrdCmsBloom.cc           XrdCms/XrdCmsBloom.hh
   XrdCms/XrdCmsCache.cc           XrdCms/XrdCmsCache.hh
   XrdCms/XrdCmsCluster.cc         XrdCms/XrdCmsCluster.hh
   XrdCms/XrdCmsClustID.cc         XrdCms/XrdCmsClustID.hh
@@ -41,15 +42,19 @@ add_executable(
   XrdCms/XrdCmsManTree.cc         XrdCms/XrdCmsManTree.hh
   XrdCms/XrdCmsMeter.cc           XrdCms/XrdCmsMeter.hh
   XrdCms/XrdCmsNash.cc            XrdCms/XrdCmsNash.hh
+  XrdCms/XrdCmsNilList.cc         XrdCms/XrdCmsNilList.hh
   XrdCms/XrdCmsNode.cc            XrdCms/XrdCmsNode.hh
   XrdCms/XrdCmsPList.cc           XrdCms/XrdCmsPList.hh
   XrdCms/XrdCmsPrepare.cc         XrdCms/XrdCmsPrepare.hh
   XrdCms/XrdCmsPrepArgs.cc        XrdCms/XrdCmsPrepArgs.hh
   XrdCms/XrdCmsProtocol.cc        XrdCms/XrdCmsProtocol.hh
+                                  XrdCms/XrdCmsRank.hh
   XrdCms/XrdCmsRouting.cc         XrdCms/XrdCmsRouting.hh
   XrdCms/XrdCmsRRQ.cc             XrdCms/XrdCmsRRQ.hh
                                   XrdCms/XrdCmsSelect.hh
+                                  XrdCms/XrdCmsSelNode.hh
   XrdCms/XrdCmsState.cc           XrdCms/XrdCmsState.hh
+  XrdCms/XrdCmsSummary.cc         XrdCms/XrdCmsSummary.hh
   XrdCms/XrdCmsSupervisor.cc      XrdCms/XrdCmsSupervisor.hh
                                   XrdCms/XrdCmsTrace.hh )
 target_link_libraries(
@@ -28,6 +28,7 @@
 #include "XrdEc/XrdEcRedundancyProvider.hh"
 #include "XrdEc/XrdEcObjCfg.hh"
 
+#include <cstdlib>
 #include <string>
 #include <unordered_map>
 
@@ -76,6 +77,26 @@ namespace XrdEc
 
       bool enable_plugins;
 
+      //-----------------------------------------------------------------------
+      //! Number of decoded blocks a Reader keeps in its cache (at least one
+      //! more than the read-ahead depth is always kept); set from the
+      //! XrdCl_EC_BLKCACHE environment variable, default 4
+      //-----------------------------------------------------------------------
+      size_t blkcache;
+
+      //-----------------------------------------------------------------------
+      //! Number of blocks a Reader prefetches ahead of a sequential reader;
+      //! set from the XrdCl_EC_READAHEAD environment variable, default 2
+      //-----------------------------------------------------------------------
+      size_t readahead;
+
+      //-----------------------------------------------------------------------
+      //! Number of blocks a StrmWriter may have being encoded or written at
+      //! any one time (Write blocks when the limit is reached); set from the
+      //! XrdCl_EC_WRTINFLIGHT environment variable, default 16
+      //-----------------------------------------------------------------------
+      size_t wrtinflight;
+
     private:
 
       std::unordered_map<std::string, RedundancyProvider> redundancies;
@@ -84,8 +105,15 @@ namespace XrdEc
       //-----------------------------------------------------------------------
       //! Constructor
       //-----------------------------------------------------------------------
-      Config() : enable_plugins( true )
+      Config() : enable_plugins( true ), blkcache( 4 ), readahead( 2 ),
+                 wrtinflight( 16 )
       {
+        const char *env;
+        if( ( env = getenv( "XrdCl_EC_BLKCACHE" ) ) ) blkcache = strtoul( env, 0, 10 );
+        if( ( env = getenv( "XrdCl_EC_READAHEAD" ) ) ) readahead = strtoul( env, 0, 10 );
+        if( ( env = getenv( "XrdCl_EC_WRTINFLIGHT" ) ) ) wrtinflight = strtoul( env, 0, 10 );
+        if( blkcache < 1 ) blkcache = 1;
+        if( wrtinflight < 1 ) wrtinflight = 1;
       }
 
       Config( const Config& ) = delete;            //< Copy constructor
@@ -213,6 +213,25 @@ namespace XrdEc
       usrcb( XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInvalidOp ), 0 );
     }
 
+    //-----------------------------------------------------------------------
+    // Start loading all the data stripes that have not been requested yet
+    // (used for read-ahead)
+    //
+    // @param self     : the block_t object
+    // @param timeout  : operation timeout
+    //-----------------------------------------------------------------------
+    static void prefetch( std::shared_ptr<block_t> &self, uint16_t timeout )
+    {
+      std::unique_lock<std::mutex> lck( self->mtx );
+      for( size_t strpid = 0; strpid < self->objcfg.nbdata; ++strpid )
+      {
+        if( self->state[strpid] != Empty ) continue;
+        self->reader.Read( self->blkid, strpid, self->stripes[strpid],
+                           read_callback( self, strpid ), timeout );
+        self->state[strpid] = Loading;
+      }
+    }
+
     //-----------------------------------------------------------------------
     // If neccessary trigger error correction procedure
     // @param self : the block_t object
@@ -426,6 +445,15 @@ namespace XrdEc
   //---------------------------------------------------------------------------
   Reader::~Reader()
   {
+    //-------------------------------------------------------------------------
+    // Read-ahead may still have reads in flight, their callbacks refer to us.
+    // We may be destroyed from one of those callbacks, so the callbacks that
+    // are running on this very thread are not waited for.
+    //-------------------------------------------------------------------------
+    std::shared_ptr<rdstate_t> state = rdstate;
+    std::thread::id self = std::this_thread::get_id();
+    std::unique_lock<std::mutex> lck( state->mtx );
+    state->cv.wait( lck, [&]{ return state->inflight == state->incb.count( self ); } );
   }
 
   //---------------------------------------------------------------------------
@@ -507,6 +535,19 @@ namespace XrdEc
       return;
     }
 
+    //-----------------------------------------------------------------------
+    // Check if this is a sequential read that moved on to a new block, if so
+    // we will read ahead once the requests for the data have been issued
+    //-----------------------------------------------------------------------
+    size_t rablk  = ( offset + length - 1 ) / objcfg.datasize;
+    bool   rdahead;
+    {
+      std::unique_lock<std::mutex> lck( blkmtx );
+      rdahead = offset == nxtoff &&
+                ( nxtoff == 0 || rablk != ( nxtoff - 1 ) / objcfg.datasize );
+      nxtoff  = offset + length;
+    }
+
     char *usrbuff = reinterpret_cast<char*>( buffer );
     typedef std::tuple<uint64_t, uint32_t,
                        void*, uint32_t,
@@ -527,14 +568,11 @@ namespace XrdEc
       //-------------------------------------------------------------------
       // Make sure we operate on a valid block
       //-------------------------------------------------------------------
-      std::unique_lock<std::mutex> lck( blkmtx );
-      if( !block || block->blkid != blkid )
-        block = std::make_shared<block_t>( blkid, *this, objcfg );
+      bool created;
+      auto blk = GetBlock( blkid, created );
       //-------------------------------------------------------------------
       // Prepare the callback for reading from single stripe
       //-------------------------------------------------------------------
-      auto blk = block;
-      lck.unlock();
       auto callback = [blk, rdctx, rdsize, rdmtx]( const XrdCl::XRootDStatus &st, uint32_t nbrd )
       {
         std::unique_lock<std::mutex> lck( *rdmtx );
@@ -580,6 +618,54 @@ namespace XrdEc
       length  -= rdsize;
       usrbuff += rdsize;
     }
+
+    if( rdahead ) ReadAhead( rablk, timeout );
+  }
+
+  //-----------------------------------------------------------------------
+  // Get the block from the cache (create it if necessary)
+  //-----------------------------------------------------------------------
+  std::shared_ptr<block_t> Reader::GetBlock( size_t blkid, bool &created )
+  {
+    std::unique_lock<std::mutex> lck( blkmtx );
+    auto itr = blkmap.find( blkid );
+    created = ( itr == blkmap.end() );
+    //---------------------------------------------------------------------
+    // We have it already, make it the most recently used one
+    //---------------------------------------------------------------------
+    if( !created )
+    {
+      blklru.splice( blklru.begin(), blklru, itr->second );
+      return blklru.front();
+    }
+    //---------------------------------------------------------------------
+    // Make room for the new block, the blocks we evict stay alive as long
+    // as there are outstanding reads for them
+    //---------------------------------------------------------------------
+    Config &cfg = Config::Instance();
+    size_t maxblks = std::max( cfg.blkcache, cfg.readahead + 1 );
+    while( blklru.size() >= maxblks )
+    {
+      blkmap.erase( blklru.back()->blkid );
+      blklru.pop_back();
+    }
+    blklru.emplace_front( std::make_shared<block_t>( blkid, *this, objcfg ) );
+    blkmap.emplace( blkid, blklru.begin() );
+    return blklru.front();
+  }
+
+  //-----------------------------------------------------------------------
+  // Start loading the blocks following given block
+  //-----------------------------------------------------------------------
+  void Reader::ReadAhead( size_t blkid, uint16_t timeout )
+  {
+    size_t depth = Config::Instance().readahead;
+    for( size_t i = 1; i <= depth && blkid + i <= lstblk; ++i )
+    {
+      bool created;
+      auto blk = GetBlock( blkid + i, created );
+      if( created ) block_t::prefetch( blk, timeout );
+    }
   }
 
   //-----------------------------------------------------------------------
@@ -613,8 +699,29 @@ namespace XrdEc
   //-------------------------------------------------------------------------
   // on-definition is not allowed here beforeiven stripes from given block
   //-------------------------------------------------------------------------
-  void Reader::Read( size_t blknb, size_t strpnb, buffer_t &buffer, callback_t cb, uint16_t timeout )
+  void Reader::Read( size_t blknb, size_t strpnb, buffer_t &buffer, callback_t usrcb, uint16_t timeout )
   {
+    // account for the read until the callback has been called
+    // (the reader may be gone once usrcb returns, so only the shared state
+    // is touched after that)
+    std::shared_ptr<rdstate_t> state = rdstate;
+    {
+      std::unique_lock<std::mutex> lck( state->mtx );
+      ++state->inflight;
+    }
+    callback_t cb = [state, usrcb]( const XrdCl::XRootDStatus &st, uint32_t nbrd )
+                    {
+                      std::thread::id self = std::this_thread::get_id();
+                      {
+                        std::unique_lock<std::mutex> lck( state->mtx );
+                        state->incb.insert( self );
+                      }
+                      usrcb( st, nbrd );
+                      std::unique_lock<std::mutex> lck( state->mtx );
+                      state->incb.erase( state->incb.find( self ) );
+                      --state->inflight;
+                      state->cv.notify_all();
+                    };
     // generate the file name (blknb/strpnb)
     std::string fn = objcfg.GetFileName( blknb, strpnb );
     // if the block/stripe does not exist it means we are reading passed the end of the file
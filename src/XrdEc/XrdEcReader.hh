@@ -30,7 +30,12 @@
 #include "XrdCl/XrdClZipArchive.hh"
 #include "XrdCl/XrdClOperations.hh"
 
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -66,7 +71,7 @@ namespace XrdEc
       //! @param objcfg : configuration for the data object (e.g. number of
       //!                 data and parity stripes)
       //-----------------------------------------------------------------------
-      Reader( ObjCfg &objcfg ) : objcfg( objcfg ), lstblk( 0 ), filesize( 0 )
+      Reader( ObjCfg &objcfg ) : objcfg( objcfg ), lstblk( 0 ), filesize( 0 ), nxtoff( 0 ), rdstate( std::make_shared<rdstate_t>() )
       {
       }
 
@@ -167,6 +172,24 @@ namespace XrdEc
       //-----------------------------------------------------------------------
       bool IsMissing( const std::string &fn );
 
+      //-----------------------------------------------------------------------
+      //! Get the block from the cache, if it is not there create it (evicting
+      //! the least recently used block if the cache is full)
+      //!
+      //! @param blkid   : number of the block
+      //! @param created : set to true if the block was not in the cache
+      //-----------------------------------------------------------------------
+      std::shared_ptr<block_t> GetBlock( size_t blkid, bool &created );
+
+      //-----------------------------------------------------------------------
+      //! Start loading the data stripes of the blocks following given block
+      //! (up to the configured read-ahead depth)
+      //!
+      //! @param blkid   : number of the block being read
+      //! @param timeout : operation timeout
+      //-----------------------------------------------------------------------
+      void ReadAhead( size_t blkid, uint16_t timeout );
+
       inline static callback_t ErrorCorrected(Reader *reader, std::shared_ptr<block_t> &self, size_t blkid, size_t strpid);
 
       void MissingVectorRead(std::shared_ptr<block_t> &block, size_t blkid, size_t strpid, uint16_t timeout = 0);
@@ -181,10 +204,29 @@ namespace XrdEc
       metadata_t                metadata;  //> map URL to CD metadata
       urlmap_t                  urlmap;    //> map blknb/strpnb (data chunk) to URL
       missing_t                 missing;   //> set of missing stripes
-      std::shared_ptr<block_t>  block;     //> cache for the block we are reading from
-      std::mutex                blkmtx;    //> mutex guarding the block from parallel access
+      typedef std::list<std::shared_ptr<block_t>> blklru_t;
+      typedef std::unordered_map<size_t, blklru_t::iterator> blkmap_t;
+
+      blklru_t                  blklru;    //> cache of blocks, most recently used first
+      blkmap_t                  blkmap;    //> map block number to its place in blklru
+      std::mutex                blkmtx;    //> mutex guarding the block cache
       size_t                    lstblk;    //> last block number
       uint64_t                  filesize;  //> file size (obtained from xattr)
+      uint64_t                  nxtoff;    //> offset following the last read (detects sequential reads)
+
+      //-----------------------------------------------------------------------
+      // Stripe reads in flight; kept apart from the reader so that a read
+      // callback that destroys the reader can still account for itself
+      //-----------------------------------------------------------------------
+      struct rdstate_t
+      {
+        rdstate_t() : inflight( 0 ) { }
+        std::mutex                              mtx;      //> mutex guarding the members below
+        std::condition_variable                 cv;       //> signalled when a read callback returns
+        size_t                                  inflight; //> number of stripe reads in flight
+        std::unordered_multiset<std::thread::id> incb;    //> threads running a read callback
+      };
+      std::shared_ptr<rdstate_t> rdstate;  //> reads in flight
       std::map<std::string, size_t>  archiveIndices;
 
       std::mutex	missingChunksMutex;
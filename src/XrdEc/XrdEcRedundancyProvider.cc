@@ -154,55 +154,110 @@ RedundancyProvider::RedundancyProvider( const ObjCfg &objcfg ) :
   // k = data
   // m = data + parity
   gf_gen_cauchy1_matrix( encode_matrix.data(), static_cast<int>( objcfg.nbchunks ), static_cast<int>( objcfg.nbdata ) );
+
+  // start with room for all the single and double error patterns of a
+  // typical configuration, the map grows if needed
+  tblmaps.emplace_back( new TableMap( 64 ) );
+  tblmap.store( tblmaps.back().get(), std::memory_order_release );
 }
 
 
-std::string RedundancyProvider::getErrorPattern( stripes_t &stripes ) const
+RedundancyProvider::pattern_t RedundancyProvider::getErrorPattern( stripes_t &stripes, size_t &nerrs ) const
 {
-  std::string pattern( objcfg.nbchunks, 0 );
+  pattern_t pattern;
+  nerrs = 0;
   for( uint8_t i = 0; i < objcfg.nbchunks; ++i )
-    if( !stripes[i].valid ) pattern[i] = '\1';
+    if( !stripes[i].valid )
+    {
+      pattern.set( i );
+      ++nerrs;
+    }
 
   return pattern;
 }
 
 
-RedundancyProvider::CodingTable& RedundancyProvider::getCodingTable( const std::string& pattern )
+RedundancyProvider::CodingTable* RedundancyProvider::lookup( const TableMap &map, size_t hash, const pattern_t& pattern )
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
-  /* If decode matrix is not already cached we have to construct it. */
-  if( !cache.count(pattern) )
+  for( size_t i = hash & map.mask; ; i = ( i + 1 ) & map.mask )
   {
-    /* Expand pattern */
-    int nerrs = 0, nsrcerrs = 0;
-    unsigned char err_indx_list[objcfg.nbparity];
-    for (std::uint8_t i = 0; i < pattern.size(); i++) {
-      if (pattern[i]) {
-        err_indx_list[nerrs++] = i;
-        if (i < objcfg.nbdata) { nsrcerrs++; }
-      }
+    CodingTable *dd = map.slots[i].load( std::memory_order_acquire );
+    if( !dd || dd->pattern == pattern ) return dd;
+  }
+}
+
+
+std::unique_ptr<RedundancyProvider::CodingTable> RedundancyProvider::makeCodingTable( const pattern_t& pattern )
+{
+  /* Expand pattern */
+  int nerrs = 0, nsrcerrs = 0;
+  unsigned char err_indx_list[objcfg.nbparity];
+  unsigned char src_in_err[objcfg.nbchunks];
+  for (std::uint8_t i = 0; i < objcfg.nbchunks; i++) {
+    src_in_err[i] = pattern[i];
+    if (pattern[i]) {
+      err_indx_list[nerrs++] = i;
+      if (i < objcfg.nbdata) { nsrcerrs++; }
     }
+  }
+
+  /* Allocate Decode Object. */
+  std::unique_ptr<CodingTable> dd( new CodingTable() );
+  dd->pattern = pattern;
+  dd->nErrors = nerrs;
+  dd->blockIndices.resize( objcfg.nbdata );
+  dd->errIndices.assign( err_indx_list, err_indx_list + nerrs );
+  dd->table.resize( objcfg.nbdata * objcfg.nbparity * 32);
+
+  /* Compute decode matrix. */
+  std::vector<unsigned char> decode_matrix(objcfg.nbchunks * objcfg.nbdata);
+
+  if (gf_gen_decode_matrix( encode_matrix.data(), decode_matrix.data(), dd->blockIndices.data(),
+                            err_indx_list, src_in_err, nerrs, nsrcerrs,
+                            static_cast<int>( objcfg.nbdata ), static_cast<int>( objcfg.nbchunks ) ) )
+    throw IOError( XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError, errno, "Failed computing decode matrix" ) );
+
+  /* Compute Tables. */
+  ec_init_tables( static_cast<int>( objcfg.nbdata ), nerrs, decode_matrix.data(), dd->table.data() );
+  return dd;
+}
 
-    /* Allocate Decode Object. */
-    CodingTable dd;
-    dd.nErrors = nerrs;
-    dd.blockIndices.resize( objcfg.nbdata );
-    dd.table.resize( objcfg.nbdata * objcfg.nbparity * 32);
 
-    /* Compute decode matrix. */
-    std::vector<unsigned char> decode_matrix(objcfg.nbchunks * objcfg.nbdata);
+RedundancyProvider::CodingTable& RedundancyProvider::getCodingTable( const pattern_t& pattern )
+{
+  /* Fast path, the table has been constructed already. */
+  size_t hash = std::hash<pattern_t>()( pattern );
+  CodingTable *dd = lookup( *tblmap.load( std::memory_order_acquire ), hash, pattern );
+  if( dd ) return *dd;
 
-    if (gf_gen_decode_matrix( encode_matrix.data(), decode_matrix.data(), dd.blockIndices.data(),
-                              err_indx_list, (unsigned char*) pattern.c_str(), nerrs, nsrcerrs,
-                              static_cast<int>( objcfg.nbdata ), static_cast<int>( objcfg.nbchunks ) ) )
-      throw IOError( XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError, errno, "Failed computing decode matrix" ) );
+  /* Slow path, someone might have beaten us to it so check again. */
+  std::lock_guard<std::mutex> lock(mutex);
+  TableMap *map = tblmap.load( std::memory_order_relaxed );
+  if( ( dd = lookup( *map, hash, pattern ) ) ) return *dd;
 
-    /* Compute Tables. */
-    ec_init_tables( static_cast<int>( objcfg.nbdata ), nerrs, decode_matrix.data(), dd.table.data() );
-    cache.insert( std::make_pair(pattern, dd) );
+  /* If decode matrix is not already cached we have to construct it. */
+  tables.emplace_back( makeCodingTable( pattern ) );
+  dd = tables.back().get();
+
+  /* Keep the map at most half full, publish a bigger copy if needed. */
+  if( tables.size() * 2 > map->mask + 1 )
+  {
+    TableMap *newmap = new TableMap( ( map->mask + 1 ) * 2 );
+    tblmaps.emplace_back( newmap );
+    for( auto &tbl : tables )
+    {
+      size_t i = std::hash<pattern_t>()( tbl->pattern ) & newmap->mask;
+      while( newmap->slots[i].load( std::memory_order_relaxed ) ) i = ( i + 1 ) & newmap->mask;
+      newmap->slots[i].store( tbl.get(), std::memory_order_relaxed );
+    }
+    tblmap.store( newmap, std::memory_order_release );
+    return *dd;
   }
-  return cache.at(pattern);
+
+  size_t i = hash & map->mask;
+  while( map->slots[i].load( std::memory_order_relaxed ) ) i = ( i + 1 ) & map->mask;
+  map->slots[i].store( dd, std::memory_order_release );
+  return *dd;
 }
 
 void RedundancyProvider::replication( stripes_t &stripes )
@@ -227,11 +282,15 @@ void RedundancyProvider::replication( stripes_t &stripes )
 
 void RedundancyProvider::compute( stripes_t &stripes )
 {
-  /* throws if stripe is not recoverable */
-  std::string pattern = getErrorPattern( stripes );
+  size_t nerrs = 0;
+  pattern_t pattern = getErrorPattern( stripes, nerrs );
 
-  /* nothing to do if there are no parity blocks. */
-  if ( !objcfg.nbparity ) return;
+  /* nothing to do if there are no parity blocks or no missing blocks. */
+  if ( !objcfg.nbparity || !nerrs ) return;
+
+  /* throws if stripe is not recoverable */
+  if ( nerrs > objcfg.nbparity )
+    throw IOError( XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError ) );
 
   /* in case of a single data block use replication */
   if ( objcfg.nbdata == 1 )
@@ -244,13 +303,10 @@ void RedundancyProvider::compute( stripes_t &stripes )
   for( uint8_t i = 0; i < objcfg.nbdata; i++ )
     inbuf[i] = reinterpret_cast<unsigned char*>( stripes[dd.blockIndices[i]].buffer );
 
-  std::vector<unsigned char> memory( dd.nErrors * objcfg.chunksize );
-
+  /* the missing blocks are decoded in place, the inputs are never among them */
   unsigned char* outbuf[dd.nErrors];
   for (int i = 0; i < dd.nErrors; i++)
-  {
-    outbuf[i] = &memory[i * objcfg.chunksize];
-  }
+    outbuf[i] = reinterpret_cast<unsigned char*>( stripes[dd.errIndices[i]].buffer );
 
   ec_encode_data(
       static_cast<int>( objcfg.chunksize ), // Length of each block of data (vector) of source or destination data.
@@ -260,16 +316,6 @@ void RedundancyProvider::compute( stripes_t &stripes )
       inbuf,          // Array of pointers to source input buffers
       outbuf          // Array of pointers to coded output buffers
   );
-
-  int e = 0;
-  for (size_t i = 0; i < objcfg.nbchunks; i++)
-  {
-    if( pattern[i] )
-    {
-      memcpy( stripes[i].buffer, outbuf[e], objcfg.chunksize );
-      e++;
-    }
-  }
 }
 
 
@@ -25,10 +25,11 @@
 #include "XrdEc/XrdEcObjCfg.hh"
 #include "XrdEc/XrdEcUtilities.hh"
 
+#include <atomic>
+#include <bitset>
 #include <memory>
 #include <vector>
 #include <string>
-#include <unordered_map>
 #include <mutex>
 
 namespace XrdEc
@@ -58,30 +59,58 @@ namespace XrdEc
     RedundancyProvider( const ObjCfg &objcfg );
 
   private:
+    //--------------------------------------------------------------------------
+    //! Error pattern / signature, bit i is set if block i of the stripe is
+    //! missing (the number of blocks in a stripe is an uint8_t).
+    //--------------------------------------------------------------------------
+    typedef std::bitset<256> pattern_t;
+
     //--------------------------------------------------------------------------
     //! Data structure to store all information required for a decode process with
     //! a known error pattern.
     //--------------------------------------------------------------------------
     struct CodingTable {
+      //! the error pattern this table has been constructed for
+      pattern_t pattern;
       //! the coding table
       std::vector<unsigned char> table;
       //! array of nData size, containing stripe indices to input blocks
       std::vector<unsigned int> blockIndices;
+      //! array of nErrors size, containing stripe indices to output blocks
+      std::vector<unsigned int> errIndices;
       //! Number of errors this coding table is constructed for (maximum==nParity)
       int nErrors;
     };
 
     //--------------------------------------------------------------------------
-    //! Constructs a string of the error pattern / signature. Each missing block
-    //! in the stripe is counted as an error block, existing blocks are assumed
-    //! to be correct (crc integrity checks of blocks should be done previously
-    //! to attempting erasure decoding).
+    //! Open addressing hash table of coding tables. Slots are only ever filled
+    //! (under the mutex), hence readers can probe it without locking. When it
+    //! gets half full a twice as big copy is published, the old one is kept
+    //! until the provider is destroyed as readers may still be probing it.
+    //--------------------------------------------------------------------------
+    struct TableMap {
+      TableMap( size_t size ) : mask( size - 1 ), slots( new std::atomic<CodingTable*>[size] )
+      {
+        for( size_t i = 0; i < size; ++i ) slots[i].store( nullptr, std::memory_order_relaxed );
+      }
+      //! size of the table - 1 (the size is a power of 2)
+      size_t mask;
+      //! the slots
+      std::unique_ptr<std::atomic<CodingTable*>[]> slots;
+    };
+
+    //--------------------------------------------------------------------------
+    //! Constructs the error pattern / signature. Each missing block in the
+    //! stripe is counted as an error block, existing blocks are assumed to be
+    //! correct (crc integrity checks of blocks should be done previously to
+    //! attempting erasure decoding).
     //!
     //! @param stripes vector of nData+nParity blocks, missing (empty) blocks
     //!        are errors
-    //! @return a string of stripe size describing the error pattern
+    //! @param nerrs   set to the number of missing blocks
+    //! @return the error pattern
     //--------------------------------------------------------------------------
-    std::string getErrorPattern( stripes_t &stripes ) const;
+    pattern_t getErrorPattern( stripes_t &stripes, size_t &nerrs ) const;
 
     //--------------------------------------------------------------------------
     //! Returns a reference to the coding table for the requested error pattern,
@@ -92,9 +121,21 @@ namespace XrdEc
     //! @return reference to the coding table for the supplied error pattern
     //--------------------------------------------------------------------------
     CodingTable& getCodingTable(
-        const std::string& pattern
+        const pattern_t& pattern
     );
 
+    //--------------------------------------------------------------------------
+    //! Constructs the coding table for the given error pattern.
+    //--------------------------------------------------------------------------
+    std::unique_ptr<CodingTable> makeCodingTable( const pattern_t& pattern );
+
+    //--------------------------------------------------------------------------
+    //! Looks up the coding table for the given error pattern in a table map.
+    //!
+    //! @return the coding table or nullptr if it is not in the map
+    //--------------------------------------------------------------------------
+    static CodingTable* lookup( const TableMap &map, size_t hash, const pattern_t& pattern );
+
   private:
 
     void replication( stripes_t &stripes );
@@ -103,9 +144,13 @@ namespace XrdEc
 
     //! the encoding matrix, required to compute any decode matrix
     std::vector<unsigned char> encode_matrix;
-    //! a cache of previously used coding tables
-    std::unordered_map<std::string, CodingTable> cache;
-    //! concurrency control
+    //! the currently published map of previously used coding tables
+    std::atomic<TableMap*> tblmap;
+    //! all the maps ever published (protected by mutex)
+    std::vector<std::unique_ptr<TableMap>> tblmaps;
+    //! all the coding tables constructed so far (protected by mutex)
+    std::vector<std::unique_ptr<CodingTable>> tables;
+    //! concurrency control for constructing new coding tables
     std::mutex mutex;
   };
 
@@ -97,9 +97,10 @@ namespace XrdEc
 
     //-------------------------------------------------------------------------
     // We can tell the user it's done as we have the date cached in the
-    // buffer
+    // buffer, unless blocks had to be parked; then we tell the user once
+    // they are on their way, which keeps a writer from getting far ahead
     //-------------------------------------------------------------------------
-    ScheduleHandler( handler );
+    WriteDone( handler );
   }
 
   //---------------------------------------------------------------------------
@@ -176,6 +177,7 @@ namespace XrdEc
         //---------------------------------------------------------------------
         for( size_t i = strpnb + 1; i < objcfg.nbdata; ++i )
           blksize += wrtbuff->GetStrpSize( i );
+        BlockDone();
         global_status.report_wrt( err, blksize );
         return;
       }
@@ -211,7 +213,11 @@ namespace XrdEc
       writes.emplace_back( std::move( p ) );
     }
 
-    XrdCl::Async( XrdCl::Parallel( writes ) >> [=]( XrdCl::XRootDStatus &st ){ global_status.report_wrt( st, blksize ); } );
+    XrdCl::Async( XrdCl::Parallel( writes ) >> [=]( XrdCl::XRootDStatus &st )
+                  {
+                    BlockDone();
+                    global_status.report_wrt( st, blksize );
+                  } );
   }
 
   //---------------------------------------------------------------------------
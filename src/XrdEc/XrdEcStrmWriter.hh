@@ -36,6 +36,7 @@
 #include <chrono>
 #include <future>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <vector>
 #include <thread>
@@ -65,7 +66,10 @@ namespace XrdEc
                                            writer_thread_stop( false ),
                                            writer_thread( writer_routine, this ),
                                            next_blknb( 0 ),
-                                           global_status( this )
+                                           global_status( this ),
+                                           inflight( 0 ),
+                                           nbparked( 0 ),
+                                           nbresumed( 0 )
       {
       }
 
@@ -133,7 +137,7 @@ namespace XrdEc
         //---------------------------------------------------------------------
         void report_wrt( const XrdCl::XRootDStatus &st, uint64_t wrtsize )
         {
-          std::unique_lock<std::recursive_mutex> lck( mtx );
+          std::unique_lock<std::mutex> lck( mtx );
           //-------------------------------------------------------------------
           // Update the global status
           //-------------------------------------------------------------------
@@ -164,7 +168,7 @@ namespace XrdEc
         //---------------------------------------------------------------------
         void issue_close( XrdCl::ResponseHandler *handler, uint16_t timeout )
         {
-          std::unique_lock<std::recursive_mutex> lck( mtx );
+          std::unique_lock<std::mutex> lck( mtx );
           //-------------------------------------------------------------------
           // There will be no more new write requests
           //-------------------------------------------------------------------
@@ -173,7 +177,11 @@ namespace XrdEc
           // If there are no outstanding writes, we can simply call the close
           // routine
           //-------------------------------------------------------------------
-          if( btsleft == 0 ) return writer->CloseImpl( handler, timeout );
+          if( btsleft == 0 )
+          {
+            lck.unlock();
+            return writer->CloseImpl( handler, timeout );
+          }
           //-------------------------------------------------------------------
           // Otherwise we save the handler for later
           //-------------------------------------------------------------------
@@ -183,15 +191,15 @@ namespace XrdEc
         //---------------------------------------------------------------------
         // get the global status value
         //---------------------------------------------------------------------
-        inline const XrdCl::XRootDStatus& get() const
+        inline XrdCl::XRootDStatus get() const
         {
-          std::unique_lock<std::recursive_mutex> lck( mtx );
+          std::unique_lock<std::mutex> lck( mtx );
           return status;
         }
 
         inline void issue_write( uint64_t wrtsize )
         {
-          std::unique_lock<std::recursive_mutex> lck( mtx );
+          std::unique_lock<std::mutex> lck( mtx );
           btsleft += wrtsize;
         }
 
@@ -201,7 +209,7 @@ namespace XrdEc
         }
 
         private:
-          mutable std::recursive_mutex  mtx;
+          mutable std::mutex            mtx;
           StrmWriter                   *writer;          //> pointer to the StrmWriter
           uint64_t                      btsleft;         //> bytes left to be written
           uint64_t                      btswritten;      //> total number of bytes written
@@ -211,11 +219,36 @@ namespace XrdEc
       };
 
       //-----------------------------------------------------------------------
-      //! Enqueue the write buffer for calculating parity and crc32c
+      //! Enqueue the write buffer for calculating parity and crc32c. If the
+      //! maximum number of blocks is already being encoded or written, the
+      //! buffer is parked instead and BlockDone() enqueues it later; the
+      //! caller never waits as it may be one of the threads that would
+      //! complete the blocks in flight.
       //!
       //! @param wrtbuff : the write buffer
       //-----------------------------------------------------------------------
       inline void EnqueueBuff( std::unique_ptr<WrtBuff> wrtbuff )
+      {
+        std::unique_lock<std::mutex> lck( inflight_mtx );
+        if( !parked.empty() || inflight >= Config::Instance().wrtinflight )
+        {
+          parked.emplace_back( std::move( wrtbuff ) );
+          ++nbparked;
+          return;
+        }
+        ++inflight;
+        // the buffer is queued under the lock so that blocks are always
+        // queued in order, whether they had to be parked or not
+        EncodeBuff( std::move( wrtbuff ) );
+      }
+
+      //-----------------------------------------------------------------------
+      //! Queue the write buffer to be erasure coded in the thread-pool (called
+      //! with inflight_mtx held)
+      //!
+      //! @param wrtbuff : the write buffer
+      //-----------------------------------------------------------------------
+      inline void EncodeBuff( std::unique_ptr<WrtBuff> wrtbuff )
       {
         // the routine to be called in the thread-pool
         // - does erasure coding
@@ -229,6 +262,24 @@ namespace XrdEc
         buffers.enqueue( ThreadPool::Instance().Execute( prepare_buff, wrtbuff.release() ) );
       }
 
+      //-----------------------------------------------------------------------
+      //! Call the user write handler once every block parked so far has been
+      //! queued, or right away if none is parked
+      //!
+      //! @param handler : user callback
+      //-----------------------------------------------------------------------
+      inline void WriteDone( XrdCl::ResponseHandler *handler )
+      {
+        std::unique_lock<std::mutex> lck( inflight_mtx );
+        if( handler && !parked.empty() )
+        {
+          waiting.emplace_back( nbparked, handler );
+          return;
+        }
+        lck.unlock();
+        ScheduleHandler( handler );
+      }
+
       //-----------------------------------------------------------------------
       //! Dequeue a write buffer after it has been erasure coded and checksumed
       //!
@@ -267,6 +318,34 @@ namespace XrdEc
       //-----------------------------------------------------------------------
       void WriteBuff( std::unique_ptr<WrtBuff> buff );
 
+      //-----------------------------------------------------------------------
+      //! Account for a block that has been written (successfully or not)
+      //-----------------------------------------------------------------------
+      inline void BlockDone()
+      {
+        std::vector<XrdCl::ResponseHandler*> ready;
+        {
+          std::unique_lock<std::mutex> lck( inflight_mtx );
+          --inflight;
+          // resume the parked blocks, in order, as far as the bound allows
+          size_t maxinflight = Config::Instance().wrtinflight;
+          while( !parked.empty() && inflight < maxinflight )
+          {
+            ++inflight;
+            ++nbresumed;
+            EncodeBuff( std::move( parked.front() ) );
+            parked.pop_front();
+          }
+          // the writes whose blocks are all queued may now be acknowledged
+          while( !waiting.empty() && waiting.front().first <= nbresumed )
+          {
+            ready.push_back( waiting.front().second );
+            waiting.pop_front();
+          }
+        }
+        for( auto handler : ready ) ScheduleHandler( handler );
+      }
+
       //-----------------------------------------------------------------------
       //! Get a buffer with metadata (CDFH and EOCD records)
       //!
@@ -293,6 +372,12 @@ namespace XrdEc
       std::thread                                      writer_thread;      //< handle to the writer thread
       size_t                                           next_blknb;         //< number of the next block to be created
       global_status_t                                  global_status;      //< global status of the writer
+      std::mutex                                       inflight_mtx;       //< mutex guarding the members below
+      size_t                                           inflight;           //< number of blocks being encoded or written
+      std::deque<std::unique_ptr<WrtBuff>>             parked;             //< blocks waiting for one in flight to finish
+      uint64_t                                         nbparked;           //< number of blocks ever parked
+      uint64_t                                         nbresumed;          //< number of parked blocks since queued
+      std::deque<std::pair<uint64_t, XrdCl::ResponseHandler*>> waiting;   //< write handlers waiting for parked blocks
   };
 
 }
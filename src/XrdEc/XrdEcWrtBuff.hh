@@ -141,7 +141,6 @@ namespace XrdEc
                                         wrtbuff( BufferPool::Instance().Create( objcfg ) )
       {
         stripes.reserve( objcfg.nbchunks );
-        memset( wrtbuff.GetBuffer(), 0, wrtbuff.GetSize() );
       }
       //-----------------------------------------------------------------------
       //! Move constructor
@@ -185,6 +184,7 @@ namespace XrdEc
         // if the buffer exist we only need to move the cursor
         if( wrtbuff.GetSize() != 0 )
         {
+          memset( wrtbuff.GetBufferAtCursor(), 0, size );
           wrtbuff.AdvanceCursor( size );
           return;
         }
@@ -256,19 +256,24 @@ namespace XrdEc
       //-----------------------------------------------------------------------
       inline void Encode()
       {
+        // the buffers are recycled, so zero whatever part of the data
+        // stripes has not been written (the parity is fully overwritten)
+        if( wrtbuff.GetCursor() < objcfg.datasize )
+          memset( wrtbuff.GetBufferAtCursor(), 0, objcfg.datasize - wrtbuff.GetCursor() );
         // first calculate the parity
         uint8_t i ;
         for( i = 0; i < objcfg.nbchunks; ++i )
           stripes.emplace_back( wrtbuff.GetBuffer( i * objcfg.chunksize ), i < objcfg.nbdata );
         Config &cfg = Config::Instance();
         cfg.GetRedundancy( objcfg ).compute( stripes );
-        // then calculate the checksums
+        // then calculate the checksums, we are already running in the thread
+        // pool and other blocks are being encoded in parallel, so there is
+        // no point in scheduling a job per stripe
         cksums.reserve( objcfg.nbchunks );
         for( uint8_t strpnb = 0; strpnb < objcfg.nbchunks; ++strpnb )
         {
           size_t chunksize = GetStrpSize( strpnb );
-          std::future<uint32_t> ftr = ThreadPool::Instance().Execute( objcfg.digest, 0, stripes[strpnb].buffer, chunksize );
-          cksums.emplace_back( std::move( ftr ) );
+          cksums.emplace_back( objcfg.digest( 0, stripes[strpnb].buffer, chunksize ) );
         }
       }
       //-----------------------------------------------------------------------
@@ -279,7 +284,7 @@ namespace XrdEc
       //-----------------------------------------------------------------------
       inline uint32_t GetCrc32c( size_t strpnb )
       {
-        return cksums[strpnb].get();
+        return cksums[strpnb];
       }
 
     private:
@@ -287,7 +292,7 @@ namespace XrdEc
       ObjCfg                             objcfg;  //< configuration for the data object
       XrdCl::Buffer                      wrtbuff; //< the buffer for the data
       stripes_t                          stripes; //< data stripes
-      std::vector<std::future<uint32_t>> cksums;  //< crc32cs for the data stripes
+      std::vector<uint32_t>              cksums;  //< crc32cs for the data stripes
   };
 
 
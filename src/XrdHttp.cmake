@@ -28,6 +28,11 @@ if( BUILD_HTTP )
     XrdHttp/XrdHttpChecksumHandler.cc XrdHttp/XrdHttpChecksumHandler.hh
     XrdHttp/XrdHttpChecksum.cc        XrdHttp/XrdHttpChecksum.hh)
 
+  if( BUILD_HTTP2 )
+    list( APPEND XrdHttpSources
+      XrdHttp/XrdHttpH2.cc            XrdHttp/XrdHttpH2.hh )
+  endif()
+
   # Note this is marked as a shared library as XrdHttp plugins are expected to
   # link against this for the XrdHttpExt class implementations.
   add_library(
@@ -58,6 +63,12 @@ if( BUILD_HTTP )
     XrdUtils
     ${LIB_XRD_HTTP_UTILS} )
 
+  if( BUILD_HTTP2 )
+    target_compile_definitions( ${LIB_XRD_HTTP_UTILS} PRIVATE HAVE_NGHTTP2 )
+    target_include_directories( ${LIB_XRD_HTTP_UTILS} PRIVATE ${NGHTTP2_INCLUDE_DIRS} )
+    target_link_libraries( ${LIB_XRD_HTTP_UTILS} PRIVATE ${NGHTTP2_LIBRARIES} )
+  endif()
+
   set_target_properties(
     ${LIB_XRD_HTTP_UTILS}
     PROPERTIES
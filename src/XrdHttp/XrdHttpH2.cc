@@ -0,0 +1,910 @@
+//------------------------------------------------------------------------------
+// This file is part of XrdHTTP: A pragmatic implementation of the
+// HTTP/WebDAV protocol for the Xrootd framework
+//
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+// File Date: Oct 2026
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/uio.h>
+
+#include <openssl/err.h>
+
+#include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdLink.hh"
+#include "XrdHttpH2.hh"
+#include "XrdHttpProtocol.hh"
+#include "XrdHttpTrace.hh"
+
+#define TRACELINK Link
+
+namespace
+{
+const char *TraceID = "H2";
+
+// Streams a client may have open at any one time
+//
+const int maxStreams = 100;
+
+// Frames are gathered up to this many bytes before being written to the link
+//
+const size_t outFlush = 128 * 1024;
+
+// DATA frames at least this large are written without being copied
+//
+const size_t sendDirect = 16384;
+
+int SelectALPN(SSL *ssl, const unsigned char **out, unsigned char *outlen,
+               const unsigned char *in, unsigned int inlen, void *arg)
+{
+  if (nghttp2_select_next_protocol((unsigned char **)out, outlen,
+                                   in, inlen) < 0)
+    return SSL_TLSEXT_ERR_NOACK;
+  return SSL_TLSEXT_ERR_OK;
+}
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdHttpH2::XrdHttpH2(XrdHttpProtocol *pP)
+  : Prot(pP), Link(pP->Link), ssl(pP->ssl), Session(0), curStream(0),
+    runWin(0), Broken(false), rspState(rsDone), rspLeft(0), outData(0),
+    outLen(0), outPend(0), outEnd(false), eofSent(false) {}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdHttpH2::~XrdHttpH2() {
+
+  if (Session) nghttp2_session_del(Session);
+
+  for (auto &it : Streams) delete it.second;
+}
+
+/******************************************************************************/
+/*                                 A b o r t                                  */
+/******************************************************************************/
+
+bool XrdHttpH2::Abort() {
+  Stream *sP = curStream;
+
+  if (Broken) return false;
+  if (!sP) return true;
+
+  // A body that runs until the link closes simply ends here. Anything else
+  // did not go out in full and the client must be told.
+  //
+  if (rspState == rsBody && rspLeft < 0)
+    return SendBody(0, 0, true) == 0;
+
+  TRACEI(REQ, "Resetting h2 stream " << sP->id);
+  curStream = 0;
+  rspState = rsDone;
+  outData = 0;
+  outLen = outPend = 0;
+  outEnd = false;
+
+  if (sP->closed) {
+    Streams.erase(sP->id);
+    delete sP;
+  } else nghttp2_submit_rst_stream(Session, NGHTTP2_FLAG_NONE, sP->id,
+                                   NGHTTP2_INTERNAL_ERROR);
+
+  if (nghttp2_session_send(Session) || Flush()) {
+    Broken = true;
+    return false;
+  }
+  return true;
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+int XrdHttpH2::Init(const char *data, int dlen) {
+  nghttp2_session_callbacks *cbs;
+  nghttp2_option *opts;
+  int bsize = Prot->myBuff->bsize, rc;
+
+  // Set up the session. We give back flow control credit ourselves.
+  //
+  if (nghttp2_session_callbacks_new(&cbs)) return -1;
+  nghttp2_session_callbacks_set_send_callback(cbs, SendCB);
+  nghttp2_session_callbacks_set_send_data_callback(cbs, SendDataCB);
+  nghttp2_session_callbacks_set_on_begin_headers_callback(cbs, OnBeginCB);
+  nghttp2_session_callbacks_set_on_header_callback(cbs, HeaderCB);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(cbs, OnChunkCB);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(cbs, OnFrameCB);
+  nghttp2_session_callbacks_set_on_stream_close_callback(cbs, OnCloseCB);
+
+  if (nghttp2_option_new(&opts)) {
+    nghttp2_session_callbacks_del(cbs);
+    return -1;
+  }
+  nghttp2_option_set_no_auto_window_update(opts, 1);
+
+  rc = nghttp2_session_server_new2(&Session, cbs, this, opts);
+  nghttp2_option_del(opts);
+  nghttp2_session_callbacks_del(cbs);
+  if (rc) {
+    Session = 0;
+    return -1;
+  }
+
+  // Size the flow control windows from the buffer the body lands in
+  //
+  nghttp2_settings_entry iv[] = {
+    {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, (uint32_t)maxStreams},
+    {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE,    (uint32_t)(bsize / 64)}
+  };
+  runWin = bsize / 2;
+  if (nghttp2_submit_settings(Session, NGHTTP2_FLAG_NONE, iv, 2)
+  ||  nghttp2_session_set_local_window_size(Session, NGHTTP2_FLAG_NONE,
+                                            0, bsize))
+    return -1;
+
+  // Take in whatever was read before we knew this was http/2
+  //
+  if (dlen > 0
+  &&  nghttp2_session_mem_recv(Session, (const uint8_t *)data, dlen) < 0) {
+    Link->setEtext("http/2 protocol error");
+    return -1;
+  }
+
+  TRACEI(REQ, "Speaking http/2; windows " << bsize / 64 << '/' << runWin);
+  return (nghttp2_session_send(Session) || Flush() ? -1 : 0);
+}
+
+/******************************************************************************/
+/*                                  i s H 2                                   */
+/******************************************************************************/
+
+bool XrdHttpH2::isH2(SSL *ssl) {
+  const unsigned char *alpn;
+  unsigned int alen;
+
+  SSL_get0_alpn_selected(ssl, &alpn, &alen);
+  return alen == 2 && !memcmp(alpn, "h2", 2);
+}
+
+/******************************************************************************/
+/*                                  N e x t                                   */
+/******************************************************************************/
+
+bool XrdHttpH2::Next() {
+  Stream *sP;
+  std::string req;
+
+  // Whatever is left of the last stream's response will never come now
+  //
+  if (curStream && !Abort()) return false;
+
+  while (!readyQ.empty()) {
+    sP = readyQ.front();
+    readyQ.pop_front();
+
+    // Rebuild the request as HTTP/1.1
+    //
+    req = sP->method + ' ' + sP->path + " HTTP/1.1\r\n";
+    if (!sP->host.empty()) req += "Host: " + sP->host + "\r\n";
+    req += sP->reqHdr;
+    if (sP->chunked) req += "Transfer-Encoding: chunked\r\n";
+    req += "\r\n";
+    sP->reqHdr.clear();
+
+    // The previous request may have left some of its body behind
+    //
+    Prot->BuffConsume(Prot->BuffUsed());
+
+    if ((int)req.size() <= Prot->BuffAvailable()) {
+      memcpy(Prot->myBuffEnd, req.data(), req.size());
+      Prot->myBuffEnd += req.size();
+      TRACEI(REQ, "Running h2 stream " << sP->id << ' ' << sP->method
+                  << ' ' << sP->path);
+
+      curStream = sP;
+      rspState = rsHead;
+      rspLine.clear();
+      rspTrail.clear();
+      rspLeft = 0;
+      eofSent = false;
+
+      // Let the client send as much of the body as half our buffer
+      //
+      if (!sP->inEnd && !sP->closed)
+        nghttp2_session_set_local_window_size(Session, NGHTTP2_FLAG_NONE,
+                                              sP->id, runWin);
+      Fill();
+      if (nghttp2_session_send(Session) || Flush()) Broken = true;
+      return true;
+    }
+
+    // Too large to ever fit
+    //
+    nghttp2_nv nva[] = {
+      {(uint8_t *)":status", (uint8_t *)"431", 7, 3, NGHTTP2_NV_FLAG_NONE}
+    };
+    nghttp2_submit_response(Session, sP->id, nva, 1, 0);
+    if (!sP->inEnd)
+      nghttp2_submit_rst_stream(Session, NGHTTP2_FLAG_NONE, sP->id,
+                                NGHTTP2_NO_ERROR);
+    if (nghttp2_session_send(Session) || Flush()) {
+      Broken = true;
+      return false;
+    }
+  }
+  return false;
+}
+
+/******************************************************************************/
+/*                               P r e f a c e                                */
+/******************************************************************************/
+
+int XrdHttpH2::Preface(const char *data, int dlen) {
+  int n = std::min(dlen, (int)NGHTTP2_CLIENT_MAGIC_LEN);
+
+  if (memcmp(data, NGHTTP2_CLIENT_MAGIC, n)) return 0;
+  return (n < (int)NGHTTP2_CLIENT_MAGIC_LEN ? -1 : 1);
+}
+
+/******************************************************************************/
+/*                                  R e c v                                   */
+/******************************************************************************/
+
+int XrdHttpH2::Recv(bool wait) {
+  int moved = Fill();
+
+  // Read from the link unless the running stream had something waiting
+  //
+  if (Broken) return -1;
+  if (!moved) {
+    do {
+      if (Read(wait)) return -1;
+      moved = Fill();
+    } while (wait && !moved && curStream && !curStream->closed
+             && !(curStream->inEnd && curStream->inPos >= curStream->inQ.size()));
+  }
+
+  // Send any acknowledgements and window updates
+  //
+  if (nghttp2_session_send(Session) || Flush()) {
+    Broken = true;
+    return -1;
+  }
+
+  // The client may have said goodbye
+  //
+  if (!nghttp2_session_want_read(Session)
+  &&  !nghttp2_session_want_write(Session)) {
+    Link->setEtext("http/2 session ended");
+    Broken = true;
+    return -1;
+  }
+  return 0;
+}
+
+/******************************************************************************/
+/*                                  S e n d                                   */
+/******************************************************************************/
+
+int XrdHttpH2::Send(const char *data, int dlen) {
+  int n;
+
+  // Follow the response through its HTTP/1.1 framing
+  //
+  while (dlen > 0) {
+    switch (rspState) {
+      case rsHead:
+        while (dlen > 0) {
+          rspLine += *data++;
+          dlen--;
+          if (rspLine.size() >= 4
+          &&  !rspLine.compare(rspLine.size() - 4, 4, "\r\n\r\n")) break;
+        }
+        if (rspLine.size() >= 4
+        &&  !rspLine.compare(rspLine.size() - 4, 4, "\r\n\r\n")
+        &&  Respond()) return -1;
+        break;
+
+      case rsBody:
+        n = (rspLeft < 0 ? dlen : (int)std::min((long long)dlen, rspLeft));
+        if (rspLeft > 0) rspLeft -= n;
+        if (SendBody(data, n, rspLeft == 0)) return -1;
+        data += n;
+        dlen -= n;
+        break;
+
+      case rsChunkLen:
+      case rsChunkEnd:
+      case rsTrailer:
+        while (dlen > 0) {
+          rspLine += *data++;
+          dlen--;
+          if (rspLine.back() == '\n') break;
+        }
+        if (rspLine.empty() || rspLine.back() != '\n') break;
+
+        if (rspState == rsChunkLen) {
+          rspLeft = strtoll(rspLine.c_str(), 0, 16);
+          rspState = (rspLeft > 0 ? rsChunkData : rsTrailer);
+        } else if (rspState == rsChunkEnd) {
+          rspState = rsChunkLen;
+        } else if (rspLine != "\r\n" && rspLine != "\n") {
+          rspTrail.push_back(rspLine);
+        } else if (SendBody(0, 0, true)) return -1;
+        rspLine.clear();
+        break;
+
+      case rsChunkData:
+        n = (int)std::min((long long)dlen, rspLeft);
+        rspLeft -= n;
+        if (SendBody(data, n, false)) return -1;
+        data += n;
+        dlen -= n;
+        if (!rspLeft) rspState = rsChunkEnd;
+        break;
+
+      default:
+        TRACEI(REQ, "Dropping " << dlen << " bytes sent past the response");
+        return 0;
+    }
+  }
+  return 0;
+}
+
+/******************************************************************************/
+/*                               S e t A L P N                                */
+/******************************************************************************/
+
+void XrdHttpH2::SetALPN(SSL_CTX *ctx) {
+  SSL_CTX_set_alpn_select_cb(ctx, SelectALPN, 0);
+}
+
+/******************************************************************************/
+/* Private:                       D a t a C B                                 */
+/******************************************************************************/
+
+ssize_t XrdHttpH2::DataCB(nghttp2_session *sess, int32_t sid, uint8_t *buf,
+                          size_t length, uint32_t *dflags,
+                          nghttp2_data_source *src, void *udata) {
+  XrdHttpH2 *h2P = (XrdHttpH2 *)udata;
+  size_t n;
+
+  if (!h2P->curStream || h2P->curStream->id != sid)
+    return NGHTTP2_ERR_DEFERRED;
+
+  // The bytes are copied straight from the caller when the frame goes out
+  //
+  n = std::min(length, (size_t)(h2P->outLen - h2P->outPend));
+  h2P->outPend += n;
+  *dflags |= NGHTTP2_DATA_FLAG_NO_COPY;
+
+  if (h2P->outEnd && h2P->outPend == h2P->outLen) {
+    *dflags |= NGHTTP2_DATA_FLAG_EOF;
+    h2P->eofSent = true;
+    if (!h2P->rspTrail.empty()) {
+      std::vector<std::string> names, values;
+      std::vector<nghttp2_nv> nva;
+      for (auto &line : h2P->rspTrail) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        size_t vbeg = line.find_first_not_of(" \t", colon + 1);
+        size_t vend = line.find_last_not_of("\r\n");
+        names.push_back(name);
+        values.push_back(vbeg == std::string::npos || vend < vbeg ? ""
+                         : line.substr(vbeg, vend - vbeg + 1));
+      }
+      for (size_t i = 0; i < names.size(); i++)
+        nva.push_back({(uint8_t *)names[i].c_str(),
+                       (uint8_t *)values[i].c_str(),
+                       names[i].size(), values[i].size(),
+                       NGHTTP2_NV_FLAG_NONE});
+      if (!nghttp2_submit_trailer(sess, sid, nva.data(), nva.size()))
+        *dflags |= NGHTTP2_DATA_FLAG_NO_END_STREAM;
+    }
+  } else if (!n) return NGHTTP2_ERR_DEFERRED;
+
+  return n;
+}
+
+/******************************************************************************/
+/* Private:                         F i l l                                   */
+/******************************************************************************/
+
+int XrdHttpH2::Fill() {
+  Stream *sP = curStream;
+  int n, credit;
+
+  if (!sP || sP->inPos >= sP->inQ.size()) return 0;
+
+  // Move as much of the body as fits into the buffer, wrapping around when
+  // the end of it has been reached
+  //
+  if (!Prot->BuffAvailable()
+  &&  Prot->myBuffEnd >= Prot->myBuff->buff + Prot->myBuff->bsize
+  &&  Prot->myBuffStart > Prot->myBuff->buff)
+    Prot->myBuffEnd = Prot->myBuff->buff;
+  n = (int)std::min((size_t)Prot->BuffAvailable(), sP->inQ.size() - sP->inPos);
+  if (n <= 0) return 0;
+  memcpy(Prot->myBuffEnd, sP->inQ.data() + sP->inPos, n);
+  Prot->myBuffEnd += n;
+  sP->inPos += n;
+
+  // Give the client back the credit for what was moved. Chunk framing is
+  // counted as body here, it evens out once the queue runs dry.
+  //
+  if (sP->inPos >= sP->inQ.size()) {
+    sP->inQ.clear();
+    sP->inPos = 0;
+    credit = sP->inRaw;
+  } else credit = std::min(n, sP->inRaw);
+
+  if (credit > 0) {
+    sP->inRaw -= credit;
+    if (!sP->closed)
+      nghttp2_session_consume_stream(Session, sP->id, credit);
+  }
+  return n;
+}
+
+/******************************************************************************/
+/* Private:                       F i n i s h                                 */
+/******************************************************************************/
+
+int XrdHttpH2::Finish() {
+  Stream *sP = curStream;
+
+  curStream = 0;
+  rspState = rsDone;
+  outData = 0;
+  outLen = outPend = 0;
+  outEnd = false;
+  if (!sP) return 0;
+
+  TRACEI(REQ, "Finished h2 stream " << sP->id);
+
+  // Stop a body that will not be read. Streams still open are deleted when
+  // nghttp2 closes them.
+  //
+  if (sP->closed) {
+    Streams.erase(sP->id);
+    delete sP;
+  } else if (!sP->inEnd)
+    nghttp2_submit_rst_stream(Session, NGHTTP2_FLAG_NONE, sP->id,
+                              NGHTTP2_NO_ERROR);
+
+  if (nghttp2_session_send(Session) || Flush()) {
+    Broken = true;
+    return -1;
+  }
+  return 0;
+}
+
+/******************************************************************************/
+/* Private:                        F l u s h                                  */
+/******************************************************************************/
+
+int XrdHttpH2::Flush() {
+  int r;
+
+  if (outBuff.empty()) return 0;
+
+  if (ssl) {
+    r = SSL_write(ssl, outBuff.data(), outBuff.size());
+    if (r <= 0) {
+      ERR_print_errors(Prot->sslbio_err);
+      Broken = true;
+      return -1;
+    }
+  } else {
+    r = Link->Send(outBuff.data(), outBuff.size());
+    if (r <= 0) {
+      Broken = true;
+      return -1;
+    }
+  }
+
+  outBuff.clear();
+  return 0;
+}
+
+/******************************************************************************/
+/* Private:                     H e a d e r C B                               */
+/******************************************************************************/
+
+int XrdHttpH2::HeaderCB(nghttp2_session *sess, const nghttp2_frame *frame,
+                        const uint8_t *name, size_t namelen,
+                        const uint8_t *value, size_t valuelen,
+                        uint8_t flags, void *udata) {
+  Stream *sP;
+  std::string hName((const char *)name, namelen);
+  std::string hVal((const char *)value, valuelen);
+
+  if (frame->hd.type != NGHTTP2_HEADERS
+  ||  frame->headers.cat != NGHTTP2_HCAT_REQUEST
+  ||  !(sP = (Stream *)nghttp2_session_get_stream_user_data(sess,
+                                                    frame->hd.stream_id)))
+    return 0;
+
+  // Pseudo headers make up the request line
+  //
+  if (hName[0] == ':') {
+    if (hName == ":method") sP->method = hVal;
+    else if (hName == ":path") sP->path = hVal;
+    else if (hName == ":authority" && sP->host.empty()) sP->host = hVal;
+    return 0;
+  }
+
+  if (hName == "host") {
+    sP->host = hVal;
+    return 0;
+  }
+  if (hName == "content-length") sP->hasLen = true;
+
+  // The parser expects the usual capitalization (e.g. Content-Length)
+  //
+  bool upper = true;
+  for (auto &c : hName) {
+    if (upper) c = toupper(c);
+    upper = (c == '-');
+  }
+  sP->reqHdr += hName + ": " + hVal + "\r\n";
+  return 0;
+}
+
+/******************************************************************************/
+/* Private:                        I n E n d                                  */
+/******************************************************************************/
+
+void XrdHttpH2::InEnd(Stream *sP) {
+
+  sP->inEnd = true;
+  if (sP->chunked) sP->inQ += "0\r\n\r\n";
+}
+
+/******************************************************************************/
+/* Private:                    O n B e g i n C B                              */
+/******************************************************************************/
+
+int XrdHttpH2::OnBeginCB(nghttp2_session *sess, const nghttp2_frame *frame,
+                         void *udata) {
+  XrdHttpH2 *h2P = (XrdHttpH2 *)udata;
+  Stream *sP;
+
+  if (frame->hd.type != NGHTTP2_HEADERS
+  ||  frame->headers.cat != NGHTTP2_HCAT_REQUEST) return 0;
+
+  sP = new Stream(frame->hd.stream_id);
+  h2P->Streams[sP->id] = sP;
+  nghttp2_session_set_stream_user_data(sess, sP->id, sP);
+  return 0;
+}
+
+/******************************************************************************/
+/* Private:                    O n C h u n k C B                              */
+/******************************************************************************/
+
+int XrdHttpH2::OnChunkCB(nghttp2_session *sess, uint8_t flags, int32_t sid,
+                         const uint8_t *data, size_t len, void *udata) {
+  Stream *sP = (Stream *)nghttp2_session_get_stream_user_data(sess, sid);
+
+  // The connection window is given back right away; it is the stream's
+  // window that holds the client to what we can buffer.
+  //
+  nghttp2_session_consume_connection(sess, len);
+  if (!sP) return 0;
+
+  if (sP->chunked) {
+    char hex[24];
+    snprintf(hex, sizeof(hex), "%zx\r\n", len);
+    sP->inQ += hex;
+    sP->inQ.append((const char *)data, len);
+    sP->inQ += "\r\n";
+  } else sP->inQ.append((const char *)data, len);
+  sP->inRaw += len;
+  return 0;
+}
+
+/******************************************************************************/
+/* Private:                    O n C l o s e C B                              */
+/******************************************************************************/
+
+int XrdHttpH2::OnCloseCB(nghttp2_session *sess, int32_t sid,
+                         uint32_t ecode, void *udata) {
+  XrdHttpH2 *h2P = (XrdHttpH2 *)udata;
+  auto it = h2P->Streams.find(sid);
+  Stream *sP;
+
+  if (it == h2P->Streams.end()) return 0;
+  sP = it->second;
+  sP->closed = true;
+
+  // The running stream is deleted once its request is done
+  //
+  if (sP == h2P->curStream) return 0;
+
+  auto qit = std::find(h2P->readyQ.begin(), h2P->readyQ.end(), sP);
+  if (qit != h2P->readyQ.end()) h2P->readyQ.erase(qit);
+  h2P->Streams.erase(it);
+  delete sP;
+  return 0;
+}
+
+/******************************************************************************/
+/* Private:                    O n F r a m e C B                              */
+/******************************************************************************/
+
+int XrdHttpH2::OnFrameCB(nghttp2_session *sess, const nghttp2_frame *frame,
+                         void *udata) {
+  XrdHttpH2 *h2P = (XrdHttpH2 *)udata;
+  Stream *sP;
+
+  if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA)
+    return 0;
+  if (!(sP = (Stream *)nghttp2_session_get_stream_user_data(sess,
+                                                    frame->hd.stream_id)))
+    return 0;
+
+  // A complete request header queues the stream. Without a length the body
+  // is handed on as chunked.
+  //
+  if (frame->hd.type == NGHTTP2_HEADERS
+  &&  frame->headers.cat == NGHTTP2_HCAT_REQUEST) {
+    sP->inEnd = (frame->hd.flags & NGHTTP2_FLAG_END_STREAM) != 0;
+    sP->chunked = !sP->inEnd && !sP->hasLen;
+    h2P->readyQ.push_back(sP);
+    return 0;
+  }
+
+  if (frame->hd.flags & NGHTTP2_FLAG_END_STREAM) h2P->InEnd(sP);
+  return 0;
+}
+
+/******************************************************************************/
+/* Private:                         P u m p                                   */
+/******************************************************************************/
+
+int XrdHttpH2::Pump() {
+
+  // Keep writing until the body handed to us has been framed, reading the
+  // client's window updates whenever the window closes.
+  //
+  while (true) {
+    if (nghttp2_session_send(Session) || Flush()) {
+      Broken = true;
+      return -1;
+    }
+    if (!outLen && (!outEnd || eofSent)) return 0;
+    if (!curStream || curStream->closed) {
+      outData = 0;
+      outLen = outPend = 0;
+      return 0;
+    }
+    if (outPend < outLen && Read(true)) return -1;
+  }
+}
+
+/******************************************************************************/
+/* Private:                         R e a d                                   */
+/******************************************************************************/
+
+int XrdHttpH2::Read(bool wait) {
+  char buff[16384];
+  ssize_t rc;
+  int rlen;
+
+  do {
+    if (ssl) {
+      rlen = SSL_read(ssl, buff, sizeof(buff));
+      if (rlen <= 0) {
+        Link->setEtext("link SSL read error");
+        ERR_print_errors(Prot->sslbio_err);
+        Broken = true;
+        return -1;
+      }
+    } else {
+      if (wait) {
+        struct iovec iov = {buff, sizeof(buff)};
+        rlen = Link->Recv(&iov, 1, Prot->readWait);
+      } else rlen = Link->Recv(buff, sizeof(buff));
+      if (rlen <= 0) {
+        Link->setEtext(rlen ? "link read error" : "link timeout or closed");
+        Broken = true;
+        return -1;
+      }
+    }
+
+    if ((rc = nghttp2_session_mem_recv(Session, (const uint8_t *)buff,
+                                       rlen)) < 0) {
+      TRACEI(REQ, "http/2 error: " << nghttp2_strerror((int)rc));
+      Link->setEtext("http/2 protocol error");
+      nghttp2_session_send(Session);
+      Flush();
+      Broken = true;
+      return -1;
+    }
+  } while (ssl && SSL_pending(ssl) > 0);
+
+  return 0;
+}
+
+/******************************************************************************/
+/* Private:                      R e s p o n d                                */
+/******************************************************************************/
+
+int XrdHttpH2::Respond() {
+  std::vector<std::string> names, values;
+  std::vector<nghttp2_nv> nva;
+  std::string status;
+  size_t pos, eol;
+  long long clen = -1;
+  bool chunked = false, noBody;
+  int code, rc;
+
+  // The status line
+  //
+  eol = rspLine.find("\r\n");
+  if (rspLine.compare(0, 7, "HTTP/1.") || eol < 12) {
+    TRACEI(REQ, "Malformed response header for h2 stream");
+    return -1;
+  }
+  status = rspLine.substr(9, 3);
+  code = atoi(status.c_str());
+  names.push_back(":status");
+  values.push_back(status);
+
+  // The header lines, less those that only make sense for HTTP/1.1
+  //
+  for (pos = eol + 2; pos < rspLine.size(); pos = eol + 2) {
+    eol = rspLine.find("\r\n", pos);
+    if (eol == std::string::npos || eol == pos) break;
+
+    size_t colon = rspLine.find(':', pos);
+    if (colon == std::string::npos || colon > eol) continue;
+    std::string name = rspLine.substr(pos, colon - pos);
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    size_t vbeg = rspLine.find_first_not_of(" \t", colon + 1);
+    std::string val = (vbeg >= eol ? "" : rspLine.substr(vbeg, eol - vbeg));
+
+    if (name == "transfer-encoding") {
+      chunked = (val.find("chunked") != std::string::npos);
+      continue;
+    }
+    if (name == "connection" || name == "keep-alive"
+    ||  name == "proxy-connection" || name == "upgrade") continue;
+    if (name == "content-length") clen = atoll(val.c_str());
+
+    names.push_back(name);
+    values.push_back(val);
+  }
+  rspLine.clear();
+
+  for (size_t i = 0; i < names.size(); i++)
+    nva.push_back({(uint8_t *)names[i].c_str(), (uint8_t *)values[i].c_str(),
+                   names[i].size(), values[i].size(), NGHTTP2_NV_FLAG_NONE});
+
+  // An interim response (e.g. 100 Continue) is sent as is
+  //
+  if (code < 200) {
+    if (!curStream->closed)
+      nghttp2_submit_headers(Session, NGHTTP2_FLAG_NONE, curStream->id, 0,
+                             nva.data(), nva.size(), 0);
+    return Pump();
+  }
+
+  noBody = curStream->method == "HEAD" || code == 204 || code == 304
+        || (!chunked && clen == 0);
+
+  if (noBody) {
+    rspState = rsDone;
+    if (!curStream->closed)
+      nghttp2_submit_response(Session, curStream->id, nva.data(), nva.size(), 0);
+    return Finish();
+  }
+
+  rspState = (chunked ? rsChunkLen : rsBody);
+  rspLeft = (chunked ? 0 : clen);
+  if (curStream->closed) return 0;
+
+  nghttp2_data_provider prd;
+  prd.source.ptr = this;
+  prd.read_callback = DataCB;
+  rc = nghttp2_submit_response(Session, curStream->id, nva.data(), nva.size(),
+                               &prd);
+  if (rc) {
+    TRACEI(REQ, "Unable to respond on h2 stream; " << nghttp2_strerror(rc));
+    return -1;
+  }
+  return Pump();
+}
+
+/******************************************************************************/
+/* Private:                     S e n d B o d y                               */
+/******************************************************************************/
+
+int XrdHttpH2::SendBody(const char *data, int dlen, bool last) {
+
+  // A stream the client reset swallows the rest of its response
+  //
+  if (!curStream->closed) {
+    outData = data;
+    outLen = dlen;
+    outPend = 0;
+    outEnd = last;
+    nghttp2_session_resume_data(Session, curStream->id);
+    if (Pump()) return -1;
+  }
+  outData = 0;
+  outLen = outPend = 0;
+
+  return (last ? Finish() : 0);
+}
+
+/******************************************************************************/
+/* Private:                       S e n d C B                                 */
+/******************************************************************************/
+
+ssize_t XrdHttpH2::SendCB(nghttp2_session *sess, const uint8_t *data,
+                          size_t length, int flags, void *udata) {
+  XrdHttpH2 *h2P = (XrdHttpH2 *)udata;
+
+  h2P->outBuff.append((const char *)data, length);
+  if (h2P->outBuff.size() >= outFlush && h2P->Flush())
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  return length;
+}
+
+/******************************************************************************/
+/* Private:                   S e n d D a t a C B                             */
+/******************************************************************************/
+
+int XrdHttpH2::SendDataCB(nghttp2_session *sess, nghttp2_frame *frame,
+                          const uint8_t *framehd, size_t length,
+                          nghttp2_data_source *src, void *udata) {
+  XrdHttpH2 *h2P = (XrdHttpH2 *)udata;
+
+  // Without TLS a full frame goes out straight from the caller's data.
+  // Otherwise copy the frame header and its share of that data.
+  //
+  if (!h2P->ssl && length >= sendDirect) {
+    struct iovec iov[2] = {{(void *)framehd, 9},
+                           {(void *)h2P->outData, length}};
+    if (h2P->Flush() || h2P->Link->Send(iov, 2, 9 + length) <= 0) {
+      h2P->Broken = true;
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+  } else {
+    h2P->outBuff.append((const char *)framehd, 9);
+    h2P->outBuff.append(h2P->outData, length);
+  }
+  h2P->outData += length;
+  h2P->outLen  -= length;
+  h2P->outPend -= length;
+
+  if (h2P->outBuff.size() >= outFlush && h2P->Flush())
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  return 0;
+}
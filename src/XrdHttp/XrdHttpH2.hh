@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+// This file is part of XrdHTTP: A pragmatic implementation of the
+// HTTP/WebDAV protocol for the Xrootd framework
+//
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+// File Date: Oct 2026
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#ifndef XROOTD_XRDHTTPH2_HH
+#define XROOTD_XRDHTTPH2_HH
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+#include <openssl/ssl.h>
+
+class XrdHttpProtocol;
+class XrdLink;
+
+/**
+ * HTTP/2 framing for one link of an XrdHttpProtocol object.
+ *
+ * The request on each stream is turned into HTTP/1.1 text and put into the
+ * protocol's buffer, where the usual parser picks it up. The HTTP/1.1
+ * response that the protocol sends back is turned into HEADERS and DATA
+ * frames for the same stream. Streams are multiplexed on the wire but run
+ * one after the other, as the link has a single bridge into xrootd; the
+ * ones that wait are queued in arrival order.
+ *
+ * Flow control follows the size of the protocol's buffer. A waiting stream
+ * may send a 1/64th of it ahead of time while the running stream may fill
+ * half of it. The connection window is a full buffer and is given back as
+ * soon as data arrives, so a stream that waits never blocks the one that
+ * runs.
+ *
+ * The object is used only while the link is being processed or while the
+ * bridge is running a request, which never happen at the same time.
+ */
+
+class XrdHttpH2 {
+public:
+
+  /// Return true if the client picked h2 via ALPN on the TLS session
+  static bool isH2(SSL *ssl);
+
+  /// Offer h2 via ALPN during the TLS handshakes of sessions made from the
+  /// context. Call it once while configuring, before any session exists.
+  static void SetALPN(SSL_CTX *ctx);
+
+  /// Check for the client connection preface used by h2c.
+  /// @return 1 if the data is the preface, 0 if it is not and -1 if there
+  ///         are too few bytes to tell
+  static int Preface(const char *data, int dlen);
+
+  /// Start the session, handing over any bytes already read from the link
+  /// @return 0 if successful, otherwise the link must be closed
+  int Init(const char *data = 0, int dlen = 0);
+
+  /// Load the next waiting stream into the protocol's buffer as HTTP/1.1.
+  /// The protocol must not be working on a request.
+  /// @return true if a request was loaded
+  bool Next();
+
+  /// Tell if a stream is waiting to run
+  bool Ready() {return !readyQ.empty();}
+
+  /// Tell if the running stream has body that is not yet in the buffer
+  bool Pending() {return curStream && curStream->inPos < curStream->inQ.size();}
+
+  /// Read frames from the link and move the running stream's body into the
+  /// protocol's buffer. With wait, block until some of the body shows up.
+  /// @return 0 if successful, -1 if the link must be closed
+  int Recv(bool wait);
+
+  /// Send HTTP/1.1 response bytes for the running stream as frames
+  /// @return 0 if successful, -1 if the link must be closed
+  int Send(const char *data, int dlen);
+
+  /// Give up on the running stream, resetting it unless its response went
+  /// out in full.
+  /// @return false if the link can no longer be used
+  bool Abort();
+
+  XrdHttpH2(XrdHttpProtocol *pP);
+  ~XrdHttpH2();
+
+private:
+
+  struct Stream {
+    std::string  reqHdr;   // HTTP/1.1 header lines, less the first
+    std::string  method;
+    std::string  path;
+    std::string  host;
+    std::string  inQ;      // Body, as it is to show up in the buffer
+    size_t       inPos;    // Bytes of inQ already put into the buffer
+    int          inRaw;    // DATA bytes not yet given back to the client
+    int32_t      id;
+    bool         hasLen;   // Request had a content-length header
+    bool         chunked;  // Body is sent on as chunked
+    bool         inEnd;    // Client sent END_STREAM
+    bool         closed;   // nghttp2 closed the stream
+
+    Stream(int32_t sid) : inPos(0), inRaw(0), id(sid), hasLen(false),
+                          chunked(false), inEnd(false), closed(false) {}
+  };
+
+  // States of the HTTP/1.1 response being turned into frames
+  //
+  enum RspState {rsHead, rsBody, rsChunkLen, rsChunkData, rsChunkEnd,
+                 rsTrailer, rsDone};
+
+  // nghttp2 callbacks
+  //
+  static ssize_t DataCB(nghttp2_session *sess, int32_t sid, uint8_t *buf,
+                        size_t length, uint32_t *dflags,
+                        nghttp2_data_source *src, void *udata);
+  static int     HeaderCB(nghttp2_session *sess, const nghttp2_frame *frame,
+                          const uint8_t *name, size_t namelen,
+                          const uint8_t *value, size_t valuelen,
+                          uint8_t flags, void *udata);
+  static int     OnBeginCB(nghttp2_session *sess, const nghttp2_frame *frame,
+                           void *udata);
+  static int     OnChunkCB(nghttp2_session *sess, uint8_t flags, int32_t sid,
+                           const uint8_t *data, size_t len, void *udata);
+  static int     OnCloseCB(nghttp2_session *sess, int32_t sid,
+                           uint32_t ecode, void *udata);
+  static int     OnFrameCB(nghttp2_session *sess, const nghttp2_frame *frame,
+                           void *udata);
+  static ssize_t SendCB(nghttp2_session *sess, const uint8_t *data,
+                        size_t length, int flags, void *udata);
+  static int     SendDataCB(nghttp2_session *sess, nghttp2_frame *frame,
+                            const uint8_t *framehd, size_t length,
+                            nghttp2_data_source *src, void *udata);
+
+  int    Fill();
+  int    Finish();
+  int    Flush();
+  void   InEnd(Stream *sP);
+  int    Pump();
+  int    Read(bool wait);
+  int    Respond();
+  int    SendBody(const char *data, int dlen, bool last);
+
+  XrdHttpProtocol          *Prot;
+  XrdLink                  *Link;
+  SSL                      *ssl;
+  nghttp2_session          *Session;
+  Stream                   *curStream;
+  std::map<int32_t, Stream*> Streams;
+  std::deque<Stream*>       readyQ;
+  std::string               outBuff;   // Frames to be written to the link
+  int                       runWin;    // Window of the running stream
+  bool                      Broken;
+
+  // The response of the running stream
+  //
+  RspState                  rspState;
+  std::string               rspLine;   // Header, chunk line or trailer
+  std::vector<std::string>  rspTrail;  // Trailer lines
+  long long                 rspLeft;   // Body bytes left, -1 until close
+  const char               *outData;   // Body bytes to be framed
+  int                       outLen;
+  int                       outPend;   // Bytes of outData promised to frames
+  bool                      outEnd;    // outData ends the body
+  bool                      eofSent;
+};
+#endif
@@ -39,6 +39,9 @@
 #include "XrdHttpUtils.hh"
 #include "XrdHttpSecXtractor.hh"
 #include "XrdHttpExtHandler.hh"
+#ifdef HAVE_NGHTTP2
+#include "XrdHttpH2.hh"
+#endif
 
 #include "XrdTls/XrdTls.hh"
 #include "XrdTls/XrdTlsContext.hh"
@@ -80,6 +83,8 @@ char *XrdHttpProtocol::sslcipherfilter = 0;
 char *XrdHttpProtocol::listredir = 0;
 bool XrdHttpProtocol::listdeny = false;
 bool XrdHttpProtocol::embeddedstatic = true;
+bool XrdHttpProtocol::usehttp2 = false;
+bool XrdHttpProtocol::h2alpn = false;
 char *XrdHttpProtocol::staticredir = 0;
 XrdOucHash<XrdHttpProtocol::StaticPreloadInfo> *XrdHttpProtocol::staticpreload = 0;
 
@@ -473,6 +478,58 @@ BIO *XrdHttpProtocol::CreateBIO(XrdLink *lp)
 #define TRACELINK Link
 
 int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
+{
+  int rc;
+
+  // We asked to be called back only to look for the next HTTP/2 stream. If
+  // the request is still going on, carry on as we would have done.
+  //
+  if (h2Redrive) {
+    h2Redrive = false;
+    if (!lp && CurrentReq.request != XrdHttpReq::rtUnset) {
+#ifdef HAVE_NGHTTP2
+      // Body that is already in hand is taken as if it had just arrived
+      if (!CurrentReq.headerok || !h2Link->Pending()) return 1;
+      lp = Link;
+#else
+      return 1;
+#endif
+    }
+  }
+
+  rc = ProcessReq(lp);
+
+#ifdef HAVE_NGHTTP2
+  // Over HTTP/2 a failed request only costs its stream, and the streams that
+  // wait are run once the current one is over. Streams run through the
+  // bridge end in a callback, so have it call us again when that happens.
+  //
+  while (h2Link) {
+    if (rc < 0) {
+      if (!DropH2Stream()) break;
+      rc = 1;
+    }
+    if (CurrentReq.request == XrdHttpReq::rtUnset) {
+      if (!h2Link->Ready()) break;
+      rc = ProcessReq(0);
+      continue;
+    }
+    if (rc > 0 && Bridge) {
+      h2Redrive = true;
+      rc = 0;
+    }
+    break;
+  }
+#endif
+
+  return rc;
+}
+
+/******************************************************************************/
+/*                            P r o c e s s R e q                             */
+/******************************************************************************/
+
+int XrdHttpProtocol::ProcessReq(XrdLink *lp)
 {
   int rc = 0;
 
@@ -558,6 +615,11 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
       if (TRACING(TRACE_AUTH)) {
         SecEntity.Display(eDest);
       }
+
+#ifdef HAVE_NGHTTP2
+      // The client may have picked h2 during the handshake
+      if (usehttp2 && XrdHttpH2::isH2(ssl) && StartH2(0, 0)) return -1;
+#endif
     }
 
 
@@ -577,12 +639,29 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
       // If we need more bytes, let's wait for another invokation
       if (BuffUsed() < ResumeBytes) return 1;
 
+#ifdef HAVE_NGHTTP2
+      // A client that knows we speak h2 starts with the connection preface
+      if (usehttp2 && !h2Link && !Bridge && !CurrentReq.headerok
+      &&  CurrentReq.request == XrdHttpReq::rtUnset && BuffUsed()) {
+        int pf = XrdHttpH2::Preface(myBuffStart, BuffUsed());
+        if (pf < 0) return 1;
+        if (pf > 0 && StartH2(myBuffStart, BuffUsed())) return -1;
+      }
+
+      // Frames that brought nothing for the running stream
+      if (h2Link && CurrentReq.headerok && !BuffUsed()) return 1;
+#endif
 
     } else
       CurrentReq.reqstate++;
   }
   DoingLogin = false;
 
+#ifdef HAVE_NGHTTP2
+  // Over HTTP/2 the next request comes from the next waiting stream
+  if (h2Link && CurrentReq.request == XrdHttpReq::rtUnset
+  &&  !CurrentReq.headerok && h2Link->Next()) CurrentReq.reqstate = 0;
+#endif
 
   // Read the next request header, that is, read until a double CRLF is found
 
@@ -877,6 +956,43 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
   TRACEI(REQ, "Process is exiting rc:" << rc);
   return rc;
 }
+
+/******************************************************************************/
+/*                          D r o p H 2 S t r e a m                           */
+/******************************************************************************/
+
+bool XrdHttpProtocol::DropH2Stream() {
+
+#ifdef HAVE_NGHTTP2
+  if (h2Link && h2Link->Abort()) {
+    CurrentReq.reset();
+    BuffConsume(BuffUsed());
+    return true;
+  }
+#endif
+  return false;
+}
+
+/******************************************************************************/
+/*                               S t a r t H 2                                */
+/******************************************************************************/
+
+#ifdef HAVE_NGHTTP2
+int XrdHttpProtocol::StartH2(const char *data, int dlen) {
+
+  // Whatever was read so far goes to the session, not to the parser
+  //
+  h2Link = new XrdHttpH2(this);
+  BuffConsume(BuffUsed());
+  if (h2Link->Init(data, dlen)) {
+    TRACEI(ALL, " Unable to start http/2 on the link.");
+    delete h2Link;
+    h2Link = 0;
+    return -1;
+  }
+  return 0;
+}
+#endif
 /******************************************************************************/
 /*                               R e c y c l e                                */
 /******************************************************************************/
@@ -1037,6 +1153,7 @@ int XrdHttpProtocol::Config(const char *ConfigFN, XrdOucEnv *myEnv) {
       else if TS_Xeq("header2cgi", xheader2cgi);
       else if TS_Xeq("httpsmode", xhttpsmode);
       else if TS_Xeq("tlsreuse", xtlsreuse);
+      else if TS_Xeq("http2", xhttp2);
       else {
         eDest.Say("Config warning: ignoring unknown directive '", var, "'.");
         Config.Echo();
@@ -1293,6 +1410,12 @@ int XrdHttpProtocol::getDataOneShot(int blen, bool wait) {
   if (!maxread)
     return 2;
 
+#ifdef HAVE_NGHTTP2
+  // Over HTTP/2 the data is the body of the running stream
+  if (h2Link)
+    return h2Link->Recv(wait);
+#endif
+
   if (ishttps) {
     int sslavail = maxread;
 
@@ -1494,6 +1617,10 @@ int XrdHttpProtocol::SendData(const char *body, int bodylen) {
 
   if (body && bodylen) {
     TRACE(REQ, "Sending " << bodylen << " bytes");
+#ifdef HAVE_NGHTTP2
+    if (h2Link)
+      return h2Link->Send(body, bodylen);
+#endif
     if (ishttps) {
       r = SSL_write(ssl, body, bodylen);
       if (r <= 0) {
@@ -1756,6 +1883,13 @@ bool XrdHttpProtocol::InitTLS() {
        return false;
       }
 
+// Offer h2 during the handshake if so wanted. This must be done here as the
+// context is shared by all connections. It survives crl refreshes.
+//
+#ifdef HAVE_NGHTTP2
+   if (usehttp2 && h2alpn) XrdHttpH2::SetALPN((SSL_CTX *)xrdctx->Context());
+#endif
+
 // All done
 //
    return true;
@@ -1769,6 +1903,11 @@ void XrdHttpProtocol::Cleanup() {
 
   TRACE(ALL, " Cleanup");
 
+#ifdef HAVE_NGHTTP2
+  delete h2Link;
+#endif
+  h2Link = 0;
+
   if (BPool && myBuff) {
     BuffConsume(BuffUsed());
     BPool->Release(myBuff);
@@ -1846,6 +1985,9 @@ void XrdHttpProtocol::Reset() {
   ResumeBytes = 0;
   Resume = 0;
 
+  h2Link = 0;
+  h2Redrive = false;
+
   //
   //  numReads = 0;
   //  numReadP = 0;
@@ -2770,6 +2912,64 @@ int XrdHttpProtocol::xtlsreuse(XrdOucStream & Config) {
    return 1;
 }
   
+/******************************************************************************/
+/*                                x h t t p 2                                 */
+/******************************************************************************/
+
+/* Function: xhttp2
+
+   Purpose:  To parse the directive: http2 {off | on [alpn]}
+
+             off      speak HTTP/1.1 only (the default)
+             on       speak HTTP/2 to clients that start with the h2
+                      connection preface (i.e. prior knowledge)
+             alpn     also offer h2 to https clients during the handshake.
+                      Streams on a connection run one at a time so a
+                      client that multiplexes requests may be slower than
+                      one using several HTTP/1.1 connections.
+
+   Output: 0 upon success or 1 upon failure.
+ */
+
+int XrdHttpProtocol::xhttp2(XrdOucStream & Config) {
+
+  char *val;
+
+// Get the argument
+//
+   val = Config.GetWord();
+   if (!val || !val[0])
+      {eDest.Emsg("Config", "http2 argument not specified"); return 1;}
+
+// Set it off or on
+//
+   h2alpn = false;
+   if (!strcmp(val, "off")) usehttp2 = false;
+      else if (!strcmp(val, "on")) usehttp2 = true;
+      else {eDest.Emsg("config", "invalid http2 parameter -", val);
+            return 1;
+           }
+
+// Check if h2 is to be offered via ALPN
+//
+   if (usehttp2 && (val = Config.GetWord()))
+      {if (strcmp(val, "alpn"))
+          {eDest.Emsg("config", "invalid http2 option -", val);
+           return 1;
+          }
+       h2alpn = true;
+      }
+
+#ifndef HAVE_NGHTTP2
+   if (usehttp2)
+      {eDest.Say("Config warning: http2 not supported by this build; "
+                 "ignoring it.");
+       usehttp2 = false;
+      }
+#endif
+   return 0;
+}
+
 /******************************************************************************/
 /*                                x t r a c e                                 */
 /******************************************************************************/
@@ -73,11 +73,13 @@ class XrdHttpExtHandler;
 struct XrdVersionInfo;
 class XrdOucGMap;
 class XrdCryptoFactory;
+class XrdHttpH2;
 
 class XrdHttpProtocol : public XrdProtocol {
   
   friend class XrdHttpReq;
   friend class XrdHttpExtReq;
+  friend class XrdHttpH2;
   
 public:
 
@@ -160,6 +162,17 @@ private:
   /// @return 0 if successful, otherwise error
   int HandleAuthentication(XrdLink* lp);
 
+  /// Process the next request on the link, as Process() does for HTTP/1.1
+  int ProcessReq(XrdLink *lp);
+
+  /// Switch the link to HTTP/2, handing over the bytes already read
+  /// @return 0 if successful, otherwise the link must be closed
+  int StartH2(const char *data, int dlen);
+
+  /// Give up on the current HTTP/2 stream, keeping the link open
+  /// @return false if the link is not HTTP/2 or can no longer be used
+  bool DropH2Stream();
+
   /// After the SSL handshake, retrieve the VOMS info and the various stuff
   /// that is needed for autorization
   int GetVOMSData(XrdLink *lp);
@@ -214,6 +227,7 @@ private:
   static int xheader2cgi(XrdOucStream &Config);
   static int xhttpsmode(XrdOucStream &Config);
   static int xtlsreuse(XrdOucStream &Config);
+  static int xhttp2(XrdOucStream &Config);
   
   static bool isRequiredXtractor; // If true treat secxtractor errors as fatal
   static XrdHttpSecXtractor *secxtractor;
@@ -314,6 +328,12 @@ private:
   bool ssldone;
   static XrdCryptoFactory *myCryptoFactory;
 
+  /// HTTP/2 framing, when the client speaks it
+  XrdHttpH2 *h2Link;
+
+  /// Tells that Process() must be called again for the next HTTP/2 stream
+  bool h2Redrive;
+
 protected:
 
   // Statistical area
@@ -404,6 +424,12 @@ protected:
   
   /// If true, use the embedded css and icons
   static bool embeddedstatic;
+
+  /// If true, speak HTTP/2 to clients that ask for it
+  static bool usehttp2;
+
+  /// If true, also offer HTTP/2 via ALPN to https clients
+  static bool h2alpn;
   
   // Url to redirect to in the case a /static is requested
   static char *staticredir;
@@ -543,7 +543,7 @@ bool XrdHttpReq::Done(XrdXrootd::Bridge::Context & info) {
   int r = PostProcessHTTPReq(true);
   // Beware, we don't have to reset() if the result is 0
   if (r) reset();
-  if (r < 0) return false; 
+  if (r < 0) return prot->DropH2Stream();
   
   
   return true;
@@ -570,8 +570,9 @@ bool XrdHttpReq::Error(XrdXrootd::Bridge::Context &info, //!< the result context
   // Second part of the ugly hack on stat()
   if ((request == rtGET) && (xrdreq.header.requestid == ntohs(kXR_stat)))
     return true;
-  
-  return false;
+
+  // An HTTP/2 link carries other streams, so only this one is given up
+  return prot->DropH2Stream();
 };
 
 bool XrdHttpReq::Redir(XrdXrootd::Bridge::Context &info, //!< the result context
@@ -1297,9 +1298,9 @@ int XrdHttpReq::ProcessHTTPReq() {
               xrdreq.read.rlen = htonl(l);
             }
 
-            // If we are using HTTPS or if the client requested trailers, disable sendfile
-            // (in the latter case, the chunked encoding prevents sendfile usage)
-            if (prot->ishttps || (m_transfer_encoding_chunked && m_trailer_headers)) {
+            // If we are using HTTPS or HTTP/2 or if the client requested trailers, disable
+            // sendfile (in the latter cases, the framing prevents sendfile usage)
+            if (prot->ishttps || prot->h2Link || (m_transfer_encoding_chunked && m_trailer_headers)) {
               if (!prot->Bridge->setSF((kXR_char *) fhandle, false)) {
                 TRACE(REQ, " XrdBridge::SetSF(false) failed.");
 
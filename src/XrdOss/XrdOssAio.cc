@@ -46,6 +46,7 @@
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysIOUring.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdSfs/XrdSfsAio.hh"
@@ -89,6 +90,27 @@ const int OSS_AIO_WRITE_DONE = SIGRTMAX;
 #endif
 #endif
 
+/******************************************************************************/
+/*                    i o _ u r i n g   C o m p l e t i o n                   */
+/******************************************************************************/
+
+namespace
+{
+void OssUringRDone(void *cbArg, int result)
+{
+   XrdSfsAio *aiop = (XrdSfsAio *)cbArg;
+   aiop->Result = result;
+   aiop->doneRead();
+}
+
+void OssUringWDone(void *cbArg, int result)
+{
+   XrdSfsAio *aiop = (XrdSfsAio *)cbArg;
+   aiop->Result = result;
+   aiop->doneWrite();
+}
+}
+
 /******************************************************************************/
 /*                                 F s y n c                                  */
 /******************************************************************************/
@@ -101,10 +123,21 @@ const int OSS_AIO_WRITE_DONE = SIGRTMAX;
 
 int XrdOssFile::Fsync(XrdSfsAio *aiop)
 {
-
-#ifdef _POSIX_ASYNCHRONOUS_IO
    int rc;
 
+// Use io_uring if it has been configured
+//
+   if (XrdOssSys::AioRing)
+      {aiop->TIdent = tident;
+       if (!(rc = XrdOssSys::AioRing->Submit(XrdSysIOUring::opFsync, fd, 0, 0,
+                                          0, OssUringWDone, (void *)aiop)))
+          return 0;
+       {int fcnt = AioFailure++;
+        if ((fcnt & 0x3ff) == 1) OssEroute.Emsg("aio", rc, "fsync via io_uring");
+       }
+      }
+
+#ifdef _POSIX_ASYNCHRONOUS_IO
 // Complete the aio request block and do the operation
 //
    if (XrdOssSys::AioAllOk)
@@ -153,11 +186,28 @@ int XrdOssFile::Fsync(XrdSfsAio *aiop)
   
 int XrdOssFile::Read(XrdSfsAio *aiop)
 {
-
-#ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioRead");
    int rc;
 
+// Use io_uring if it has been configured
+//
+   if (XrdOssSys::AioRing)
+      {aiop->TIdent = tident;
+       TRACE(Debug,  "fd=" <<fd <<" read " <<aiop->sfsAio.aio_nbytes <<'@'
+                           <<aiop->sfsAio.aio_offset <<" queued; aiocb="
+                           <<Xrd::hex1 <<aiop);
+       if (!(rc = XrdOssSys::AioRing->Submit(XrdSysIOUring::opRead, fd,
+                                          (void *)aiop->sfsAio.aio_buf,
+                                          (size_t)aiop->sfsAio.aio_nbytes,
+                                           (off_t)aiop->sfsAio.aio_offset,
+                                          OssUringRDone, (void *)aiop)))
+          return 0;
+       {int fcnt = AioFailure++;
+        if ((fcnt & 0x3ff) == 1) OssEroute.Emsg("aio", rc, "read via io_uring");
+       }
+      }
+
+#ifdef _POSIX_ASYNCHRONOUS_IO
 // Complete the aio request block and do the operation
 //
    if (XrdOssSys::AioAllOk)
@@ -211,10 +261,28 @@ int XrdOssFile::Read(XrdSfsAio *aiop)
   
 int XrdOssFile::Write(XrdSfsAio *aiop)
 {
-#ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioWrite");
    int rc;
 
+// Use io_uring if it has been configured
+//
+   if (XrdOssSys::AioRing)
+      {aiop->TIdent = tident;
+       TRACE(Debug, "fd=" <<fd <<" write " <<aiop->sfsAio.aio_nbytes <<'@'
+                          <<aiop->sfsAio.aio_offset <<" queued; aiocb="
+                          <<Xrd::hex1 <<aiop);
+       if (!(rc = XrdOssSys::AioRing->Submit(XrdSysIOUring::opWrite, fd,
+                                          (void *)aiop->sfsAio.aio_buf,
+                                          (size_t)aiop->sfsAio.aio_nbytes,
+                                           (off_t)aiop->sfsAio.aio_offset,
+                                          OssUringWDone, (void *)aiop)))
+          return 0;
+       {int fcnt = AioFailure++;
+        if ((fcnt & 0x3ff) == 1) OssEroute.Emsg("Write", rc, "write via io_uring");
+       }
+      }
+
+#ifdef _POSIX_ASYNCHRONOUS_IO
 // Complete the aio request block and do the operation
 //
    if (XrdOssSys::AioAllOk)
@@ -259,6 +327,10 @@ int XrdOssFile::Write(XrdSfsAio *aiop)
 /******************************************************************************/
 
 int   XrdOssSys::AioAllOk = 0;
+
+XrdSysIOUring *XrdOssSys::AioRing  = 0;
+int            XrdOssSys::AioRingN = 0;
+int            XrdOssSys::AioRingQ = 256;
   
 #if defined(_POSIX_ASYNCHRONOUS_IO) && !defined(HAVE_SIGWTI)
 // The folowing is for sigwaitinfo() emulation
@@ -280,6 +352,26 @@ extern "C" {extern void XrdOssAioWSH(int, siginfo_t *, void *);}
 
 int XrdOssSys::AioInit()
 {
+// If io_uring was requested, try to use it. Should the kernel not support it
+// we simply fall back to using POSIX aio.
+//
+   if (AioRingN)
+      {const char *eTxt = "";
+       int rc;
+       AioRing = new XrdSysIOUring(AioRingN, AioRingQ);
+       if (!(rc = AioRing->Init(eTxt)))
+          {char buff[80];
+           snprintf(buff, sizeof(buff), "%d ring(s) with queue depth %d.",
+                    AioRingN, AioRingQ);
+           OssEroute.Say("++++++ Async I/O using io_uring; ", buff);
+           return 1;
+          }
+       OssEroute.Emsg("AioInit", rc, eTxt);
+       OssEroute.Say("Config warning: io_uring unusable; using POSIX aio.");
+       delete AioRing;
+       AioRing = 0;
+      }
+
 #if defined(_POSIX_ASYNCHRONOUS_IO)
    EPNAME("AioInit");
    extern void *XrdOssAioWait(void *carg);
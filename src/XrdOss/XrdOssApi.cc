@@ -53,6 +53,7 @@
 #include "XrdOss/XrdOssConfig.hh"
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
+#include "XrdOss/XrdOssReadV.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
@@ -912,6 +913,11 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
    ssize_t rdsz, totBytes = 0;
    int i;
 
+// When so configured, the segments are read in offset order with those close
+// together merged into a single read (see XrdOssReadV). Prereads do not apply.
+//
+   if (XrdOssSS->rvEngine && n > 1) return XrdOssSS->rvEngine->Read(fd,readV,n);
+
 // For platforms that support fadvise, pre-advise what we will be reading
 //
 #if (defined(__linux__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))) && defined(HAVE_ATOMICS)
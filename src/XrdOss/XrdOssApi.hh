@@ -82,6 +82,8 @@ static const int    noDread  = 0x04;
 
 class oocx_CXFile;
 class XrdSfsAio;
+class XrdSysIOUring;
+class XrdOssReadV;
 class XrdOssCache_FS;
 class XrdOssMioFile;
   
@@ -200,6 +202,10 @@ int       Stats(char *bp, int bl);
 static int   AioInit();
 static int   AioAllOk;
 
+static XrdSysIOUring *AioRing;  // io_uring engine when configured and usable
+static int   AioRingN;          // Number of io_uring instances (0 -> posix aio)
+static int   AioRingQ;          // Submission queue depth per io_uring
+
 static char  tryMmap;           // Memory mapped files enabled
 static char  chkMmap;           // Memory mapped files are selective
    
@@ -279,6 +285,10 @@ int               prActive;  //    preread activity count
 short             prDepth;   //    preread depth
 short             prQSize;   //    preread maximum allowed
 
+XrdOssReadV      *rvEngine;  //    readv merging engine (nil -> not merging)
+int               rvGap;     //    readv largest gap merged (-1 -> no merging)
+int               rvMaxIO;   //    readv largest merged read
+
 XrdVersionInfo   *myVersion; //    Compilation version set by constructor
    
          XrdOssSys();
@@ -346,6 +356,7 @@ void   ConfigStats(XrdSysError &Eroute);
 void   ConfigStats(dev_t Devnum, char *lP);
 int    ConfigXeq(char *, XrdOucStream &, XrdSysError &);
 void   List_Path(const char *, const char *, unsigned long long, XrdSysError &);
+int    xaio(XrdOucStream &Config, XrdSysError &Eroute);
 int    xalloc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcache(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcachescan(XrdOucStream &Config, XrdSysError &Eroute);
@@ -356,6 +367,7 @@ int    xmemf(XrdOucStream &Config, XrdSysError &Eroute);
 int    xnml(XrdOucStream &Config, XrdSysError &Eroute);
 int    xpath(XrdOucStream &Config, XrdSysError &Eroute);
 int    xprerd(XrdOucStream &Config, XrdSysError &Eroute);
+int    xreadv(XrdOucStream &Config, XrdSysError &Eroute);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute, int *isCD=0);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute,
               const char *grp, bool isAsgn);
@@ -51,6 +51,7 @@
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
 #include "XrdOss/XrdOssOpaque.hh"
+#include "XrdOss/XrdOssReadV.hh"
 #include "XrdOss/XrdOssSpace.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdOuc/XrdOuca2x.hh"
@@ -213,6 +214,9 @@ XrdOssSys::XrdOssSys()
    prActive      = 0;
    prDepth       = 0;
    prQSize       = 0;
+   rvEngine      = 0;
+   rvGap         = -1;
+   rvMaxIO       = 1048576;
    STT_Lib       = 0;
    STT_Parms     = 0;
    STT_Func      = 0;
@@ -322,6 +326,10 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
 //
    if (!NoGo) NoGo = !AioInit();
 
+// Set up merging of readv segments, using io_uring when we have it
+//
+   if (!NoGo && rvGap >= 0) rvEngine = new XrdOssReadV(rvGap, rvMaxIO, AioRing);
+
 // Initialize memory mapping setting to speed execution
 //
    if (!NoGo) ConfigMio(Eroute);
@@ -396,7 +404,7 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
 
 void XrdOssSys::Config_Display(XrdSysError &Eroute)
 {
-     char buff[4096], *cloc;
+     char buff[4096], aioBuff[64], rvBuff[64], *cloc;
      XrdOucPList *fp;
 
      // Preset some tests
@@ -411,11 +419,21 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
      if (!ConfigFN || !ConfigFN[0]) cloc = (char *)"Default";
         else cloc = ConfigFN;
 
+     if (!AioRingN) strcpy(aioBuff, "posix");
+        else snprintf(aioBuff, sizeof(aioBuff), "uring rings %d qdepth %d",
+                      AioRingN, AioRingQ);
+
+     if (rvGap < 0) strcpy(rvBuff, "merge off");
+        else snprintf(rvBuff, sizeof(rvBuff), "merge %d maxio %d",
+                      rvGap, rvMaxIO);
+
      snprintf(buff, sizeof(buff), "Config effective %s oss configuration:\n"
+                                  "       oss.aio          %s\n"
                                   "       oss.alloc        %lld %d %d\n"
                                   "       oss.spacescan    %d\n"
                                   "       oss.fdlimit      %d %d\n"
                                   "       oss.maxsize      %lld\n"
+                                  "       oss.readv        %s\n"
                                   "%s%s%s"
                                   "%s%s%s"
                                   "%s%s%s"
@@ -424,10 +442,10 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
                                   "%s%s%s"
                                   "       oss.trace        %x\n"
                                   "       oss.xfr          %d deny %d keep %d",
-             cloc,
+             cloc, aioBuff,
              minalloc, ovhalloc, fuzalloc,
              cscanint,
-             FDFence, FDLimit, MaxSize,
+             FDFence, FDLimit, MaxSize, rvBuff,
              XrdOssConfig_Val(N2N_Lib,    namelib),
              XrdOssConfig_Val(LocalRoot,  localroot),
              XrdOssConfig_Val(RemoteRoot, remoteroot),
@@ -1046,6 +1064,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
     int nosubs;
     XrdOucEnv *myEnv = 0;
 
+   TS_Xeq("aio",           xaio);
    TS_Xeq("alloc",         xalloc);
    TS_Xeq("cache",         xcache);
    TS_Xeq("cachescan",     xcachescan); // Backward compatibility
@@ -1057,6 +1076,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    TS_Xeq("namelib",       xnml);
    TS_Xeq("path",          xpath);
    TS_Xeq("preread",       xprerd);
+   TS_Xeq("readv",         xreadv);
    TS_Xeq("space",         xspace);
    TS_Xeq("stagecmd",      xstg);
    TS_Xeq("statlib",       xstl);
@@ -1114,6 +1134,62 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
 
+/******************************************************************************/
+/*                                  x a i o                                   */
+/******************************************************************************/
+
+/* Function: xaio
+
+   Purpose:  To parse the directive: aio {posix | uring} [rings <n>] [qdepth <n>]
+
+             posix       use POSIX aio for asynchronous requests (default).
+             uring       use io_uring for asynchronous requests. Should the
+                         kernel not support io_uring, POSIX aio is used.
+             rings <n>   the number of io_uring instances to use. Threads
+                         are spread across the rings. The default is 4.
+             qdepth <n>  the submission queue depth of each ring. The
+                         default is 256.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xaio(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    int rnum = 4, qdep = 256;
+    bool useRing;
+
+    if (!(val = Config.GetWord()))
+       {Eroute.Emsg("Config", "aio engine not specified"); return 1;}
+         if (!strcmp(val, "posix")) useRing = false;
+    else if (!strcmp(val, "uring")) useRing = true;
+    else {Eroute.Emsg("Config", "invalid aio engine -", val); return 1;}
+
+    while((val = Config.GetWord()))
+         {     if (!strcmp(val, "rings"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config", "aio rings value not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute,"aio rings",val,&rnum,1,64))
+                      return 1;
+                  }
+          else if (!strcmp(val, "qdepth"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config", "aio qdepth value not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute,"aio qdepth",val,&qdep,8,32768))
+                      return 1;
+                  }
+          else {Eroute.Emsg("Config", "invalid aio option -", val); return 1;}
+         }
+
+    AioRingN = (useRing ? rnum : 0);
+    AioRingQ = qdep;
+    return 0;
+}
+
 /******************************************************************************/
 /*                                x a l l o c                                 */
 /******************************************************************************/
@@ -1533,6 +1609,70 @@ int XrdOssSys::xprerd(XrdOucStream &Config, XrdSysError &Eroute)
       prBytes = lim;
       return 0;
 }
+
+/******************************************************************************/
+/*                                x r e a d v                                 */
+/******************************************************************************/
+
+/* Function: xreadv
+
+   Purpose:  To parse the directive: readv [merge {<gap> | off}] [maxio <bytes>]
+
+             <gap>    segments of a readv that are no more than <gap> bytes
+                      apart are read using a single request. The bytes in
+                      between are read and discarded. A gap of 0 merges
+                      only segments that abut. The max is 1M. Segments are
+                      always read in offset order when merging and the
+                      preread directive does not apply.
+             off      reads each segment by itself in the order requested.
+                      This is the default.
+             <bytes>  the largest number of bytes that a merged read may
+                      span. The default is 1M (i.e. 1 megabyte). The max is
+                      16M and it may not be less than <gap>.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xreadv(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    static const long long m1 = 1048576LL, m16 = 16777216LL;
+    char *val;
+    long long gap = rvGap, maxio = rvMaxIO;
+
+      if (!(val = Config.GetWord()))
+         {Eroute.Emsg("Config", "readv option not specified"); return 1;}
+
+      while(val)
+           {     if (!strcmp(val, "merge"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","readv merge gap not specified");
+                         return 1;
+                        }
+                     if (!strcmp(val, "off")) gap = -1;
+                        else if (XrdOuca2x::a2sz(Eroute,"readv merge gap",val,
+                                                 &gap, 0, m1)) return 1;
+                    }
+            else if (!strcmp(val, "maxio"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","readv maxio not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2sz(Eroute,"readv maxio",val,&maxio,
+                                         4096, m16)) return 1;
+                    }
+            else {Eroute.Emsg("Config","invalid readv option -",val); return 1;}
+            val = Config.GetWord();
+           }
+
+      if (gap > maxio)
+         {Eroute.Emsg("Config","readv merge gap may not exceed maxio");
+          return 1;
+         }
+
+      rvGap   = static_cast<int>(gap);
+      rvMaxIO = static_cast<int>(maxio);
+      return 0;
+}
   
 /******************************************************************************/
 /*                                x s p a c e                                 */
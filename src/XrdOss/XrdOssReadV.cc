@@ -0,0 +1,205 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s R e a d V . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+#include <vector>
+#include <sys/uio.h>
+
+#include "XrdOss/XrdOssReadV.hh"
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdSys/XrdSysIOUring.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+struct rvRun
+      {XrdSysSemaphore *Done;
+       long long        Offs;     // File offset of the first segment
+       ssize_t          Want;     // Bytes to read, including any gaps
+       ssize_t          Result;   // Bytes actually read or -errno
+       int              iovBeg;
+       int              iovNum;
+       int              segBeg;   // Segments read, as indices into the order
+       int              segEnd;
+      };
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+void rvDone(void *cbArg, int result)
+{
+   rvRun *rP = static_cast<rvRun *>(cbArg);
+
+   rP->Result = result;
+   rP->Done->Post();
+}
+
+ssize_t rvRead(int fd, struct iovec *iov, int iovcnt, off_t offs)
+{
+   ssize_t rdsz;
+
+   do {rdsz = preadv(fd, iov, iovcnt, offs);} while(rdsz < 0 && errno == EINTR);
+   return (rdsz < 0 ? -errno : rdsz);
+}
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOssReadV::XrdOssReadV(int gap, int maxio, XrdSysIOUring *ring)
+                        : Ring(ring), Sink(0), Gap(gap), MaxIO(maxio),
+                          numVecs(0), numReqs(0)
+{
+// Allocate the buffer that receives the bytes between merged segments. It is
+// shared by every read as its contents are never looked at.
+//
+   if (Gap > 0) Sink = new char[Gap];
+
+// Establish how many buffers one preadv() may fill
+//
+   MaxIOV = -1;
+#ifdef _SC_IOV_MAX
+   MaxIOV = sysconf(_SC_IOV_MAX);
+#endif
+#ifdef IOV_MAX
+   if (MaxIOV <= 0) MaxIOV = IOV_MAX;
+#endif
+   if (MaxIOV <= 0) MaxIOV = 1024;
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOssReadV::~XrdOssReadV()
+{
+   if (Sink) delete [] Sink;
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+ssize_t XrdOssReadV::Read(int fd, XrdOucIOVec *readV, int n)
+{
+   std::vector<int>          order;
+   std::vector<rvRun>        runs;
+   std::vector<struct iovec> iov;
+   XrdSysSemaphore           rvSem(0);
+   ssize_t totBytes = 0, rdsz;
+   long long runEnd = 0;
+   int inFlight = 0;
+
+// Order the segments by offset, skipping empty ones
+//
+   order.reserve(n);
+   for (int i = 0; i < n; i++)
+       {if (readV[i].size > 0)
+           {order.push_back(i);
+            totBytes += readV[i].size;
+           }
+           else if (readV[i].size < 0) return -EINVAL;
+       }
+   if (order.empty()) return 0;
+
+   std::stable_sort(order.begin(), order.end(),
+                    [readV](int a, int b)
+                           {return readV[a].offset < readV[b].offset;});
+
+// Group the segments into reads. A segment joins the current read when it
+// starts at or not too far past the end of it and the read stays within size.
+// Otherwise, including when it overlaps the read, it starts a new one.
+//
+   iov.reserve(order.size()*2);
+   for (int k = 0; k < (int)order.size(); k++)
+       {XrdOucIOVec &seg = readV[order[k]];
+        if (!runs.empty())
+           {rvRun &cur = runs.back();
+            long long gap = seg.offset - runEnd;
+            if (gap >= 0 && gap <= Gap
+            &&  seg.offset + seg.size - cur.Offs <= MaxIO
+            &&  cur.iovNum + (gap ? 2 : 1) <= MaxIOV)
+               {if (gap)
+                   {iov.push_back({Sink, static_cast<size_t>(gap)});
+                    cur.iovNum++;
+                   }
+                iov.push_back({seg.data, static_cast<size_t>(seg.size)});
+                cur.iovNum++;
+                cur.segEnd = k+1;
+                runEnd   = seg.offset + seg.size;
+                cur.Want = runEnd - cur.Offs;
+                continue;
+               }
+           }
+        runs.push_back({&rvSem, seg.offset, seg.size, 0,
+                        static_cast<int>(iov.size()), 1, k, k+1});
+        iov.push_back({seg.data, static_cast<size_t>(seg.size)});
+        runEnd = seg.offset + seg.size;
+       }
+   numVecs++;
+   numReqs += runs.size();
+
+// Issue the reads. When we have an io_uring they are all issued at once and
+// any that it cannot take are done here while the others are in progress.
+//
+   bool useRing = Ring && runs.size() > 1;
+   for (rvRun &r : runs)
+       {if (useRing
+        &&  !Ring->Submit(XrdSysIOUring::opReadv, fd, &iov[r.iovBeg], r.iovNum,
+                          r.Offs, rvDone, &r)) inFlight++;
+           else r.Result = rvRead(fd, &iov[r.iovBeg], r.iovNum, r.Offs);
+       }
+   while(inFlight--) rvSem.Wait();
+
+// A read that came up short is redone one segment at a time so that we report
+// exactly what the caller would have seen had the segments been read singly.
+//
+   for (rvRun &r : runs)
+       {if (r.Result == r.Want) continue;
+        for (int k = r.segBeg; k < r.segEnd; k++)
+            {XrdOucIOVec &seg = readV[order[k]];
+             do {rdsz = pread(fd, seg.data, seg.size, seg.offset);}
+                while(rdsz < 0 && errno == EINTR);
+             if (rdsz != seg.size) return (rdsz < 0 ? -errno : -ESPIPE);
+            }
+       }
+
+// All done
+//
+   return totBytes;
+}
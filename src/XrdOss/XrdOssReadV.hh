@@ -0,0 +1,99 @@
+#ifndef XRDOSSREADV__H
+#define XRDOSSREADV__H
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s R e a d V . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+
+#include <sys/types.h>
+
+#include "XrdSys/XrdSysRAtomic.hh"
+
+class  XrdSysIOUring;
+struct XrdOucIOVec;
+
+//------------------------------------------------------------------------------
+//! XrdOssReadV performs vector reads with as few storage requests as possible.
+//! The segments are sorted by offset and those that are no more than a set
+//! number of bytes apart are read together by one preadv(), the bytes that lie
+//! between them being read into a scratch buffer and discarded. When an
+//! io_uring engine is available, the merged reads are all issued at once so
+//! that the device may service them in whatever order it likes.
+//!
+//! Segments that overlap are never merged as a single read may only place the
+//! data it reads in one buffer. Each such segment simply starts a new read.
+//------------------------------------------------------------------------------
+
+class XrdOssReadV
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Read every segment in a vector.
+//!
+//! @param  fd      - The file descriptor to read from.
+//! @param  readV   - The segments to read; the order is immaterial.
+//! @param  n       - The number of elements in readV.
+//!
+//! @return The number of bytes read upon success. Otherwise, -errno; -ESPIPE
+//!         indicates that a segment extends past the end of the file.
+//------------------------------------------------------------------------------
+
+ssize_t       Read(int fd, XrdOucIOVec *readV, int n);
+
+//------------------------------------------------------------------------------
+//! Return the number of vectors read and storage requests used to read them.
+//------------------------------------------------------------------------------
+
+void          Stats(long long &vecs, long long &reqs)
+                   {vecs = numVecs; reqs = numReqs;}
+
+//------------------------------------------------------------------------------
+//! Constructor and destructor.
+//!
+//! @param  gap     - The largest number of bytes between two segments that
+//!                   still allows them to be read together.
+//! @param  maxio   - The largest number of bytes to read with one request.
+//!                   Segments larger than this are still read as a whole.
+//! @param  ring    - The io_uring engine to use or nil to read synchronously.
+//------------------------------------------------------------------------------
+
+              XrdOssReadV(int gap, int maxio, XrdSysIOUring *ring=0);
+             ~XrdOssReadV();
+
+private:
+
+XrdSysIOUring *Ring;
+char          *Sink;    // Receives the bytes between merged segments
+int            Gap;
+int            MaxIO;
+int            MaxIOV;
+
+RAtomic_llong  numVecs;
+RAtomic_llong  numReqs;
+};
+#endif
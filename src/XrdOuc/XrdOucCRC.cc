@@ -199,20 +199,20 @@ uint32_t XrdOucCRC::Calc32C(const void* data, size_t count, uint32_t prevcs)
   
 void XrdOucCRC::Calc32C(const void* data, size_t count, uint32_t* csval)
 {
-   int i, numpages = count/XrdSys::PageSize;
+   size_t numpages = count/XrdSys::PageSize;
    const uint8_t* dataP = (const uint8_t*)data;
 
-// Calculate the CRC32C for each page
+// Calculate the CRC32C for all of the full pages at once
 //
-   for (i = 0; i < numpages; i++)
-       {csval[i] = crc32c(0, dataP, XrdSys::PageSize);
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
+   if (numpages)
+      {crc32c_pages(dataP, XrdSys::PageSize, numpages, csval);
+       count -= numpages*XrdSys::PageSize;
+       dataP += numpages*XrdSys::PageSize;
+      }
 
 // if there is anything left, calculate that as well
 //
-   if (count > 0) csval[i] = crc32c(0, dataP, count);
+   if (count > 0) csval[numpages] = crc32c(0, dataP, count);
 }
 
 /******************************************************************************/
@@ -236,30 +236,33 @@ bool XrdOucCRC::Ver32C(const void*    data,  size_t    count,
 int  XrdOucCRC::Ver32C(const void*     data,  size_t    count,
                        const uint32_t* csval, uint32_t& valcs)
 {
-   int i, numpages = count/XrdSys::PageSize;
+   static const int batch = 32;
+   int i, k, n, numpages = count/XrdSys::PageSize;
    const uint8_t* dataP = (const uint8_t*)data;
-   uint32_t actualCS;
+   uint32_t actualCS[batch];
 
-// Calculate the CRC32C for each page and make sure it is the same.
+// Calculate the CRC32C for each page and make sure it is the same. We do this
+// in batches so that we stop reasonably soon after the first mismatch.
 //
-   for (i = 0; i < numpages; i++)
-       {
-        actualCS = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] != actualCS)
-           {valcs = actualCS;
-            return i;
-           }
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
+   for (i = 0; i < numpages; i += n)
+       {n = (numpages - i < batch ? numpages - i : batch);
+        crc32c_pages(dataP, XrdSys::PageSize, n, actualCS);
+        for (k = 0; k < n; k++)
+            if (csval[i+k] != actualCS[k])
+               {valcs = actualCS[k];
+                return i+k;
+               }
+        count -= n*XrdSys::PageSize;
+        dataP += n*XrdSys::PageSize;
        }
 
 // if there is anything left, verify that as well
 //
    if (count > 0)
       {
-       actualCS = crc32c(0, dataP, count);
-       if (csval[i] != actualCS)
-          {valcs = actualCS;
+       actualCS[0] = crc32c(0, dataP, count);
+       if (csval[i] != actualCS[0])
+          {valcs = actualCS[0];
            return i;
           }
       }
@@ -274,28 +277,31 @@ int  XrdOucCRC::Ver32C(const void*     data,  size_t    count,
 bool XrdOucCRC::Ver32C(const void*     data,  size_t count,
                        const uint32_t* csval, bool*  valok)
 {
-   int i, numpages = count/XrdSys::PageSize;
+   static const int batch = 32;
+   int i, k, n, numpages = count/XrdSys::PageSize;
    const uint8_t* dataP = (const uint8_t*)data;
-   uint32_t actualCS;
+   uint32_t actualCS[batch];
    bool retval = true;
 
 // Calculate the CRC32C for each page and make sure it is the same.
 //
-   for (i = 0; i < numpages; i++)
-       {
-        actualCS = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] == actualCS) valok[i] = true;
-           else valok[i] = retval = false;
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
+   for (i = 0; i < numpages; i += n)
+       {n = (numpages - i < batch ? numpages - i : batch);
+        crc32c_pages(dataP, XrdSys::PageSize, n, actualCS);
+        for (k = 0; k < n; k++)
+            {if (csval[i+k] == actualCS[k]) valok[i+k] = true;
+                else valok[i+k] = retval = false;
+            }
+        count -= n*XrdSys::PageSize;
+        dataP += n*XrdSys::PageSize;
        }
 
 // if there is anything left, verify that as well
 //
    if (count > 0)
       {
-       actualCS = crc32c(0, dataP, count);
-       if (csval[i] == actualCS) valok[i] = true;
+       actualCS[0] = crc32c(0, dataP, count);
+       if (csval[i] == actualCS[0]) valok[i] = true;
            else valok[i] = retval = false;
       }
 
@@ -313,15 +319,14 @@ bool XrdOucCRC::Ver32C(const void*     data,  size_t    count,
    const uint8_t* dataP = (const uint8_t*)data;
    bool retval = true;
 
-// Calculate the CRC32C for each page and make sure it is the same.
+// Calculate the CRC32C for all of the full pages at once and then compare.
 //
-   for (i = 0; i < numpages; i++)
-       {
-        valcs[i] = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] != valcs[i]) retval = false;
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
+   if (numpages)
+      {crc32c_pages(dataP, XrdSys::PageSize, numpages, valcs);
+       count -= numpages*XrdSys::PageSize;
+       dataP += numpages*XrdSys::PageSize;
+      }
+   for (i = 0; i < numpages; i++) if (csval[i] != valcs[i]) retval = false;
 
 // if there is anything left, verify that as well
 //
@@ -45,6 +45,8 @@
                      XrdOucCRC32C.hh with corresponding change to include
                      statement herein. Add required casts to allow C++
                      compilation.
+        16 Oct 2026  Check for SSE 4.2 only once. Add crc32c_pages() which
+                     computes independent page crcs three pages at a time.
  */
 
 #include <pthread.h>
@@ -263,13 +265,77 @@ static uint32_t crc32c_hw(uint32_t crc, void const *buf, size_t len) {
         (have) = (ecx >> 20) & 1; \
     } while (0)
 
+/* The cpuid instruction is serializing and, when virtualized, may trap to the
+   hypervisor.  So, check for SSE 4.2 only once. */
+static pthread_once_t crc32c_once_sse42 = PTHREAD_ONCE_INIT;
+static int crc32c_sse42 = 0;
+
+static void crc32c_init_sse42(void) {
+    SSE42(crc32c_sse42);
+}
+
+/* Compute the CRC-32C of each of npages pages of pgsz bytes using the Intel
+   hardware instruction.  Since each page has its own crc there is no need to
+   shift and combine crcs as crc32c_hw() does.  Instead, three pages are run in
+   parallel, one crc instruction on each, to cover the latency of the crc32
+   instruction. */
+static void crc32c_hw_pages(void const *buf, size_t pgsz, size_t npages,
+                            uint32_t *crcs) {
+    unsigned char const *next = (unsigned char const *)buf;
+
+    /* compute the crcs on sets of three pages, eight bytes at a time from each
+       page; the page size must be a multiple of eight for this to work */
+    if ((pgsz & 7) == 0 && pgsz) {
+        while (npages >= 3) {
+            uint64_t crc0 = 0xffffffff;
+            uint64_t crc1 = 0xffffffff;
+            uint64_t crc2 = 0xffffffff;
+            unsigned char const *p = next;
+            unsigned char const * const end = next + pgsz;
+            do {
+                __asm__("crc32q\t" "(%3), %0\n\t"
+                        "crc32q\t" "(%3,%4), %1\n\t"
+                        "crc32q\t" "(%3,%4,2), %2"
+                        : "=r"(crc0), "=r"(crc1), "=r"(crc2)
+                        : "r"(p), "r"(pgsz), "0"(crc0), "1"(crc1), "2"(crc2));
+                p += 8;
+            } while (p < end);
+            crcs[0] = ~(uint32_t)crc0;
+            crcs[1] = ~(uint32_t)crc1;
+            crcs[2] = ~(uint32_t)crc2;
+            crcs += 3;
+            next += pgsz*3;
+            npages -= 3;
+        }
+    }
+
+    /* compute the crcs of the remaining pages one at a time */
+    while (npages) {
+        *crcs++ = crc32c_hw(0, next, pgsz);
+        next += pgsz;
+        npages--;
+    }
+}
+
 /* Compute a CRC-32C.  If the crc32 instruction is available, use the hardware
    version.  Otherwise, use the software version. */
 uint32_t crc32c(uint32_t crc, void const *buf, size_t len) {
-    int sse42;
-    
-    SSE42(sse42);
-    return sse42 ? crc32c_hw(crc, buf, len) : crc32c_sw(crc, buf, len);
+    pthread_once(&crc32c_once_sse42, crc32c_init_sse42);
+    return crc32c_sse42 ? crc32c_hw(crc, buf, len) : crc32c_sw(crc, buf, len);
+}
+
+/* Compute the CRC-32C of each of npages consecutive pages of pgsz bytes. */
+void crc32c_pages(void const *buf, size_t pgsz, size_t npages, uint32_t *crcs) {
+    pthread_once(&crc32c_once_sse42, crc32c_init_sse42);
+    if (crc32c_sse42) {
+        crc32c_hw_pages(buf, pgsz, npages, crcs);
+        return;
+    }
+    unsigned char const *next = (unsigned char const *)buf;
+    while (npages--) {
+        *crcs++ = crc32c_sw(0, next, pgsz);
+        next += pgsz;
+    }
 }
 
 #else /* !__x86_64__ */
@@ -278,6 +344,14 @@ uint32_t crc32c(uint32_t crc, void const *buf, size_t len) {
     return crc32c_sw(crc, buf, len);
 }
 
+void crc32c_pages(void const *buf, size_t pgsz, size_t npages, uint32_t *crcs) {
+    unsigned char const *next = (unsigned char const *)buf;
+    while (npages--) {
+        *crcs++ = crc32c_sw(0, next, pgsz);
+        next += pgsz;
+    }
+}
+
 #endif
 
 /* Construct table for software CRC-32C little-endian calculation. */
@@ -13,6 +13,12 @@
 // crc == 0.  crc32c() uses the Intel crc32 hardware instruction if available.
 uint32_t crc32c(uint32_t crc, void const *buf, size_t len);
 
+// crc32c_pages() computes the CRC-32C of each of npages consecutive pages of
+// pgsz bytes starting at buf, placing each page's crc in crcs[0..npages-1].
+// Each crc starts from zero. When the crc32 instruction is available several
+// pages are processed in parallel.
+void crc32c_pages(void const *buf, size_t pgsz, size_t npages, uint32_t *crcs);
+
 // crc32c_sw() is the same, but does not use the hardware instruction, even if
 // available.
 uint32_t crc32c_sw(uint32_t crc, void const *buf, size_t len);
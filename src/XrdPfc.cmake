@@ -22,6 +22,7 @@ add_library(
   XrdPfc/XrdPfcPurge.cc
   XrdPfc/XrdPfcCommand.cc
   XrdPfc/XrdPfcFile.cc          XrdPfc/XrdPfcFile.hh
+  XrdPfc/XrdPfcBlockIndex.cc    XrdPfc/XrdPfcBlockIndex.hh
   XrdPfc/XrdPfcFSctl.cc         XrdPfc/XrdPfcFSctl.hh
   XrdPfc/XrdPfcStats.hh
   XrdPfc/XrdPfcInfo.cc          XrdPfc/XrdPfcInfo.hh
@@ -414,20 +414,21 @@ File* Cache::GetFile(const std::string& path, IO* io, long long off, long long f
    
    TRACE(Debug, "GetFile " << path << ", io " << io);
 
-   ActiveMap_i it;
+   ActiveShard &shard = active_shard(path);
+   ActiveMap_i  it;
 
    {
-      XrdSysCondVarHelper lock(&m_active_cond);
+      XrdSysCondVarHelper lock(&shard.m_cond);
 
       while (true)
       {
-         it = m_active.find(path);
+         it = shard.m_map.find(path);
 
          // File is not open or being opened. Mark it as being opened and
          // proceed to opening it outside of while loop.
-         if (it == m_active.end())
+         if (it == shard.m_map.end())
          {
-            it = m_active.insert(std::make_pair(path, (File*) 0)).first;
+            it = shard.m_map.insert(std::make_pair(path, (File*) 0)).first;
             break;
          }
 
@@ -440,8 +441,8 @@ File* Cache::GetFile(const std::string& path, IO* io, long long off, long long f
          }
          else
          {
-            // Wait for some change in m_active, then recheck.
-            m_active_cond.Wait();
+            // Wait for some change in this shard, then recheck.
+            shard.m_cond.Wait();
          }
       }
    }
@@ -469,7 +470,7 @@ File* Cache::GetFile(const std::string& path, IO* io, long long off, long long f
    }
 
    {
-      XrdSysCondVarHelper lock(&m_active_cond);
+      XrdSysCondVarHelper lock(&shard.m_cond);
 
       if (file)
       {
@@ -480,10 +481,10 @@ File* Cache::GetFile(const std::string& path, IO* io, long long off, long long f
       }
       else
       {
-         m_active.erase(it);
+         shard.m_map.erase(it);
       }
 
-      m_active_cond.Broadcast();
+      shard.m_cond.Broadcast();
    }
 
    return file;
@@ -496,7 +497,7 @@ void Cache::ReleaseFile(File* f, IO* io)
    TRACE(Debug, "ReleaseFile " << f->GetLocalPath() << ", io " << io);
    
    {
-     XrdSysCondVarHelper lock(&m_active_cond);
+     XrdSysCondVarHelper lock(&active_shard(f->GetLocalPath()).m_cond);
 
      f->RemoveIO(io);
    }
@@ -571,9 +572,11 @@ void Cache::inc_ref_cnt(File* f, bool lock, bool high_debug)
 
    int tlvl = high_debug ? TRACE_Debug : TRACE_Dump;
 
-   if (lock) m_active_cond.Lock();
+   XrdSysCondVar &cond = active_shard(f->GetLocalPath()).m_cond;
+
+   if (lock) cond.Lock();
    int rc = f->inc_ref_cnt();
-   if (lock) m_active_cond.UnLock();
+   if (lock) cond.UnLock();
 
    TRACE_INT(tlvl, "inc_ref_cnt " << f->GetLocalPath() << ", cnt at exit = " << rc);
 }
@@ -585,14 +588,16 @@ void Cache::dec_ref_cnt(File* f, bool high_debug)
    int tlvl = high_debug ? TRACE_Debug : TRACE_Dump;
    int cnt;
 
+   ActiveShard &shard = active_shard(f->GetLocalPath());
+
    {
-     XrdSysCondVarHelper lock(&m_active_cond);
+     XrdSysCondVarHelper lock(&shard.m_cond);
 
      cnt = f->get_ref_cnt();
 
      if (f->is_in_emergency_shutdown())
      {
-        // In this case file has been already removed from m_active map and
+        // In this case file has been already removed from active map and
         // does not need to be synced.
 
         if (cnt == 1)
@@ -627,16 +632,18 @@ void Cache::dec_ref_cnt(File* f, bool high_debug)
    }
 
    {
-      XrdSysCondVarHelper lock(&m_active_cond);
+      XrdSysCondVarHelper lock(&shard.m_cond);
 
       cnt = f->dec_ref_cnt();
       TRACE_INT(tlvl, "dec_ref_cnt " << f->GetLocalPath() << ", cnt after sync_check and dec_ref_cnt = " << cnt);
       if (cnt == 0)
       {
-         ActiveMap_i it = m_active.find(f->GetLocalPath());
-         m_active.erase(it);
+         shard.m_map.erase(f->GetLocalPath());
 
-         m_closed_files_stats.insert(std::make_pair(f->GetLocalPath(), f->DeltaStatsFromLastCall()));
+         {
+            XrdSysCondVarHelper lock_stats(&m_active_cond);
+            m_closed_files_stats.insert(std::make_pair(f->GetLocalPath(), f->DeltaStatsFromLastCall()));
+         }
 
          if (m_gstream)
          {
@@ -672,10 +679,12 @@ void Cache::dec_ref_cnt(File* f, bool high_debug)
 
 bool Cache::IsFileActiveOrPurgeProtected(const std::string& path)
 {
-   XrdSysCondVarHelper lock(&m_active_cond);
+   ActiveShard &shard = active_shard(path);
+
+   XrdSysCondVarHelper lock(&shard.m_cond);
 
-   return m_active.find(path)          != m_active.end() ||
-          m_purge_delay_set.find(path) != m_purge_delay_set.end();
+   return shard.m_map.find(path)             != shard.m_map.end() ||
+          shard.m_purge_delay_set.find(path) != shard.m_purge_delay_set.end();
 }
 
 
@@ -805,8 +814,9 @@ int Cache::LocalFilePath(const char *curl, char *buff, int blen,
    }
 
    {
-      XrdSysCondVarHelper lock(&m_active_cond);
-      m_purge_delay_set.insert(f_name);
+      ActiveShard &shard = active_shard(f_name);
+      XrdSysCondVarHelper lock(&shard.m_cond);
+      shard.m_purge_delay_set.insert(f_name);
    }
 
    struct stat sbuff, sbuff2;
@@ -833,11 +843,13 @@ int Cache::LocalFilePath(const char *curl, char *buff, int blen,
          // Do I still want to inject access record?
          // Oh, it writes only if not active .... still let's try to use existing File.
 
-         m_active_cond.Lock();
+         XrdSysCondVar &shard_cond = active_shard(f_name).m_cond;
 
-         bool is_active = m_active.find(f_name) != m_active.end();
+         shard_cond.Lock();
 
-         if (is_active) m_active_cond.UnLock();
+         bool is_active = active_shard(f_name).m_map.count(f_name) != 0;
+
+         if (is_active) shard_cond.UnLock();
 
          XrdOssDF* infoFile = m_oss->newFile(m_configuration.m_username.c_str());
          XrdOucEnv myEnv;
@@ -862,7 +874,7 @@ int Cache::LocalFilePath(const char *curl, char *buff, int blen,
          }
          delete infoFile;
 
-         if ( ! is_active) m_active_cond.UnLock();
+         if ( ! is_active) shard_cond.UnLock();
 
          if (read_ok)
          {
@@ -934,8 +946,9 @@ int Cache::Prepare(const char *curl, int oflags, mode_t mode)
    }
 
    {
-      XrdSysCondVarHelper lock(&m_active_cond);
-      m_purge_delay_set.insert(f_name);
+      ActiveShard &shard = active_shard(f_name);
+      XrdSysCondVarHelper lock(&shard.m_cond);
+      shard.m_purge_delay_set.insert(f_name);
    }
 
    struct stat sbuff;
@@ -965,8 +978,9 @@ int Cache::Stat(const char *curl, struct stat &sbuff)
    std::string f_name = url.GetPath();
 
    {
-      XrdSysCondVarHelper lock(&m_active_cond);
-      m_purge_delay_set.insert(f_name);
+      ActiveShard &shard = active_shard(f_name);
+      XrdSysCondVarHelper lock(&shard.m_cond);
+      shard.m_purge_delay_set.insert(f_name);
    }
 
    if (m_oss->Stat(f_name.c_str(), &sbuff) == XrdOssOK)
@@ -1020,14 +1034,15 @@ int Cache::Unlink(const char *curl)
 
 int Cache::UnlinkFile(const std::string& f_name, bool fail_if_open)
 {
+   ActiveShard &shard = active_shard(f_name);
    ActiveMap_i  it;
    File        *file = 0;
    {
-      XrdSysCondVarHelper lock(&m_active_cond);
+      XrdSysCondVarHelper lock(&shard.m_cond);
 
-      it = m_active.find(f_name);
+      it = shard.m_map.find(f_name);
 
-      if (it != m_active.end())
+      if (it != shard.m_map.end())
       {
          if (fail_if_open)
          {
@@ -1035,7 +1050,7 @@ int Cache::UnlinkFile(const std::string& f_name, bool fail_if_open)
             return -EBUSY;
          }
 
-         // Null File* in m_active map means an operation is ongoing, probably
+         // Null File* in active map means an operation is ongoing, probably
          // Attach() with possible File::Open(). Ask for retry.
          if (it->second == 0)
          {
@@ -1049,7 +1064,7 @@ int Cache::UnlinkFile(const std::string& f_name, bool fail_if_open)
       }
       else
       {
-         it = m_active.insert(std::make_pair(f_name, (File*) 0)).first;
+         it = shard.m_map.insert(std::make_pair(f_name, (File*) 0)).first;
       }
    }
 
@@ -1067,9 +1082,11 @@ int Cache::UnlinkFile(const std::string& f_name, bool fail_if_open)
    TRACE(Debug, "UnlinkCommon " << f_name << ", f_ret=" << f_ret << ", i_ret=" << i_ret);
 
    {
-      XrdSysCondVarHelper lock(&m_active_cond);
+      XrdSysCondVarHelper lock(&shard.m_cond);
+
+      shard.m_map.erase(it);
 
-      m_active.erase(it);
+      shard.m_cond.Broadcast();
    }
 
    return std::min(f_ret, i_ret);
@@ -21,6 +21,8 @@
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "Xrd/XrdScheduler.hh"
 #include "XrdVersion.hh"
@@ -442,17 +444,34 @@ private:
    WriteQ m_writeQ;
 
    // active map, purge delay set
-   typedef std::map<std::string, File*>               ActiveMap_t;
+   typedef std::unordered_map<std::string, File*>     ActiveMap_t;
    typedef ActiveMap_t::iterator                      ActiveMap_i;
    typedef std::multimap<std::string, XrdPfc::Stats>  StatsMMap_t;
    typedef StatsMMap_t::iterator                      StatsMMap_i;
-   typedef std::set<std::string>                      FNameSet_t;
+   typedef std::unordered_set<std::string>            FNameSet_t;
 
-   ActiveMap_t      m_active;             //!< Map of currently active / open files.
+   // The active file table is split into shards selected by the hash of the
+   // file path. A shard's cond-var protects its part of the active map and
+   // purge delay set as well as the reference counts of its File objects.
+   struct ActiveShard
+   {
+      ActiveShard() : m_cond(0) {}
+
+      XrdSysCondVar m_cond;
+      ActiveMap_t   m_map;
+      FNameSet_t    m_purge_delay_set;
+   };
+
+   static const int s_num_active_shards = 64; // must be a power of 2
+
+   ActiveShard& active_shard(const std::string &path)
+   { return m_active_shards[std::hash<std::string>()(path) & (s_num_active_shards - 1)]; }
+
+   ActiveShard      m_active_shards[s_num_active_shards]; //!< Currently active / open files.
    StatsMMap_t      m_closed_files_stats;
-   FNameSet_t       m_purge_delay_set;
    bool             m_in_purge;
-   XrdSysCondVar    m_active_cond;        //!< Cond-var protecting active file data structures.
+   XrdSysCondVar    m_active_cond;        //!< Cond-var protecting closed file stats and purge state;
+                                          //!< may be taken while holding a shard lock, never the reverse.
 
    void inc_ref_cnt(File*, bool lock, bool high_debug);
    void dec_ref_cnt(File*, bool high_debug);
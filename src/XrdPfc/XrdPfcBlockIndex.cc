@@ -0,0 +1,88 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d P f c B l o c k I n d e x . c c                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdPfcBlockIndex.hh"
+
+using namespace XrdPfc;
+
+void BlockIndex::insert(int idx, Block *b)
+{
+   // Keep the load factor at or below one half.
+   if (2 * (m_size + 1) > (int) (m_mask + 1))
+      rehash(m_slots ? 2 * (m_mask + 1) : 16);
+
+   unsigned int i = slot_of(idx);
+   while (m_slots[i].m_block && m_slots[i].m_idx != idx)
+      i = (i + 1) & m_mask;
+
+   if ( ! m_slots[i].m_block) ++m_size;
+   m_slots[i].m_idx   = idx;
+   m_slots[i].m_block = b;
+}
+
+bool BlockIndex::erase(int idx)
+{
+   if (m_size == 0) return false;
+
+   unsigned int i = slot_of(idx);
+   while (m_slots[i].m_block && m_slots[i].m_idx != idx)
+      i = (i + 1) & m_mask;
+   if ( ! m_slots[i].m_block) return false;
+
+   // Shift back any following entries that probed past the freed slot.
+   unsigned int j = i;
+   while (true)
+   {
+      j = (j + 1) & m_mask;
+      if ( ! m_slots[j].m_block) break;
+      unsigned int k = slot_of(m_slots[j].m_idx);
+      if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j)) continue;
+      m_slots[i] = m_slots[j];
+      i = j;
+   }
+   m_slots[i].m_block = nullptr;
+   --m_size;
+   return true;
+}
+
+void BlockIndex::rehash(unsigned int n_slots)
+{
+   Slot         *old_slots = m_slots;
+   unsigned int  old_n     = m_slots ? m_mask + 1 : 0;
+
+   m_slots = new Slot[n_slots];
+   m_mask  = n_slots - 1;
+   m_size  = 0;
+   for (unsigned int i = 0; i < n_slots; ++i) m_slots[i] = { 0, nullptr };
+
+   for (unsigned int i = 0; i < old_n; ++i)
+   {
+      if (old_slots[i].m_block) insert(old_slots[i].m_idx, old_slots[i].m_block);
+   }
+   delete [] old_slots;
+}
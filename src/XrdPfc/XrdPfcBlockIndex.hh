@@ -0,0 +1,84 @@
+#ifndef __XRDPFC_BLOCKINDEX_HH__
+#define __XRDPFC_BLOCKINDEX_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d P f c B l o c k I n d e x . h h                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+namespace XrdPfc
+{
+class Block;
+
+//------------------------------------------------------------------------------
+//! Flat open-addressing index of blocks in RAM, keyed by block number.
+//! Linear probing is used and deletions shift subsequent entries back so no
+//! tombstones are needed. All methods must be called under File's state lock.
+//------------------------------------------------------------------------------
+
+class BlockIndex
+{
+public:
+   BlockIndex() : m_slots(nullptr), m_mask(0), m_size(0) {}
+   ~BlockIndex() { delete [] m_slots; }
+
+   Block* find(int idx) const
+   {
+      if (m_size == 0) return nullptr;
+      for (unsigned int i = slot_of(idx); m_slots[i].m_block; i = (i + 1) & m_mask)
+      {
+         if (m_slots[i].m_idx == idx) return m_slots[i].m_block;
+      }
+      return nullptr;
+   }
+
+   void   insert(int idx, Block *b);
+   bool   erase (int idx);
+
+   int    size()  const { return m_size; }
+   bool   empty() const { return m_size == 0; }
+
+private:
+   BlockIndex(const BlockIndex&) = delete;
+   BlockIndex& operator=(const BlockIndex&) = delete;
+
+   struct Slot
+   {
+      int    m_idx;
+      Block *m_block;   // nullptr marks an empty slot
+   };
+
+   unsigned int slot_of(int idx) const { return ((unsigned int) idx * 2654435761u) & m_mask; }
+
+   void   rehash(unsigned int n_slots);
+
+   Slot         *m_slots;
+   unsigned int  m_mask;
+   int           m_size;
+};
+
+}
+
+#endif
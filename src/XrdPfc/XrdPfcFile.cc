@@ -67,6 +67,7 @@ File::File(const std::string& path, long long iOffset, long long iFileSize) :
    m_state_cond(0),
    m_block_size(0),
    m_num_blocks(0),
+   m_bytes_hit_nolock(0),
    m_prefetch_state(kOff),
    m_prefetch_read_cnt(0),
    m_prefetch_hit_cnt(0),
@@ -126,7 +127,7 @@ void File::initiate_emergency_shutdown()
    {
       XrdSysCondVarHelper _lck(m_state_cond);
 
-      m_in_shutdown = true;
+      __atomic_store_n(&m_in_shutdown, true, __ATOMIC_RELEASE);
 
       if (m_prefetch_state != kStopped && m_prefetch_state != kComplete)
       {
@@ -145,6 +146,7 @@ Stats File::DeltaStatsFromLastCall()
 
    Stats delta = m_last_stats;
 
+   collect_nolock_stats();
    m_last_stats = m_stats.Clone();
 
    delta.DeltaToReference(m_last_stats);
@@ -214,7 +216,7 @@ bool File::ioActive(IO *io)
          insert_remote_location(loc);
 
          io->m_allow_prefetching = false;
-         io->m_in_detach = true;
+         __atomic_store_n(&io->m_in_detach, true, __ATOMIC_RELEASE);
 
          // Check if any IO is still available for prfetching. If not, stop it.
          if (m_prefetch_state == kOn || m_prefetch_state == kHold)
@@ -278,6 +280,7 @@ bool File::FinalizeSyncBeforeExit()
    {
      if ( ! m_writes_during_sync.empty() || m_non_flushed_cnt > 0 || ! m_detach_time_logged)
      {
+       collect_nolock_stats();
        Stats loc_stats = m_stats.Clone();
        m_cfi.WriteIOStatDetach(loc_stats);
        m_detach_time_logged = true;
@@ -553,7 +556,7 @@ Block* File::PrepareBlockRequest(int i, IO *io, void *req_id, bool prefetch)
 
       if (b)
       {
-         m_block_map[i] = b;
+         m_block_map.insert(i, b);
 
          // Actual Read request is issued in ProcessBlockRequests().
 
@@ -646,6 +649,12 @@ int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize, ReadR
 
    TRACEF(Dump, "Read() sid: " << Xrd::hex1 << rh->m_seq_id << " size: " << iUserSize);
 
+   XrdOucIOVec readV( { iUserOff, iUserSize, 0, iUserBuff } );
+
+   int ret;
+   if (ReadHitNoLock(io, &readV, 1, ret))
+      return ret;
+
    m_state_cond.Lock();
 
    if (m_in_shutdown || io->m_in_detach)
@@ -659,13 +668,11 @@ int File::Read(IO *io, char* iUserBuff, long long iUserOff, int iUserSize, ReadR
    if (m_cfi.IsComplete())
    {
       m_state_cond.UnLock();
-      int ret = m_data_file->Read(iUserBuff, iUserOff, iUserSize);
+      ret = m_data_file->Read(iUserBuff, iUserOff, iUserSize);
       if (ret > 0) m_stats.AddBytesHit(ret);
       return ret;
    }
 
-   XrdOucIOVec readV( { iUserOff, iUserSize, 0, iUserBuff } );
-
    return ReadOpusCoalescere(io, &readV, 1, rh, "Read() ");
 }
 
@@ -675,6 +682,10 @@ int File::ReadV(IO *io, const XrdOucIOVec *readV, int readVnum, ReadReqRH *rh)
 {
    TRACEF(Dump, "ReadV() for " << readVnum << " chunks.");
 
+   int ret;
+   if (ReadHitNoLock(io, readV, readVnum, ret))
+      return ret;
+
    m_state_cond.Lock();
 
    if (m_in_shutdown || io->m_in_detach)
@@ -688,7 +699,7 @@ int File::ReadV(IO *io, const XrdOucIOVec *readV, int readVnum, ReadReqRH *rh)
    if (m_cfi.IsComplete())
    {
       m_state_cond.UnLock();
-      int ret = m_data_file->ReadV(const_cast<XrdOucIOVec*>(readV), readVnum);
+      ret = m_data_file->ReadV(const_cast<XrdOucIOVec*>(readV), readVnum);
       if (ret > 0) m_stats.AddBytesHit(ret);
       return ret;
    }
@@ -698,6 +709,66 @@ int File::ReadV(IO *io, const XrdOucIOVec *readV, int readVnum, ReadReqRH *rh)
 
 //------------------------------------------------------------------------------
 
+bool File::ReadHitNoLock(IO *io, const XrdOucIOVec *readV, int readVnum, int &retval)
+{
+   // Serve the request straight from the data file, without taking the state
+   // lock or creating any request bookkeeping, when every block it touches is
+   // already on disk. Returns false if the regular path has to be taken.
+   //
+   // Blocks obtained through prefetching are left to the regular path while
+   // prefetching is running as their hits feed the prefetch score.
+
+   if (__atomic_load_n(&m_in_shutdown, __ATOMIC_ACQUIRE) ||
+       __atomic_load_n(&io->m_in_detach, __ATOMIC_ACQUIRE))
+      return false;
+
+   if ( ! m_cfi.IsCompleteNoLock())
+   {
+      const int  n_blocks    = m_cfi.GetNBlocks();
+      const PrefetchState_e pfs = __atomic_load_n(&m_prefetch_state, __ATOMIC_ACQUIRE);
+      const bool prefetching = (pfs == kOn || pfs == kHold);
+
+      for (int iov_idx = 0; iov_idx < readVnum; ++iov_idx)
+      {
+         const XrdOucIOVec &iov = readV[iov_idx];
+         if (iov.size <= 0) return false;
+
+         const int idx_first = offsetIdx(iov.offset / m_block_size);
+         const int idx_last  = offsetIdx((iov.offset + iov.size - 1) / m_block_size);
+
+         if (idx_first < 0 || idx_last >= n_blocks) return false;
+
+         for (int i = idx_first; i <= idx_last; ++i)
+         {
+            if ( ! m_cfi.TestBitWrittenNoLock(i) || (prefetching && m_cfi.TestBitPrefetch(i)))
+               return false;
+         }
+      }
+   }
+
+   if (readVnum == 1)
+      retval = m_data_file->Read(readV[0].data, readV[0].offset, readV[0].size);
+   else
+      retval = m_data_file->ReadV(const_cast<XrdOucIOVec*>(readV), readVnum);
+
+   if (retval > 0) m_bytes_hit_nolock += retval;
+
+   TRACEF(DumpXL, "ReadHitNoLock() n_chunks = " << readVnum << ", retval = " << retval);
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void File::collect_nolock_stats()
+{
+   long long bh = m_bytes_hit_nolock;
+   while (bh && ! m_bytes_hit_nolock.compare_exchange_strong(bh, 0)) ;
+   if (bh) m_stats.AddBytesHit(bh);
+}
+
+//------------------------------------------------------------------------------
+
 int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
                              ReadReqRH *rh, const char *tpfx)
 {
@@ -741,7 +812,7 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
       for (int block_idx = idx_first; block_idx <= idx_last; ++block_idx)
       {
          TRACEF(DumpXL, tpfx << "sid: " << Xrd::hex1 << rh->m_seq_id << " idx: " << block_idx);
-         BlockMap_i bi = m_block_map.find(block_idx);
+         Block *bp = m_block_map.find(block_idx);
 
          // overlap and read
          long long off;     // offset in user buffer
@@ -751,20 +822,20 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
          overlap(block_idx, m_block_size, iUserOff, iUserSize, off, blk_off, size);
 
          // In RAM or incoming?
-         if (bi != m_block_map.end())
+         if (bp)
          {
-            inc_ref_count(bi->second);
-            TRACEF(Dump, tpfx << (void*) iUserBuff << " inc_ref_count for existing block " << bi->second << " idx = " <<  block_idx);
+            inc_ref_count(bp);
+            TRACEF(Dump, tpfx << (void*) iUserBuff << " inc_ref_count for existing block " << bp << " idx = " <<  block_idx);
 
-            if (bi->second->is_finished())
+            if (bp->is_finished())
             {
                // note, blocks with error should not be here !!!
                // they should be either removed or reissued in ProcessBlockResponse()
-               assert(bi->second->is_ok());
+               assert(bp->is_ok());
 
-               blks_ready[bi->second].emplace_back( ChunkRequest(nullptr, iUserBuff + off, blk_off, size) );
+               blks_ready[bp].emplace_back( ChunkRequest(nullptr, iUserBuff + off, blk_off, size) );
 
-               if (bi->second->m_prefetch)
+               if (bp->m_prefetch)
                   ++prefetch_cnt;
             }
             else
@@ -775,7 +846,7 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
                // We have a lock on state_cond --> as we register the request before releasing the lock,
                // we are sure to get a call-in via the ChunkRequest handling when this block arrives.
 
-               bi->second->m_chunk_reqs.emplace_back( ChunkRequest(read_req, iUserBuff + off, blk_off, size) );
+               bp->m_chunk_reqs.emplace_back( ChunkRequest(read_req, iUserBuff + off, blk_off, size) );
                ++read_req->m_n_chunk_reqs;
             }
 
@@ -891,6 +962,17 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
    // End synchronous part -- update with sync stats and determine actual state of this read.
    // Note: remote reads might have already finished during disk-read!
 
+   // Pure disk hits need no further bookkeeping, skip the file-wide lock.
+
+   if ( ! read_req && blks_ready.empty())
+   {
+      m_stats.AddBytesHit(bytes_read);
+
+      // !!! No callout.
+
+      return error_cond ? error_cond : bytes_read;
+   }
+
    m_state_cond.Lock();
 
    for (auto &bvi : blks_ready)
@@ -922,9 +1004,10 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
    }
    else
    {
-      m_stats.m_BytesHit += bytes_read;
       m_state_cond.UnLock();
 
+      m_stats.AddBytesHit(bytes_read);
+
       // !!! No callout.
 
       return error_cond ? error_cond : bytes_read;
@@ -978,12 +1061,14 @@ void File::WriteBlockToDisk(Block* b)
    {
       XrdSysCondVarHelper _lck(m_state_cond);
 
-      m_cfi.SetBitWritten(blk_idx);
-
+      // Prefetch bit must be set first, lock-free readers rely on it
+      // being visible once they see the written bit.
       if (b->m_prefetch)
       {
          m_cfi.SetBitPrefetch(blk_idx);
       }
+
+      m_cfi.SetBitWritten(blk_idx);
       if (b->req_cksum_net() && ! b->has_cksums() && m_cfi.IsCkSumNet())
       {
          m_cfi.ResetCkSumNet();
@@ -1027,6 +1112,7 @@ void File::Sync()
    bool errorp = false;
    if (ret == XrdOssOK)
    {
+      collect_nolock_stats();
       Stats loc_stats = m_stats.Clone();
       m_cfi.WriteIOStat(loc_stats);
       m_cfi.Write(m_info_file, m_filename.c_str());
@@ -1092,8 +1178,7 @@ void File::free_block(Block* b)
    // Method always called under lock.
    int i = b->m_offset / m_block_size;
    TRACEF(Dump, "free_block block " << b << "  idx =  " <<  i);
-   size_t ret = m_block_map.erase(i);
-   if (ret != 1)
+   if ( ! m_block_map.erase(i))
    {
       // assert might be a better option than a warning
       TRACEF(Error, "free_block did not erase " <<  i  << " from map");
@@ -1434,8 +1519,7 @@ void File::Prefetch()
          {
             int f_act = f + m_offset / m_block_size;
 
-            BlockMap_i bi = m_block_map.find(f_act);
-            if (bi == m_block_map.end())
+            if ( ! m_block_map.find(f_act))
             {
                Block *b = PrepareBlockRequest(f_act, *m_current_io, nullptr, true);
                if (b)
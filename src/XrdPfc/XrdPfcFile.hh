@@ -24,11 +24,15 @@
 #include "XrdOuc/XrdOucCache.hh"
 #include "XrdOuc/XrdOucIOVec.hh"
 
+#include "XrdSys/XrdSysRAtomic.hh"
+
+#include "XrdPfcBlockIndex.hh"
 #include "XrdPfcInfo.hh"
 #include "XrdPfcStats.hh"
 
 #include <functional>
 #include <map>
+#include <new>
 #include <set>
 #include <string>
 
@@ -293,7 +297,7 @@ public:
    int                GetNDownloadedBlocks() const { return m_cfi.GetNDownloadedBlocks(); }
    const Stats&       RefStats()             const { return m_stats; }
 
-   // These three methods are called under Cache's m_active lock
+   // These three methods are called under the lock of Cache's active shard for this file
    int get_ref_cnt() { return   m_ref_cnt; }
    int inc_ref_cnt() { return ++m_ref_cnt; }
    int dec_ref_cnt() { return --m_ref_cnt; }
@@ -342,10 +346,7 @@ private:
    typedef std::list<int>        IntList_t;
    typedef IntList_t::iterator   IntList_i;
 
-   typedef std::map<int, Block*> BlockMap_t;
-   typedef BlockMap_t::iterator  BlockMap_i;
-
-   BlockMap_t    m_block_map;
+   BlockIndex    m_block_map;
    XrdSysCondVar m_state_cond;
    long long     m_block_size;
    int           m_num_blocks;
@@ -353,11 +354,14 @@ private:
    // Stats
 
    Stats         m_stats;              //!< cache statistics for this instance
+   RAtomic_llong m_bytes_hit_nolock;   //!< bytes hit via ReadHitNoLock(), not yet added to m_stats
    Stats         m_last_stats;         //!< copy of cache stats during last purge cycle, used for per directory stat reporting
 
    std::set<std::string> m_remote_locations; //!< Gathered in AddIO / ioUpdate / ioActive.
    void insert_remote_location(const std::string &loc);
 
+   void collect_nolock_stats();
+
    // Prefetch
 
    enum PrefetchState_e { kOff=-1, kOn, kHold, kStopped, kComplete };
@@ -394,6 +398,8 @@ private:
 
    int    ReadBlocksFromDisk(std::vector<XrdOucIOVec>& ioVec, int expected_size);
 
+   bool   ReadHitNoLock(IO *io, const XrdOucIOVec *readV, int readVnum, int &retval);
+
    int    ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
                              ReadReqRH *rh, const char *tpfx);
 
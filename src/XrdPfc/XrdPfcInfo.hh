@@ -114,6 +114,14 @@ public:
    //---------------------------------------------------------------------
    bool TestBitWritten(int i) const;
 
+   //---------------------------------------------------------------------
+   //! Test if block at the given index is written to disk. Unlike
+   //! TestBitWritten() this may be called without holding the lock
+   //! that serializes SetBitWritten(); a set bit guarantees the block
+   //! data and its prefetch bit are visible to the caller.
+   //---------------------------------------------------------------------
+   bool TestBitWrittenNoLock(int i) const;
+
    //---------------------------------------------------------------------
    //! Test if block at the given index has been prefetched
    //---------------------------------------------------------------------
@@ -234,6 +242,11 @@ public:
    //---------------------------------------------------------------------
    bool IsComplete() const;
 
+   //---------------------------------------------------------------------
+   //! Get complete status without holding the SetBitWritten() lock
+   //---------------------------------------------------------------------
+   bool IsCompleteNoLock() const;
+
    //---------------------------------------------------------------------
    //! Get number of downloaded blocks
    //---------------------------------------------------------------------
@@ -360,10 +373,19 @@ inline void Info::SetBitWritten(int i)
 
    const int off = i - cn*8;
 
-   m_buff_written[cn] |= cfiBIT(off);
+   __atomic_fetch_or(&m_buff_written[cn], cfiBIT(off), __ATOMIC_RELEASE);
 
    if (--m_missingBlocks == 0)
-      m_complete = true;
+      __atomic_store_n(&m_complete, true, __ATOMIC_RELEASE);
+}
+
+inline bool Info::TestBitWrittenNoLock(int i) const
+{
+   const int cn = i/8;
+   assert(cn < GetBitvecSizeInBytes());
+
+   const int off = i - cn*8;
+   return (__atomic_load_n(&m_buff_written[cn], __ATOMIC_ACQUIRE) & cfiBIT(off)) != 0;
 }
 
 inline void Info::SetBitPrefetch(int i)
@@ -374,7 +396,7 @@ inline void Info::SetBitPrefetch(int i)
    assert(cn < GetBitvecSizeInBytes());
 
    const int off = i - cn*8;
-   m_buff_prefetch[cn] |= cfiBIT(off);
+   __atomic_fetch_or(&m_buff_prefetch[cn], cfiBIT(off), __ATOMIC_RELAXED);
 }
 
 inline bool Info::TestBitPrefetch(int i) const
@@ -385,7 +407,7 @@ inline bool Info::TestBitPrefetch(int i) const
    assert(cn < GetBitvecSizeInBytes());
 
    const int off = i - cn*8;
-   return (m_buff_prefetch[cn] & cfiBIT(off)) != 0;
+   return (__atomic_load_n(&m_buff_prefetch[cn], __ATOMIC_RELAXED) & cfiBIT(off)) != 0;
 }
 
 inline void Info::SetBitSynced(int i)
@@ -453,6 +475,11 @@ inline bool Info::IsComplete() const
    return m_complete;
 }
 
+inline bool Info::IsCompleteNoLock() const
+{
+   return __atomic_load_n(&m_complete, __ATOMIC_ACQUIRE);
+}
+
 inline int Info::CountBlocksNotWrittenInRng(int firstIdx, int lastIdx) const
 {
    // TODO rewrite to use full byte comparisons outside of edges ?
@@ -572,8 +572,13 @@ void Cache::copy_out_active_stats_and_update_data_fs_state()
 
       // Slurp in stats from files closed since last cycle.
       updates.swap( m_closed_files_stats );
+   }
+
+   for (int s = 0; s < s_num_active_shards; ++s)
+   {
+      XrdSysCondVarHelper lock(&m_active_shards[s].m_cond);
 
-      for (ActiveMap_i i = m_active.begin(); i != m_active.end(); ++i)
+      for (ActiveMap_i i = m_active_shards[s].m_map.begin(); i != m_active_shards[s].m_map.end(); ++i)
       {
          if (i->second != 0)
          {
@@ -949,10 +954,16 @@ void Cache::Purge()
          m_fs_state->upward_propagate_usage_purged();
       }
 
+      for (int s = 0; s < s_num_active_shards; ++s)
+      {
+         XrdSysCondVarHelper lock(&m_active_shards[s].m_cond);
+
+         m_active_shards[s].m_purge_delay_set.clear();
+      }
+
       {
          XrdSysCondVarHelper lock(&m_active_cond);
 
-         m_purge_delay_set.clear();
          m_in_purge = false;
       }
 
@@ -59,6 +59,7 @@ add_library(
   XrdXrootd/XrdXrootdXeq.cc             XrdXrootd/XrdXrootdXeq.hh
   XrdXrootd/XrdXrootdXeqChkPnt.cc
   XrdXrootd/XrdXrootdXeqFAttr.cc
+  XrdXrootd/XrdXrootdXeqMux.cc
   XrdXrootd/XrdXrootdXeqPgrw.cc
                                         XrdXrootd/XrdXrootdXPath.hh
 
@@ -133,6 +134,7 @@ add_library(
                                XrdOss/XrdOssMioFile.hh
   XrdOss/XrdOssMSS.cc
   XrdOss/XrdOssPath.cc         XrdOss/XrdOssPath.hh
+  XrdOss/XrdOssReadV.cc        XrdOss/XrdOssReadV.hh
   XrdOss/XrdOssReloc.cc
   XrdOss/XrdOssRename.cc
   XrdOss/XrdOssSpace.cc        XrdOss/XrdOssSpace.hh
@@ -174,6 +176,7 @@ add_library(
   XrdCms/XrdCmsRTable.cc          XrdCms/XrdCmsRTable.hh
   XrdCms/XrdCmsSecurity.cc        XrdCms/XrdCmsSecurity.hh
   XrdCms/XrdCmsTalk.cc            XrdCms/XrdCmsTalk.hh
+                                  XrdCms/XrdCmsSMask.hh
                                   XrdCms/XrdCmsTypes.hh
   XrdCms/XrdCmsUtils.cc           XrdCms/XrdCmsUtils.hh
                                   XrdCms/XrdCmsVnId.hh
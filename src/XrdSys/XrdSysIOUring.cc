@@ -0,0 +1,516 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S y s I O U r i n g . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef HAVE_IO_URING
+#include <sched.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "XrdSys/XrdSysIOUring.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                        L o c a l   D e f i n e s                           */
+/******************************************************************************/
+
+#ifdef HAVE_IO_URING
+
+namespace
+{
+// The user data value of the request that tells a reaper thread to exit.
+//
+const __u64 exitMark = ~(__u64)0;
+
+// Maximum number of completions handled as a single batch by a reaper.
+//
+const int   maxReap  = 64;
+
+// Each submitting thread is assigned a ring the first time it submits. Threads
+// are assigned round-robin so that load is spread evenly across all rings.
+//
+RAtomic_uint     nextRing(0);
+thread_local int myRing = -1;
+
+int sysSetup(unsigned int ents, struct io_uring_params *parms)
+   {return (int)syscall(__NR_io_uring_setup, ents, parms);}
+
+int sysEnter(int fd, unsigned int nsub, unsigned int ncmp, unsigned int flags)
+   {return (int)syscall(__NR_io_uring_enter, fd, nsub, ncmp, flags, 0, 0);}
+
+int sysRegister(int fd, unsigned int opc, void *arg, unsigned int narg)
+   {return (int)syscall(__NR_io_uring_register, fd, opc, arg, narg);}
+}
+#endif
+
+/******************************************************************************/
+/*                 X r d S y s I O U r i n g : : R i n g                      */
+/******************************************************************************/
+
+struct XrdSysIOUring::Ring
+{
+struct Slot {DoneCB cb; void *cbArg; Slot *next;};
+
+XrdSysMutex           sqMutex;  // Serializes filling the submission queue
+pthread_t             reapTID;
+int                   ringFD;
+bool                  reapOK;
+
+#ifdef HAVE_IO_URING
+unsigned int         *sqHead;
+unsigned int         *sqTail;
+unsigned int         *sqArray;
+unsigned int          sqMask;
+unsigned int          sqEnts;
+struct io_uring_sqe  *sqeVec;
+
+unsigned int         *cqHead;
+unsigned int         *cqTail;
+unsigned int          cqMask;
+struct io_uring_cqe  *cqeVec;
+
+void                 *sqMem;
+size_t                sqLen;
+void                 *cqMem;
+size_t                cqLen;
+size_t                sqeLen;
+#endif
+
+Slot                 *slotVec;  // One slot for every possible completion
+Slot                 *slotFree;
+int                   slotBusy; // Number of requests in flight
+
+int                   Setup(int qdepth, const char *&eTxt);
+void                  Reap();
+int                   Stop();
+
+                      Ring() : ringFD(-1), reapOK(false),
+#ifdef HAVE_IO_URING
+                               sqeVec(0), sqMem(0), cqMem(0),
+#endif
+                               slotVec(0), slotFree(0), slotBusy(0) {}
+                     ~Ring();
+};
+
+/******************************************************************************/
+/*                     R i n g   D e s t r u c t o r                          */
+/******************************************************************************/
+
+XrdSysIOUring::Ring::~Ring()
+{
+#ifdef HAVE_IO_URING
+   if (reapOK) Stop();
+   if (sqeVec) munmap(sqeVec, sqeLen);
+   if (cqMem && cqMem != sqMem) munmap(cqMem, cqLen);
+   if (sqMem) munmap(sqMem, sqLen);
+   if (ringFD >= 0) close(ringFD);
+#endif
+   if (slotVec) delete [] slotVec;
+}
+
+/******************************************************************************/
+/*                            R i n g : : R e a p                             */
+/******************************************************************************/
+
+void XrdSysIOUring::Ring::Reap()
+{
+#ifdef HAVE_IO_URING
+   struct {DoneCB cb; void *cbArg; int result;} done[maxReap];
+   Slot *slotP, *slotFirst, *slotLast;
+   unsigned int head, tail;
+   int n, rc;
+   bool isDone = false, isIdle = false;
+
+// Wait for completions and process them in batches. Slots are returned to the
+// free list before any callback is invoked so that a callback may queue
+// another request on this ring. We exit only after being told to do so and
+// every request in flight has completed.
+//
+   do {do {rc = sysEnter(ringFD, 0, 1, IORING_ENTER_GETEVENTS);}
+          while(rc < 0 && errno == EINTR);
+       if (rc < 0 && errno != EAGAIN && errno != EBUSY) break;
+
+       do {head = *cqHead;
+           tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+           slotFirst = slotLast = 0;
+           for (n = 0; head != tail && n < maxReap; head++)
+               {struct io_uring_cqe *cqeP = &cqeVec[head & cqMask];
+                if (cqeP->user_data == exitMark) {isDone = true; continue;}
+                slotP = &slotVec[cqeP->user_data];
+                done[n].cb     = slotP->cb;
+                done[n].cbArg  = slotP->cbArg;
+                done[n].result = cqeP->res;
+                slotP->next    = slotFirst;
+                if (!slotFirst) slotLast = slotP;
+                slotFirst = slotP;
+                n++;
+               }
+           __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+           sqMutex.Lock();
+           if (slotFirst)
+              {slotLast->next = slotFree;
+               slotFree = slotFirst;
+               slotBusy -= n;
+              }
+           isIdle = (slotBusy == 0);
+           sqMutex.UnLock();
+
+           for (int i = 0; i < n; i++)
+               if (done[i].cb) done[i].cb(done[i].cbArg, done[i].result);
+          } while(head != tail);
+      } while(!isDone || !isIdle);
+#endif
+}
+
+/******************************************************************************/
+/*                           R i n g : : S e t u p                            */
+/******************************************************************************/
+
+int XrdSysIOUring::Ring::Setup(int qdepth, const char *&eTxt)
+{
+#ifdef HAVE_IO_URING
+   struct io_uring_params parms;
+   int n;
+
+// Create the ring
+//
+   memset(&parms, 0, sizeof(parms));
+   parms.flags = IORING_SETUP_CLAMP;
+   if ((ringFD = sysSetup(qdepth, &parms)) < 0)
+      {eTxt = "create io_uring"; return errno;}
+
+// Verify that the kernel supports every operation that we will be using.
+// Kernels older than 5.6 do not support the probe and are not usable.
+//
+  {size_t plen = sizeof(struct io_uring_probe)
+               + 256*sizeof(struct io_uring_probe_op);
+   struct io_uring_probe *probe = (struct io_uring_probe *)calloc(1, plen);
+   int ok = sysRegister(ringFD, IORING_REGISTER_PROBE, probe, 256) >= 0;
+   if (!ok) n = errno;
+      else {int opv[] = {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC,
+                         IORING_OP_READV};
+            for (int i = 0; ok && i < (int)(sizeof(opv)/sizeof(int)); i++)
+                ok = opv[i] <= probe->last_op
+                  && (probe->ops[opv[i]].flags & IO_URING_OP_SUPPORTED);
+            n = ENOSYS;
+           }
+   free(probe);
+   if (!ok) {eTxt = "probe io_uring operations"; return n;}
+  }
+
+// Map in the submission and completion queues. Newer kernels allow both
+// queues to be mapped using a single mapping.
+//
+   sqLen = parms.sq_off.array + parms.sq_entries*sizeof(unsigned int);
+   cqLen = parms.cq_off.cqes  + parms.cq_entries*sizeof(struct io_uring_cqe);
+   if (parms.features & IORING_FEAT_SINGLE_MMAP)
+      {if (cqLen > sqLen) sqLen = cqLen;
+       cqLen = sqLen;
+      }
+
+   sqMem = mmap(0, sqLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                ringFD, IORING_OFF_SQ_RING);
+   if (sqMem == MAP_FAILED) {sqMem = 0; eTxt = "map io_uring sq"; return errno;}
+
+   if (parms.features & IORING_FEAT_SINGLE_MMAP) cqMem = sqMem;
+      else {cqMem = mmap(0, cqLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                         ringFD, IORING_OFF_CQ_RING);
+            if (cqMem == MAP_FAILED)
+               {cqMem = 0; eTxt = "map io_uring cq"; return errno;}
+           }
+
+   sqeLen = parms.sq_entries*sizeof(struct io_uring_sqe);
+   sqeVec = (struct io_uring_sqe *)mmap(0, sqeLen, PROT_READ|PROT_WRITE,
+                         MAP_SHARED|MAP_POPULATE, ringFD, IORING_OFF_SQES);
+   if (sqeVec == MAP_FAILED)
+      {sqeVec = 0; eTxt = "map io_uring sqes"; return errno;}
+
+// Establish all of the pointers into the shared queues
+//
+   char *sqP = (char *)sqMem, *cqP = (char *)cqMem;
+   sqHead  = (unsigned int *)(sqP + parms.sq_off.head);
+   sqTail  = (unsigned int *)(sqP + parms.sq_off.tail);
+   sqArray = (unsigned int *)(sqP + parms.sq_off.array);
+   sqMask  = *(unsigned int *)(sqP + parms.sq_off.ring_mask);
+   sqEnts  = parms.sq_entries;
+
+   cqHead  = (unsigned int *)(cqP + parms.cq_off.head);
+   cqTail  = (unsigned int *)(cqP + parms.cq_off.tail);
+   cqMask  = *(unsigned int *)(cqP + parms.cq_off.ring_mask);
+   cqeVec  = (struct io_uring_cqe *)(cqP + parms.cq_off.cqes);
+
+// Allocate one slot for each possible completion less one for the exit
+// request. This bounds the number of requests in flight so that the
+// completion queue can never overflow.
+//
+   n = parms.cq_entries - 1;
+   slotVec = new Slot[n];
+   for (int i = 0; i < n; i++) {slotVec[i].next = slotFree; slotFree = &slotVec[i];}
+   return 0;
+#else
+   eTxt = "use io_uring";
+   return ENOSYS;
+#endif
+}
+
+/******************************************************************************/
+/*                            R i n g : : S t o p                             */
+/******************************************************************************/
+
+int XrdSysIOUring::Ring::Stop()
+{
+#ifdef HAVE_IO_URING
+   struct io_uring_sqe *sqeP;
+   unsigned int tail;
+   int rc;
+
+// Queue a no-op whose completion tells the reaper to exit once every request
+// in flight has completed. Slots are not involved but we may need to wait for
+// the kernel to consume queued entries before there is room for the no-op.
+//
+   do {sqMutex.Lock();
+       tail = *sqTail;
+       if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) < sqEnts) break;
+       sqMutex.UnLock();
+       if (sysEnter(ringFD, sqEnts, 0, 0) < 0) sched_yield();
+      } while(1);
+
+   sqeP = &sqeVec[tail & sqMask];
+   memset(sqeP, 0, sizeof(struct io_uring_sqe));
+   sqeP->opcode    = IORING_OP_NOP;
+   sqeP->user_data = exitMark;
+   sqArray[tail & sqMask] = tail & sqMask;
+   __atomic_store_n(sqTail, tail+1, __ATOMIC_RELEASE);
+   sqMutex.UnLock();
+
+   do {rc = sysEnter(ringFD, sqEnts, 0, 0);} while(rc < 0 && errno == EINTR);
+   reapOK = false;
+   return XrdSysThread::Join(reapTID, 0);
+#else
+   return 0;
+#endif
+}
+
+/******************************************************************************/
+/*                              X r d R e a p e r                             */
+/******************************************************************************/
+
+namespace
+{
+void *XrdSysIOUringReaper(void *carg)
+{
+   ((XrdSysIOUring::Ring *)carg)->Reap();
+   return (void *)0;
+}
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdSysIOUring::XrdSysIOUring(int rings, int qdepth)
+             : ringVec(0), ringNum(rings > 0 ? rings : 1),
+               ringQSZ(qdepth > 0 ? qdepth : 128),
+               numReqs(0), numFull(0), numCalls(0), numFail(0) {}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdSysIOUring::~XrdSysIOUring()
+{
+   Stop();
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+int XrdSysIOUring::Init(const char *&eTxt)
+{
+#ifdef HAVE_IO_URING
+   XrdSysRWLockHelper wrLock(ringLock, false);
+   int rc = 0;
+
+// Allocate and set up each ring
+//
+   if (ringVec) return 0;
+   ringVec = new Ring[ringNum];
+
+   for (int i = 0; i < ringNum; i++)
+       {if ((rc = ringVec[i].Setup(ringQSZ, eTxt))) break;
+        if ((rc = XrdSysThread::Run(&ringVec[i].reapTID, XrdSysIOUringReaper,
+                                    (void *)&ringVec[i],
+                                    XRDSYSTHREAD_BIND | XRDSYSTHREAD_HOLD,
+                                    "io_uring reaper")))
+           {eTxt = "start io_uring reaper"; break;}
+        ringVec[i].reapOK = true;
+       }
+
+// If anything failed, tear everything down
+//
+   if (rc) {delete [] ringVec; ringVec = 0;}
+   return rc;
+#else
+   eTxt = "use io_uring";
+   return ENOSYS;
+#endif
+}
+
+/******************************************************************************/
+/*                                  S t o p                                   */
+/******************************************************************************/
+
+void XrdSysIOUring::Stop()
+{
+   XrdSysRWLockHelper wrLock(ringLock, false);
+
+// Deleting the rings waits for all requests in flight to complete
+//
+   if (ringVec) {delete [] ringVec; ringVec = 0;}
+}
+
+/******************************************************************************/
+/*                              W i t h d r a w                               */
+/******************************************************************************/
+
+// The kernel refused to consume the queued entries for a reason that retrying
+// will not cure. Entries after ours may belong to other threads, so ours can
+// not be taken off the queue. Instead, should it still be queued, it is turned
+// into a no-op whose completion, if it ever comes, only frees the slot. The
+// caller then reports the failure so that the request is done another way.
+// Returns true if the entry was withdrawn and false if the kernel got it
+// after all, in which case the callback will be invoked as usual.
+
+bool XrdSysIOUring::Withdraw(Ring &R, unsigned int tail, void *slot)
+{
+#ifdef HAVE_IO_URING
+   struct io_uring_sqe *sqeP = &R.sqeVec[tail & R.sqMask];
+   Ring::Slot *slotP = (Ring::Slot *)slot;
+   bool queued;
+
+   R.sqMutex.Lock();
+   if ((queued = (int)(__atomic_load_n(R.sqHead,__ATOMIC_ACQUIRE) - tail) <= 0))
+      {sqeP->addr = 0;
+       sqeP->len  = 0;
+       __atomic_store_n(&sqeP->opcode, (__u8)IORING_OP_NOP, __ATOMIC_RELEASE);
+       slotP->cb  = 0;
+       numFail++;
+      }
+   R.sqMutex.UnLock();
+   return queued;
+#else
+   return false;
+#endif
+}
+
+/******************************************************************************/
+/*                                S u b m i t                                 */
+/******************************************************************************/
+
+int XrdSysIOUring::Submit(Opc opc, int fd, void *buff, size_t blen, off_t offs,
+                          DoneCB cb, void *cbArg)
+{
+#ifdef HAVE_IO_URING
+   static const __u8 opMap[] = {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC,
+                                IORING_OP_READV};
+   struct io_uring_sqe *sqeP;
+   Ring::Slot *slotP;
+   unsigned int tail;
+   int rc;
+
+// Make sure we have rings and find the one assigned to this thread. We never
+// wait for the lock as the rings may be stopping and a completion callback
+// that submits another request would otherwise deadlock the reaper.
+//
+   if (!ringLock.CondReadLock()) return EAGAIN;
+   if (!ringVec) {ringLock.UnLock(); return ENOSYS;}
+   if (myRing < 0) myRing = nextRing++;
+   Ring &R = ringVec[myRing % ringNum];
+
+// Allocate a slot and an sqe. If either is not available the caller must
+// handle the request some other way.
+//
+   R.sqMutex.Lock();
+   tail = *R.sqTail;
+   if (!R.slotFree || tail - __atomic_load_n(R.sqHead,__ATOMIC_ACQUIRE) >= R.sqEnts)
+      {R.sqMutex.UnLock();
+       ringLock.UnLock();
+       numFull++;
+       return EAGAIN;
+      }
+   slotP = R.slotFree;
+   R.slotFree = slotP->next;
+   R.slotBusy++;
+   slotP->cb = cb; slotP->cbArg = cbArg;
+
+// Fill out the sqe and make it visible to the kernel
+//
+   sqeP = &R.sqeVec[tail & R.sqMask];
+   memset(sqeP, 0, sizeof(struct io_uring_sqe));
+   sqeP->opcode    = opMap[opc];
+   sqeP->fd        = fd;
+   sqeP->user_data = slotP - R.slotVec;
+   if (opc != opFsync)
+      {sqeP->addr = (unsigned long)buff;
+       sqeP->len  = blen;
+       sqeP->off  = offs;
+      }
+   R.sqArray[tail & R.sqMask] = tail & R.sqMask;
+   __atomic_store_n(R.sqTail, tail+1, __ATOMIC_RELEASE);
+   R.sqMutex.UnLock();
+   numReqs++;
+
+// Tell the kernel to consume everything that has been queued. Since this is
+// done outside of the lock, entries queued by concurrent threads are submitted
+// as a batch by whichever thread gets here first. We keep at it until our own
+// entry has been consumed; transient failures are simply retried.
+//
+   numCalls++;
+   while((int)(__atomic_load_n(R.sqHead, __ATOMIC_ACQUIRE) - tail) <= 0)
+        {if ((rc = sysEnter(R.ringFD, R.sqEnts, 0, 0)) > 0) continue;
+         if (rc < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {rc = errno;
+             if (Withdraw(R, tail, slotP)) {ringLock.UnLock(); return rc;}
+             break;
+            }
+         sched_yield();
+        }
+   ringLock.UnLock();
+   return 0;
+#else
+   return ENOSYS;
+#endif
+}
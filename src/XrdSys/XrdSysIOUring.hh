@@ -0,0 +1,152 @@
+#ifndef __XRDSYSIOURING_HH__
+#define __XRDSYSIOURING_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S y s I O U r i n g . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
+
+//------------------------------------------------------------------------------
+//! The XrdSysIOUring class implements a small set of Linux io_uring instances
+//! used to perform file I/O asynchronously without the thread-per-request
+//! emulation that glibc uses for POSIX aio. Each ring has its own submission
+//! lock and a dedicated reaper thread that collects completions in batches.
+//! Submitting threads are spread across the rings so that unrelated threads
+//! rarely contend for the same submission queue.
+//!
+//! The kernel interface is used directly (i.e. liburing is not required).
+//! When the platform or the running kernel does not support io_uring, Init()
+//! fails and the caller is expected to use its existing synchronous or aio
+//! code path instead.
+//------------------------------------------------------------------------------
+
+class XrdSysIOUring
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Completion callback. It is invoked on the ring's reaper thread.
+//!
+//! @param  cbArg   - The argument passed to Submit().
+//! @param  result  - >= 0 the number of bytes transferred (zero for fsync);
+//!                   <  0 the negative errno value describing the failure.
+//------------------------------------------------------------------------------
+
+typedef void (*DoneCB)(void *cbArg, int result);
+
+enum Opc {opRead = 0, opWrite, opFsync, opReadv};
+
+//------------------------------------------------------------------------------
+//! Initialize all of the rings and start the reaper threads.
+//!
+//! @param  eTxt    - Upon failure, set to describe what failed.
+//!
+//! @return 0 upon success; otherwise the errno value describing the failure.
+//!         ENOSYS is returned when io_uring is not supported.
+//------------------------------------------------------------------------------
+
+int           Init(const char *&eTxt);
+
+//------------------------------------------------------------------------------
+//! Stop all of the rings. This waits for every request in flight to complete
+//! before tearing down the rings. Afterwards, Submit() fails with ENOSYS
+//! until Init() is called again.
+//------------------------------------------------------------------------------
+
+void          Stop();
+
+//------------------------------------------------------------------------------
+//! Queue an I/O request.
+//!
+//! @param  opc     - The operation to perform.
+//! @param  fd      - The file descriptor to use.
+//! @param  buff    - The buffer to read into or write from (ignored for sync).
+//! @param  blen    - The number of bytes to transfer    (ignored for sync).
+//! @param  offs    - The file offset for the transfer   (ignored for sync).
+//! @param  cb      - The function to call when the request completes.
+//! @param  cbArg   - The argument to pass to cb.
+//!
+//! For opReadv, buff points to an array of struct iovec and blen is the number
+//! of elements in it. The array must remain valid until cb is called.
+//!
+//! @return 0 the request was queued and cb will be called upon completion.
+//!         EAGAIN the ring is full; the request should be done another way.
+//!         ENOSYS the rings were never successfully initialized.
+//!         Any other value is the errno with which the kernel refused the
+//!         request; cb will not be called and the request should be done
+//!         another way.
+//------------------------------------------------------------------------------
+
+int           Submit(Opc opc, int fd, void *buff, size_t blen, off_t offs,
+                     DoneCB cb, void *cbArg);
+
+//------------------------------------------------------------------------------
+//! Obtain usage statistics.
+//!
+//! @param  reqs    - Set to the number of requests queued.
+//! @param  full    - Set to the number of requests rejected with EAGAIN.
+//! @param  calls   - Set to the number of submission system calls made.
+//! @param  fails   - Set to the number of requests the kernel refused.
+//------------------------------------------------------------------------------
+
+void          Stats(long long &reqs, long long &full, long long &calls,
+                    long long &fails)
+                   {reqs = numReqs; full = numFull; calls = numCalls;
+                    fails = numFail;
+                   }
+
+//------------------------------------------------------------------------------
+//! Constructor and destructor
+//!
+//! @param  rings   - The number of rings to create.
+//! @param  qdepth  - The submission queue depth of each ring. Up to twice
+//!                   this number of requests may be in flight per ring.
+//------------------------------------------------------------------------------
+
+              XrdSysIOUring(int rings=1, int qdepth=128);
+             ~XrdSysIOUring();
+
+struct        Ring;
+
+private:
+
+bool          Withdraw(Ring &R, unsigned int tail, void *slot);
+
+XrdSysRWLock  ringLock;
+Ring         *ringVec;
+int           ringNum;
+int           ringQSZ;
+
+RAtomic_llong numReqs;
+RAtomic_llong numFull;
+RAtomic_llong numCalls;
+RAtomic_llong numFail;
+};
+#endif
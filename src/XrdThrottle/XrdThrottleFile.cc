@@ -7,13 +7,18 @@
 
 using namespace XrdThrottle;
 
-#define DO_LOADSHED if (m_throttle.CheckLoadShed(m_loadshed)) \
+#define SET_LOADSHED \
 { \
    unsigned port; \
    std::string host; \
    m_throttle.PerformLoadShed(m_loadshed, host, port); \
    m_eroute.Emsg("File", "Performing load-shed for client", m_connection_id.c_str()); \
    error.setErrInfo(port, host.c_str()); \
+}
+
+#define DO_LOADSHED if (m_throttle.CheckLoadShed(m_loadshed)) \
+{ \
+   SET_LOADSHED \
    return SFS_REDIRECT; \
 }
 
@@ -22,6 +27,83 @@ DO_LOADSHED \
 m_throttle.Apply(amount, 1, m_uid); \
 XrdThrottleTimer xtimer = m_throttle.StartIOTimer();
 
+// In asynchronous mode, hand aio requests to the throttle manager rather than
+// waiting here for shares; the request completes whenever it is admitted.
+#define DO_AIO_THROTTLE(op, opts, done) \
+if (m_throttle.IsAsync()) \
+{ \
+   if (m_throttle.CheckLoadShed(m_loadshed)) \
+   { \
+      SET_LOADSHED \
+      aioparm->Result = SFS_REDIRECT; \
+   } \
+   else \
+   { \
+      m_throttle.Submit(new AioRequest(m_throttle, m_uid, *m_sfs, aioparm, op, opts)); \
+      return SFS_OK; \
+   } \
+   aioparm->done(); \
+   return SFS_OK; \
+}
+
+namespace
+{
+/*
+ * An aio request deferred by the throttle.  The IO is done synchronously
+ * against the underlying file, exactly as the non-deferred path does, on
+ * whichever thread admits the request.
+ */
+class AioRequest : public XrdThrottleRequest
+{
+public:
+
+enum AioOp {aioRead, aioWrite, aioPgRead, aioPgWrite};
+
+void DoIO() override
+{
+   XrdSfsFileOffset offset = (XrdSfsFileOffset)m_aiop->sfsAio.aio_offset;
+   char            *buffer = (char *)m_aiop->sfsAio.aio_buf;
+   XrdSfsXferSize   blen   = (XrdSfsXferSize)m_aiop->sfsAio.aio_nbytes;
+
+   switch(m_op)
+   {
+      case aioRead:
+         m_aiop->Result = m_sfs.read(offset, buffer, blen);
+         break;
+      case aioWrite:
+         m_aiop->Result = m_sfs.write(offset, buffer, blen);
+         break;
+      case aioPgRead:
+         m_aiop->Result = m_sfs.pgRead(offset, buffer, blen, m_aiop->cksVec, m_opts);
+         break;
+      case aioPgWrite:
+         m_aiop->Result = m_sfs.pgWrite(offset, buffer, blen, m_aiop->cksVec, m_opts);
+         break;
+   }
+}
+
+void Done() override
+{
+   if (m_op == aioRead || m_op == aioPgRead) m_aiop->doneRead();
+   else m_aiop->doneWrite();
+}
+
+AioRequest(XrdThrottleManager &throttle, int uid, XrdSfsFile &sfs,
+           XrdSfsAio *aiop, AioOp op, uint64_t opts)
+   : XrdThrottleRequest(throttle, (int)aiop->sfsAio.aio_nbytes, 1, uid),
+     m_sfs(sfs), m_aiop(aiop), m_op(op), m_opts(opts) {}
+
+virtual ~AioRequest() {}
+
+private:
+
+XrdSfsFile &m_sfs;
+XrdSfsAio  *m_aiop;
+AioOp       m_op;
+uint64_t    m_opts;
+};
+}
+
 File::File(const char                     *user,
                  unique_sfs_ptr            sfs,
                  XrdThrottleManager       &throttle,
@@ -128,7 +210,8 @@ File::pgRead(XrdSfsFileOffset   offset,
 
 XrdSfsXferSize
 File::pgRead(XrdSfsAio *aioparm, uint64_t opts)
-{  // We disable all AIO-based reads.
+{  // Unless deferred, AIO-based reads are done synchronously.
+   DO_AIO_THROTTLE(AioRequest::aioPgRead, opts, doneRead)
    aioparm->Result = this->pgRead((XrdSfsFileOffset)aioparm->sfsAio.aio_offset,
                                             (char *)aioparm->sfsAio.aio_buf,
                                     (XrdSfsXferSize)aioparm->sfsAio.aio_nbytes,
@@ -150,7 +233,8 @@ File::pgWrite(XrdSfsFileOffset   offset,
 
 XrdSfsXferSize
 File::pgWrite(XrdSfsAio *aioparm, uint64_t opts)
-{  // We disable all AIO-based writes.
+{  // Unless deferred, AIO-based writes are done synchronously.
+   DO_AIO_THROTTLE(AioRequest::aioPgWrite, opts, doneWrite)
    aioparm->Result = this->pgWrite((XrdSfsFileOffset)aioparm->sfsAio.aio_offset,
                                              (char *)aioparm->sfsAio.aio_buf,
                                      (XrdSfsXferSize)aioparm->sfsAio.aio_nbytes,
@@ -178,7 +262,8 @@ File::read(XrdSfsFileOffset   fileOffset,
 
 int
 File::read(XrdSfsAio *aioparm)
-{  // We disable all AIO-based reads.
+{  // Unless deferred, AIO-based reads are done synchronously.
+   DO_AIO_THROTTLE(AioRequest::aioRead, 0, doneRead)
    aioparm->Result = this->read((XrdSfsFileOffset)aioparm->sfsAio.aio_offset,
                                           (char *)aioparm->sfsAio.aio_buf,
                                   (XrdSfsXferSize)aioparm->sfsAio.aio_nbytes);
@@ -198,6 +283,7 @@ File::write(      XrdSfsFileOffset   fileOffset,
 int
 File::write(XrdSfsAio *aioparm)
 {
+   DO_AIO_THROTTLE(AioRequest::aioWrite, 0, doneWrite)
    aioparm->Result = this->write((XrdSfsFileOffset)aioparm->sfsAio.aio_offset,
                                            (char *)aioparm->sfsAio.aio_buf,
                                    (XrdSfsXferSize)aioparm->sfsAio.aio_nbytes);
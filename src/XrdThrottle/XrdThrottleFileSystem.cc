@@ -1,5 +1,6 @@
 
 #include "XrdOfs/XrdOfs.hh"
+#include "XrdOuc/XrdOucEnv.hh"
 
 #include "XrdThrottle/XrdThrottle.hh"
 
@@ -70,6 +71,12 @@ FileSystem::Disc(const XrdSecEntity *client)
 void
 FileSystem::EnvInfo(XrdOucEnv *envP)
 {
+   // Deferred requests are dispatched via the scheduler; without one, all
+   // requests are throttled synchronously.
+   XrdScheduler *sched = envP ? (XrdScheduler *)envP->GetPtr("XrdScheduler*") : 0;
+   if (m_throttle.WantAsync() && !sched)
+      m_eroute.Say("Config warning: no scheduler available; asynchronous throttling disabled.");
+   m_throttle.SetScheduler(sched);
    m_sfs_ptr->EnvInfo(envP);
 }
 
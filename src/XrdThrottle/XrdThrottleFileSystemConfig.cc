@@ -227,11 +227,15 @@ FileSystem::xmaxconn(XrdOucStream &Config)
 /* Function: xthrottle
 
    Purpose:  To parse the directive: throttle [data <drate>] [iops <irate>] [concurrency <climit>] [interval <rint>]
+                                              [async]
 
              <drate>    maximum bytes per second through the server.
              <irate>    maximum IOPS per second through the server.
              <climit>   maximum number of concurrent IO connections.
              <rint>     minimum interval in milliseconds between throttle re-computing.
+             async      park asynchronous requests that are over the throttle
+                        and complete them once admitted instead of stalling
+                        the requesting thread.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -239,6 +243,7 @@ int
 FileSystem::xthrottle(XrdOucStream &Config)
 {
     long long drate = -1, irate = -1, rint = 1000, climit = -1;
+    bool async = false;
     char *val;
 
     while ((val = Config.GetWord()))
@@ -267,6 +272,10 @@ FileSystem::xthrottle(XrdOucStream &Config)
              {m_eroute.Emsg("Config", "Concurrency limit not specified."); return 1;}
           if (XrdOuca2x::a2sz(m_eroute,"Concurrency limit value",val,&climit,1)) return 1;
        }
+       else if (strcmp("async", val) == 0)
+       {
+          async = true;
+       }
        else
        {
           m_eroute.Emsg("Config", "Warning - unknown throttle option specified", val, ".");
@@ -274,6 +283,7 @@ FileSystem::xthrottle(XrdOucStream &Config)
     }
 
     m_throttle.SetThrottles(drate, irate, climit, static_cast<float>(rint)/1000.0);
+    m_throttle.SetAsync(async);
     return 0;
 }
 
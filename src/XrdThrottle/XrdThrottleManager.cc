@@ -1,6 +1,8 @@
 
 #include "XrdThrottleManager.hh"
 
+#include "Xrd/XrdScheduler.hh"
+
 #include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -252,50 +254,160 @@ XrdThrottleManager::CloseFile(const std::string &entity)
 
 
 /*
- * Apply the throttle.  If there are no limits set, returns immediately.  Otherwise,
- * this applies the limits as best possible, stalling the thread if necessary.
+ * Take whatever shares are currently available towards the request without
+ * blocking.  The request is updated with what remains; returns true if it
+ * has been fully satisfied.
  */
-void
-XrdThrottleManager::Apply(int reqsize, int reqops, int uid)
+bool
+XrdThrottleManager::TryApply(int &reqsize, int &reqops, int uid)
 {
    if (m_bytes_per_second < 0)
       reqsize = 0;
    if (m_ops_per_second < 0)
       reqops = 0;
-   while (reqsize || reqops)
+   if (!reqsize && !reqops) return true;
+
+   // Subtract the requested out of the shares
+   AtomicBeg(m_compute_var);
+   GetShares(m_primary_bytes_shares[uid], reqsize);
+   if (reqsize)
+   {
+      TRACE(BANDWIDTH, "Using secondary shares; request has " << reqsize << " bytes left.");
+      GetShares(m_secondary_bytes_shares[uid], reqsize);
+      TRACE(BANDWIDTH, "Finished with secondary shares; request has " << reqsize << " bytes left.");
+   }
+   else
+   {
+      TRACE(BANDWIDTH, "Filled byte shares out of primary; " << m_primary_bytes_shares[uid] << " left.");
+   }
+   GetShares(m_primary_ops_shares[uid], reqops);
+   if (reqops)
    {
-      // Subtract the requested out of the shares
+      GetShares(m_secondary_ops_shares[uid], reqops);
+   }
+   StealShares(uid, reqsize, reqops);
+   AtomicEnd(m_compute_var);
+
+   return !reqsize && !reqops;
+}
+
+/*
+ * Apply the throttle.  If there are no limits set, returns immediately.  Otherwise,
+ * this applies the limits as best possible, stalling the thread if necessary.
+ */
+void
+XrdThrottleManager::Apply(int reqsize, int reqops, int uid)
+{
+   while (!TryApply(reqsize, reqops, uid))
+   {
+      if (reqsize) TRACE(BANDWIDTH, "Sleeping to wait for throttle fairshare.");
+      if (reqops) TRACE(IOPS, "Sleeping to wait for throttle fairshare.");
+      m_compute_var.Wait();
       AtomicBeg(m_compute_var);
-      GetShares(m_primary_bytes_shares[uid], reqsize);
-      if (reqsize)
+      AtomicInc(m_loadshed_limit_hit);
+      AtomicEnd(m_compute_var);
+   }
+}
+
+/*
+ * Submit a request without blocking the caller.  If nothing is parked and
+ * the request is within its share and the concurrency limit, the IO is done
+ * right away on the calling thread.  Otherwise the request is parked behind
+ * those already waiting; parked requests are retried whenever an IO
+ * completes and after each refill, and handed to the scheduler once admitted.
+ */
+void
+XrdThrottleManager::Submit(XrdThrottleRequest *req)
+{
+   if (!m_defer_num.load(std::memory_order_acquire) && Admit(*req))
+   {
+      req->DoIt();
+      return;
+   }
+
+   AtomicBeg(m_compute_var);
+   AtomicInc(m_loadshed_limit_hit);
+   AtomicEnd(m_compute_var);
+
+   {
+      const std::lock_guard<std::mutex> lock(m_defer_mutex);
+      req->m_next = nullptr;
+      if (m_defer_last) m_defer_last->m_next = req;
+      else m_defer_first = req;
+      m_defer_last = req;
+      m_defer_num.fetch_add(1, std::memory_order_release);
+   }
+
+   // A slot may have freed up since we looked; this also gives the requests
+   // parked ahead of us their turn first.
+   DispatchDeferred();
+}
+
+/*
+ * Try to admit a request: obtain the rest of its shares and a slot under
+ * the concurrency limit.  Shares obtained are kept even if the request is
+ * not admitted, just as Apply() does while it waits.  Sets 'full' when the
+ * request was refused only for lack of a concurrency slot.
+ */
+bool
+XrdThrottleManager::Admit(XrdThrottleRequest &req, bool *full)
+{
+   if (!TryApply(req.m_reqsize, req.m_reqops, req.m_uid)) return false;
+   if (TryStartIO()) return true;
+   if (full) *full = true;
+   return false;
+}
+
+/*
+ * Retry the parked requests, in the order they were submitted.  Those that
+ * are now admitted are scheduled; the rest stay parked.  Once no concurrency
+ * slot is left no later request can be admitted, so we stop looking.
+ */
+void
+XrdThrottleManager::DispatchDeferred()
+{
+   XrdThrottleRequest *req, *keep_first = nullptr, *keep_last = nullptr;
+   int dispatched = 0, kept = 0;
+   bool full = false;
+
+   if (!m_sched || !m_defer_num.load(std::memory_order_acquire)) return;
+
+   {
+      const std::lock_guard<std::mutex> lock(m_defer_mutex);
+      req = m_defer_first;
+      m_defer_first = m_defer_last = nullptr;
+   }
+   if (!req) return;
+
+   while (req)
+   {
+      XrdThrottleRequest *next = req->m_next;
+      if (!full && Admit(*req, &full))
       {
-         TRACE(BANDWIDTH, "Using secondary shares; request has " << reqsize << " bytes left.");
-         GetShares(m_secondary_bytes_shares[uid], reqsize);
-         TRACE(BANDWIDTH, "Finished with secondary shares; request has " << reqsize << " bytes left.");
+         m_defer_num.fetch_sub(1, std::memory_order_release);
+         m_sched->Schedule(req);
+         dispatched++;
       }
       else
       {
-         TRACE(BANDWIDTH, "Filled byte shares out of primary; " << m_primary_bytes_shares[uid] << " left.");
-      }
-      GetShares(m_primary_ops_shares[uid], reqops);
-      if (reqops)
-      {
-         GetShares(m_secondary_ops_shares[uid], reqops);
-      }
-      StealShares(uid, reqsize, reqops);
-      AtomicEnd(m_compute_var);
-
-      if (reqsize || reqops)
-      {
-         if (reqsize) TRACE(BANDWIDTH, "Sleeping to wait for throttle fairshare.");
-         if (reqops) TRACE(IOPS, "Sleeping to wait for throttle fairshare.");
-         m_compute_var.Wait();
-         AtomicBeg(m_compute_var);
-         AtomicInc(m_loadshed_limit_hit);
-         AtomicEnd(m_compute_var);
+         req->m_next = nullptr;
+         if (keep_last) keep_last->m_next = req;
+         else keep_first = req;
+         keep_last = req;
+         kept++;
       }
+      req = next;
    }
 
+   // Requests parked while we were busy go behind the ones we kept.
+   if (keep_first)
+   {
+      const std::lock_guard<std::mutex> lock(m_defer_mutex);
+      keep_last->m_next = m_defer_first;
+      m_defer_first = keep_first;
+      if (!m_defer_last) m_defer_last = keep_last;
+   }
+   TRACE(DEBUG, "Dispatched " << dispatched << " deferred requests; " << kept << " remain parked.");
 }
 
 void *
@@ -354,6 +466,7 @@ XrdThrottleManager::Recompute()
 
       TRACE(DEBUG, "Recomputing fairshares for throttle.");
       RecomputeInternal();
+      DispatchDeferred();
       TRACE(DEBUG, "Finished recomputing fairshares for throttle; sleeping for " << m_interval_length_seconds << " seconds.");
       XrdSysTimer::Wait(static_cast<int>(1000*m_interval_length_seconds));
    }
@@ -486,6 +599,25 @@ XrdThrottleManager::StartIOTimer()
    return XrdThrottleTimer(*this);
 }
 
+/*
+ * Count a new outstanding IO if doing so stays within the concurrency limit;
+ * returns false, without counting it, otherwise.
+ */
+bool
+XrdThrottleManager::TryStartIO()
+{
+   AtomicBeg(m_compute_var);
+   int cur_counter = AtomicInc(m_io_counter);
+   if (m_concurrency_limit >= 0 && cur_counter > m_concurrency_limit)
+   {
+      AtomicDec(m_io_counter);
+      AtomicEnd(m_compute_var);
+      return false;
+   }
+   AtomicEnd(m_compute_var);
+   return true;
+}
+
 /*
  * Finish recording an IO timer.
  */
@@ -498,6 +630,23 @@ XrdThrottleManager::StopIOTimer(struct timespec timer)
    // Note this may result in tv_nsec > 1e9
    AtomicAdd(m_io_wait.tv_nsec, timer.tv_nsec);
    AtomicEnd(m_compute_var);
+
+   // A concurrency slot just freed up; let a parked request have it.
+   DispatchDeferred();
+}
+
+/*
+ * Perform an admitted request; the outstanding IO was already counted when
+ * the request was admitted and the timer releases it.
+ */
+void
+XrdThrottleRequest::DoIt()
+{
+   XrdThrottleTimer xtimer(m_manager);
+   DoIO();
+   xtimer.StopTimer();
+   Done();
+   delete this;
 }
 
 /*
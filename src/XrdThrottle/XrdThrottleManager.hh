@@ -15,6 +15,12 @@
  * Note that we do not actually keep close track of users, but rather
  * put them into a hash.  This way, we can pretend there's a constant
  * number of users and use a lock-free algorithm.
+ *
+ * Requests may also be submitted asynchronously (see Submit()).  Instead
+ * of stalling the calling thread, a request that is over its share or
+ * over the concurrency limit is parked and retried whenever an IO completes
+ * and after each recompute; once admitted it is handed to the scheduler to
+ * perform the IO.
  */
 
 #ifndef __XrdThrottleManager_hh_
@@ -31,20 +37,25 @@
 #include <string>
 #include <vector>
 #include <ctime>
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <memory>
 
+#include "Xrd/XrdJob.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
+class XrdScheduler;
 class XrdSysError;
 class XrdOucTrace;
+class XrdThrottleRequest;
 class XrdThrottleTimer;
 
 class XrdThrottleManager
 {
 
 friend class XrdThrottleTimer;
+friend class XrdThrottleRequest;
 
 public:
 
@@ -55,6 +66,10 @@ bool        CloseFile(const std::string &entity);
 
 void        Apply(int reqsize, int reqops, int uid);
 
+void        Submit(XrdThrottleRequest *req);
+
+bool        IsAsync() {return m_async && m_sched;}
+
 bool        IsThrottling() {return (m_ops_per_second > 0) || (m_bytes_per_second > 0);}
 
 void        SetThrottles(float reqbyterate, float reqoprate, int concurrency, float interval_length)
@@ -68,6 +83,12 @@ void        SetMaxOpen(unsigned long max_open) {m_max_open = max_open;}
 
 void        SetMaxConns(unsigned long max_conns) {m_max_conns = max_conns;}
 
+void        SetAsync(bool async) {m_async = async;}
+
+bool        WantAsync() {return m_async;}
+
+void        SetScheduler(XrdScheduler *sched) {m_sched = sched;}
+
 //int         Stats(char *buff, int blen, int do_sync=0) {return m_pool.Stats(buff, blen, do_sync);}
 
 static
@@ -100,6 +121,14 @@ void *      RecomputeBootstrap(void *pp);
 
 int         WaitForShares();
 
+bool        TryApply(int &reqsize, int &reqops, int uid);
+
+bool        TryStartIO();
+
+bool        Admit(XrdThrottleRequest &req, bool *full=nullptr);
+
+void        DispatchDeferred();
+
 void        GetShares(int &shares, int &request);
 
 void        StealShares(int uid, int &reqsize, int &reqops);
@@ -145,14 +174,57 @@ std::unordered_map<std::string, unsigned long> m_conn_counters;
 std::unordered_map<std::string, std::unique_ptr<std::unordered_map<pid_t, unsigned long>>> m_active_conns;
 std::mutex m_file_mutex;
 
+// Requests parked until they are within their share (asynchronous mode)
+bool        m_async{false};
+XrdScheduler *m_sched{nullptr};
+std::mutex  m_defer_mutex;
+XrdThrottleRequest *m_defer_first{nullptr};
+XrdThrottleRequest *m_defer_last{nullptr};
+std::atomic<int> m_defer_num{0};
+
 static const char *TraceID;
 
 };
 
+/*
+ * A throttled IO request that is submitted asynchronously.  Derived classes
+ * implement DoIO(), which performs the IO, and Done(), which reports the
+ * result to the requester.  Both are called exactly once, possibly on a
+ * different thread than the one that submitted the request; the object
+ * deletes itself afterwards.
+ */
+class XrdThrottleRequest : public XrdJob
+{
+
+friend class XrdThrottleManager;
+
+public:
+
+virtual void DoIO() = 0;
+
+virtual void Done() = 0;
+
+void         DoIt() override;
+
+             XrdThrottleRequest(XrdThrottleManager &manager, int reqsize, int reqops, int uid) :
+                XrdJob("throttled IO"), m_manager(manager), m_next(nullptr),
+                m_reqsize(reqsize), m_reqops(reqops), m_uid(uid) {}
+
+virtual     ~XrdThrottleRequest() {}
+
+private:
+XrdThrottleManager &m_manager;
+XrdThrottleRequest *m_next;
+int         m_reqsize;
+int         m_reqops;
+int         m_uid;
+};
+
 class XrdThrottleTimer
 {
 
 friend class XrdThrottleManager;
+friend class XrdThrottleRequest;
 
 public:
 
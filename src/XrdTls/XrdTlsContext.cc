@@ -655,6 +655,14 @@ XrdTlsContext::XrdTlsContext(const char *cert,  const char *key,
 //
    SSL_CTX_set_options(pImpl->ctx, sslOpts);
 
+// Allow record encryption to be offloaded to the kernel when so requested.
+// OpenSSL silently falls back to user space encryption when the kernel or
+// the negotiated cipher does not support it.
+//
+#ifdef SSL_OP_ENABLE_KTLS
+   if (opts & ktlsON) SSL_CTX_set_options(pImpl->ctx, SSL_OP_ENABLE_KTLS);
+#endif
+
 // Handle session re-negotiation automatically
 //
 // SSL_CTX_set_mode(pImpl->ctx, sslMode);
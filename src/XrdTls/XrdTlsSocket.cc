@@ -418,6 +418,24 @@ XrdTlsPeerCerts *XrdTlsSocket::getCerts(bool ver)
    return new XrdTlsPeerCerts(pcert, SSL_get_peer_cert_chain(pImpl->ssl));
 }
   
+/******************************************************************************/
+/*                               h a s K T L S                                */
+/******************************************************************************/
+
+bool XrdTlsSocket::hasKTLS()
+{
+// Kernel TLS is negotiated by OpenSSL once the handshake completes. The check
+// is cheap as it simply queries the state of the underlying write BIO.
+//
+#if !defined(OPENSSL_NO_KTLS) && OPENSSL_VERSION_NUMBER >= 0x30000000L
+   if (!pImpl->ssl || pImpl->fatal || !SSL_is_init_finished(pImpl->ssl))
+      return false;
+   return BIO_get_ktls_send(SSL_get_wbio(pImpl->ssl)) != 0;
+#else
+   return false;
+#endif
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -698,6 +716,73 @@ XrdTls::RC XrdTlsSocket::Read( char *buffer, size_t size, int &bytesRead )
     return XrdTls::TLS_SYS_Error;
   }
 
+/******************************************************************************/
+/*                              S e n d F i l e                               */
+/******************************************************************************/
+
+XrdTls::RC XrdTlsSocket::SendFile( int fd, off_t offset, size_t size,
+                                   int &bytesWritten )
+{
+#if !defined(OPENSSL_NO_KTLS) && OPENSSL_VERSION_NUMBER >= 0x30000000L
+    EPNAME("SendFile");
+    XrdSysMutexHelper mHelper;
+    int ssler;
+
+    //------------------------------------------------------------------------
+    // Serialize call if need be
+    //------------------------------------------------------------------------
+
+    if (pImpl->isSerial) mHelper.Lock(&(pImpl->sslMutex));
+
+    //------------------------------------------------------------------------
+    // Return an error if this socket received a fatal error as OpenSSL will
+    // SEGV when called after such an error.
+    //------------------------------------------------------------------------
+
+    if (pImpl->fatal)
+       {DBG_SIO("Failing due to previous error, fatal=" << (int)pImpl->fatal);
+        return (XrdTls::RC)pImpl->fatal;
+       }
+
+    //------------------------------------------------------------------------
+    // Unlike SSL_write(), SSL_sendfile() never negotiates a session. The
+    // caller must have verified that kTLS is active (i.e. handshake done).
+    //------------------------------------------------------------------------
+
+ do{ossl_ssize_t rc = SSL_sendfile( pImpl->ssl, fd, offset, size, 0 );
+
+    if (rc > 0)
+      {bytesWritten = (int)rc;
+       DBG_SIO(rc <<" out of " <<size <<" bytes.");
+       return XrdTls::TLS_AOK;
+      }
+
+    // We have a potential error, diagnose it as we would for a write.
+    //
+    ssler = Diagnose("TLS_SendFile", (int)rc, XrdTls::dbgSIO);
+    if (ssler == SSL_ERROR_NONE)
+       {bytesWritten = 0;
+        DBG_SIO(rc <<" out of " <<size <<" bytes.");
+        return XrdTls::TLS_AOK;
+       }
+
+    // If the error isn't due to blocking issues or we may not block, we're done.
+    //
+    if (ssler != SSL_ERROR_WANT_READ && ssler != SSL_ERROR_WANT_WRITE)
+       return XrdTls::ssl2RC(ssler);
+    if (!(pImpl->cAttr & wBlocking)) return XrdTls::ssl2RC(ssler);
+
+    // Wait unil the write can get restarted
+
+   } while(Wait4OK(ssler == SSL_ERROR_WANT_READ));
+
+    return XrdTls::TLS_SYS_Error;
+#else
+    bytesWritten = 0;
+    return XrdTls::TLS_UNK_Error;
+#endif
+}
+
 /******************************************************************************/
 /*                            S e t T r a c e I D                             */
 /******************************************************************************/
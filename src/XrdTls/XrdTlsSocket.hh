@@ -19,6 +19,7 @@
 //------------------------------------------------------------------------------
 
 #include <string>
+#include <sys/types.h>
 
 #include "XrdTls/XrdTls.hh"
 
@@ -136,6 +137,16 @@ enum HS_Mode
 
 XrdTlsPeerCerts *getCerts(bool ver=true);
 
+//------------------------------------------------------------------------
+//! Determine whether record encryption for sends has been offloaded to the
+//! kernel (kTLS). This is only possible after the handshake has completed
+//! and when the context was created with the XrdTlsContext::ktlsON option.
+//!
+//! @return true if SendFile() may be used, false otherwise.
+//------------------------------------------------------------------------
+
+  bool       hasKTLS();
+
 //------------------------------------------------------------------------
 //! Initialize this object to handle the specified TLS I/O mode for the
 //! given file descriptor. Should an error occur, messages are automatically
@@ -205,6 +216,21 @@ XrdTlsPeerCerts *getCerts(bool ver=true);
 
   XrdTls::RC Read( char *buffer, size_t size, int &bytesRead );
 
+//------------------------------------------------------------------------
+//! Send file data over the TLS connection using the kernel's sendfile().
+//! This may only be used when hasKTLS() returns true.
+//!
+//! @param  fd         - The file descriptor of the file holding the data.
+//! @param  offset     - The file offset of the data.
+//! @param  size       - The number of bytes to send.
+//! @param  bytesOut   - Number of bytes actually written, if successful.
+//!
+//! @return TLS_AOK if the operation was successful; otherwise the appropraite
+//!                 return code indicating the problem.
+//------------------------------------------------------------------------
+
+  XrdTls::RC SendFile( int fd, off_t offset, size_t size, int &bytesOut );
+
 //------------------------------------------------------------------------
 //! Set the trace identifier (used when it's updated).
 //!
@@ -36,6 +36,7 @@ set ( XrdSysSources
   XrdSys/XrdSysFallocate.cc     XrdSys/XrdSysFallocate.hh
                                 XrdSys/XrdSysHeaders.hh
   XrdSys/XrdSysIOEvents.cc      XrdSys/XrdSysIOEvents.hh
+  XrdSys/XrdSysIOUring.cc       XrdSys/XrdSysIOUring.hh
                                 XrdSys/XrdSysIOEventsPollE.icc
                                 XrdSys/XrdSysIOEventsPollKQ.icc
                                 XrdSys/XrdSysIOEventsPollPoll.icc
@@ -213,6 +214,7 @@ set ( XrdSources
   Xrd/XrdLinkCtl.cc             Xrd/XrdLinkCtl.hh
                                 Xrd/XrdLinkInfo.hh
   Xrd/XrdLinkXeq.cc             Xrd/XrdLinkXeq.hh
+  Xrd/XrdLinkZC.cc              Xrd/XrdLinkZC.hh
   Xrd/XrdLinkMatch.cc           Xrd/XrdLinkMatch.hh
   Xrd/XrdGlobals.cc
   Xrd/XrdObject.icc             Xrd/XrdObject.hh
@@ -233,6 +235,7 @@ set ( XrdSources
   #-----------------------------------------------------------------------------
 set ( XrdCksSources
   XrdCks/XrdCksAssist.cc           XrdCks/XrdCksAssist.hh
+  XrdCks/XrdCksCalcadler32.cc      XrdCks/XrdCksCalcadler32.hh
   XrdCks/XrdCksCalccrc32.cc        XrdCks/XrdCksCalccrc32.hh
   XrdCks/XrdCksCalccrc32C.cc       XrdCks/XrdCksCalccrc32C.hh
   XrdCks/XrdCksCalcmd5.cc          XrdCks/XrdCksCalcmd5.hh
@@ -240,7 +243,6 @@ set ( XrdCksSources
   XrdCks/XrdCksLoader.cc           XrdCks/XrdCksLoader.hh
   XrdCks/XrdCksManager.cc          XrdCks/XrdCksManager.hh
   XrdCks/XrdCksManOss.cc           XrdCks/XrdCksManOss.hh
-                                   XrdCks/XrdCksCalcadler32.hh
                                    XrdCks/XrdCksCalc.hh
                                    XrdCks/XrdCksData.hh
                                    XrdCks/XrdCks.hh
@@ -28,10 +28,12 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
   
+#include <cerrno>
 #include <unistd.h>
 #include <arpa/inet.h>
 
 #include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdScheduler.hh"
 #include "XrdOuc/XrdOucPgrwUtils.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -52,6 +54,8 @@ extern XrdSysTrace  XrdXrootdTrace;
 namespace XrdXrootd
 {
 extern XrdBuffManager       *BPool;
+extern XrdScheduler         *Sched;
+extern XrdXrootdStats       *SI;
 }
 
 using namespace XrdXrootd;
@@ -78,7 +82,8 @@ static const int  maxKeep = 64; // 4MB in the pocket
 /******************************************************************************/
   
 XrdXrootdAioPgrw::XrdXrootdAioPgrw(XrdXrootdAioTask* tP, XrdBuffer *bP)
-                 : XrdXrootdAioBuff(this, tP, bP)
+                 : XrdXrootdAioBuff(this, tP, bP), XrdJob("pgread segment"),
+                   pipeSfs(0), pipeBeg(0)
 {
    char *buff = bP->buff;
    uint32_t *csV = csVec;
@@ -140,6 +145,7 @@ XrdXrootdAioPgrw *XrdXrootdAioPgrw::Alloc(XrdXrootdAioTask* arp)
        aiobuff->Result = 0;
        aiobuff->cksVec = aiobuff->pgrwP->csVec;
        aiobuff->pgrwP->reqP = arp;
+       aiobuff->pgrwP->pipeBeg = 0;
       }
 
 // Update aio counters
@@ -151,6 +157,52 @@ XrdXrootdAioPgrw *XrdXrootdAioPgrw::Alloc(XrdXrootdAioTask* arp)
    return aiobuff->pgrwP;
 }
   
+/******************************************************************************/
+/*                                  D o I t                                   */
+/******************************************************************************/
+
+// This method is invoked on a scheduler thread to issue a pipelined read.
+  
+void XrdXrootdAioPgrw::DoIt()
+{
+   XrdSfsFile *sfsP = pipeSfs;
+   int rc;
+
+// Issue the read. Should it fail, complete it with the error ourselves so that
+// the request sees it in the same way as a failed asynchronous read.
+//
+   if ((rc = sfsP->pgRead((XrdSfsAio *)this)) != SFS_OK)
+      {int eCode = sfsP->error.getErrInfo();
+       Result = -(rc == SFS_ERROR && eCode > 0 ? eCode : EIO);
+       doneRead();
+      }
+}
+
+/******************************************************************************/
+/*                              d o n e R e a d                               */
+/******************************************************************************/
+  
+void XrdXrootdAioPgrw::doneRead()
+{
+// When pipelined, record how long the read took. If the filesystem did not
+// supply the checksums compute them now so that the sending thread need not.
+//
+   if (pipeBeg)
+      {long long tNow = XrdXrootdStats::pgpNow();
+       SI->pgpTime(XrdXrootdStats::pgpRead, tNow - pipeBeg);
+       if (noChkSums() && Result > 0)
+          {XrdOucPgrwUtils::csCalc((char *)sfsAio.aio_buf, sfsAio.aio_offset,
+                                   Result, cksVec);
+           SI->pgpTime(XrdXrootdStats::pgpCsum, XrdXrootdStats::pgpNow()-tNow);
+          }
+       pipeBeg = 0;
+      }
+
+// Tell the request this data is available to be sent to the client
+//
+   reqP->Completed(this);
+}
+  
 /******************************************************************************/
 /*                              i o v 4 R e c v                               */
 /******************************************************************************/
@@ -235,6 +287,20 @@ void XrdXrootdAioPgrw::Recycle()
       }
 }
   
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+  
+void XrdXrootdAioPgrw::Start(XrdSfsFile *sfsP)
+{
+// Have a scheduler thread issue the read so that it proceeds while the
+// request sends whatever data it already has.
+//
+   pipeSfs = sfsP;
+   pipeBeg = XrdXrootdStats::pgpNow();
+   Sched->Schedule((XrdJob *)this);
+}
+  
 /******************************************************************************/
 /*                            S e t u p 2 R e c v                             */
 /******************************************************************************/
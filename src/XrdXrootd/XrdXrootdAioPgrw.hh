@@ -33,24 +33,31 @@
 #include <sys/uio.h>
 
 #include "XProtocol/XProtocol.hh"
+#include "Xrd/XrdJob.hh"
 #include "XrdXrootd/XrdXrootdAioBuff.hh"
 #include "XrdXrootd/XrdXrootdPgrwAio.hh"
 
 // The XrdXrootdAioPgr object represents a single aio read or write operation.
 // One or more of these are allocated by the XrdXrootdPgrwAio to effect
-// asynchronous I/O. This object is specific to pgRead requests.
+// asynchronous I/O. This object is specific to pgRead requests. When pgreads
+// are pipelined, the object is also the job that issues its own read.
 
+class XrdSfsFile;
 class XrdXrootdFile;
 class XrdXrootdAioTask;
 class XrdXrootdProtocol;
   
-class XrdXrootdAioPgrw : public XrdXrootdAioBuff
+class XrdXrootdAioPgrw : public XrdXrootdAioBuff, public XrdJob
 {
 public:
 
 static
 XrdXrootdAioPgrw   *Alloc(XrdXrootdAioTask *arp);
 
+         void       DoIt() override;
+
+         void       doneRead() override;
+
 struct   iovec     *iov4Data(int &iovNum) {iovNum = csNum<<1; return &ioVec[1];}
 
 struct   iovec     *iov4Recv(int &iovNum);
@@ -69,6 +76,8 @@ struct   iovec     *iov4Send(int &iovNum, int &iovLen, bool cs2net=false);
 
          int        Setup2Send(off_t offs, int dlen, const char *&eMsg);
 
+         void       Start(XrdSfsFile *sfsP);
+
                     XrdXrootdAioPgrw(XrdXrootdAioTask* tP, XrdBuffer *bP);
                    ~XrdXrootdAioPgrw();
 
@@ -79,6 +88,8 @@ private:
 
 static const char*  TraceID;
 
+XrdSfsFile         *pipeSfs;   // -> File to read when pipelined
+long long           pipeBeg;   // Time the pipelined read started (usec)
 int                 csNum;
 int                 iovReset;
 uint32_t            csVec[acsSZ];
@@ -349,6 +349,11 @@ int XrdXrootdProtocol::Configure(char *parms, XrdProtocol_Config *pi)
        if (!as_aioOK) eDest.Say("Config asynchronous I/O has been disabled!");
       }
 
+// Pipelined pgreads do their storage reads on scheduler threads and so may be
+// used even when the filesystem itself has no async I/O. Report their timing.
+//
+   SI->pgpOn = as_pgpipe;
+
 // Compute the maximum stutter allowed during async I/O (one per 64k)
 //
    if (as_segsize > 65536) as_okstutter = as_segsize/65536;
@@ -788,9 +793,10 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
    Purpose:  To parse directive: async [limit <aiopl>] [maxsegs <msegs>]
                                        [maxtot <mtot>] [segsize <segsize>]
                                        [minsize <iosz>] [maxstalls <cnt>]
-                                       [timeout <tos>]
+                                       [timeout <tos>] [minzcsz <zcsz>]
+                                       [muxreq <mreq>]
                                        [Debug] [force] [syncw] [off]
-                                       [nocache] [nosf]
+                                       [nocache] [nosf] [pgpipe] [rvpipe]
 
              <aiopl>  maximum number of async req per link. Default 8.
              <msegs>  maximum number of async ops per request. Default 8.
@@ -803,6 +809,14 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
                       to allow async processing to occur (default is maxbsz/2
                       typically 1M).
              <tos>    second timeout for async I/O.
+             <zcsz>   the minimum response size that is sent using zero-copy
+                      (i.e. MSG_ZEROCOPY) on non-TLS links. The default is
+                      zero which disables zero-copy sends.
+             <mreq>   the maximum number of independent requests on a link that
+                      may be run at the same time. These are stat, statx,
+                      locate, and reads smaller than <iosz>. Any other request
+                      waits for them to finish. The default is 0 which runs
+                      requests on a link one at a time.
              <cnt>    Maximum number of client stalls before synchronous i/o is
                       used. Async mode is tried after <cnt> requests.
              Debug    Turns on async I/O for everything. This an internal
@@ -813,6 +827,15 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
              off      Disables async i/o
              nocache  Disables async I/O is this is a caching proxy.
              nosf     Disables use of sendfile to send data to the client.
+             pgpipe   Pipelines large pgread requests: the file is read in
+                      segments by scheduler threads, each segment's checksums
+                      are computed as its read completes, and segments are
+                      sent as they become ready. This is done even when the
+                      filesystem does not support async I/O. Timing for each
+                      stage is added to the xrootd summary statistics.
+             rvpipe   Reads the next part of a multi-part readv response,
+                      using a scheduler thread, while the previous part is
+                      being sent. Each such readv then occupies two threads.
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -823,7 +846,8 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
     int  i, ppp;
     int  V_force=-1, V_syncw = -1, V_off = -1, V_mstall = -1, V_nosf = -1;
     int  V_limit=-1, V_msegs=-1, V_mtot=-1, V_minsz=-1, V_segsz=-1;
-    int  V_minsf=-1, V_debug=-1, V_noca=-1, V_tmo=-1;
+    int  V_minsf=-1, V_debug=-1, V_noca=-1, V_tmo=-1, V_minzc=-1;
+    int  V_pgpipe=-1, V_rvpipe=-1, V_muxrq=-1;
     long long llp;
     struct asyncopts {const char *opname; int minv; int *oploc;
                       const char *opmsg;} asopts[] =
@@ -833,6 +857,8 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
         {"off",       -1, &V_off,   ""},
         {"nocache",   -1, &V_noca,  ""},
         {"nosf",      -1, &V_nosf,  ""},
+        {"pgpipe",    -1, &V_pgpipe,""},
+        {"rvpipe",    -1, &V_rvpipe,""},
         {"syncw",     -1, &V_syncw, ""},
         {"limit",      0, &V_limit, "async limit"},
         {"segsize", 4096, &V_segsz, "async segsize"},
@@ -841,7 +867,9 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
         {"maxstalls",  0, &V_mstall,"async maxstalls"},
         {"maxtot",     0, &V_mtot,  "async maxtot"},
         {"minsfsz",    1, &V_minsf, "async minsfsz"},
-        {"minsize", 4096, &V_minsz, "async minsize"}};
+        {"minzcsz",65536, &V_minzc, "async minzcsz"},
+        {"minsize", 4096, &V_minsz, "async minsize"},
+        {"muxreq",     0, &V_muxrq, "async muxreq"}};
     int numopts = sizeof(asopts)/sizeof(struct asyncopts);
 
     if (!(val = Config.GetWord()))
@@ -916,11 +944,15 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
    if (V_mstall> 0) as_maxstalls = V_mstall;
    if (V_debug > 0) asyncFlags  |= asDebug;
    if (V_force > 0) as_force     = true;
-   if (V_off   > 0) as_aioOK     = false;
+   if (V_pgpipe> 0) as_pgpipe    = true;
+   if (V_rvpipe> 0) as_rvpipe    = true;
+   if (V_off   > 0) as_aioOK     = as_rvpipe = as_pgpipe = false;
    if (V_syncw > 0) as_syncw     = true;
    if (V_noca  > 0) asyncFlags  |= asNoCache;
    if (V_nosf  > 0) as_nosf      = true;
    if (V_minsf > 0) as_minsfsz   = V_minsf;
+   if (V_minzc > 0) as_minzcsz   = V_minzc;
+   if (V_muxrq > 0) as_muxreq    = V_muxrq;
 
    return 0;
 }
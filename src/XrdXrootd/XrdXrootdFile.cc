@@ -83,7 +83,7 @@ static const unsigned long  heldMask = ~1UL;
 XrdXrootdFile::XrdXrootdFile(const char *id, const char *path, XrdSfsFile *fp,
                              char mode, bool async, struct stat *sP)
                             : XrdSfsp(fp), mmAddr(0), FileKey(strdup(path)),
-                              FileMode(mode), AsyncMode(async),
+                              FileMode(mode), AsyncMode(async), muxBusy(false),
                               aioFob(0), pgwFob(0), fhProc(0),
                               ID(id), refCount(0), syncWait(0)
 {
@@ -111,6 +111,7 @@ char               FileMode;     // 'r' or 'w'
 bool               AsyncMode;    // 1 -> if file in async r/w mode
 bool               isMMapped;    // 1 -> file is memory mapped
 bool               sfEnabled;    // 1 -> file is sendfile enabled
+bool               muxBusy;      // 1 -> a concurrent request is using it
 union {int         fdNum;        // File descriptor number if regular file
        int         fHandle;      // The file handle upon close()
       };
@@ -44,6 +44,7 @@
 #include "XrdXrootd/XrdXrootdFile.hh"
 #include "XrdXrootd/XrdXrootdPgrwAio.hh"
 #include "XrdXrootd/XrdXrootdPgwBadCS.hh"
+#include "XrdXrootd/XrdXrootdStats.hh"
 #include "XrdXrootd/XrdXrootdTrace.hh"
 
 #define TRACELINK dataLink
@@ -56,8 +57,9 @@ extern XrdSysTrace  XrdXrootdTrace;
 
 namespace XrdXrootd
 {
-extern XrdSysError   eLog;
-extern XrdScheduler *Sched;
+extern XrdSysError     eLog;
+extern XrdScheduler   *Sched;
+extern XrdXrootdStats *SI;
 }
 using namespace XrdXrootd;
   
@@ -134,12 +136,17 @@ bool XrdXrootdPgrwAio::CopyF2L_Add2Q(XrdXrootdAioPgrw *aioP)
            aioP->Recycle();
            return false;
           }
-       if ((rc = dataFile->XrdSfsp->pgRead((XrdSfsAio *)aioP)) != SFS_OK)
-          {SendFSError(rc);
-           aioP->Recycle();
-           return false;
+       if (XrdXrootdProtocol::as_pgpipe)
+          {inFlight++;
+           aioP->Start(dataFile->XrdSfsp);
+          } else {
+           if ((rc = dataFile->XrdSfsp->pgRead((XrdSfsAio *)aioP)) != SFS_OK)
+              {SendFSError(rc);
+               aioP->Recycle();
+               return false;
+              }
+           inFlight++;
           }
-       inFlight++;
        TRACEP(FSAIO, "pgrd beg " <<dlen <<'@' <<dataOffset
                                  <<" inF=" <<int(inFlight));
        dataOffset += dlen;
@@ -164,51 +171,74 @@ void XrdXrootdPgrwAio::CopyF2L()
 // Pick a finished element off the pendQ. Wait for an oustanding buffer if we
 // reached our buffer limit. Otherwise, ask for a return if we can start anew.
 // Note: We asked getBuff() if it returns nil to not release the lock.
-//
-do{bool doWait = dataLen <= 0 || inFlight >= XrdXrootdProtocol::as_maxperreq;
-   if (!(bP = getBuff(doWait)))
-      {if (isDone || !CopyF2L_Add2Q()) break;
-       continue;
-      }
+// When pipelined, a held buffer that is next in offset order goes first.
+//
+do{if (!(aioP = Unhold()))
+      {bool doWait = dataLen <= 0
+                  || inFlight+heldNum >= XrdXrootdProtocol::as_maxperreq;
+       if (!(bP = getBuff(doWait)))
+          {if (isDone || !CopyF2L_Add2Q()) break;
+           continue;
+          }
 
 // Step 1: do some tracing
 //
-   TRACEP(FSAIO,"pgrd end "<<bP->sfsAio.aio_nbytes<<'@'<<bP->sfsAio.aio_offset
-                 <<" result="<<bP->Result<<" D-S="<<isDone<<'-'<<int(Status)
-                 <<" inF="<<int(inFlight));
+       TRACEP(FSAIO,"pgrd end "<<bP->sfsAio.aio_nbytes<<'@'
+                     <<bP->sfsAio.aio_offset<<" result="<<bP->Result
+                     <<" D-S="<<isDone<<'-'<<int(Status)
+                     <<" inF="<<int(inFlight));
 
 // Step 2: Validate this buffer
 //
-   if (!Validate(bP))
-      {if (bP != finalRead) bP->Recycle();
-       continue;
-      }
+       if (!Validate(bP))
+          {if (bP != finalRead) bP->Recycle();
+           continue;
+          }
 
 // Step 3: Get a pointer to the derived type (we avoid dynamic cast)
 //
-   aioP = bP->pgrwP;
+       aioP = bP->pgrwP;
 
 // Step 4: If this aio request was simulated (indicated by cksVec being nil)
 // we have to compute the checksums and reset the pointer via noChkSums().
+// Pipelined reads have already done this when the read completed.
 //
-   if (aioP->noChkSums() && aioP->Result > 0)
-      XrdOucPgrwUtils::csCalc((char *)aioP->sfsAio.aio_buf,
-                       aioP->sfsAio.aio_offset, aioP->Result, aioP->cksVec);
+       if (aioP->noChkSums() && aioP->Result > 0)
+          XrdOucPgrwUtils::csCalc((char *)aioP->sfsAio.aio_buf,
+                          aioP->sfsAio.aio_offset, aioP->Result, aioP->cksVec);
+
+// Step 5: Pipelined reads complete in any order but clients expect the data
+// in offset order. So, hold on to this buffer if it is not the next one.
+//
+       if (XrdXrootdProtocol::as_pgpipe && !(aioP = Hold(aioP))) continue;
+      }
 
-// Step 5: If this is the last block to be read then save it for final status
+// Step 6: If this is the last block to be read then save it for final status
 //
-   if (inFlight == 0 && dataLen == 0 && !finalRead)
+   if (inFlight == 0 && dataLen == 0 && !finalRead && !heldQ)
       {finalRead = aioP;
        break;
       }
 
-// Step 8: Send the data to the client and if successful, see if we need to
+// Step 7: Send the data to the client and if successful, see if we need to
 //         schedule more data to be read from the data source.
 //
    if (!isDone && SendData(aioP) && dataLen) {if (!CopyF2L_Add2Q(aioP)) break;}
       else aioP->Recycle();
 
-   } while(inFlight > 0);
+   } while(inFlight > 0 || (heldQ && heldQ->sfsAio.aio_offset == sendOffset));
+
+// Anything still held can never be sent. Normally, this happens only when the
+// request failed but if it did not we must fail it now.
+//
+   if (heldQ)
+      {if (!isDone) SendError(EIDRM, "pgread pipeline logic error");
+       while((aioP = heldQ))
+            {heldQ = aioP->next ? aioP->next->pgrwP : 0;
+             aioP->Recycle();
+            }
+       heldNum = 0;
+      }
 
 // If we are here then the request has finished. If all went well,
 // fire off the final response.
@@ -356,6 +386,36 @@ void XrdXrootdPgrwAio::DoIt()
    if (aioState & aioRead) CopyF2L();
 }
 
+/******************************************************************************/
+/*                                  H o l d                                   */
+/******************************************************************************/
+
+// Return the buffer if it is the next one to be sent. Otherwise, place it in
+// the held queue in offset order and return nil.
+  
+XrdXrootdAioPgrw *XrdXrootdPgrwAio::Hold(XrdXrootdAioPgrw *aioP)
+{
+   XrdXrootdAioPgrw *pP = 0, *nP = heldQ;
+   long long aioOffset = aioP->sfsAio.aio_offset;
+
+// If this is the next buffer in sequence, it can be sent right away
+//
+   if (aioOffset == sendOffset)
+      {sendOffset += aioP->Result;
+       return aioP;
+      }
+
+// Insert the buffer in the held queue
+//
+   while(nP && nP->sfsAio.aio_offset < aioOffset)
+        {pP = nP; nP = (nP->next ? nP->next->pgrwP : 0);}
+   aioP->next = nP;
+   if (pP) pP->next = aioP;
+      else heldQ = aioP;
+   heldNum++;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                  R e a d                                   */
 /******************************************************************************/
@@ -365,9 +425,11 @@ void XrdXrootdPgrwAio::Read(long long offs, int dlen)
 
 // Setup the copy from the file to the network
 //
-   dataOffset = highOffset = offs;
+   dataOffset = highOffset = sendOffset = offs;
    dataLen    = dlen;
    aioState   = aioRead | aioPage;
+   heldQ      = 0;
+   heldNum    = 0;
 
 // Reads run disconnected and are self-terminating, so we need to inclreas the
 // refcount for the link we will be using to prevent it from disaapearing.
@@ -452,7 +514,13 @@ bool XrdXrootdPgrwAio::SendData(XrdXrootdAioBuff *bP, bool final)
 //     snprintf(trBuff, sizeof(trBuff), "Aio PGR: %d@%ld (%ld)\n",
 //              iovLen, bP->sfsAio.aio_offset, (bP->sfsAio.aio_offset>>12));
 //     std::cerr<<trBuff<<std::flush;
-       rc = Response.Send(pgrResp.rsp, infoLen, ioVec, iovNum, iovLen);
+       if (!XrdXrootdProtocol::as_pgpipe)
+          rc = Response.Send(pgrResp.rsp, infoLen, ioVec, iovNum, iovLen);
+          else {long long tBeg = XrdXrootdStats::pgpNow();
+                rc = Response.Send(pgrResp.rsp, infoLen, ioVec, iovNum, iovLen);
+                SI->pgpTime(XrdXrootdStats::pgpSend,
+                            XrdXrootdStats::pgpNow() - tBeg);
+               }
       } else {
        pgrResp.rsp.bdy.dlen = 0;
        pgrResp.ofs          = htonll(dataOffset);
@@ -501,6 +569,23 @@ int XrdXrootdPgrwAio::SendDone()
    return rc;
 }
 
+/******************************************************************************/
+/*                                U n h o l d                                 */
+/******************************************************************************/
+
+// Return the held buffer that is the next one to be sent, if any.
+  
+XrdXrootdAioPgrw *XrdXrootdPgrwAio::Unhold()
+{
+   XrdXrootdAioPgrw *aioP = heldQ;
+
+   if (!aioP || aioP->sfsAio.aio_offset != sendOffset) return 0;
+   heldQ = (aioP->next ? aioP->next->pgrwP : 0);
+   heldNum--;
+   sendOffset += aioP->Result;
+   return aioP;
+}
+
 /******************************************************************************/
 /*                                V e r C k s                                 */
 /******************************************************************************/
@@ -63,12 +63,17 @@ virtual ~XrdXrootdPgrwAio() {}
        void               CopyF2L() override;
        int                CopyL2F() override;
        bool               CopyL2F(XrdXrootdAioBuff *bP) override;
+       XrdXrootdAioPgrw  *Hold(XrdXrootdAioPgrw *aioP);
        bool               SendData(XrdXrootdAioBuff *bP, bool final=false);
        int                SendDone();
+       XrdXrootdAioPgrw  *Unhold();
        bool               VerCks(XrdXrootdAioPgrw *aioP);
 
 static const char        *TraceID;
 
        XrdXrootdPgwBadCS *badCSP;     // -> Bad checksum recorder
+       XrdXrootdAioPgrw  *heldQ;      // -> Pipelined reads held in offset order
+       long long          sendOffset; // Offset of the next data to be sent
+       int                heldNum;    // Number of reads in heldQ
 };
 #endif
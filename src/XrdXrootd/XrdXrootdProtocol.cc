@@ -124,12 +124,16 @@ int                   XrdXrootdProtocol::as_minsfsz   = 1;
 #else
 int                   XrdXrootdProtocol::as_minsfsz   = 8192;
 #endif
+int                   XrdXrootdProtocol::as_minzcsz   = 0;
+int                   XrdXrootdProtocol::as_muxreq    = 0;
 int                   XrdXrootdProtocol::as_maxstalls = 4;
 short                 XrdXrootdProtocol::as_okstutter = 1; // For 64K unit
 short                 XrdXrootdProtocol::as_timeout   = 45;
 bool                  XrdXrootdProtocol::as_force     = false;
 bool                  XrdXrootdProtocol::as_aioOK     = true;
 bool                  XrdXrootdProtocol::as_nosf      = false;
+bool                  XrdXrootdProtocol::as_pgpipe    = false;
+bool                  XrdXrootdProtocol::as_rvpipe    = false;
 bool                  XrdXrootdProtocol::as_syncw     = false;
 
 const char           *XrdXrootdProtocol::myInst  = 0;
@@ -255,7 +259,7 @@ XrdSfsXioImpl SfsXioImpl(&XrdXrootdProtocol::Buffer,
 XrdXrootdProtocol::XrdXrootdProtocol() 
                     : XrdProtocol("xroot protocol handler"),
                       XrdSfsXio(SfsXioImpl),
-                      ProtLink(this), Entity(0), AppName(0)
+                      ProtLink(this), Entity(0), AppName(0), muxCond(0)
 {
    Reset();
 }
@@ -348,6 +352,7 @@ int dlen, rc;
    SI->Bump(SI->Count);
    xp->Link = lp;
    xp->Response.Set(lp);
+   if (as_minzcsz) lp->setZeroCopy(as_minzcsz);
    strcpy(xp->Entity.prot, "host");
    xp->Entity.host = (char *)lp->Host();
    xp->Entity.addrInfo = lp->AddrInfo();
@@ -473,6 +478,15 @@ int XrdXrootdProtocol::Process2()
                                 return Link->setEtext("request without login");
             }
 
+// Run independent requests concurrently with each other, if so configured.
+// Any other request must wait for them to finish as it may change the state
+// that they depend on (e.g. the file table).
+//
+   if (as_muxreq)
+      {if (MuxOK()) return do_Mux();
+       MuxWait(0);
+      }
+
 // Help the compiler, select the the high activity requests (the ones with
 // file handles) in a separate switch statement. A special case exists for
 // sync() which return with a callback, so handle it here. Note that stat(fh)
@@ -1503,6 +1517,10 @@ void XrdXrootdProtocol::Reset()
    isTLS              = false;  // Made true when link converted to TLS
    linkAioReq         = 0;
    pioFree = pioFirst = pioLast = 0;
+   muxOwner           = 0;
+   muxFile            = 0;
+   muxNum             = 0;
+   muxWait            = false;
    isActive = isLinkWT= isNOP = isDead = false;
    sigNeed = sigHere = sigRead = false;
    sigWarn = true;
@@ -220,6 +220,8 @@ static int           as_maxperreq; // Max async ops per request
 static int           as_maxpersrv; // Max async ops per server
 static int           as_miniosz;   // Min async request size
 static int           as_minsfsz;   // Min sendf request size
+static int           as_minzcsz;   // Min zero-copy send size (0 -> off)
+static int           as_muxreq;    // Max concurrent requests per link
 static int           as_seghalf;
 static int           as_segsize;   // Aio quantum (optimal)
 static int           as_maxstalls; // Maximum stalls we will tolerate
@@ -228,6 +230,8 @@ static short         as_timeout;   // request timeout (usually < stream timeout)
 static bool          as_force;     // aio to be forced
 static bool          as_aioOK;     // aio is enabled
 static bool          as_nosf;      // sendfile is disabled
+static bool          as_pgpipe;    // pgread reads, checksums and sends overlap
+static bool          as_rvpipe;    // readv reads overlap sends
 static bool          as_syncw;     // writes to be synchronous
 
 private:
@@ -256,6 +260,8 @@ enum RD_func {RD_chmod = 0, RD_chksum,  RD_dirlist, RD_locate, RD_mkdir,
        int   do_Locate();
        int   do_Mkdir();
        int   do_Mv();
+       int   do_Mux();
+       int   do_MuxIO();
        int   do_Offload(int (XrdXrootdProtocol::*Invoke)(), int pathID);
        int   do_OffloadIO();
        int   do_Open();
@@ -322,6 +328,9 @@ static int   ConfigSecurity(XrdOucEnv &xEnv, const char *cfn);
        int   getDumpCont();
        bool  logLogin(bool xauth=false);
 static int   mapMode(int mode);
+       bool  MuxOK();
+       void  MuxWait(int maxNum, XrdXrootdFile *fP=0);
+       int   MuxXeq();
        void  Reset();
 static int   rpCheck(char *fn, char **opaque);
        int   rpEmsg(const char *op, char *fn);
@@ -599,6 +608,14 @@ XrdXrootdPio              *pioFirst;
 XrdXrootdPio              *pioLast;
 XrdXrootdPio              *pioFree;
 
+// This area is used to run independent requests on a link concurrently
+//
+XrdSysCondVar              muxCond;      // Caller handles the lock
+XrdXrootdProtocol         *muxOwner;     // -> Link's protocol when running one
+XrdXrootdFile             *muxFile;      // -> File the running request holds
+int                        muxNum;       // Requests now running concurrently
+bool                       muxWait;      // Link's protocol waits for muxNum
+
 short                      PathID;       // Path for this protocol object
 bool                       newPio;       // True when initially scheduled
 unsigned char              rvSeq;
@@ -72,6 +72,24 @@ AuthBad  = 0;     // Stats: Number of authentication failures
 aokSCnt  = 0;     // Stats: Number of signature successes
 badSCnt  = 0;     // Stats: Number of signature failures
 ignSCnt  = 0;     // Stats: Number of signature ignored
+pgpOn    = false; // Stats: Include pipelined pgread timing
+
+for (int i = 0; i < pgpStages; i++)
+    for (int j = 0; j < pgpBins; j++) pgpHist[i][j] = 0;
+}
+
+/******************************************************************************/
+/*                               p g p T i m e                                */
+/******************************************************************************/
+
+void XrdXrootdStats::pgpTime(pgpStage stage, long long usec)
+{
+   int bin = 0;
+
+// Find the power of two bin for this time; the last bin takes all the rest
+//
+   while(usec > 1 && bin < pgpBins-1) {usec >>= 1; bin++;}
+   pgpHist[stage][bin]++;
 }
 
 /******************************************************************************/
@@ -88,7 +106,7 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
    "<sig><ok>%d</ok><bad>%d</bad><ign>%d</ign></sig>"
    "<aio><num>%lld</num><max>%d</max><rej>%lld</rej></aio>"
    "<err>%d</err><rdr>%lld</rdr><dly>%d</dly>"
-   "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn></stats>";
+   "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn>";
 //                                   1 2 3 4 5 6 7 8
    static const long long LLMax = 0x7fffffffffffffffLL;
    static const int       INMax = 0x7fffffff;
@@ -105,7 +123,8 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                       INMax, INMax, INMax,
                       LLMax, INMax, LLMax, INMax, LLMax, INMax,
                       INMax, INMax, INMax, INMax);
-       return len + (fsP ? fsP->getStats(0,0) : 0);
+       if (pgpOn) len += pgpFmt(dummy, sizeof(dummy), true);
+       return len + 8 + (fsP ? fsP->getStats(0,0) : 0);
       }
 
 // Format our statistics
@@ -120,6 +139,12 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                   AsyncNum, AsyncMax, AsyncRej, errorCnt, redirCnt, stallCnt,
                   LoginAT, AuthBad, LoginAU, LoginUA);
    statsMutex.UnLock();
+   if (len >= blen) len = blen-1;
+
+// Add pipelined pgread timing, if wanted, and close off our statistics
+//
+   if (pgpOn) len += pgpFmt(buff+len, blen-len, false);
+   if (blen - len > 8) len += snprintf(buff+len, blen-len, "</stats>");
 
 // Now include filesystem statistics and return
 //
@@ -164,3 +189,27 @@ int XrdXrootdStats::Stats(XrdXrootdResponse &resp, const char *opts)
     xstats->Stats(&statsResp, xopts);
     return statsResp.rc;
 }
+
+/******************************************************************************/
+/* Private:                       p g p F m t                                 */
+/******************************************************************************/
+
+int XrdXrootdStats::pgpFmt(char *buff, int blen, bool dummy)
+{
+   static const long long LLMax = 0x7fffffffffffffffLL;
+   static const char *sName[pgpStages] = {"rd", "cs", "snd"};
+   int len;
+
+// Each stage is reported as a comma separated list of its bin counts
+//
+   len = snprintf(buff, blen, "<pgp>");
+   for (int i = 0; i < pgpStages && len < blen; i++)
+       {len += snprintf(buff+len, blen-len, "<%s>", sName[i]);
+        for (int j = 0; j < pgpBins && len < blen; j++)
+            len += snprintf(buff+len, blen-len, (j ? ",%lld" : "%lld"),
+                            (dummy ? LLMax : (long long)pgpHist[i][j]));
+        if (len < blen) len += snprintf(buff+len, blen-len, "</%s>", sName[i]);
+       }
+   if (len < blen) len += snprintf(buff+len, blen-len, "</pgp>");
+   return (len < blen ? len : blen-1);
+}
@@ -29,7 +29,10 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <ctime>
+
 #include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 #include "XrdOuc/XrdOucStats.hh"
 
 class XrdSfsFileSystem;
@@ -68,6 +71,24 @@ int              aokSCnt;      // Stats: Number of signature successes
 int              badSCnt;      // Stats: Number of signature failures
 int              ignSCnt;      // Stats: Number of signature ignored
 
+// Timing of each stage of a pipelined pgread (see "async pgpipe"). Each stage
+// has a histogram where bin i counts times of [2**i, 2**(i+1)) microseconds
+// and the last bin counts all longer times.
+//
+enum pgpStage   {pgpRead = 0, pgpCsum, pgpSend, pgpStages};
+
+static const int pgpBins = 20;
+
+static long long pgpNow()
+                       {struct timespec ts;
+                        clock_gettime(CLOCK_MONOTONIC, &ts);
+                        return ts.tv_sec*1000000LL + ts.tv_nsec/1000;
+                       }
+
+void             pgpTime(pgpStage stage, long long usec);
+
+bool             pgpOn;        // Stats: Include pipelined pgread timing
+
 void             setFS(XrdSfsFileSystem *fsp) {fsP = fsp;}
 
 int              Stats(char *buff, int blen, int do_sync=0);
@@ -78,7 +99,10 @@ int              Stats(XrdXrootdResponse &resp, const char *opts);
                 ~XrdXrootdStats() {}
 private:
 
+int              pgpFmt(char *buff, int blen, bool dummy);
+
 XrdSfsFileSystem *fsP;
 XrdStats *xstats;
+RAtomic_llong    pgpHist[pgpStages][pgpBins];
 };
 #endif
@@ -51,6 +51,7 @@
 #include "XrdSys/XrdSysE2T.hh"
 #include "Xrd/XrdBuffer.hh"
 #include "Xrd/XrdInet.hh"
+#include "Xrd/XrdJob.hh"
 #include "Xrd/XrdLinkCtl.hh"
 #include "XrdXrootd/XrdXrootdAioFob.hh"
 #include "XrdXrootd/XrdXrootdCallBack.hh"
@@ -99,6 +100,94 @@ struct XrdXrootdSessID
        ~XrdXrootdSessID() {}
        };
 
+// A readv request is sent as one or more responses. Each response holds one
+// or more runs of elements that refer to the same file and each run is read
+// with a single readv() call.
+//
+struct XrdXrootdRVRun
+       {XrdXrootdFile     *fP;
+        int                fH;     // File handle as supplied by the client
+        int                vBeg;   // First element in the run
+        int                vNum;   // Number of elements in the run
+        int                vAmt;   // Number of bytes the elements hold
+       };
+
+struct XrdXrootdRVRsp
+       {int                rBeg;   // First run in the response
+        int                rEnd;   // Last  run in the response plus one
+        int                rLen;   // Length of the response
+       };
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+// The XrdXrootdRVRead object reads the runs for a readv response. The read is
+// done either in the calling thread or as a scheduled job so that the next
+// response may be read while the current one is being sent.
+//
+class XrdXrootdRVRead : public XrdJob
+{
+public:
+
+void            DoIt() {Read(rBeg, rEnd); rvDone.Post();}
+
+// Read() returns the run that failed or -1 if all of them were read
+//
+int             Read(int runBeg, int runEnd)
+                    {for (int i = runBeg; i < runEnd; i++)
+                         {rvResult = rvRun[i].fP->XrdSfsp->readv(
+                                             &rdVec[rvRun[i].vBeg],
+                                              rvRun[i].vNum);
+                          if (rvResult != rvRun[i].vAmt) return (rvFail = i);
+                         }
+                     return (rvFail = -1);
+                    }
+
+XrdSfsXferSize  Result() {return rvResult;}
+
+void            Start(XrdScheduler *sP, int runBeg, int runEnd)
+                     {rBeg = runBeg; rEnd = runEnd; sP->Schedule(this);}
+
+int             Wait() {rvDone.Wait(); return rvFail;}
+
+                XrdXrootdRVRead(XrdXrootdRVRun *runP, XrdOucIOVec *vecP)
+                               : XrdJob("readv"), rvRun(runP), rdVec(vecP),
+                                 rvDone(0), rvResult(0), rvFail(-1),
+                                 rBeg(0), rEnd(0) {}
+               ~XrdXrootdRVRead() {}
+
+private:
+
+XrdXrootdRVRun *rvRun;
+XrdOucIOVec    *rdVec;
+XrdSysSemaphore rvDone;
+XrdSfsXferSize  rvResult;
+int             rvFail;
+int             rBeg;
+int             rEnd;
+};
+
+// The XrdXrootdRVVec object holds the decoded readv vector and how it is split
+// into runs and responses. It is sized to the request and kept off the stack.
+//
+class XrdXrootdRVVec
+{
+public:
+
+XrdOucIOVec    *rdVec;
+XrdXrootdRVRun *rvRun;
+XrdXrootdRVRsp *rvRsp;
+
+                XrdXrootdRVVec(int vNum) : rdVec(new XrdOucIOVec[vNum]),
+                                           rvRun(new XrdXrootdRVRun[vNum]),
+                                           rvRsp(new XrdXrootdRVRsp[vNum]) {}
+               ~XrdXrootdRVVec() {delete [] rdVec;
+                                  delete [] rvRun;
+                                  delete [] rvRsp;
+                                 }
+};
+
 /******************************************************************************/
 /*                         L o c a l   D e f i n e s                          */
 /******************************************************************************/
@@ -136,6 +225,26 @@ struct tm *tmp;
     return buff;
 }
 
+// Lay out the element headers of a readv response in its buffer and point
+// each element at the place its data is to be read into.
+//
+void rvLayout(XrdXrootdRVRun *rvRun, XrdXrootdRVRsp &rvRsp,
+              XrdOucIOVec *rdVec, char *buffp)
+{
+   struct readahead_list respHdr;
+
+   for (int r = rvRsp.rBeg; r < rvRsp.rEnd; r++)
+       {memcpy(respHdr.fhandle, &rvRun[r].fH, sizeof(respHdr.fhandle));
+        for (int i = rvRun[r].vBeg; i < rvRun[r].vBeg+rvRun[r].vNum; i++)
+            {respHdr.rlen   = htonl(rdVec[i].size);
+             respHdr.offset = htonll(rdVec[i].offset);
+             memcpy(buffp, &respHdr, sizeof(respHdr));
+             rdVec[i].data  = buffp + sizeof(respHdr);
+             buffp += sizeof(respHdr) + rdVec[i].size;
+            }
+       }
+}
+
 // comment out genUEID as it is not used
 //
 
@@ -2381,7 +2490,8 @@ int XrdXrootdProtocol::do_Read()
 // will use and if possible, do a fast dispatch.
 //
         if (IO.File->isMMapped) IO.Mode = XrdXrootd::IOParms::useMMap;
-   else if (IO.File->sfEnabled && !isTLS && IO.IOLen >= as_minsfsz
+   else if (IO.File->sfEnabled && (!isTLS || Link->hasKTLS())
+        &&  IO.IOLen >= as_minsfsz
         &&  IO.Offset+IO.IOLen <= IO.File->Stats.fSize)
            IO.Mode = XrdXrootd::IOParms::useSF;
    else if (IO.File->AsyncMode && IO.IOLen >= as_miniosz
@@ -2538,15 +2648,16 @@ int XrdXrootdProtocol::do_ReadV()
 // The readv file system code originally added by Brian Bockelman, UNL.
 //
    const int hdrSZ = sizeof(readahead_list);
-   struct XrdOucIOVec     rdVec[XrdProto::maxRvecsz+1];
-   struct readahead_list *raVec, respHdr;
+   struct readahead_list *raVec;
+   XrdBuffer             *xbP = 0;
    long long totSZ;
-   XrdSfsXferSize rdVAmt, rdVXfr, xfrSZ = 0;
-   int rdVBeg, rdVBreak, rdVNow, rdVNum, rdVecNum;
+   XrdSfsXferSize rdVXfr = 0;
+   int rdVBeg = 0, rdVNum = 0, rdVecNum, runNum, rspNum, rvFail = -1;
    int currFH, i, k, Quantum, Qleft, rdVecLen = Request.header.dlen;
    int rvMon = Monitor.InOut();
    int ioMon = (rvMon > 1);
-   char *buffp, vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+   char *rvBuff[2], vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+   bool rvPipe;
 
 // Compute number of elements in the read vector and make sure we have no
 // partial elements.
@@ -2566,6 +2677,14 @@ int XrdXrootdProtocol::do_ReadV()
 //
    numReadV++; numSegsV += rdVecNum;
 
+// Allocate the vector along with room for the runs and responses it may need
+//
+   XrdXrootdRVVec  rvVec(rdVecNum);
+   XrdOucIOVec    *rdVec = rvVec.rdVec;
+   XrdXrootdRVRun *rvRun = rvVec.rvRun;
+   XrdXrootdRVRsp *rvRsp = rvVec.rvRsp;
+   XrdXrootdRVRead rvRead(rvRun, rdVec);
+
 // Run down the list and compute the total size of the read. No individual
 // read may be greater than the maximum transfer size. We also use this loop
 // to copy the read ahead list to our readv vector for later processing.
@@ -2582,14 +2701,6 @@ int XrdXrootdProtocol::do_ReadV()
         memcpy(&rdVec[i].info, raVec[i].fhandle, sizeof(int));
        }
 
-// Now add an extra dummy element to force flushing of the read vector.
-//
-   rdVec[i].offset = -1;
-   rdVec[i].size   =  0;
-   rdVec[i].info   = -1;
-   rdVBreak = rdVecNum;
-   rdVecNum++;
-
 // We limit the total size of the read to be 2GB for convenience
 //
    if (totSZ > 0x7fffffffLL)
@@ -2612,77 +2723,109 @@ int XrdXrootdProtocol::do_ReadV()
    if (!FTab) return Response.Send(kXR_FileNotOpen,
                               "readv does not refer to an open file");
 
-// Preset the previous and current file handle to be the handle of the first
-// element and make sure the file is actually open.
-//
-   currFH = rdVec[0].info;
-   memcpy(respHdr.fhandle, &currFH, sizeof(respHdr.fhandle));
-   if (!(IO.File = FTab->Get(currFH))) return Response.Send(kXR_FileNotOpen,
-                                      "readv does not refer to an open file");
-
-// Setup variables for running through the list.
-//
-   Qleft = Quantum; buffp = argp->buff; rvSeq++;
-   rdVBeg = rdVNow = 0; rdVXfr = rdVAmt = 0;
-
-// Now run through the elements
+// Split the vector into responses, each no larger than the transfer unit, and
+// each response into runs of elements for the same file. Each run is read with
+// a single readv() call. We also make sure every file is open before we start.
 //
+   currFH = rdVec[0].info; Qleft = 0; runNum = rspNum = 0;
    for (i = 0; i < rdVecNum; i++)
-       {if (rdVec[i].info != currFH)
-           {xfrSZ = IO.File->XrdSfsp->readv(&rdVec[rdVNow], i-rdVNow);
-            if (xfrSZ != rdVAmt) break;
-            rdVNum = i - rdVBeg; rdVXfr += rdVAmt;
-            IO.File->Stats.rvOps(rdVXfr, rdVNum);
-            if (rvMon)
-               {Monitor.Agent->Add_rv(IO.File->Stats.FileID, htonl(rdVXfr),
-                                              htons(rdVNum), rvSeq, vType);
-                if (ioMon) for (k = rdVBeg; k < i; k++)
-                    Monitor.Agent->Add_rd(IO.File->Stats.FileID,
-                            htonl(rdVec[k].size), htonll(rdVec[k].offset));
-               }
-            rdVXfr = rdVAmt = 0;
-            if (i == rdVBreak) break;
-            rdVBeg = rdVNow = i; currFH = rdVec[i].info;
-            memcpy(respHdr.fhandle, &currFH, sizeof(respHdr.fhandle));
+       {bool newRsp = Qleft < (rdVec[i].size + hdrSZ);
+        if (newRsp || rdVec[i].info != currFH || !runNum)
+           {currFH = rdVec[i].info;
             if (!(IO.File = FTab->Get(currFH)))
                return Response.Send(kXR_FileNotOpen,
                                     "readv does not refer to an open file");
-            }
-
-        if (Qleft < (rdVec[i].size + hdrSZ))
-           {if (rdVAmt)
-               {xfrSZ = IO.File->XrdSfsp->readv(&rdVec[rdVNow], i-rdVNow);
-                if (xfrSZ != rdVAmt) break;
+            if (newRsp)
+               {if (rspNum) rvRsp[rspNum-1].rEnd = runNum;
+                rvRsp[rspNum].rBeg = runNum; rvRsp[rspNum++].rLen = 0;
+                Qleft = Quantum;
                }
-            if (Response.Send(kXR_oksofar,argp->buff,Quantum-Qleft) < 0)
-               return -1;
-            Qleft = Quantum;
-            buffp = argp->buff;
-            rdVNow = i; rdVXfr += rdVAmt; rdVAmt = 0;
+            rvRun[runNum].fP   = IO.File; rvRun[runNum].fH   = currFH;
+            rvRun[runNum].vBeg = i;       rvRun[runNum].vNum = 0;
+            rvRun[runNum++].vAmt = 0;
+           }
+        rvRun[runNum-1].vNum++; rvRun[runNum-1].vAmt += rdVec[i].size;
+        rvRsp[rspNum-1].rLen += (rdVec[i].size + hdrSZ);
+        Qleft -= (rdVec[i].size + hdrSZ);
+        TRACEP(FSIO,"fh=" <<currFH<<" readV "<< rdVec[i].size <<'@'
+                    <<rdVec[i].offset);
+       }
+   rvRsp[rspNum-1].rEnd = runNum;
+
+// When more than one response is needed and "async rvpipe" is in effect, the
+// next response is read into a second buffer, using a scheduler thread, while
+// the current one is being sent so that the disk and the network are busy at
+// the same time. Otherwise, each response is read and then sent in turn.
+//
+   rvBuff[0] = rvBuff[1] = argp->buff;
+   if ((rvPipe = (as_rvpipe && rspNum > 1 && (xbP = BPool->Obtain(Quantum)))))
+      rvBuff[1] = xbP->buff;
+   rvSeq++; k = 0;
+
+// Now run through the responses
+//
+   for (int r = 0; r < rspNum; r++)
+       {if (r && rvPipe) rvFail = rvRead.Wait();
+           else {rvLayout(rvRun, rvRsp[r], rdVec, rvBuff[k]);
+                 rvFail = rvRead.Read(rvRsp[r].rBeg, rvRsp[r].rEnd);
+                }
+        if (rvFail >= 0) break;
+
+        // Start reading the next response into the other buffer
+        //
+        if (rvPipe && r+1 < rspNum)
+           {rvLayout(rvRun, rvRsp[r+1], rdVec, rvBuff[k^1]);
+            rvRead.Start(Sched, rvRsp[r+1].rBeg, rvRsp[r+1].rEnd);
            }
 
-        xfrSZ = rdVec[i].size; rdVAmt += xfrSZ;
-        respHdr.rlen   = htonl(xfrSZ);
-        respHdr.offset = htonll(rdVec[i].offset);
-        memcpy(buffp, &respHdr, hdrSZ);
-        rdVec[i].data = buffp + hdrSZ;
-        buffp += (xfrSZ+hdrSZ); Qleft -= (xfrSZ+hdrSZ);
-        TRACEP(FSIO,"fh=" <<currFH<<" readV "<< xfrSZ <<'@'<<rdVec[i].offset);
+        // Account for every file whose elements have all been read
+        //
+        for (i = rvRsp[r].rBeg; i < rvRsp[r].rEnd; i++)
+            {rdVXfr += rvRun[i].vAmt; rdVNum += rvRun[i].vNum;
+             if (i+1 < runNum && rvRun[i+1].fH == rvRun[i].fH) continue;
+             IO.File = rvRun[i].fP;
+             IO.File->Stats.rvOps(rdVXfr, rdVNum);
+             if (rvMon)
+                {Monitor.Agent->Add_rv(IO.File->Stats.FileID, htonl(rdVXfr),
+                                               htons(rdVNum), rvSeq, vType);
+                 if (ioMon) for (int j = rdVBeg; j < rdVBeg+rdVNum; j++)
+                     Monitor.Agent->Add_rd(IO.File->Stats.FileID,
+                             htonl(rdVec[j].size), htonll(rdVec[j].offset));
+                }
+             rdVBeg += rdVNum; rdVXfr = rdVNum = 0;
+            }
+
+        // Send the response; the last one ends the request
+        //
+        if ((r+1 < rspNum
+           ? Response.Send(kXR_oksofar, rvBuff[k], rvRsp[r].rLen)
+           : Response.Send(rvBuff[k], rvRsp[r].rLen)) < 0)
+           {if (rvPipe && r+1 < rspNum) rvRead.Wait();
+            if (xbP) BPool->Release(xbP);
+            return -1;
+           }
+        if (rvPipe) k ^= 1;
        }
 
-// Check if we have an error here. This is indicated when rdVAmt is not zero.
+// Release the second buffer, nothing can be reading into it at this point
 //
-   if (rdVAmt)
-      {if (xfrSZ >= 0)
+   if (xbP) BPool->Release(xbP);
+
+// Check if we have an error here. This is indicated when a run failed.
+//
+   if (rvFail >= 0)
+      {XrdSfsXferSize xfrSZ = rvRead.Result();
+       IO.File = rvRun[rvFail].fP;
+       if (xfrSZ >= 0)
           {xfrSZ = SFS_ERROR;
            IO.File->XrdSfsp->error.setErrInfo(-ENODATA,"readv past EOF");
           }
        return fsError(xfrSZ, 0, IO.File->XrdSfsp->error, 0, 0);
       }
 
-// All done, return result of the last segment or just zero
+// All done
 //
-   return (Quantum != Qleft ? Response.Send(argp->buff, Quantum-Qleft) : 0);
+   return 0;
 }
 
 /******************************************************************************/
@@ -0,0 +1,246 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d X r o o t d X e q M u x . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstring>
+#include <netinet/in.h>
+
+#include "XProtocol/XProtocol.hh"
+#include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdLink.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdXrootd/XrdXrootdFile.hh"
+#include "XrdXrootd/XrdXrootdProtocol.hh"
+#include "XrdXrootd/XrdXrootdStats.hh"
+#include "XrdXrootd/XrdXrootdTrace.hh"
+#include "XrdXrootd/XrdXrootdXeq.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+extern XrdSysTrace  XrdXrootdTrace;
+
+#undef  TRACELINK
+#define TRACELINK Link
+
+/******************************************************************************/
+/*                                d o _ M u x                                 */
+/******************************************************************************/
+
+// Requests are run concurrently by handing each one to a protocol object that
+// shares this link's session (i.e. its client, file table, and monitoring)
+// and which is then scheduled to run the request. Responses are sent on the
+// link as each request completes; the client matches them by stream id.
+// Requests that refer to an open file are run one at a time for each file as
+// they share its statistics and its error object.
+  
+int XrdXrootdProtocol::do_Mux()
+{
+   XrdXrootdProtocol *pp;
+   XrdXrootdFile *fP = 0;
+   int dlen = Request.header.dlen;
+
+// Find the file, if any, the request refers to. Should there be none, the
+// request will simply fail and there is nothing to hold.
+//
+   if (FTab && (Request.header.requestid == kXR_read || !dlen))
+      {XrdXrootdFHandle fh(Request.header.requestid == kXR_read
+                           ? Request.read.fhandle : Request.stat.fhandle);
+       fP = FTab->Get(fh.handle);
+      }
+
+// Do not run more than the allowed number of requests at the same time nor
+// more than one at a time for the same file.
+//
+   MuxWait(as_muxreq-1, fP);
+
+// Get a protocol object to run the request on behalf of this one
+//
+   if (!(pp = ProtStack.Pop())) pp = new XrdXrootdProtocol();
+
+// Copy the argument, if any. Should we not be able to get a buffer for it,
+// simply run the request here as it is safe to do so.
+//
+   if (dlen)
+      {if (!(pp->argp = BPool->Obtain(dlen+1)))
+          {ProtStack.Push(&pp->ProtLink);
+           return MuxXeq();
+          }
+       memcpy(pp->argp->buff, argp->buff, dlen+1);
+       pp->halfBSize = pp->argp->bsize >> 1;
+      }
+
+// Share whatever the request needs to run in the context of this session
+//
+   pp->Link          = Link;
+   pp->Client        = Client;
+   pp->FTab          = FTab;
+   pp->Monitor.Agent = Monitor.Agent;
+   pp->Monitor.Did   = Monitor.Did;
+   pp->Monitor.Iops  = Monitor.Iops;
+   pp->Monitor.Fops  = Monitor.Fops;
+   pp->clientPV      = clientPV;
+   pp->CapVer        = CapVer;
+   pp->Status        = Status;
+   pp->rdType        = rdType;
+   pp->isTLS         = isTLS;
+   pp->Request       = Request;
+   pp->ReqID         = ReqID;
+   pp->ReqID.setID(Request.header.streamid);
+   pp->Response.Set(Link);
+   pp->Response.Set(Request.header.streamid);
+   pp->muxOwner      = this;
+   pp->muxFile       = fP;
+   pp->Resume        = &XrdXrootdProtocol::do_MuxIO;
+
+// Account for the request and hold the link until the request has been run
+//
+   muxCond.Lock();
+   muxNum++;
+   if (fP) fP->muxBusy = true;
+   muxCond.UnLock();
+   Link->setRef(1);
+   TRACEP(REQ, "req=" <<XProtocol::reqName(Request.header.requestid)
+               <<" run concurrently; active=" <<muxNum);
+
+// Schedule the request and return so that the next one can be read
+//
+   Sched->Schedule((XrdJob *)pp);
+   return 0;
+}
+
+/******************************************************************************/
+/*                              d o _ M u x I O                               */
+/******************************************************************************/
+  
+int XrdXrootdProtocol::do_MuxIO()
+{
+   XrdXrootdProtocol *pp = muxOwner;
+   XrdXrootdFile *fP = muxFile;
+   XrdLink *lp = Link;
+
+// Run the request. A fatal error means the session must end. As the link is
+// being read by the session's protocol object, we simply shut it down and let
+// the protocol object discover that on its next read.
+//
+   if (MuxXeq() < 0) lp->Shutdown(true);
+
+// Fold in our statistics and release what is ours. What we shared with the
+// session must be left alone, which Reset() does as it simply zeroes it all.
+//
+   SI->statsMutex.Lock();
+   SI->readCnt += numReads;
+   SI->statsMutex.UnLock();
+   if (argp) {BPool->Release(argp); argp = 0;}
+   Monitor.Agent = 0;
+   Monitor.Clear();
+   Reset();
+
+// Tell the session we are done and drop our hold on the link. We are then
+// free to be reused.
+//
+   pp->muxCond.Lock();
+   pp->muxNum--;
+   if (fP) fP->muxBusy = false;
+   if (pp->muxWait) {pp->muxWait = false; pp->muxCond.Signal();}
+   pp->muxCond.UnLock();
+   lp->setRef(-1);
+   ProtStack.Push(&ProtLink);
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 M u x O K                                  */
+/******************************************************************************/
+
+// Only requests that neither change the session nor depend on the order in
+// which they are run are allowed to run concurrently. These are stat, statx,
+// and locate as well as reads too small for async I/O. Reads with pre-reads
+// or for another path and reads that are being monitored (as the monitor
+// buffer is not locked) are excluded.
+  
+bool XrdXrootdProtocol::MuxOK()
+{
+// The client must be fully logged in on a session of its own
+//
+   if (!(Status & XRD_LOGGEDIN) || (Status & (XRD_NEED_AUTH | XRD_BOUNDPATH))
+   ||  !Response.isOurs()) return false;
+
+// Screen the request
+//
+   switch(Request.header.requestid)
+         {case kXR_read:   if (Request.header.dlen
+                           && (Request.header.dlen != sizeof(read_args)
+                               || ((read_args *)argp->buff)->pathid))
+                              return false;
+                           return !Monitor.InOut()
+                               && (int)ntohl(Request.read.rlen) < as_miniosz;
+          case kXR_stat:   return !Request.header.dlen || !CL_Redir;
+          case kXR_locate:
+          case kXR_statx:  return Request.header.dlen && !CL_Redir;
+          default:         break;
+         }
+   return false;
+}
+
+/******************************************************************************/
+/*                               M u x W a i t                                */
+/******************************************************************************/
+
+void XrdXrootdProtocol::MuxWait(int maxNum, XrdXrootdFile *fP)
+{
+
+// Wait until no more than maxNum requests are running concurrently and none
+// of them is using the indicated file. A file is only marked as used by this
+// thread, so it stays free once we see that it is.
+//
+   muxCond.Lock();
+   while(muxNum > maxNum || (fP && fP->muxBusy))
+        {muxWait = true;
+         muxCond.Wait();
+        }
+   muxCond.UnLock();
+}
+
+/******************************************************************************/
+/*                                M u x X e q                                 */
+/******************************************************************************/
+  
+int XrdXrootdProtocol::MuxXeq()
+{
+   switch(Request.header.requestid)
+         {case kXR_locate:  SI->Bump(SI->miscCnt);
+                            return do_Locate();
+          case kXR_read:    return do_Read();
+          case kXR_stat:    return do_Stat();
+          case kXR_statx:   SI->Bump(SI->miscCnt);
+                            return do_Statx();
+          default:          break;
+         }
+   return Response.Send(kXR_InvalidRequest, "Invalid request code");
+}
@@ -160,9 +160,10 @@ int XrdXrootdProtocol::do_PgRead()
    IO.File->Stats.pgrOps(IO.IOLen, (IO.Flags & XrdProto::kXR_pgRetry) != 0);
 
 // Use synchronous reads unless async I/O is allowed, the read size is
-// sufficient, and there are not too many async operations in flight.
+// sufficient, and there are not too many async operations in flight. Pipelined
+// reads are always allowed as they do not rely on the filesystem's async I/O.
 //
-   if (IO.File->AsyncMode && IO.IOLen >= pgAioMin
+   if ((IO.File->AsyncMode || as_pgpipe) && IO.IOLen >= pgAioMin
    &&  IO.Offset+IO.IOLen <= IO.File->Stats.fSize+pgAioHalf
    &&  linkAioReq < as_maxperlnk && srvrAioOps < as_maxpersrv
    &&  !(IO.Flags & XrdProto::kXR_pgRetry))
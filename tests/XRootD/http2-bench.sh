@@ -0,0 +1,60 @@
+#!/usr/bin/env bash
+
+# Compare many parallel range GETs over HTTP/1.1 and HTTP/2 on one server.
+#
+# The server must load XrdHttp with "http.http2 on" ("http.http2 on alpn"
+# for https URLs) and export a file of at least RSIZE bytes as ${FILE}.
+# HTTP/1.1 runs NREQ requests over as many connections with curl; HTTP/2
+# runs them as streams of a single connection with nghttp (curl before 8.0
+# does not reliably multiplex).
+
+: ${CURL:=$(command -v curl)}
+: ${NGHTTP:=$(command -v nghttp)}
+: ${URL:=http://localhost:${PORT:-8443}}
+: ${FILE:=/bench.dat}
+: ${NREQ:=200}
+: ${RSIZE:=65536}
+: ${ROUNDS:=5}
+
+for PROG in ${CURL} ${NGHTTP}; do
+	if [[ ! -x "${PROG}" ]]; then
+		echo 1>&2 "$(basename $0): error: '${PROG}': command not found"
+		exit 1
+	fi
+done
+
+case ${URL} in
+	https:*) CURLOPT=-k ;;
+	*)       CURLOPT=   ;;
+esac
+
+RANGE="0-$((RSIZE - 1))"
+
+now() { date +%s%N; }
+
+h1() {
+	${CURL} -s ${CURLOPT} --http1.1 -Z --parallel-max ${NREQ} -r ${RANGE} \
+		-o /dev/null -w "%{http_code}\n" "${URL}${FILE}?n=[1-${NREQ}]" \
+		2>/dev/null | grep -vc '^206$'
+}
+
+h2() {
+	${NGHTTP} -n -H "range: bytes=${RANGE}" -m ${NREQ} \
+		"${URL}${FILE}" 2>/dev/null || echo 1
+}
+
+for PROTO in h1 h2; do
+	BEST=
+	for i in $(seq ${ROUNDS}); do
+		T0=$(now)
+		BAD=$(${PROTO})
+		T1=$(now)
+		if [[ "${BAD}" != "" && "${BAD}" != "0" ]]; then
+			echo 1>&2 "$(basename $0): error: ${PROTO} requests failed"
+			exit 1
+		fi
+		MS=$(( (T1 - T0) / 1000000 ))
+		[[ -z "${BEST}" || ${MS} -lt ${BEST} ]] && BEST=${MS}
+	done
+	echo "${PROTO}: ${NREQ} x ${RSIZE} byte range GETs, best of ${ROUNDS}: ${BEST} ms"
+done
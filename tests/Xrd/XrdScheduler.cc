@@ -0,0 +1,120 @@
+#undef NDEBUG
+
+#include <Xrd/XrdJob.hh>
+#include <Xrd/XrdScheduler.hh>
+#include <XrdSys/XrdSysPthread.hh>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+// Compare the single job queue of the scheduler with work-stealing lanes.
+// Jobs are either scheduled by outside threads, as the poller does, or by
+// the jobs themselves, as a link does when it has more work to do. The
+// comparison is disabled and is run with --gtest_also_run_disabled_tests;
+// LanesRunAll makes sure the lanes run every job they are given.
+
+namespace
+{
+class BenchJob : public XrdJob
+{
+public:
+
+void DoIt() override
+     {if (--left > 0 && chain) {sched->Schedule(this); return;}
+      if (++(*done) == target) doneSem->Post();
+     }
+
+     BenchJob() : XrdJob("bench job"), sched(0), done(0), doneSem(0),
+                  target(0), left(0), chain(false) {}
+
+XrdScheduler      *sched;
+std::atomic<int>  *done;
+XrdSysSemaphore   *doneSem;
+int                target;
+int                left;
+bool               chain;
+};
+
+// Run one round and return the number of jobs run per second
+//
+double Round(XrdScheduler *sched, std::vector<BenchJob> &jobs, int nSubmit,
+             int nChain)
+{
+  XrdSysSemaphore doneSem(0);
+  std::atomic<int> done(0);
+  const int nJobs = (int)jobs.size();
+  const int total = (nChain > 1 ? nJobs*nChain : nJobs);
+
+  for (auto &job : jobs)
+      {job.sched = sched; job.done = &done; job.doneSem = &doneSem;
+       job.target = nJobs; job.left = nChain; job.chain = nChain > 1;
+      }
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> submitters;
+  for (int i = 0; i < nSubmit; i++)
+      submitters.emplace_back([&, i]
+          {for (int j = i; j < nJobs; j += nSubmit) sched->Schedule(&jobs[j]);});
+  for (auto &t : submitters) t.join();
+  doneSem.Wait();
+  auto t1 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(done.load(), nJobs);
+  return total / std::chrono::duration<double>(t1 - t0).count();
+}
+}
+
+TEST(XrdScheduler, LanesRunAll)
+{
+  // Fewer workers than lanes so that idle workers have to steal and woken
+  // workers often find their job already taken
+  //
+  XrdScheduler *sched = new XrdScheduler(2, 4, 0);
+  std::vector<BenchJob> jobs(2000), links(16);
+
+  sched->setLanes(4);
+  sched->Start();
+  for (int r = 0; r < 3; r++)
+      {Round(sched, jobs, 4, 1);
+       Round(sched, links, 1, 100);
+      }
+
+  // The scheduler has no way to stop its threads; it is left running.
+}
+
+TEST(XrdScheduler, DISABLED_Bench)
+{
+  const int nLanes[]  = {0, 4};
+  const int nRounds   = 5;
+
+  for (int lanes : nLanes)
+      {XrdScheduler *sched = new XrdScheduler(16, 256, 0);
+       std::vector<BenchJob> jobs(20000);
+       double fanIn = 0, chains = 0;
+
+       sched->setLanes(lanes);
+       sched->Start();
+
+       // Keep the best of a few rounds of each kind
+       //
+       for (int r = 0; r < nRounds; r++)
+           fanIn = std::max(fanIn, Round(sched, jobs, 4, 1));
+
+       std::vector<BenchJob> links(64);
+       for (int r = 0; r < nRounds; r++)
+           chains = std::max(chains, Round(sched, links, 1, 1000));
+
+       printf("%-12s: %10.0f jobs/s from 4 threads, "
+              "%10.0f jobs/s rescheduled by 64 jobs\n",
+              (lanes ? "4 lanes" : "single queue"), fanIn, chains);
+
+       // The scheduler has no way to stop its threads; it is left running.
+      }
+}
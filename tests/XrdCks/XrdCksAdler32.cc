@@ -0,0 +1,153 @@
+#undef NDEBUG
+
+#include <XrdCks/XrdCksCalcadler32.hh>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace testing;
+
+// Cross-check the adler32 calculator, which uses the AVX2 kernel on hosts
+// that have it, against a plain byte at a time implementation. The lengths
+// straddle the 32 byte vector width and the NMAX block limit of the sums.
+
+namespace
+{
+const unsigned int adlerBase = 65521;
+const int          adlerNMax = 5552;
+
+unsigned int Reference(const unsigned char *buff, size_t len)
+{
+  unsigned int s1 = 1, s2 = 0;
+
+  for (size_t i = 0; i < len; i++)
+      {s1 = (s1 + buff[i]) % adlerBase;
+       s2 = (s2 + s1) % adlerBase;
+      }
+  return (s2 << 16) | s1;
+}
+
+unsigned int Adler(XrdCksCalcadler32 &calc)
+{
+  unsigned int val;
+
+  memcpy(&val, calc.Final(), sizeof(val));
+  return ntohl(val);
+}
+
+unsigned int Adler(const unsigned char *buff, size_t len)
+{
+  XrdCksCalcadler32 calc;
+
+  calc.Update((const char *)buff, (int)len);
+  return Adler(calc);
+}
+
+std::vector<unsigned char> RandomData(size_t len, unsigned int seed)
+{
+  std::vector<unsigned char> data(len);
+  srand(seed);
+  for (auto &c : data) c = (unsigned char)(rand() & 0xff);
+  return data;
+}
+
+// Lengths around the vector width, the NMAX block and a few multiples of it
+//
+std::vector<size_t> Lengths()
+{
+  std::vector<size_t> lens;
+  const size_t blk[] = {0, (size_t)adlerNMax, (size_t)adlerNMax/32*32,
+                        2*(size_t)adlerNMax, 3*(size_t)adlerNMax};
+
+  for (size_t b : blk)
+      for (int d = -33; d <= 33; d++)
+          if ((long)b + d >= 0) lens.push_back(b + d);
+  lens.push_back(64*1024);
+  lens.push_back(1024*1024 + 7);
+  return lens;
+}
+}
+
+TEST(XrdCksAdler32, KnownValue)
+{
+  // The value given for this string in the adler32 literature
+  const char *wiki = "Wikipedia";
+  EXPECT_EQ(Adler((const unsigned char *)wiki, strlen(wiki)), 0x11e60398u);
+  EXPECT_EQ(Adler((const unsigned char *)"", 0), 1u);
+}
+
+TEST(XrdCksAdler32, Lengths)
+{
+  auto data = RandomData(3*adlerNMax + 64, 11);
+  auto big  = RandomData(1024*1024 + 7, 12);
+
+  for (size_t len : Lengths())
+      {const auto &src = (len <= data.size() ? data : big);
+       EXPECT_EQ(Adler(src.data(), len), Reference(src.data(), len))
+                 << "len=" << len;
+      }
+}
+
+TEST(XrdCksAdler32, AllOnes)
+{
+  // Bytes of 0xff give the largest sums so they would show any overflow
+  // before the sums are reduced.
+  std::vector<unsigned char> data(4*adlerNMax + 100, 0xff);
+
+  for (size_t len : Lengths())
+      {if (len > data.size()) continue;
+       EXPECT_EQ(Adler(data.data(), len), Reference(data.data(), len))
+                 << "len=" << len;
+      }
+}
+
+TEST(XrdCksAdler32, Unaligned)
+{
+  auto data = RandomData(2*adlerNMax + 128, 13);
+  const size_t lens[] = {31, 32, 33, 100, (size_t)adlerNMax - 1,
+                         (size_t)adlerNMax, (size_t)adlerNMax + 1,
+                         2*(size_t)adlerNMax + 3};
+
+  for (size_t off = 0; off < 64; off++)
+      for (size_t len : lens)
+          EXPECT_EQ(Adler(data.data() + off, len),
+                    Reference(data.data() + off, len))
+                    << "off=" << off << " len=" << len;
+}
+
+TEST(XrdCksAdler32, SplitUpdates)
+{
+  auto data = RandomData(200*1024 + 3, 14);
+  unsigned int ref = Reference(data.data(), data.size());
+  const size_t pieces[] = {1, 7, 31, 32, 33, 1000, (size_t)adlerNMax - 1,
+                           (size_t)adlerNMax, (size_t)adlerNMax + 1, 65536};
+
+  // Fixed size pieces
+  //
+  for (size_t piece : pieces)
+      {XrdCksCalcadler32 calc;
+       for (size_t pos = 0; pos < data.size(); pos += piece)
+           calc.Update((const char *)data.data() + pos,
+                       (int)std::min(piece, data.size() - pos));
+       EXPECT_EQ(Adler(calc), ref) << "piece=" << piece;
+      }
+
+  // Random sized pieces, which also leave the later ones unaligned
+  //
+  srand(15);
+  for (int i = 0; i < 20; i++)
+      {XrdCksCalcadler32 calc;
+       size_t pos = 0, piece;
+       while(pos < data.size())
+            {piece = std::min((size_t)(rand() % (3*adlerNMax)),
+                              data.size() - pos);
+             calc.Update((const char *)data.data() + pos, (int)piece);
+             pos += piece;
+            }
+       EXPECT_EQ(Adler(calc), ref) << "round=" << i;
+      }
+}
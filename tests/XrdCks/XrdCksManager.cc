@@ -0,0 +1,98 @@
+#undef NDEBUG
+
+#include <XrdVersion.hh>
+#include <XrdCks/XrdCksData.hh>
+#include <XrdCks/XrdCksManager.hh>
+#include <XrdSys/XrdSysError.hh>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace testing;
+
+// Check that the checksums MultiCalc() computes in a single pass over a file
+// are the ones Calc() computes one at a time.
+
+namespace
+{
+XrdSysError eDest(0, "cks_");
+
+XrdVERSIONINFODEF(myVer, XrdCksTest, XrdVNUMBER, XrdVERSION);
+
+class CksManager : public Test
+{
+protected:
+
+void SetUp() override
+     {char path[] = "/tmp/XrdCksManager.XXXXXX";
+      int fd = mkstemp(path);
+      ASSERT_GE(fd, 0);
+      fPath = path;
+
+      // Enough data for several reads of the default I/O size and a tail
+      //
+      std::vector<char> data(3*1024*1024 + 4097);
+      srand(31);
+      for (auto &c : data) c = (char)(rand() & 0xff);
+      ASSERT_EQ(write(fd, data.data(), data.size()), (ssize_t)data.size());
+      close(fd);
+     }
+
+void TearDown() override {unlink(fPath.c_str());}
+
+std::string fPath;
+};
+}
+
+TEST_F(CksManager, MultiCalc)
+{
+  const char *names[] = {"adler32", "crc32", "crc32c", "md5"};
+  const int   nCks    = sizeof(names)/sizeof(names[0]);
+  XrdCksManager cksMan(&eDest, 0, myVer);
+  XrdCksData    single[nCks], multi[nCks];
+
+  ASSERT_TRUE(cksMan.Init(0));
+
+  for (int i = 0; i < nCks; i++)
+      {single[i].Set(names[i]);
+       ASSERT_EQ(cksMan.Calc(fPath.c_str(), single[i], 0), 0) << names[i];
+       multi[i].Set(names[i]);
+      }
+  ASSERT_EQ(cksMan.MultiCalc(fPath.c_str(), multi, nCks, 0), 0);
+
+  for (int i = 0; i < nCks; i++)
+      {EXPECT_STREQ(multi[i].Name, names[i]);
+       EXPECT_EQ(multi[i].Length, single[i].Length) << names[i];
+       EXPECT_EQ(memcmp(multi[i].Value, single[i].Value, single[i].Length), 0)
+                 << names[i];
+      }
+
+  // An empty name is the default checksum
+  //
+  XrdCksData dflt[2];
+  dflt[1].Set("md5");
+  ASSERT_EQ(cksMan.MultiCalc(fPath.c_str(), dflt, 2, 0), 0);
+  EXPECT_STREQ(dflt[0].Name, cksMan.Name());
+}
+
+TEST_F(CksManager, MultiCalcErrors)
+{
+  XrdCksManager cksMan(&eDest, 0, myVer);
+  XrdCksData    cks[9];
+
+  ASSERT_TRUE(cksMan.Init(0));
+
+  EXPECT_EQ(cksMan.MultiCalc(fPath.c_str(), cks, 0, 0), -EINVAL);
+  EXPECT_EQ(cksMan.MultiCalc(fPath.c_str(), cks, 9, 0), -EINVAL);
+
+  cks[0].Set("adler32"); cks[1].Set("nosuchcks");
+  EXPECT_EQ(cksMan.MultiCalc(fPath.c_str(), cks, 2, 0), -ENOTSUP);
+
+  cks[1].Set("crc32");
+  EXPECT_EQ(cksMan.MultiCalc("/tmp/no/such/file", cks, 2, 0), -ENOENT);
+}
@@ -0,0 +1,160 @@
+#undef NDEBUG
+
+#include <XrdCl/XrdClDefaultEnv.hh>
+#include <XrdCl/XrdClFile.hh>
+#include <XrdCl/XrdClPostMaster.hh>
+#include <XrdSys/XrdSysPthread.hh>
+#include <gtest/gtest.h>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+// Copy a file in and out of the local file system through XrdCl::File with
+// each of the local I/O engines (XRD_LOCALIOENGINE) and compare the rates
+// and the cpu time used. The engine is picked when the post master is made,
+// so every engine is run in a child process of its own. The Copy test moves
+// a few MB to check each engine; the timed copy of a larger file is disabled
+// and is run with --gtest_also_run_disabled_tests.
+
+namespace
+{
+const size_t   blockSz  = 1024*1024;
+const int      inFlight = 8;
+
+double ProcessCPU()
+{
+  struct rusage ru;
+
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec
+       + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+double Since(const std::chrono::steady_clock::time_point &t0)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Write then read a file of fileSz bytes, inFlight blocks at a time; every
+// block starts with its own offset so that what is read back can be checked.
+// Returns the number of failed requests.
+//
+int Copy(const std::string &url, uint64_t fileSz,
+         double &wrRate, double &rdRate, double &cpu)
+{
+  std::vector<std::vector<char>> buffs(inFlight, std::vector<char>(blockSz, 'l'));
+  std::atomic<int> bad(0);
+  XrdSysSemaphore  doneSem(0);
+  XrdCl::File      file;
+  double           c0 = ProcessCPU();
+
+  auto handler = [&](bool isRead, uint64_t offs, char *buff) {
+    return XrdCl::ResponseHandler::Wrap([=, &bad, &doneSem](XrdCl::XRootDStatus &st,
+                                                            XrdCl::AnyObject &rsp) {
+      if (!st.IsOK()) bad++;
+      else if (isRead) {
+        XrdCl::ChunkInfo *chunk = 0;
+        rsp.Get(chunk);
+        if (!chunk || chunk->length != blockSz || memcmp(buff, &offs, sizeof(offs)))
+          bad++;
+      }
+      doneSem.Post();
+    });
+  };
+
+  if (!file.Open(url, XrdCl::OpenFlags::Delete | XrdCl::OpenFlags::Update,
+                 XrdCl::Access::UR | XrdCl::Access::UW).IsOK())
+    return 1;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint64_t offs = 0; offs < fileSz; offs += inFlight*blockSz) {
+    for (int i = 0; i < inFlight; i++) {
+      uint64_t bOffs = offs + i*blockSz;
+      memcpy(buffs[i].data(), &bOffs, sizeof(bOffs));
+      if (!file.Write(bOffs, blockSz, buffs[i].data(),
+                      handler(false, bOffs, buffs[i].data())).IsOK()) {
+        bad++; doneSem.Post();
+      }
+    }
+    for (int i = 0; i < inFlight; i++) doneSem.Wait();
+  }
+  if (!file.Sync().IsOK()) bad++;
+  wrRate = fileSz / (1024*1024) / Since(t0);
+
+  t0 = std::chrono::steady_clock::now();
+  for (uint64_t offs = 0; offs < fileSz; offs += inFlight*blockSz) {
+    for (int i = 0; i < inFlight; i++) {
+      uint64_t bOffs = offs + i*blockSz;
+      memset(buffs[i].data(), 0, sizeof(bOffs));
+      if (!file.Read(bOffs, blockSz, buffs[i].data(),
+                     handler(true, bOffs, buffs[i].data())).IsOK()) {
+        bad++; doneSem.Post();
+      }
+    }
+    for (int i = 0; i < inFlight; i++) doneSem.Wait();
+  }
+  rdRate = fileSz / (1024*1024) / Since(t0);
+  cpu = ProcessCPU() - c0;
+
+  if (!file.Close().IsOK()) bad++;
+  return bad;
+}
+
+// Copy a file with each engine in a child process, printing the rates when
+// report is set
+//
+void CopyAll(uint64_t fileSz, bool report)
+{
+  char tmpl[] = "/tmp/xrdcl-localio.XXXXXX";
+  ASSERT_TRUE(mkdtemp(tmpl));
+  const std::string path = std::string(tmpl) + "/data";
+
+  for (const char *engine : { "aio", "pool", "uring" }) {
+    fflush(stdout);
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+
+    if (pid == 0) {
+      double wrRate = 0, rdRate = 0, cpu = 0;
+      XrdCl::DefaultEnv::GetEnv()->PutString("LocalIOEngine", engine);
+      int bad = Copy("file://" + path, fileSz, wrRate, rdRate, cpu);
+      bool noRing = !strcmp(engine, "uring")
+                 && !XrdCl::DefaultEnv::GetPostMaster()->GetLocalIORing();
+      if (report) printf("%-5s: write %7.1f MB/s, read %7.1f MB/s, %6.3f cpu s/GB%s\n",
+             engine, wrRate, rdRate, cpu * 1024*1024*1024 / (2.0*fileSz),
+             (noRing ? " (no io_uring, the pool was used)" : ""));
+      fflush(stdout);
+      _exit(bad ? 1 : 0);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0)
+      << "copy with the " << engine << " engine failed";
+  }
+
+  unlink(path.c_str());
+  rmdir(tmpl);
+}
+}
+
+TEST(LocalIOTest, Copy)
+{
+  CopyAll(4*inFlight*blockSz, false);
+}
+
+TEST(LocalIOTest, DISABLED_Bench)
+{
+  CopyAll(128*1024*1024, true);
+}
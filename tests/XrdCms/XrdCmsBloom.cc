@@ -0,0 +1,138 @@
+#undef NDEBUG
+
+#include <XrdCms/XrdCmsBloom.hh>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+// Check that a namespace summary never loses a path, that it wrongly admits
+// to about as many others as it should, and that it survives being sent in
+// pieces.
+
+namespace
+{
+std::string PathOf(int i, const char *pfx)
+{
+  char buff[128];
+  snprintf(buff, sizeof(buff), "/store/%s/run%04d/file%07d.root",
+           pfx, i % 1000, i);
+  return buff;
+}
+
+unsigned long long HashOf(const std::string &path)
+{
+  return XrdCmsBloom::Hash(path.c_str(), path.size());
+}
+}
+
+TEST(XrdCmsBloom, Sizing)
+{
+  int hashes;
+
+  EXPECT_EQ(XrdCmsBloom::Sizing(0, 10, hashes), XrdCmsBloom::minBits);
+  EXPECT_EQ(hashes, XrdCmsBloom::maxHash);
+
+  unsigned int bits = XrdCmsBloom::Sizing(1000000, 10, hashes);
+  EXPECT_EQ(bits, 1U << 24);
+  EXPECT_TRUE(XrdCmsBloom::Valid(bits, hashes));
+  EXPECT_GE(hashes, 7);
+  EXPECT_LE(hashes, 12);
+
+  EXPECT_EQ(XrdCmsBloom::Sizing(1LL << 40, 32, hashes), XrdCmsBloom::maxBits);
+  EXPECT_EQ(hashes, 1);
+
+  EXPECT_FALSE(XrdCmsBloom::Valid(XrdCmsBloom::minBits + 8, 7));
+  EXPECT_FALSE(XrdCmsBloom::Valid(XrdCmsBloom::minBits >> 1, 7));
+  EXPECT_FALSE(XrdCmsBloom::Valid(XrdCmsBloom::minBits, 0));
+  EXPECT_FALSE(XrdCmsBloom::Valid(XrdCmsBloom::minBits, XrdCmsBloom::maxHash+1));
+}
+
+TEST(XrdCmsBloom, FalsePositives)
+{
+  const int nPaths = 200000;
+  int hashes, wrong = 0;
+
+  // Exactly 10 bits per path so the expected rate is about 1%
+  //
+  unsigned int bits = XrdCmsBloom::Sizing(nPaths, 10, hashes);
+  XrdCmsBloom bf(bits, hashes);
+  int nAdd = bits / 10;
+
+  for (int i = 0; i < nAdd; i++) bf.Add(HashOf(PathOf(i, "have")));
+  for (int i = 0; i < nAdd; i++)
+      ASSERT_TRUE(bf.Test(HashOf(PathOf(i, "have")))) << PathOf(i, "have");
+
+  for (int i = 0; i < nPaths; i++)
+      if (bf.Test(HashOf(PathOf(i, "miss")))) wrong++;
+
+  EXPECT_LT(100.0 * wrong / nPaths, 2.0);
+}
+
+TEST(XrdCmsBloom, Layout)
+{
+  // The bit layout is part of the protocol: bit n of the filter is bit n%8
+  // of byte n/8. With one hash function a path sets bit (low 32 bits of its
+  // hash) modulo the size.
+  //
+  const unsigned int bits = XrdCmsBloom::minBits;
+  XrdCmsBloom bf(bits, 1);
+  unsigned long long hVal = HashOf(PathOf(7, "have"));
+  unsigned int n = static_cast<unsigned int>(hVal) & (bits - 1);
+
+  bf.Add(hVal);
+  for (unsigned int i = 0; i < bf.Bytes(); i++)
+      EXPECT_EQ(bf.Data()[i], (i == n/8 ? 1 << (n%8) : 0)) << "byte " << i;
+
+  std::vector<char> piece(bf.Bytes(), 0);
+  piece[n/8] = static_cast<char>(1 << (n%8));
+  XrdCmsBloom other(bits, 1);
+  ASSERT_TRUE(other.Merge(0, piece.data(), piece.size()));
+  EXPECT_TRUE(other.Test(hVal));
+}
+
+TEST(XrdCmsBloom, Pieces)
+{
+  const int nPaths = 50000, piece = 8192;
+  int hashes;
+
+  unsigned int bits = XrdCmsBloom::Sizing(nPaths, 10, hashes);
+  XrdCmsBloom src(bits, hashes), dst(bits, hashes);
+  for (int i = 0; i < nPaths; i++) src.Add(HashOf(PathOf(i, "have")));
+
+  // A path added at the receiving end while the pieces arrive must survive
+  //
+  std::string late = PathOf(0, "late");
+  dst.Add(HashOf(late));
+
+  const char *data = (const char *)src.Data();
+  for (unsigned int offs = 0; offs < src.Bytes(); offs += piece)
+      {int dlen = (src.Bytes() - offs < (unsigned int)piece
+                ? src.Bytes() - offs : piece);
+       ASSERT_TRUE(dst.Merge(offs, data + offs, dlen));
+      }
+  EXPECT_FALSE(dst.Merge(dst.Bytes() - 1, data, 2));
+
+  for (int i = 0; i < nPaths; i++)
+      ASSERT_TRUE(dst.Test(HashOf(PathOf(i, "have"))));
+  EXPECT_TRUE(dst.Test(HashOf(late)));
+}
+
+TEST(XrdCmsBloom, Empty)
+{
+  int hashes;
+
+  unsigned int bits = XrdCmsBloom::Sizing(0, 10, hashes);
+  XrdCmsBloom bf(bits, hashes), other(bits, hashes);
+  EXPECT_TRUE(bf.Empty());
+
+  // Merging an empty filter leaves it empty; one path makes it non-empty
+  //
+  ASSERT_TRUE(bf.Merge(0, (const char *)other.Data(), other.Bytes()));
+  EXPECT_TRUE(bf.Empty());
+  bf.Add(HashOf(PathOf(0, "have")));
+  EXPECT_FALSE(bf.Empty());
+}
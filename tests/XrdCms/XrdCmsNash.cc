@@ -0,0 +1,147 @@
+#undef NDEBUG
+
+#include <XrdCms/XrdCmsKey.hh>
+#include <XrdCms/XrdCmsNash.hh>
+#include <XrdSys/XrdSysError.hh>
+#include <XrdSys/XrdSysPthread.hh>
+#include <XrdSys/XrdSysTrace.hh>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+// Check the key pool and hash table behind the cmsd location cache. The
+// disabled MixedThroughput test times a mixed add/lookup workload against a
+// single locked table and against the table split into shards with a lock
+// each, as XrdCmsCache now does; run it with --gtest_also_run_disabled_tests.
+
+namespace XrdCms
+{
+XrdSysError Say(0, "cms_");
+XrdSysTrace Trace("cms");
+}
+
+namespace
+{
+// A stand-in for one shard of XrdCmsCache
+//
+struct Shard
+{
+  XrdSysMutex   Mutex;
+  XrdCmsKeyPool Pool;
+  XrdCmsNash    CTable;
+
+  Shard() : CTable(Pool, 610, 987) {}
+};
+
+void MakeKey(XrdCmsKey &key, std::string &path, int n)
+{
+  path = "/store/data/run" + std::to_string(n / 1000) + "/file"
+       + std::to_string(n) + ".root";
+  key = XrdCmsKey(const_cast<char *>(path.c_str()), path.size());
+  key.setHash();
+}
+}
+
+TEST(NashTest, AddFindAge)
+{
+  XrdCmsKeyPool pool;
+  XrdCmsNash    table(pool, 3, 5);
+  std::string   path;
+  XrdCmsKey     key;
+  const int     nKeys = 5000;
+
+  // Add enough keys to force the table to expand a few times
+  //
+  for (int i = 0; i < nKeys; i++)
+      {MakeKey(key, path, i);
+       key.TOD = i % 2;
+       ASSERT_NE(table.Add(key), nullptr);
+      }
+  for (int i = 0; i < nKeys; i++)
+      {MakeKey(key, path, i);
+       XrdCmsKeyItem *iP = table.Find(key);
+       ASSERT_NE(iP, nullptr);
+       EXPECT_STREQ(iP->Key.Val, path.c_str());
+      }
+
+  // Age out the keys added at tick 0; they can no longer be found and can be
+  // recycled while the others remain.
+  //
+  XrdCmsKeyItem *iP = pool.Unload(0u), *nP;
+  int n = 0;
+  while((nP = iP)) {iP = iP->Key.TODRef; EXPECT_TRUE(table.Recycle(nP)); n++;}
+  EXPECT_EQ(n, nKeys/2);
+  for (int i = 0; i < nKeys; i++)
+      {MakeKey(key, path, i);
+       EXPECT_EQ(table.Find(key) != nullptr, (i % 2) != 0) << path;
+      }
+
+  // Remove a single key
+  //
+  MakeKey(key, path, 1);
+  iP = table.Find(key);
+  ASSERT_NE(iP, nullptr);
+  EXPECT_EQ(pool.Unload(iP), iP);
+  EXPECT_TRUE(table.Recycle(iP));
+  EXPECT_EQ(table.Find(key), nullptr);
+}
+
+TEST(NashTest, DISABLED_MixedThroughput)
+{
+  const int nThreads = 4, nKeys = 200000, nOps = 400000;
+  const int shardCnt[2] = {1, 32};
+
+  // Paths are looked up nine times for every path added, roughly what a busy
+  // manager sees. Lookups are of previously added paths.
+  //
+  for (int k = 0; k < 2; k++)
+      {int nShards = shardCnt[k];
+       std::vector<Shard *> shards;
+       std::atomic<long long> found(0);
+       for (int i = 0; i < nShards; i++) shards.push_back(new Shard);
+
+       auto pick = [&](XrdCmsKey &key) -> Shard &
+                   {return *shards[(key.Hash >> 27) % nShards];};
+
+       auto worker = [&](int t)
+           {std::string path;
+            XrdCmsKey key;
+            long long hits = 0;
+            int added = 0;
+            for (int j = 0; j < nOps; j++)
+                {if (j % 10 == 0 && added < nKeys/nThreads)
+                    {MakeKey(key, path, t + nThreads*added++);
+                     Shard &sP = pick(key);
+                     sP.Mutex.Lock();
+                     if (!sP.CTable.Find(key)) sP.CTable.Add(key);
+                     sP.Mutex.UnLock();
+                    } else {
+                     MakeKey(key, path, t + nThreads*(j % (added ? added : 1)));
+                     Shard &sP = pick(key);
+                     sP.Mutex.Lock();
+                     if (sP.CTable.Find(key)) hits++;
+                     sP.Mutex.UnLock();
+                    }
+                }
+            found += hits;
+           };
+
+       auto t0 = std::chrono::steady_clock::now();
+       std::vector<std::thread> threads;
+       for (int t = 0; t < nThreads; t++) threads.emplace_back(worker, t);
+       for (auto &th : threads) th.join();
+       double secs = std::chrono::duration<double>
+                     (std::chrono::steady_clock::now() - t0).count();
+
+       EXPECT_GT(found.load(), 0);
+       printf("%2d shard(s), %d threads: %10.0f ops/s (%lld hits)\n",
+              nShards, nThreads, nThreads*nOps/secs, found.load());
+      }
+}
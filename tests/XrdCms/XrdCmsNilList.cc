@@ -0,0 +1,130 @@
+#undef NDEBUG
+
+#include <XrdCms/XrdCmsNilList.hh>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace testing;
+
+// Check the list of paths that the cmsd location cache found on no node: it
+// must forget paths when they expire, when a node reconnects, when it is full,
+// and when a path or a directory above or around it comes into existence.
+// The lookup timing over 200,000 paths is disabled; run it with
+// --gtest_also_run_disabled_tests.
+
+namespace
+{
+bool Add(XrdCmsNilList &nl, const std::string &path, time_t endT = 100,
+         unsigned int clock = 1)
+{
+  return nl.Add(path.c_str(), path.size(), endT, clock) != 0;
+}
+
+bool Find(XrdCmsNilList &nl, const std::string &path, time_t now = 0,
+          unsigned int clock = 1)
+{
+  return nl.Find(path.c_str(), path.size(), now, clock);
+}
+}
+
+TEST(XrdCmsNilList, ExpiryAndClock)
+{
+  XrdCmsNilList nl(16);
+
+  Add(nl, "/store/a", 100, 5);
+  EXPECT_TRUE(Find(nl, "/store/a", 99, 5));
+  EXPECT_FALSE(Find(nl, "/store/b", 99, 5));
+
+  // A node reconnected after the path was added
+  //
+  EXPECT_FALSE(Find(nl, "/store/a", 99, 6));
+  EXPECT_EQ(nl.Num(), 0);
+
+  // The path has expired
+  //
+  Add(nl, "/store/a", 100, 5);
+  EXPECT_FALSE(Find(nl, "/store/a", 100, 5));
+  EXPECT_EQ(nl.Num(), 0);
+
+  // Trim stops at the first path that has not expired
+  //
+  Add(nl, "/1", 10); Add(nl, "/2", 20); Add(nl, "/3", 30);
+  EXPECT_EQ(nl.Trim(20), 2);
+  EXPECT_TRUE(Find(nl, "/3", 20));
+  EXPECT_EQ(nl.Trim(100), 1);
+  EXPECT_EQ(nl.Num(), 0);
+}
+
+TEST(XrdCmsNilList, Bounded)
+{
+  XrdCmsNilList nl(3);
+
+  EXPECT_FALSE(Add(nl, "/a"));
+  EXPECT_FALSE(Add(nl, "/b"));
+  EXPECT_FALSE(Add(nl, "/c"));
+
+  // Refreshing /a makes /b the oldest, so /b is the one forgotten
+  //
+  EXPECT_FALSE(Add(nl, "/a"));
+  EXPECT_TRUE(Add(nl, "/d"));
+  EXPECT_EQ(nl.Num(), 3);
+  EXPECT_TRUE(Find(nl, "/a"));
+  EXPECT_FALSE(Find(nl, "/b"));
+  EXPECT_TRUE(Find(nl, "/c"));
+  EXPECT_TRUE(Find(nl, "/d"));
+}
+
+TEST(XrdCmsNilList, DelTree)
+{
+  XrdCmsNilList nl(64);
+
+  Add(nl, "/store/x");
+  Add(nl, "/store/x/f1");
+  Add(nl, "/store/x/sub/f2");
+  Add(nl, "/store/x.root");
+  Add(nl, "/store/x-1/f3");
+  Add(nl, "/store/xy/f4");
+
+  EXPECT_TRUE(nl.Del("/store/xy/f4", 12));
+  EXPECT_FALSE(nl.Del("/store/xy/f4", 12));
+
+  // Only the path and what is under it go, not its look-alike neighbours
+  //
+  EXPECT_EQ(nl.DelTree("/store/x/", 9), 3);
+  EXPECT_EQ(nl.Num(), 2);
+  EXPECT_TRUE(Find(nl, "/store/x.root"));
+  EXPECT_TRUE(Find(nl, "/store/x-1/f3"));
+
+  EXPECT_EQ(nl.DelTree("/", 1), 2);
+  EXPECT_EQ(nl.Num(), 0);
+}
+
+TEST(XrdCmsNilList, DISABLED_Timing)
+{
+  const int nPaths = 200000;
+  XrdCmsNilList nl(nPaths);
+  char buff[128];
+
+  for (int i = 0; i < nPaths; i++)
+      {int n = snprintf(buff, sizeof(buff), "/store/friend/run%04d/f%07d.root",
+                        i % 1000, i);
+       nl.Add(buff, n, 100, 1);
+      }
+
+  int hits = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < nPaths; i++)
+      {int n = snprintf(buff, sizeof(buff), "/store/friend/run%04d/f%07d.root",
+                        i % 1000, i);
+       if (nl.Find(buff, n, 0, 1)) hits++;
+      }
+  auto t1 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(hits, nPaths);
+  printf("%.3f us per negative lookup with %d paths\n",
+         std::chrono::duration<double, std::micro>(t1 - t0).count() / nPaths,
+         nl.Num());
+}
@@ -0,0 +1,256 @@
+#undef NDEBUG
+
+#include <XrdCms/XrdCmsRank.hh>
+#include <XrdCms/XrdCmsSelNode.hh>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+// Check the node ranking and the load based selection of the cluster, which
+// XrdCmsSelNode holds, run against a table of stand-in nodes. The disabled
+// SelectRate test compares the select rate of comparing every node in the
+// mask against the selection the cluster makes for cells of 64, 256, and
+// 1024 nodes; run it with --gtest_also_run_disabled_tests.
+
+template<typename T>
+class RankTest : public ::testing::Test {};
+
+typedef Types<XrdCmsRank<64>, XrdCmsRank<256>, XrdCmsRank<1024>> RankTypes;
+
+TYPED_TEST_SUITE(RankTest, RankTypes);
+
+namespace
+{
+const int Fuzz     = 20;
+
+// The members of XrdCmsNode that a selection looks at
+//
+struct Node
+{
+static const char allowsSS = 0x02;
+
+  char hasNet    = 1;
+  char isBad     = 0;
+  char isOffline = 0;
+  char isNoStage = 0;
+  int  DiskMinF  = 0;
+  int  DiskFree  = 0;
+  int  myLoad    = 0;
+  int  myMass    = 0;
+  int  RefW      = 0;
+  int  RefR      = 0;
+};
+
+typedef XrdCmsSelNode<Node> SelNode;
+
+const SelNode::Parms parms = {100, Fuzz, 0, 8};
+
+// Make a cell of nNodes nodes with random loads, a few unusable nodes, and
+// rank them
+//
+template<typename Rank>
+void MakeCell(std::vector<Node> &nodes, std::vector<Node *> &tab, Rank &rTab)
+{
+  srand(1);
+  for (int i = 0; i < (int)nodes.size(); i++)
+      {nodes[i].myLoad = rand() % 101;
+       nodes[i].isBad  = (rand() % 16) == 0;
+       tab[i] = &nodes[i];
+       rTab.Set(i, nodes[i].myLoad/(Fuzz+1));
+      }
+}
+
+// Select as the cluster does, counting the reference as it would
+//
+template<typename Rank>
+Node *Select(std::vector<Node *> &tab, const Rank &rTab,
+             const typename Rank::Mask &mask, unsigned int &next)
+{
+  XrdCmsSelector selR;
+  bool Multi = false;
+
+  selR.needNet = 1; selR.needSpace = 0; selR.selPack = 0;
+  selR.Reset();
+  Node *sp = SelNode::byLoad(tab.data(), (int)tab.size()-1, rTab, mask,
+                             selR, Multi, next, parms);
+  if (sp) sp->RefR++;
+  return sp;
+}
+
+// Select by comparing every node in the mask, as the cluster did before the
+// nodes were ranked
+//
+template<typename Mask>
+Node *Scan(std::vector<Node *> &tab, const Mask &mask)
+{
+  XrdCmsSelector selR;
+  bool Multi = false;
+
+  selR.needNet = 1; selR.needSpace = 0; selR.selPack = 0;
+  selR.Reset();
+  Node *sp = SelNode::byScan(tab.data(), (int)tab.size()-1, mask, selR,
+                             Multi, parms);
+  if (sp) sp->RefR++;
+  return sp;
+}
+}
+
+TYPED_TEST(RankTest, Ranking)
+{
+  typedef TypeParam Rank;
+  typedef typename Rank::Mask Mask;
+  const int nSlots = Mask::Words * 64;
+
+  Rank  rTab;
+  Mask  nodes, all(~0);
+  Mask  few = Mask::Bit(1) | Mask::Bit(nSlots-1);
+
+  EXPECT_EQ(rTab.Lowest(all, nodes), -1);
+  EXPECT_EQ(rTab.Rank(0), -1);
+
+  // Rank every slot by its number and make sure the lowest is found
+  //
+  for (int i = 0; i < nSlots; i++) rTab.Set(i, i % Rank::maxRank);
+  EXPECT_EQ(rTab.Lowest(all, nodes), 0);
+  EXPECT_TRUE(nodes.Test(0));
+  EXPECT_EQ(rTab.Lowest(few, nodes), 1);
+  EXPECT_EQ(nodes, Mask::Bit(1));
+  EXPECT_EQ(rTab.Lowest(few, nodes, 2), (nSlots-1) % Rank::maxRank);
+
+  // Move a node and drop one
+  //
+  rTab.Set(nSlots-1, 0);
+  EXPECT_EQ(rTab.Lowest(few, nodes), 0);
+  EXPECT_EQ(nodes, Mask::Bit(nSlots-1));
+  EXPECT_EQ(rTab.Rank(nSlots-1), 0);
+  rTab.Set(nSlots-1, -1);
+  EXPECT_EQ(rTab.Rank(nSlots-1), -1);
+  EXPECT_EQ(rTab.Lowest(few, nodes), 1);
+  EXPECT_EQ(nodes, Mask::Bit(1));
+
+  // Large values all land in the highest rank
+  //
+  rTab.Set(1, 100000);
+  EXPECT_EQ(rTab.Rank(1), Rank::maxRank-1);
+  EXPECT_EQ(rTab.Lowest(few, nodes), Rank::maxRank-1);
+}
+
+TYPED_TEST(RankTest, LookupWhileMoving)
+{
+  typedef TypeParam Rank;
+  typedef typename Rank::Mask Mask;
+  const int slot = Mask::Words * 64 - 1;
+
+  // A lookup racing with a node moving between two ranks finds it in one of
+  // them or not at all, never anything else
+  //
+  Rank *rTab = new Rank;
+  std::atomic<bool> stop(false);
+  rTab->Set(slot, 3);
+  std::thread mover([&]
+     {for (int i = 0; !stop; i++) rTab->Set(slot, (i & 1 ? 3 : 5));});
+
+  Mask nodes, all(~0);
+  for (int i = 0; i < 100000; i++)
+      {int rank = rTab->Lowest(all, nodes);
+       if (rank < 0) continue;
+       ASSERT_TRUE(rank == 3 || rank == 5) << "rank " << rank;
+       ASSERT_EQ(nodes, Mask::Bit(slot));
+      }
+  stop = true;
+  mover.join();
+  delete rTab;
+}
+
+TYPED_TEST(RankTest, Select)
+{
+  typedef TypeParam Rank;
+  typedef typename Rank::Mask Mask;
+  const int nNodes = Mask::Words * 64;
+
+  std::vector<Node>   nodes(nNodes);
+  std::vector<Node *> tab(nNodes);
+  Rank *rTab = new Rank;
+  MakeCell(nodes, tab, *rTab);
+
+  // Selections over the whole cell spread over the least loaded nodes and,
+  // in a cell that is too large to scan, come from the least loaded rank
+  //
+  int lowRank = nNodes, picked = 0;
+  for (auto &n : nodes) if (!n.isBad && n.myLoad/(Fuzz+1) < lowRank)
+                           lowRank = n.myLoad/(Fuzz+1);
+  unsigned int next = 0;
+  for (int j = 0; j < 1000; j++)
+      {Node *sp = Select(tab, *rTab, Mask(~0), next);
+       ASSERT_TRUE(sp);
+       ASSERT_FALSE(sp->isBad);
+       if (nNodes > 64) {ASSERT_EQ(sp->myLoad/(Fuzz+1), lowRank);}
+      }
+  for (auto &n : nodes) if (n.RefR) picked++;
+  EXPECT_GT(picked, 1);
+
+  // A few nodes are all compared and the least loaded one is picked
+  //
+  Mask few(0);
+  Node *best = 0;
+  for (int i = 0; i < 4; i++)
+      {int k = (i * 97 + 5) % nNodes;
+       nodes[k].isBad = 0;
+       nodes[k].myLoad = 10 + i * (Fuzz+1);
+       if (!best) best = &nodes[k];
+       few |= Mask::Bit(k);
+      }
+  EXPECT_EQ(Select(tab, *rTab, few, next), best);
+
+  // Unusable nodes are never picked
+  //
+  for (auto &n : nodes) n.isBad = 1;
+  EXPECT_EQ(Select(tab, *rTab, Mask(~0), next), nullptr);
+  delete rTab;
+}
+
+TYPED_TEST(RankTest, DISABLED_SelectRate)
+{
+  typedef TypeParam Rank;
+  typedef typename Rank::Mask Mask;
+  const int nNodes = Mask::Words * 64;
+  const int nIters = 20000;
+
+  std::vector<Node>   nodes(nNodes);
+  std::vector<Node *> tab(nNodes);
+  Rank *rTab = new Rank;
+  MakeCell(nodes, tab, *rTab);
+
+  // Time a selection across the whole cell (e.g. creating a file) and one of
+  // a file that lives on just a few nodes (the common case).
+  //
+  Mask few(0);
+  for (int i = 0; i < 4; i++) few |= Mask::Bit((i * 97 + 5) % nNodes);
+  Mask masks[2] = {Mask(~0), few};
+  const char *what[2] = {"all nodes", "4 nodes"};
+
+  for (int k = 0; k < 2; k++)
+      {unsigned int next = 0;
+       auto t0 = std::chrono::steady_clock::now();
+       for (int j = 0; j < nIters; j++) ASSERT_TRUE(Scan(tab, masks[k]));
+       auto t1 = std::chrono::steady_clock::now();
+       for (int j = 0; j < nIters; j++)
+           ASSERT_TRUE(Select(tab, *rTab, masks[k], next));
+       auto t2 = std::chrono::steady_clock::now();
+
+       double scan = std::chrono::duration<double>(t1-t0).count();
+       double rank = std::chrono::duration<double>(t2-t1).count();
+       printf("%5d node cell, %-9s: %10.0f selects/s scanning, "
+              "%10.0f selects/s selecting\n",
+              nNodes, what[k], nIters/scan, nIters/rank);
+      }
+
+  delete rTab;
+}
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "XrdEc/XrdEcRedundancyProvider.hh"
+#include "XrdEc/XrdEcObjCfg.hh"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace XrdEc;
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class DecodeBench: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( DecodeBench );
+      CPPUNIT_TEST( DecodeCheck );
+      CPPUNIT_TEST( Decode1MissingBench );
+      CPPUNIT_TEST( Decode2MissingBench );
+      CPPUNIT_TEST( DecodeAllParityMissingBench );
+    CPPUNIT_TEST_SUITE_END();
+
+    //--------------------------------------------------------------------------
+    //! Recover every data stripe once for each number of missing stripes; this
+    //! is the only one of the tests run by ctest, the timed ones are run by
+    //! name with the test-runner.
+    //--------------------------------------------------------------------------
+    inline void DecodeCheck()
+    {
+      DecodeBenchImpl( 1, nbdata, false );
+      DecodeBenchImpl( 2, nbdata, false );
+      DecodeBenchImpl( nbparity, nbdata, false );
+    }
+
+    inline void Decode1MissingBench()
+    {
+      DecodeBenchImpl( 1, nbiters, true );
+    }
+
+    inline void Decode2MissingBench()
+    {
+      DecodeBenchImpl( 2, nbiters, true );
+    }
+
+    inline void DecodeAllParityMissingBench()
+    {
+      DecodeBenchImpl( nbparity, nbiters, true );
+    }
+
+    //--------------------------------------------------------------------------
+    //! Encode a block, then 'iters' times drop 'nbmissing' data stripes
+    //! (rotating which ones) and reconstruct them, verifying the result each
+    //! time. The decode rate is printed if 'report' is set.
+    //--------------------------------------------------------------------------
+    void DecodeBenchImpl( size_t nbmissing, size_t iters, bool report );
+
+  private:
+
+    static const size_t nbdata   = 8;
+    static const size_t nbparity = 4;
+    static const size_t chsize   = 1024 * 1024;
+    static const size_t nbiters  = 256;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DecodeBench );
+
+void DecodeBench::DecodeBenchImpl( size_t nbmissing, size_t iters, bool report )
+{
+  ObjCfg objcfg( "bench.txt", nbdata, nbparity, chsize, true, true );
+  RedundancyProvider redundancy( objcfg );
+
+  // generate the data and compute the parity
+  std::vector<char> block( objcfg.blksize );
+  std::default_random_engine random_engine( 1234 );
+  std::uniform_int_distribution<int> dist( 0, 255 );
+  for( size_t i = 0; i < objcfg.datasize; ++i )
+    block[i] = static_cast<char>( dist( random_engine ) );
+
+  stripes_t stripes;
+  for( size_t i = 0; i < objcfg.nbchunks; ++i )
+    stripes.emplace_back( block.data() + i * chsize, i < nbdata );
+  redundancy.compute( stripes );
+  std::vector<char> expected( block );
+
+  // now drop data stripes and recover them
+  double elapsed = 0;
+  for( size_t iter = 0; iter < iters; ++iter )
+  {
+    for( size_t i = 0; i < objcfg.nbchunks; ++i )
+      stripes[i].valid = true;
+    for( size_t i = 0; i < nbmissing; ++i )
+    {
+      size_t strpnb = ( iter + i ) % nbdata;
+      stripes[strpnb].valid = false;
+      memset( stripes[strpnb].buffer, 0, chsize );
+    }
+    auto start = std::chrono::steady_clock::now();
+    redundancy.compute( stripes );
+    elapsed += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    CPPUNIT_ASSERT( memcmp( block.data(), expected.data(), objcfg.datasize ) == 0 );
+  }
+
+  if( !report ) return;
+  double mbytes = double( iters ) * objcfg.datasize / ( 1024 * 1024 );
+  std::cout << "\nDecode " << nbmissing << " missing of " << nbdata << "+"
+            << nbparity << ": " << mbytes / elapsed << " MB/s of data ("
+            << elapsed * 1e6 / iters << " us per stripe)" << std::endl;
+}
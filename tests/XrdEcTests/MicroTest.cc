@@ -29,14 +29,18 @@
 #include "XrdEc/XrdEcStrmWriter.hh"
 #include "XrdEc/XrdEcReader.hh"
 #include "XrdEc/XrdEcObjCfg.hh"
+#include "XrdEc/XrdEcConfig.hh"
 
 #include "XrdCl/XrdClMessageUtils.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 #include "XrdZip/XrdZipCDFH.hh"
 
+#include <algorithm>
 #include <string>
 #include <memory>
 #include <limits>
+#include <iostream>
 
 #include <unistd.h>
 #include <cstdio>
@@ -65,6 +69,10 @@ class MicroTest: public CppUnit::TestCase
       CPPUNIT_TEST( BigWriteTestIsalCrcNoMt );
       CPPUNIT_TEST( AlignedWrite1MissingTestIsalCrcNoMt );
       CPPUNIT_TEST( AlignedWrite2MissingTestIsalCrcNoMt );
+      CPPUNIT_TEST( ReadAheadBench );
+      CPPUNIT_TEST( DestroyInCallbackTest );
+      CPPUNIT_TEST( ChainedWriteTest );
+      CPPUNIT_TEST( WrtInflightBench );
     CPPUNIT_TEST_SUITE_END();
 
     void Init( bool usecrc32c );
@@ -120,6 +128,31 @@ class MicroTest: public CppUnit::TestCase
 		CleanUp();
     }
 
+    //--------------------------------------------------------------------------
+    //! Read the object sequentially with different read-ahead depths, verify
+    //! the data and report the throughput for each depth
+    //--------------------------------------------------------------------------
+    void ReadAheadBench();
+
+    //--------------------------------------------------------------------------
+    //! Destroy the reader from the handler of a read while read-ahead still
+    //! has reads in flight
+    //--------------------------------------------------------------------------
+    void DestroyInCallbackTest();
+
+    //--------------------------------------------------------------------------
+    //! Issue every write from the handler of the previous one, with a single
+    //! block allowed in flight, so that the writer has to park blocks while
+    //! called from a client thread, and verify the data
+    //--------------------------------------------------------------------------
+    void ChainedWriteTest();
+
+    //--------------------------------------------------------------------------
+    //! Write the object with different limits on the blocks in flight and
+    //! report the throughput for each limit
+    //--------------------------------------------------------------------------
+    void WrtInflightBench();
+
     inline void AlignedWrite1MissingTestImpl( bool usecrc32c )
     {
       // initialize directories
@@ -646,6 +679,212 @@ void MicroTest::CleanUp()
   nftw( datadir.c_str(), unlink_cb, 64, FTW_DEPTH | FTW_PHYS );
 }
 
+void MicroTest::ReadAheadBench()
+{
+  Init( true );
+  AlignedWriteRaw();
+
+  Config &cfg = Config::Instance();
+  size_t readahead = cfg.readahead;
+  const size_t depths[] = { 0, 1, 2, 4, 8 };
+  for( size_t depth : depths )
+  {
+    cfg.readahead = depth;
+    auto start = std::chrono::steady_clock::now();
+    for( size_t i = 0; i < nbiters; ++i )
+      ReadVerify( chsize );
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double mbytes = double( nbiters ) * rawdata.size() / ( 1024 * 1024 );
+    std::cout << "\nSequential read, read-ahead depth " << depth << ": "
+              << mbytes / elapsed.count() << " MB/s" << std::endl;
+  }
+  cfg.readahead = readahead;
+
+  CleanUp();
+}
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Deletes the reader once the read is done
+  //----------------------------------------------------------------------------
+  class DestroyReader: public XrdCl::ResponseHandler
+  {
+    public:
+      DestroyReader( Reader *reader ) : reader( reader ), failed( false ),
+                                        done( 0 )
+      {
+      }
+
+      void HandleResponse( XrdCl::XRootDStatus *st, XrdCl::AnyObject *rsp )
+      {
+        if( !st->IsOK() ) failed = true;
+        delete st;
+        delete rsp;
+        delete reader;
+        done.Post();
+      }
+
+      void Wait() { done.Wait(); }
+
+      bool Failed() const { return failed; }
+
+    private:
+      Reader          *reader;
+      bool             failed;
+      XrdSysSemaphore  done;
+  };
+}
+
+void MicroTest::DestroyInCallbackTest()
+{
+  Init( true );
+  AlignedWriteRaw();
+
+  Config &cfg = Config::Instance();
+  size_t readahead = cfg.readahead;
+  cfg.readahead = 4;
+
+  Reader *reader = new Reader( *objcfg );
+  XrdCl::SyncResponseHandler handler1;
+  reader->Open( &handler1 );
+  handler1.WaitForResponse();
+  XrdCl::XRootDStatus *status = handler1.GetStatus();
+  CPPUNIT_ASSERT_XRDST( *status );
+  delete status;
+
+  // the first read starts the read-ahead of the following blocks
+  std::vector<char> rdbuff( objcfg->datasize );
+  DestroyReader handler2( reader );
+  reader->Read( 0, rdbuff.size(), rdbuff.data(), &handler2, 0 );
+  handler2.Wait();
+  CPPUNIT_ASSERT( !handler2.Failed() );
+  CPPUNIT_ASSERT( std::equal( rdbuff.begin(), rdbuff.end(), rawdata.begin() ) );
+  cfg.readahead = readahead;
+
+  CleanUp();
+}
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Writes count times two blocks, each write being issued by the handler of
+  // the previous one
+  //----------------------------------------------------------------------------
+  class ChainedWrite: public XrdCl::ResponseHandler
+  {
+    public:
+      ChainedWrite( StrmWriter &writer, size_t size, size_t count,
+                    std::vector<char> &rawdata ) : writer( writer ),
+                    buffer( size ), count( count ), wrtnb( 0 ),
+                    failed( false ), rawdata( rawdata ), done( 0 )
+      {
+      }
+
+      void Next()
+      {
+        if( wrtnb == count ) return done.Post();
+        memset( buffer.data(), 'A' + wrtnb % 26, buffer.size() );
+        rawdata.insert( rawdata.end(), buffer.begin(), buffer.end() );
+        ++wrtnb;
+        writer.Write( buffer.size(), buffer.data(), this );
+      }
+
+      void HandleResponse( XrdCl::XRootDStatus *st, XrdCl::AnyObject *rsp )
+      {
+        if( !st->IsOK() ) failed = true;
+        delete st;
+        delete rsp;
+        Next();
+      }
+
+      void Wait() { done.Wait(); }
+
+      bool Failed() const { return failed; }
+
+    private:
+      StrmWriter        &writer;
+      std::vector<char>  buffer;
+      size_t             count;
+      size_t             wrtnb;
+      bool               failed;
+      std::vector<char> &rawdata;
+      XrdSysSemaphore    done;
+  };
+}
+
+void MicroTest::ChainedWriteTest()
+{
+  Init( true );
+
+  Config &cfg = Config::Instance();
+  size_t wrtinflight = cfg.wrtinflight;
+  cfg.wrtinflight = 1;
+
+  StrmWriter writer( *objcfg );
+  XrdCl::SyncResponseHandler handler1;
+  writer.Open( &handler1 );
+  handler1.WaitForResponse();
+  XrdCl::XRootDStatus *status = handler1.GetStatus();
+  CPPUNIT_ASSERT_XRDST( *status );
+  delete status;
+
+  ChainedWrite chain( writer, 2 * objcfg->datasize, nbiters, rawdata );
+  chain.Next();
+  chain.Wait();
+  CPPUNIT_ASSERT( !chain.Failed() );
+
+  XrdCl::SyncResponseHandler handler2;
+  writer.Close( &handler2 );
+  handler2.WaitForResponse();
+  status = handler2.GetStatus();
+  CPPUNIT_ASSERT_XRDST( *status );
+  delete status;
+  cfg.wrtinflight = wrtinflight;
+
+  Verify();
+  CleanUp();
+}
+
+void MicroTest::WrtInflightBench()
+{
+  Config &cfg = Config::Instance();
+  size_t wrtinflight = cfg.wrtinflight;
+  const size_t limits[] = { 1, 2, 4, 16 };
+  const size_t nbblks   = 4096;
+  for( size_t limit : limits )
+  {
+    Init( true );
+    cfg.wrtinflight = limit;
+    std::vector<char> buffer( objcfg->datasize );
+    auto start = std::chrono::steady_clock::now();
+    StrmWriter writer( *objcfg );
+    XrdCl::SyncResponseHandler handler1;
+    writer.Open( &handler1 );
+    handler1.WaitForResponse();
+    XrdCl::XRootDStatus *status = handler1.GetStatus();
+    CPPUNIT_ASSERT_XRDST( *status );
+    delete status;
+    for( size_t i = 0; i < nbblks; ++i )
+    {
+      memset( buffer.data(), 'A' + i % 26, buffer.size() );
+      writer.Write( buffer.size(), buffer.data(), nullptr );
+    }
+    XrdCl::SyncResponseHandler handler2;
+    writer.Close( &handler2 );
+    handler2.WaitForResponse();
+    status = handler2.GetStatus();
+    CPPUNIT_ASSERT_XRDST( *status );
+    delete status;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double mbytes = double( nbblks ) * buffer.size() / ( 1024 * 1024 );
+    std::cout << "\nStream write, " << limit << " blocks in flight: "
+              << mbytes / elapsed.count() << " MB/s" << std::endl;
+    CleanUp();
+  }
+  cfg.wrtinflight = wrtinflight;
+}
+
 void MicroTest::AlignedWriteRaw()
 {
   char buffer[objcfg->chunksize];
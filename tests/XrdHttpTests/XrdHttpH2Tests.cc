@@ -0,0 +1,133 @@
+#undef NDEBUG
+
+#include "XrdHttp/XrdHttpH2.hh"
+
+#include <gtest/gtest.h>
+#include <nghttp2/nghttp2.h>
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <cstring>
+#include <string>
+
+using namespace testing;
+
+// Check how HTTP/2 is recognized: by the h2c connection preface on plain
+// connections and via ALPN, offered once per server context, on TLS ones.
+
+namespace
+{
+// A server context with a throw-away self-signed certificate
+//
+SSL_CTX *ServerCtx()
+{
+  SSL_CTX      *ctx  = SSL_CTX_new(TLS_server_method());
+  EVP_PKEY_CTX *kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, 0);
+  EVP_PKEY     *pkey = 0;
+  X509         *x509 = X509_new();
+
+  EVP_PKEY_keygen_init(kctx);
+  EVP_PKEY_CTX_set_rsa_keygen_bits(kctx, 2048);
+  EVP_PKEY_keygen(kctx, &pkey);
+  EVP_PKEY_CTX_free(kctx);
+
+  X509_set_version(x509, 2);
+  ASN1_INTEGER_set(X509_get_serialNumber(x509), 1);
+  X509_gmtime_adj(X509_get_notBefore(x509), 0);
+  X509_gmtime_adj(X509_get_notAfter(x509), 3600);
+  X509_set_pubkey(x509, pkey);
+  X509_NAME_add_entry_by_txt(X509_get_subject_name(x509), "CN", MBSTRING_ASC,
+                             (const unsigned char *)"localhost", -1, -1, 0);
+  X509_set_issuer_name(x509, X509_get_subject_name(x509));
+  X509_sign(x509, pkey, EVP_sha256());
+
+  SSL_CTX_use_certificate(ctx, x509);
+  SSL_CTX_use_PrivateKey(ctx, pkey);
+  X509_free(x509);
+  EVP_PKEY_free(pkey);
+  return ctx;
+}
+
+// Run a handshake in memory and report what the server agreed to.
+// The client offers the protocols in ALPN wire format, if any.
+//
+bool Handshake(SSL_CTX *sctx, const std::string &offer)
+{
+  SSL_CTX *cctx = SSL_CTX_new(TLS_client_method());
+  SSL     *srv  = SSL_new(sctx);
+  SSL     *cli  = SSL_new(cctx);
+  BIO     *sbio, *cbio;
+  int      crc = 0, src = 0;
+
+  BIO_new_bio_pair(&sbio, 0, &cbio, 0);
+  SSL_set_bio(srv, sbio, sbio);
+  SSL_set_bio(cli, cbio, cbio);
+  SSL_set_accept_state(srv);
+  SSL_set_connect_state(cli);
+  if (offer.size())
+     SSL_set_alpn_protos(cli, (const unsigned char *)offer.data(),
+                         offer.size());
+
+  for (int i = 0; i < 100 && (crc != 1 || src != 1); i++)
+      {if (crc != 1) crc = SSL_do_handshake(cli);
+       if (src != 1) src = SSL_do_handshake(srv);
+      }
+  EXPECT_EQ(crc, 1);
+  EXPECT_EQ(src, 1);
+
+  bool isH2 = XrdHttpH2::isH2(srv);
+  SSL_free(cli);
+  SSL_free(srv);
+  SSL_CTX_free(cctx);
+  return isH2;
+}
+
+const std::string h2Only("\x02h2", 3);
+const std::string h1Only("\x08http/1.1", 9);
+const std::string h2h1 = h2Only + h1Only;
+}
+
+TEST(XrdHttpH2, Preface)
+{
+  const char *magic = NGHTTP2_CLIENT_MAGIC;
+  int         mlen  = NGHTTP2_CLIENT_MAGIC_LEN;
+  std::string data(magic, mlen);
+
+  EXPECT_EQ(XrdHttpH2::Preface(data.c_str(), mlen), 1);
+
+  data += "\x00\x00\x00\x04";
+  EXPECT_EQ(XrdHttpH2::Preface(data.c_str(), data.size()), 1);
+
+  EXPECT_EQ(XrdHttpH2::Preface(magic, 3), -1);
+  EXPECT_EQ(XrdHttpH2::Preface(magic, mlen - 1), -1);
+
+  const char *get = "GET / HTTP/1.1\r\n";
+  EXPECT_EQ(XrdHttpH2::Preface(get, strlen(get)), 0);
+  EXPECT_EQ(XrdHttpH2::Preface("PRX", 3), 0);
+}
+
+TEST(XrdHttpH2, ALPN)
+{
+  SSL_CTX *sctx = ServerCtx();
+
+  // Without the callback h2 is never agreed to
+  //
+  EXPECT_FALSE(Handshake(sctx, h2h1));
+
+  // Once offered, a client that asks for it gets it, others are unaffected
+  //
+  XrdHttpH2::SetALPN(sctx);
+  EXPECT_TRUE (Handshake(sctx, h2h1));
+  EXPECT_TRUE (Handshake(sctx, h2Only));
+  EXPECT_FALSE(Handshake(sctx, h1Only));
+  EXPECT_FALSE(Handshake(sctx, ""));
+
+  // Every later session made from the context still offers it
+  //
+  for (int i = 0; i < 4; i++) EXPECT_TRUE(Handshake(sctx, h2h1));
+
+  SSL_CTX_free(sctx);
+}
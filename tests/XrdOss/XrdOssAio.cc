@@ -0,0 +1,285 @@
+#undef NDEBUG
+
+#include <XrdSys/XrdSysIOUring.hh>
+#include <XrdSys/XrdSysPthread.hh>
+#include <gtest/gtest.h>
+
+#include <aio.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+// Compare the two ways the oss can run asynchronous reads: POSIX aio, which
+// glibc runs on a pool of helper threads, and an io_uring ring. Reads of
+// 64KB at random offsets of a cached file are kept a fixed number deep, so
+// the numbers show the cost of each engine rather than that of the disk.
+// The comparison takes a while and is disabled; run it with
+// --gtest_also_run_disabled_tests. The Check test does a few hundred reads
+// the same way to verify the data each engine returns.
+
+namespace
+{
+const size_t fileSz = 64*1024*1024;
+const size_t readSz = 64*1024;
+
+struct Request
+{
+struct aiocb      aioCB;
+std::vector<char> buff;
+off_t             offs;
+};
+
+// Everything in flight is tracked here; a completion returns its request
+// to the free list, as reads complete in any order.
+//
+struct Engine
+{
+XrdSysMutex            freeMutex;
+std::vector<Request *> freeReqs;
+XrdSysSemaphore   slots;
+XrdSysSemaphore   allDone;
+std::atomic<int>  done;
+std::atomic<int>  bad;
+int               target;
+
+Request *Get() {slots.Wait();
+                XrdSysMutexHelper mHelp(freeMutex);
+                Request *req = freeReqs.back();
+                freeReqs.pop_back();
+                return req;
+               }
+
+void     Put(Request *req) {freeMutex.Lock();
+                            freeReqs.push_back(req);
+                            freeMutex.UnLock();
+                            slots.Post();
+                           }
+
+     Engine(std::vector<Request> &reqs, int nReq)
+           : slots((int)reqs.size()), allDone(0), done(0), bad(0),
+             target(nReq)
+           {for (auto &req : reqs) freeReqs.push_back(&req);}
+};
+
+Engine *theEngine = 0;
+
+void Finished(Request *req, int result)
+{
+  Engine *eP = theEngine;
+  int target = eP->target;
+
+  if (result != (int)readSz
+  ||  memcmp(req->buff.data(), &req->offs, sizeof(req->offs))) eP->bad++;
+  eP->Put(req);
+  if (++(eP->done) == target) eP->allDone.Post();
+}
+
+void RingDone(void *cbArg, int result)
+{
+  Finished((Request *)cbArg, result);
+}
+
+void AioDone(union sigval sv)
+{
+  Request *req = (Request *)sv.sival_ptr;
+  int rc = aio_error(&req->aioCB);
+
+  Finished(req, (rc ? -rc : (int)aio_return(&req->aioCB)));
+}
+
+double ProcessCPU()
+{
+  struct rusage ru;
+
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec
+       + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+class AioBench : public Test
+{
+protected:
+
+void SetUp() override
+     {char path[] = "/tmp/XrdOssAio.XXXXXX";
+      fd = mkstemp(path);
+      ASSERT_GE(fd, 0);
+      unlink(path);
+
+      // Each read size block starts with its own offset so that every
+      // completed read can be checked.
+      //
+      std::vector<char> blk(readSz, 'a');
+      for (off_t offs = 0; offs < (off_t)fileSz; offs += readSz)
+          {memcpy(blk.data(), &offs, sizeof(offs));
+           ASSERT_EQ(pwrite(fd, blk.data(), readSz, offs), (ssize_t)readSz);
+          }
+     }
+
+void TearDown() override {close(fd);}
+
+// Run nReads reads qDepth deep; returns reads per second
+//
+double Run(XrdSysIOUring *ring, int qDepth, int nReads, double &cpu);
+
+int fd;
+};
+
+double AioBench::Run(XrdSysIOUring *ring, int qDepth, int nReads, double &cpu)
+{
+  std::vector<Request> reqs(qDepth);
+  Engine engine(reqs, nReads);
+  const int nBlks = fileSz / readSz;
+  int rc;
+
+  for (auto &req : reqs) req.buff.resize(readSz);
+  theEngine = &engine;
+  srand(17);
+
+  double c0 = ProcessCPU();
+  auto   t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < nReads; i++)
+      {Request *req = engine.Get();
+       req->offs = (off_t)(rand() % nBlks) * readSz;
+       memset(req->buff.data(), 0, sizeof(req->offs));
+       if (ring)
+          {while((rc = ring->Submit(XrdSysIOUring::opRead, fd,
+                                    req->buff.data(), readSz, req->offs,
+                                    RingDone, req)) == EAGAIN) usleep(10);
+          } else {
+           memset(&req->aioCB, 0, sizeof(req->aioCB));
+           req->aioCB.aio_fildes = fd;
+           req->aioCB.aio_buf    = req->buff.data();
+           req->aioCB.aio_nbytes = readSz;
+           req->aioCB.aio_offset = req->offs;
+           req->aioCB.aio_sigevent.sigev_notify          = SIGEV_THREAD;
+           req->aioCB.aio_sigevent.sigev_notify_function = AioDone;
+           req->aioCB.aio_sigevent.sigev_value.sival_ptr = req;
+           while((rc = aio_read(&req->aioCB)) && errno == EAGAIN) usleep(10);
+           if (rc) rc = errno;
+          }
+       if (rc) {ADD_FAILURE() << "submit failed; " << strerror(rc);
+                Finished(req, -rc);
+               }
+      }
+  engine.allDone.Wait();
+  double wall = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - t0).count();
+  cpu = ProcessCPU() - c0;
+  theEngine = 0;
+
+  EXPECT_EQ(engine.bad.load(), 0);
+  return nReads / wall;
+}
+}
+
+TEST_F(AioBench, Check)
+{
+  const char *eTxt = "";
+  XrdSysIOUring ring(1, 16);
+  double cpu;
+
+  Run(0, 8, 256, cpu);
+  if (ring.Init(eTxt)) return;
+  Run(&ring, 8, 256, cpu);
+  ring.Stop();
+}
+
+TEST_F(AioBench, DISABLED_Reads)
+{
+  const int qDepths[] = {1, 8, 32};
+  const int nReads    = 20000;
+  const char *eTxt = "";
+  XrdSysIOUring ring(1, 128);
+  bool hasRing = ring.Init(eTxt) == 0;
+
+  if (!hasRing) printf("io_uring is not available (%s); aio only\n", eTxt);
+
+  for (int qd : qDepths)
+      {double aioCPU, ringCPU = 0, ringRate = 0;
+       double aioRate = Run(0, qd, nReads, aioCPU);
+       if (hasRing) ringRate = Run(&ring, qd, nReads, ringCPU);
+       printf("depth %2d: aio %8.0f reads/s %5.1f cpu us/read, "
+              "io_uring %8.0f reads/s %5.1f cpu us/read\n", qd,
+              aioRate, aioCPU*1e6/nReads, ringRate, ringCPU*1e6/nReads);
+      }
+
+  if (hasRing) ring.Stop();
+}
+
+namespace
+{
+// Return the descriptor of the (only) io_uring instance of the process
+//
+int RingFD()
+{
+  DIR *dir = opendir("/proc/self/fd");
+  struct dirent *dent;
+  char link[256];
+  int fd = -1;
+
+  while(dir && (dent = readdir(dir)))
+       {std::string path = std::string("/proc/self/fd/") + dent->d_name;
+        ssize_t n = readlink(path.c_str(), link, sizeof(link)-1);
+        if (n <= 0) continue;
+        link[n] = 0;
+        if (strstr(link, "io_uring")) {fd = atoi(dent->d_name); break;}
+       }
+  if (dir) closedir(dir);
+  return fd;
+}
+
+void NeverCalled(void *cbArg, int result)
+{
+  (*(std::atomic<int> *)cbArg)++;
+}
+}
+
+TEST(XrdSysIOUring, RefusedSubmit)
+{
+  const char *eTxt = "";
+  XrdSysIOUring ring(1, 8);
+  if (ring.Init(eTxt)) GTEST_SKIP() << "io_uring not available";
+
+  int ringFD = RingFD(), saveFD, rc;
+  ASSERT_GE(ringFD, 0);
+  ASSERT_GE((saveFD = dup(ringFD)), 0);
+
+  // Replace the ring's descriptor with one that is not a ring so that the
+  // kernel refuses every submission. The request must fail and its callback
+  // must never be called.
+  //
+  char buff[16];
+  std::atomic<int> calls(0);
+  int fd = open("/dev/zero", O_RDONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(dup2(fd, ringFD), ringFD);
+  rc = ring.Submit(XrdSysIOUring::opRead, fd, buff, sizeof(buff), 0,
+                   NeverCalled, &calls);
+  EXPECT_NE(rc, 0);
+  EXPECT_NE(rc, EAGAIN);
+
+  long long reqs, full, ncalls, fails;
+  ring.Stats(reqs, full, ncalls, fails);
+  EXPECT_EQ(fails, 1);
+
+  // Put the ring back; the withdrawn request is then consumed as a no-op
+  //
+  ASSERT_EQ(dup2(saveFD, ringFD), ringFD);
+  close(saveFD);
+  ring.Stop();
+  EXPECT_EQ(calls.load(), 0);
+  close(fd);
+}
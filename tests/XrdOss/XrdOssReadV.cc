@@ -0,0 +1,150 @@
+#undef NDEBUG
+
+#include <XrdOss/XrdOssReadV.hh>
+#include <XrdOuc/XrdOucIOVec.hh>
+#include <XrdSys/XrdSysIOUring.hh>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+using namespace testing;
+
+// Check that merged vector reads return exactly what reading each segment by
+// itself would, whatever the order, spacing, and overlap of the segments.
+
+namespace
+{
+class XrdOssReadVTest : public Test
+{
+protected:
+  void SetUp() override
+  {
+    char path[] = "/tmp/XrdOssReadV.XXXXXX";
+    fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    unlink(path);
+    data.resize(fSize);
+    srand(1234);
+    for (auto &c : data) c = static_cast<char>(rand());
+    ASSERT_EQ(write(fd, data.data(), fSize), (ssize_t)fSize);
+  }
+
+  void TearDown() override { if (fd >= 0) close(fd); }
+
+  // Build segments of random sizes, some abutting, some overlapping, some far
+  // apart, and return them in a random order.
+  //
+  void MakeVec(int n)
+  {
+    long long offs = 0;
+    segs.clear();
+    for (int i = 0; i < n; i++)
+    {
+      int sz = 1 + rand() % 20000;
+      switch (rand() % 4)
+      {
+        case 0:  break;                                // abuts
+        case 1:  offs += rand() % 4096; break;         // small gap
+        case 2:  offs -= rand() % 2048; break;         // overlaps
+        default: offs += 100000 + rand() % 100000;     // far away
+      }
+      if (offs < 0) offs = 0;
+      if (offs + sz > fSize) offs = rand() % (fSize - sz);
+      segs.push_back({offs, sz});
+      offs += sz;
+    }
+    for (int i = n - 1; i > 0; i--) std::swap(segs[i], segs[rand() % (i + 1)]);
+  }
+
+  void Check(XrdOssReadV &rv, bool withEmpty = false)
+  {
+    std::vector<std::vector<char>> bufs(segs.size());
+    std::vector<XrdOucIOVec> iov(segs.size());
+    long long total = 0;
+    for (size_t i = 0; i < segs.size(); i++)
+    {
+      int sz = (withEmpty && i % 7 == 3 ? 0 : segs[i].second);
+      bufs[i].assign(sz + 1, 0);
+      iov[i].offset = segs[i].first;
+      iov[i].size   = sz;
+      iov[i].info   = 0;
+      iov[i].data   = bufs[i].data();
+      total += sz;
+    }
+    ASSERT_EQ(rv.Read(fd, iov.data(), iov.size()), total);
+    for (size_t i = 0; i < segs.size(); i++)
+    {
+      ASSERT_EQ(memcmp(bufs[i].data(), data.data() + iov[i].offset,
+                       iov[i].size), 0) << "segment " << i;
+      ASSERT_EQ(bufs[i][iov[i].size], 0) << "segment " << i << " overrun";
+    }
+  }
+
+  static const long long fSize = 8 * 1024 * 1024;
+  int fd = -1;
+  std::vector<char> data;
+  std::vector<std::pair<long long, int>> segs;
+};
+}
+
+TEST_F(XrdOssReadVTest, Merged)
+{
+  XrdOssReadV rv(4096, 1024 * 1024);
+  for (int pass = 0; pass < 20; pass++)
+  {
+    MakeVec(1 + rand() % 1024);
+    Check(rv, pass & 1);
+  }
+}
+
+TEST_F(XrdOssReadVTest, AbuttingOnly)
+{
+  XrdOssReadV rv(0, 1024 * 1024);
+  long long vecs, reqs;
+
+  // Sixteen abutting 4K segments given backwards need only one read
+  //
+  segs.clear();
+  for (int i = 15; i >= 0; i--) segs.push_back({4096LL * i, 4096});
+  Check(rv);
+  rv.Stats(vecs, reqs);
+  EXPECT_EQ(vecs, 1);
+  EXPECT_EQ(reqs, 1);
+
+  MakeVec(500);
+  Check(rv);
+}
+
+TEST_F(XrdOssReadVTest, PastEOF)
+{
+  XrdOssReadV rv(4096, 1024 * 1024);
+  std::vector<char> b1(100), b2(100);
+  XrdOucIOVec iov[2] = {{fSize - 50, 100, 0, b1.data()},
+                        {fSize - 200, 100, 0, b2.data()}};
+
+  EXPECT_EQ(rv.Read(fd, iov, 2), -ESPIPE);
+  iov[0].offset = fSize - 100;
+  EXPECT_EQ(rv.Read(fd, iov, 2), 200);
+  EXPECT_EQ(rv.Read(-1, iov, 2), -EBADF);
+}
+
+TEST_F(XrdOssReadVTest, IOUring)
+{
+  XrdSysIOUring ring(1, 8);
+  const char *eTxt;
+  if (ring.Init(eTxt)) GTEST_SKIP() << "io_uring not available";
+
+  // A small ring makes some reads spill over to being done synchronously
+  //
+  XrdOssReadV rv(1024, 64 * 1024, &ring);
+  for (int pass = 0; pass < 20; pass++)
+  {
+    MakeVec(1 + rand() % 1024);
+    Check(rv, pass & 1);
+  }
+  ring.Stop();
+}
@@ -0,0 +1,136 @@
+#undef NDEBUG
+
+#include <XrdOuc/XrdOucCRC.hh>
+#include <XrdOuc/XrdOucCRC32C.hh>
+#include <XrdSys/XrdSysPageSize.hh>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace testing;
+
+// Cross-check the hardware assisted (and multi-page) CRC32C paths against
+// the portable software implementation. PagesBench, which times a page at a
+// time against several at once, is disabled; run it with
+// --gtest_also_run_disabled_tests.
+
+class CRC32CTest : public ::testing::Test {};
+
+namespace
+{
+std::vector<unsigned char> RandomData(size_t len, unsigned int seed)
+{
+  std::vector<unsigned char> data(len);
+  srand(seed);
+  for (auto &c : data) c = (unsigned char)(rand() & 0xff);
+  return data;
+}
+}
+
+TEST(CRC32CTest, KnownValue)
+{
+  // The standard check value for CRC-32C
+  EXPECT_EQ(crc32c(0, "123456789", 9), 0xe3069283u);
+  EXPECT_EQ(crc32c_sw(0, "123456789", 9), 0xe3069283u);
+}
+
+TEST(CRC32CTest, SingleBuffer)
+{
+  auto data = RandomData(3*8192 + 1000, 1);
+
+  // Vary the length and the alignment to exercise all of the code paths
+  for (size_t offs : { 0, 1, 3, 7 }) {
+    for (size_t len : { 0, 1, 7, 8, 255, 768, 4095, 4096, 8193, 3*8192 }) {
+      EXPECT_EQ(crc32c(0, data.data() + offs, len),
+                crc32c_sw(0, data.data() + offs, len))
+        << "offs " << offs << " len " << len;
+    }
+  }
+}
+
+TEST(CRC32CTest, Pages)
+{
+  const size_t pgsz = XrdSys::PageSize;
+  auto data = RandomData(17*pgsz + 8, 2);
+
+  for (size_t offs : { 0, 4, 8 }) {
+    for (size_t npages = 0; npages <= 17; npages++) {
+      std::vector<uint32_t> crcs(npages + 1, 0xdeadbeef);
+      crc32c_pages(data.data() + offs, pgsz, npages, crcs.data());
+      for (size_t i = 0; i < npages; i++)
+        EXPECT_EQ(crcs[i], crc32c_sw(0, data.data() + offs + i*pgsz, pgsz))
+          << "offs " << offs << " page " << i << " of " << npages;
+      EXPECT_EQ(crcs[npages], 0xdeadbeef);
+    }
+  }
+
+  // Page sizes that are not a multiple of eight take the serial path
+  std::vector<uint32_t> crcs(5);
+  crc32c_pages(data.data(), 1001, 5, crcs.data());
+  for (size_t i = 0; i < 5; i++)
+    EXPECT_EQ(crcs[i], crc32c_sw(0, data.data() + i*1001, 1001));
+}
+
+TEST(CRC32CTest, PageVerify)
+{
+  const size_t pgsz = XrdSys::PageSize;
+  const size_t len  = 40*pgsz + 100;
+  const int    npg  = 41;
+  auto data = RandomData(len, 3);
+
+  std::vector<uint32_t> csval(npg), valcs(npg);
+  XrdOucCRC::Calc32C(data.data(), len, csval.data());
+  for (int i = 0; i < npg; i++)
+    EXPECT_EQ(csval[i], crc32c_sw(0, data.data() + i*pgsz,
+                                  (i < npg-1 ? pgsz : len - i*pgsz)));
+
+  uint32_t badcs = 0;
+  EXPECT_EQ(XrdOucCRC::Ver32C(data.data(), len, csval.data(), badcs), -1);
+  EXPECT_TRUE(XrdOucCRC::Ver32C(data.data(), len, csval.data(), valcs.data()));
+
+  // Corrupt pages on either side of a verification batch boundary
+  for (int bad : { 0, 31, 32, 40 }) {
+    std::vector<uint32_t> wrong(csval);
+    wrong[bad] ^= 1;
+    EXPECT_EQ(XrdOucCRC::Ver32C(data.data(), len, wrong.data(), badcs), bad);
+    EXPECT_EQ(badcs, csval[bad]);
+
+    std::unique_ptr<bool[]> valok(new bool[npg]);
+    EXPECT_FALSE(XrdOucCRC::Ver32C(data.data(), len, wrong.data(), valok.get()));
+    for (int i = 0; i < npg; i++) EXPECT_EQ(valok[i], i != bad);
+  }
+}
+
+TEST(CRC32CTest, DISABLED_PagesBench)
+{
+  const size_t pgsz   = XrdSys::PageSize;
+  const size_t npages = 256;
+  const int    nIters = 200;
+  auto data = RandomData(npages*pgsz, 4);
+  std::vector<uint32_t> crc1(npages), crc2(npages);
+
+  // Time one page at a time, as pgread and pgwrite used to do, against all
+  // of the pages at once.
+  //
+  auto t0 = std::chrono::steady_clock::now();
+  for (int j = 0; j < nIters; j++)
+    for (size_t i = 0; i < npages; i++)
+      crc1[i] = crc32c(0, data.data() + i*pgsz, pgsz);
+  auto t1 = std::chrono::steady_clock::now();
+  for (int j = 0; j < nIters; j++)
+    crc32c_pages(data.data(), pgsz, npages, crc2.data());
+  auto t2 = std::chrono::steady_clock::now();
+  EXPECT_EQ(crc1, crc2);
+
+  double mb     = double(nIters) * npages * pgsz / (1024*1024);
+  double single = std::chrono::duration<double>(t1 - t0).count();
+  double multi  = std::chrono::duration<double>(t2 - t1).count();
+  printf("%zu byte pages: %8.1f MB/s one page at a time, "
+         "%8.1f MB/s several pages at a time\n",
+         pgsz, mb / single, mb / multi);
+}
@@ -0,0 +1,211 @@
+#undef NDEBUG
+
+#include <XrdSys/XrdSysPthread.hh>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace testing;
+
+// Time file opens and closes against the table of active files of the cache
+// with the locking that Cache::GetFile() and Cache::ReleaseFile() do: an open
+// inserts a placeholder, opens the file without the lock and then publishes
+// it; a close drops the reference and removes the last one, recording its
+// stats under the cache-wide lock. The single std::map is the table before it
+// was split into shards. Setting up a whole Cache needs a configured oss and
+// remote origin, so only the table is used here. OpenClose checks the sharing
+// of open files; the timing is disabled and is run with
+// --gtest_also_run_disabled_tests.
+
+namespace
+{
+struct ActiveFile
+{
+int refCnt;
+
+    ActiveFile() : refCnt(0) {}
+};
+
+template<class Map>
+class ActiveTable
+{
+public:
+
+ActiveFile *Open(const std::string &path)
+{
+  Shard &shard = ShardOf(path);
+  typename Map::iterator it;
+
+  {XrdSysCondVarHelper lock(&shard.cond);
+   while(true)
+        {it = shard.map.find(path);
+         if (it == shard.map.end())
+            {it = shard.map.insert(std::make_pair(path, (ActiveFile *)0)).first;
+             break;
+            }
+         if (it->second) {it->second->refCnt++; return it->second;}
+         shard.cond.Wait();
+        }
+  }
+
+  ActiveFile *file = new ActiveFile;
+
+  {XrdSysCondVarHelper lock(&shard.cond);
+   file->refCnt++;
+   it->second = file;
+   shard.cond.Broadcast();
+  }
+  return file;
+}
+
+void Close(const std::string &path, ActiveFile *file)
+{
+  Shard &shard = ShardOf(path);
+  XrdSysCondVarHelper lock(&shard.cond);
+
+  if (--file->refCnt == 0)
+     {shard.map.erase(path);
+      XrdSysCondVarHelper lockStats(&statsCond);
+      nClosed++;
+      delete file;
+     }
+}
+
+long long Closed() {XrdSysCondVarHelper lock(&statsCond); return nClosed;}
+
+size_t    Size() {size_t n = 0;
+                  for (auto &shard : shards) n += shard.map.size();
+                  return n;
+                 }
+
+          ActiveTable(int nShards) : shards(nShards), statsCond(0), nClosed(0) {}
+
+private:
+
+struct Shard
+{
+XrdSysCondVar cond;
+Map           map;
+
+              Shard() : cond(0) {}
+};
+
+Shard &ShardOf(const std::string &path)
+      {return shards[std::hash<std::string>()(path) & (shards.size() - 1)];}
+
+std::vector<Shard> shards;
+XrdSysCondVar      statsCond;
+long long          nClosed;
+};
+
+typedef ActiveTable<std::map<std::string, ActiveFile *>>           OldTable;
+typedef ActiveTable<std::unordered_map<std::string, ActiveFile *>> ShardTable;
+
+// Each thread opens and closes nOps random files out of the paths, keeping
+// a few open at any time; returns opens per second
+//
+template<class Table>
+double Opens(Table &table, const std::vector<std::string> &paths,
+             int nThreads, int nOps)
+{
+  const int nOpen = 4;
+  std::vector<std::thread> threads;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int t = 0; t < nThreads; t++)
+      threads.emplace_back([&, t]
+         {unsigned int seed = t + 1;
+          std::vector<std::pair<const std::string *, ActiveFile *>> open;
+          for (int i = 0; i < nOps; i++)
+              {const std::string &path = paths[rand_r(&seed) % paths.size()];
+               open.emplace_back(&path, table.Open(path));
+               if ((int)open.size() == nOpen)
+                  {for (auto &f : open) table.Close(*f.first, f.second);
+                   open.clear();
+                  }
+              }
+          for (auto &f : open) table.Close(*f.first, f.second);
+         });
+  for (auto &t : threads) t.join();
+
+  EXPECT_EQ(table.Size(), 0u);
+  return nThreads * nOps / std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - t0).count();
+}
+}
+
+namespace
+{
+std::vector<std::string> MakePaths(int n)
+{
+  std::vector<std::string> paths;
+  char buff[64];
+
+  for (int i = 0; i < n; i++)
+      {snprintf(buff, sizeof(buff), "/store/data/run%03d/file%05d.root",
+                i % 100, i);
+       paths.push_back(buff);
+      }
+  return paths;
+}
+}
+
+TEST(XrdPfcActiveShards, OpenClose)
+{
+  ShardTable table(16);
+
+  // Opens of the same path share the file until the last close
+  //
+  ActiveFile *f1 = table.Open("/store/a"), *f2 = table.Open("/store/a");
+  ActiveFile *f3 = table.Open("/store/b");
+  EXPECT_EQ(f1, f2);
+  EXPECT_NE(f1, f3);
+  EXPECT_EQ(f1->refCnt, 2);
+  EXPECT_EQ(table.Size(), 2u);
+  table.Close("/store/a", f1);
+  EXPECT_EQ(table.Size(), 2u);
+  EXPECT_EQ(table.Closed(), 0);
+  table.Close("/store/a", f2);
+  table.Close("/store/b", f3);
+  EXPECT_EQ(table.Size(), 0u);
+  EXPECT_EQ(table.Closed(), 2);
+
+  // Threads opening and closing a few paths leave nothing behind
+  //
+  std::vector<std::string> paths = MakePaths(8);
+  Opens(table, paths, 4, 2000);
+}
+
+TEST(XrdPfcActiveShards, DISABLED_OpenBench)
+{
+  const int nShards[]  = {1, 16, 64};
+  const int nThreads[] = {1, 16, 64};
+  const int nTotal     = 256000;
+  std::vector<std::string> paths = MakePaths(16384);
+
+  for (int nt : nThreads)
+      {OldTable old(1);
+       double rate = 0;
+       for (int r = 0; r < 3; r++)
+           rate = std::max(rate, Opens(old, paths, nt, nTotal/nt));
+       printf("%2d threads: std::map %9.0f opens/s", nt, rate);
+
+       for (int ns : nShards)
+           {ShardTable table(ns);
+            rate = 0;
+            for (int r = 0; r < 3; r++)
+                rate = std::max(rate, Opens(table, paths, nt, nTotal/nt));
+            printf(", %2d shards %9.0f", ns, rate);
+           }
+       printf("\n");
+      }
+}
@@ -0,0 +1,160 @@
+#undef NDEBUG
+
+#include <XrdPfc/XrdPfcBlockIndex.hh>
+#include <XrdPfc/XrdPfcFile.hh>
+#include <XrdSys/XrdSysPthread.hh>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace XrdPfc;
+
+// Check the flat block index of a cached file against std::map, which it
+// replaced. The disabled ReadVBench test times both for the lookups a vector
+// read does on a hot file: every read takes the file's state lock once and
+// finds each of its blocks, as File::ReadOpusCoalescere() does. File::ReadV()
+// itself is not timed as a File can only be opened through a configured Cache
+// with its oss, and ReadV() on fully cached data is a plain oss read that no
+// lookup is done for. Run it with --gtest_also_run_disabled_tests.
+
+namespace
+{
+const long long blockSz = 1024*1024;
+
+std::vector<Block*> MakeBlocks(int n)
+{
+  std::vector<Block*> blocks;
+  for (int i = 0; i < n; i++)
+      blocks.push_back(new Block(0, 0, 0, 0, i*blockSz, blockSz, blockSz,
+                                 false, false));
+  return blocks;
+}
+
+void FreeBlocks(std::vector<Block*> &blocks)
+{
+  for (auto b : blocks) delete b;
+  blocks.clear();
+}
+
+// The two indexes with the same interface
+//
+struct MapIndex
+{
+std::map<int, Block*> theMap;
+
+Block *find(int idx) const
+       {auto it = theMap.find(idx);
+        return (it == theMap.end() ? nullptr : it->second);
+       }
+void   insert(int idx, Block *b) {theMap[idx] = b;}
+};
+
+// Run nReads vector reads of nChunks chunks spread over the file from each
+// of nThreads threads; returns vector reads per second
+//
+template<class Index>
+double ReadVs(Index &index, int nBlocks, int nThreads, int nReads, int nChunks)
+{
+  XrdSysCondVar stateCond(0);
+  std::vector<std::thread> readers;
+  std::vector<int> misses(nThreads, 0);
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int t = 0; t < nThreads; t++)
+      readers.emplace_back([&, t]
+         {unsigned int seed = t + 1;
+          std::vector<int> idx(nChunks);
+          for (int r = 0; r < nReads; r++)
+              {for (auto &i : idx) i = rand_r(&seed) % nBlocks;
+               XrdSysCondVarHelper lock(&stateCond);
+               for (int i : idx)
+                   {Block *b = index.find(i);
+                    if (b) b->m_refcnt++;
+                       else misses[t]++;
+                   }
+               for (int i : idx) index.find(i)->m_refcnt--;
+              }
+         });
+  for (auto &t : readers) t.join();
+  double wall = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - t0).count();
+
+  for (int m : misses) EXPECT_EQ(m, 0);
+  return nThreads * nReads / wall;
+}
+}
+
+TEST(XrdPfcBlockIndex, MatchesMap)
+{
+  std::vector<Block*> blocks = MakeBlocks(4096);
+  std::map<int, Block*> ref;
+  BlockIndex index;
+
+  // Random inserts and erases over a key range small enough that probe
+  // chains run into each other and deletions have to shift entries back
+  //
+  srand(21);
+  for (int n = 0; n < 200000; n++)
+      {int idx = rand() % (int)blocks.size();
+       if (rand() % 3)
+          {index.insert(idx, blocks[idx]);
+           ref[idx] = blocks[idx];
+          } else {
+           EXPECT_EQ(index.erase(idx), ref.erase(idx) == 1) << "idx=" << idx;
+          }
+       EXPECT_EQ(index.size(), (int)ref.size());
+
+       if (n % 10000 == 0)
+          for (int i = 0; i < (int)blocks.size(); i++)
+              {auto it = ref.find(i);
+               EXPECT_EQ(index.find(i), (it == ref.end() ? nullptr : it->second))
+                         << "idx=" << i;
+              }
+      }
+
+  while(!ref.empty())
+       {EXPECT_TRUE(index.erase(ref.begin()->first));
+        ref.erase(ref.begin());
+       }
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.find(0), nullptr);
+  FreeBlocks(blocks);
+}
+
+TEST(XrdPfcBlockIndex, DISABLED_ReadVBench)
+{
+  const int nBlocks   = 1024;
+  const int nChunks   = 16;
+  const int nThreads[] = {1, 16, 64};
+  const int nTotal    = 200000;
+
+  std::vector<Block*> blocks = MakeBlocks(nBlocks);
+  MapIndex   mapIndex;
+  BlockIndex flatIndex;
+  for (int i = 0; i < nBlocks; i++)
+      {mapIndex.insert(i, blocks[i]);
+       flatIndex.insert(i, blocks[i]);
+      }
+
+  for (int nt : nThreads)
+      {double mapRate = 0, flatRate = 0;
+       for (int r = 0; r < 3; r++)
+           {mapRate  = std::max(mapRate,
+                       ReadVs(mapIndex,  nBlocks, nt, nTotal/nt, nChunks));
+            flatRate = std::max(flatRate,
+                       ReadVs(flatIndex, nBlocks, nt, nTotal/nt, nChunks));
+           }
+       printf("%2d threads: std::map %9.0f readv/s, BlockIndex %9.0f readv/s "
+              "(%d chunks each)\n", nt, mapRate, flatRate, nChunks);
+      }
+
+  for (auto b : blocks) EXPECT_EQ(b->m_refcnt, 0);
+  FreeBlocks(blocks);
+}
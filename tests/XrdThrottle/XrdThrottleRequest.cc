@@ -0,0 +1,154 @@
+#undef NDEBUG
+
+#include <Xrd/XrdScheduler.hh>
+#include <XrdOuc/XrdOucTrace.hh>
+#include <XrdSys/XrdSysError.hh>
+#include <XrdSys/XrdSysPthread.hh>
+#include <XrdThrottle/XrdThrottleManager.hh>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+// Check the asynchronous mode of the throttle: a request that can be admitted
+// is done on the submitting thread, one over the concurrency limit is parked
+// without blocking the submitter, and parked requests are handed to the
+// scheduler, in the order submitted, as the IOs ahead of them complete. The
+// recompute thread is not started (Init() is not called) so only completing
+// IOs dispatch parked requests; that keeps the order deterministic.
+
+namespace
+{
+XrdSysError eDest(0, "throttle_");
+XrdOucTrace trace(&eDest);
+
+// What the requests did, in the order they did it
+//
+struct Record
+{
+std::mutex                   mtx;
+std::condition_variable      cv;
+std::vector<int>             order;
+std::vector<std::thread::id> tids;
+int                          running = 0;
+int                          maxRunning = 0;
+int                          done = 0;
+
+// Wait until pred() is true; returns false after ten seconds
+//
+template<class Pred>
+bool WaitFor(Pred pred)
+     {std::unique_lock<std::mutex> lock(mtx);
+      return cv.wait_for(lock, std::chrono::seconds(10), pred);
+     }
+};
+
+class TestRequest : public XrdThrottleRequest
+{
+public:
+
+void DoIO() override
+     {{std::lock_guard<std::mutex> lock(rec.mtx);
+       rec.order.push_back(id);
+       rec.tids.push_back(std::this_thread::get_id());
+       if (++rec.running > rec.maxRunning) rec.maxRunning = rec.running;
+       rec.cv.notify_all();
+      }
+      if (gate) gate->Wait();
+      std::lock_guard<std::mutex> lock(rec.mtx);
+      rec.running--;
+     }
+
+void Done() override
+     {std::lock_guard<std::mutex> lock(rec.mtx);
+      rec.done++;
+      rec.cv.notify_all();
+     }
+
+     TestRequest(XrdThrottleManager &mgr, Record &rec, int id,
+                 XrdSysSemaphore *gate = 0)
+                : XrdThrottleRequest(mgr, 4096, 1, 0),
+                  rec(rec), id(id), gate(gate) {}
+
+private:
+Record          &rec;
+int              id;
+XrdSysSemaphore *gate;
+};
+
+XrdScheduler *Scheduler()
+{
+  // The scheduler has no way to stop its threads; it is left running.
+  static XrdScheduler *sched = 0;
+
+  if (!sched) {sched = new XrdScheduler(2, 4, 0); sched->Start();}
+  return sched;
+}
+}
+
+TEST(XrdThrottleRequest, Admit)
+{
+  XrdThrottleManager mgr(&eDest, &trace);
+  Record rec;
+
+  // With no limits every request is admitted and done before Submit() returns
+  //
+  mgr.SetThrottles(-1, -1, -1, 1.0);
+  mgr.SetAsync(true);
+  mgr.SetScheduler(Scheduler());
+  ASSERT_TRUE(mgr.IsAsync());
+
+  for (int i = 0; i < 3; i++)
+      {mgr.Submit(new TestRequest(mgr, rec, i));
+       EXPECT_EQ(rec.done, i+1);
+      }
+  EXPECT_EQ(rec.order, std::vector<int>({0, 1, 2}));
+  for (auto &tid : rec.tids) EXPECT_EQ(tid, std::this_thread::get_id());
+}
+
+TEST(XrdThrottleRequest, ParkAndDispatch)
+{
+  XrdThrottleManager mgr(&eDest, &trace);
+  XrdSysSemaphore gate(0);
+  Record rec;
+  const int nParked = 4;
+
+  // The limit is compared with the number of IOs already in progress, as
+  // StartIOTimer() does, so a limit of 0 lets one IO run at a time
+  //
+  mgr.SetThrottles(-1, -1, 0, 1.0);
+  mgr.SetAsync(true);
+  mgr.SetScheduler(Scheduler());
+
+  // The first request takes the only slot and holds it until the gate opens
+  //
+  std::thread first([&] {mgr.Submit(new TestRequest(mgr, rec, 0, &gate));});
+  ASSERT_TRUE(rec.WaitFor([&] {return rec.running == 1;}));
+
+  // The rest are parked; Submit() must not wait for the slot
+  //
+  for (int i = 1; i <= nParked; i++) mgr.Submit(new TestRequest(mgr, rec, i));
+  {std::lock_guard<std::mutex> lock(rec.mtx);
+   EXPECT_EQ(rec.order.size(), 1u);
+   EXPECT_EQ(rec.done, 0);
+  }
+
+  // Completing the first IO lets the parked ones run one at a time, in order,
+  // on the scheduler's threads
+  //
+  gate.Post();
+  first.join();
+  ASSERT_TRUE(rec.WaitFor([&] {return rec.done == nParked+1;}));
+
+  std::vector<int> want;
+  for (int i = 0; i <= nParked; i++) want.push_back(i);
+  EXPECT_EQ(rec.order, want);
+  EXPECT_EQ(rec.maxRunning, 1);
+  for (int i = 1; i <= nParked; i++)
+      EXPECT_NE(rec.tids[i], std::this_thread::get_id()) << "request " << i;
+}
@@ -0,0 +1,245 @@
+#undef NDEBUG
+
+#include <string>
+
+#include <XrdTls/XrdTlsContext.hh>
+#include <XrdTls/XrdTlsSocket.hh>
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+// Send a file over a loopback TLS connection, once the way TLS links did
+// before kernel TLS (pread() into a buffer then SSL_write()) and once with
+// SendFile() on a kTLS enabled socket, and compare the throughput and the
+// cpu time of the sender. Without kernel support (the "tls" TCP ULP) kTLS
+// is never negotiated and only the first is run. The Transfer test sends a
+// small file both ways and checks what arrives; the timed sends of a larger
+// file are disabled and are run with --gtest_also_run_disabled_tests.
+
+namespace
+{
+class TlsBench : public Test
+{
+protected:
+
+void SetUp() override
+     {char tmpl[] = "/tmp/xrdtls-bench.XXXXXX";
+      ASSERT_TRUE(mkdtemp(tmpl));
+      dir = tmpl;
+      certFN = dir + "/cert.pem"; keyFN = dir + "/key.pem";
+      dataFN = dir + "/data";
+      ASSERT_TRUE(MakeCert());
+     }
+
+void TearDown() override
+     {unlink(certFN.c_str()); unlink(keyFN.c_str()); unlink(dataFN.c_str());
+      rmdir(dir.c_str());
+     }
+
+bool MakeCert();
+
+// Write a data file of fileSz bytes
+//
+void MakeData(size_t fileSz);
+
+// Send the data file nRounds times to a client that checks what it gets,
+// with SendFile() when ktls is set; the rate is printed when report is set.
+//
+void Send(bool ktls, size_t fileSz, int nRounds, bool report);
+
+std::string dir, certFN, keyFN, dataFN;
+};
+
+bool TlsBench::MakeCert()
+{
+  EVP_PKEY_CTX *kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, 0);
+  EVP_PKEY     *pkey = 0;
+  X509         *x509 = X509_new();
+  FILE         *fp   = 0;
+  bool aOK;
+
+  EVP_PKEY_keygen_init(kctx);
+  EVP_PKEY_CTX_set_rsa_keygen_bits(kctx, 2048);
+  EVP_PKEY_keygen(kctx, &pkey);
+  EVP_PKEY_CTX_free(kctx);
+
+  X509_set_version(x509, 2);
+  ASN1_INTEGER_set(X509_get_serialNumber(x509), 1);
+  X509_gmtime_adj(X509_get_notBefore(x509), 0);
+  X509_gmtime_adj(X509_get_notAfter(x509), 3600);
+  X509_set_pubkey(x509, pkey);
+  X509_NAME_add_entry_by_txt(X509_get_subject_name(x509), "CN", MBSTRING_ASC,
+                             (const unsigned char *)"localhost", -1, -1, 0);
+  X509_set_issuer_name(x509, X509_get_subject_name(x509));
+  X509_sign(x509, pkey, EVP_sha256());
+
+  // The key may only be readable by its owner
+  //
+  int fd = open(keyFN.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0600);
+  aOK = fd >= 0 && (fp = fdopen(fd, "w"))
+     && PEM_write_PrivateKey(fp, pkey, 0, 0, 0, 0, 0);
+  if (fp) fclose(fp);
+     else if (fd >= 0) close(fd);
+  if (aOK && (aOK = (fp = fopen(certFN.c_str(), "w"))))
+     {aOK = PEM_write_X509(fp, x509) != 0;
+      fclose(fp);
+     }
+  X509_free(x509);
+  EVP_PKEY_free(pkey);
+  return aOK;
+}
+
+double ThreadCPU()
+{
+  struct rusage ru;
+
+  getrusage(RUSAGE_THREAD, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec
+       + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+void Loopback(int &sFD, int &cFD)
+{
+  struct sockaddr_in addr = {};
+  socklen_t alen = sizeof(addr);
+  int lFD = socket(AF_INET, SOCK_STREAM, 0);
+
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(lFD, (struct sockaddr *)&addr, sizeof(addr));
+  listen(lFD, 1);
+  getsockname(lFD, (struct sockaddr *)&addr, &alen);
+  cFD = socket(AF_INET, SOCK_STREAM, 0);
+  connect(cFD, (struct sockaddr *)&addr, sizeof(addr));
+  sFD = accept(lFD, 0, 0);
+  close(lFD);
+}
+}
+
+void TlsBench::MakeData(size_t fileSz)
+{
+  std::vector<char> buff(1024*1024, 'k');
+  int fd = open(dataFN.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0600);
+  ASSERT_GE(fd, 0);
+  for (size_t i = 0; i < fileSz/buff.size(); i++)
+      ASSERT_EQ(write(fd, buff.data(), buff.size()), (ssize_t)buff.size());
+  close(fd);
+}
+
+void TlsBench::Send(bool ktls, size_t fileSz, int nRounds, bool report)
+{
+  const double gBytes = double(fileSz) * nRounds / (1024*1024*1024);
+  std::string eMsg;
+
+  XrdTlsContext cCtx(0, 0, 0, certFN.c_str(), 0, &eMsg);
+  ASSERT_TRUE(cCtx.isOK()) << eMsg;
+
+  uint64_t opts = XrdTlsContext::servr | (ktls ? XrdTlsContext::ktlsON : 0);
+  XrdTlsContext sCtx(certFN.c_str(), keyFN.c_str(), 0, 0, opts, &eMsg);
+  ASSERT_TRUE(sCtx.isOK()) << eMsg;
+
+  int sFD, cFD;
+  Loopback(sFD, cFD);
+  XrdTlsSocket sSock(sCtx, sFD, XrdTlsSocket::TLS_RBL_WBL,
+                     XrdTlsSocket::TLS_HS_BLOCK, false);
+  XrdTlsSocket cSock(cCtx, cFD, XrdTlsSocket::TLS_RBL_WBL,
+                     XrdTlsSocket::TLS_HS_BLOCK, true);
+
+  // Handshake and then read everything the server sends
+  //
+  XrdTls::RC rc;
+  long long rcvd = 0, badBytes = 0;
+  std::thread client([&]
+     {std::vector<char> buff(1024*1024);
+      int n;
+      if (cSock.Connect() != XrdTls::TLS_AOK) return;
+      while(cSock.Read(buff.data(), buff.size(), n) == XrdTls::TLS_AOK
+         && n > 0)
+           {rcvd += n;
+            badBytes += n - std::count(buff.begin(), buff.begin()+n, 'k');
+           }
+     });
+  rc = sSock.Accept(&eMsg);
+  if (rc != XrdTls::TLS_AOK || (ktls && !sSock.hasKTLS()))
+     {if (rc == XrdTls::TLS_AOK) sSock.Shutdown();
+      shutdown(sFD, SHUT_RDWR); client.join();
+      close(sFD); close(cFD);
+      ASSERT_EQ(rc, XrdTls::TLS_AOK) << eMsg;
+      if (report) printf("kTLS is not available; pread+SSL_write only\n");
+      return;
+     }
+
+  // Failures end the sends but the client must still be joined
+  //
+  int fd = open(dataFN.c_str(), O_RDONLY);
+  std::vector<char> buff(256*1024);
+  double c0 = ThreadCPU();
+  auto   t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < nRounds && rc == XrdTls::TLS_AOK; r++)
+      {size_t offs = 0, len;
+       int n = 0;
+       while(offs < fileSz && rc == XrdTls::TLS_AOK)
+            {len = std::min(fileSz - offs, buff.size());
+             if (ktls) rc = sSock.SendFile(fd, offs, len, n);
+                else if (pread(fd, buff.data(), len, offs) != (ssize_t)len)
+                        rc = XrdTls::TLS_SYS_Error;
+                        else rc = sSock.Write(buff.data(), len, n);
+             offs += n;
+            }
+      }
+  double wall = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - t0).count();
+  double cpu  = ThreadCPU() - c0;
+  close(fd);
+
+  sSock.Shutdown();
+  shutdown(sFD, SHUT_WR);
+  client.join();
+  close(sFD); close(cFD);
+  EXPECT_EQ(rc, XrdTls::TLS_AOK);
+  EXPECT_EQ(rcvd, (long long)fileSz * nRounds);
+  EXPECT_EQ(badBytes, 0);
+
+  if (report)
+     printf("%-22s: %7.1f MB/s, %6.3f sender cpu s/GB\n",
+            (ktls ? "kTLS sendfile" : "pread+SSL_write"),
+            gBytes*1024/wall, cpu/gBytes);
+}
+
+TEST_F(TlsBench, Transfer)
+{
+  const size_t fileSz = 4*1024*1024;
+
+  MakeData(fileSz);
+  Send(false, fileSz, 1, false);
+  Send(true,  fileSz, 1, false);
+}
+
+TEST_F(TlsBench, DISABLED_SendFile)
+{
+  const size_t fileSz = 64*1024*1024;
+
+  MakeData(fileSz);
+  Send(false, fileSz, 4, true);
+  Send(true,  fileSz, 4, true);
+}